@@ -0,0 +1,42 @@
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @def BENCH_RUNS_COUNT
+ * @brief Count of runs of every measure, the fastest one is kept to filter out the noise of the machine
+ */
+#define BENCH_RUNS_COUNT 5
+
+/**
+ * @brief Return the current time in milliseconds, read with `timespec_get` since it is the only precise clock of C11
+ *
+ * @return The current time in milliseconds
+ */
+static inline double bench_now(void)
+{
+    struct timespec time;
+
+    timespec_get(&time, TIME_UTC);
+    return time.tv_sec * 1e3 + time.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Xorshift generator, so that the inputs of the benchmarks are the same on every platform
+ *
+ * @param state Pointer to the state of the generator, must not be 0
+ * @return The next pseudo-random number
+ */
+static inline uint32_t bench_random(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include "geometry.h"
+#include "bench.h"
+#include <math.h>
+
+/*
+    Measures the vertices per second of the geometry kernels against the per-vertex trigonometry
+    in double precision that generated the circles before them
+*/
+
+#define POINTS_COUNT 4096
+#define ITERATIONS_COUNT 2000
+
+// Read after every measure so that the compiler can't drop the generated points
+static volatile float bench_sink;
+
+static void trigonometry_generate_circle(const vec2 center, float radius, uint32_t points_count, vec2 *dest)
+{
+    for (uint32_t i = 0; i < points_count; ++i) {
+        double angle = 2.0 * GLM_PI * i / points_count;
+
+        dest[i][0] = (float) (center[0] + radius * cos(angle));
+        dest[i][1] = (float) (center[1] + radius * sin(angle));
+    }
+}
+
+static void kernel_generate_circle(vec2 *points)
+{
+    geometry_generate_circle((vec2) {0.5f, -0.25f}, 2.0f, POINTS_COUNT, points);
+}
+
+static void kernel_generate_ellipse(vec2 *points)
+{
+    geometry_generate_ellipse((vec2) {0.5f, -0.25f}, (vec2) {2.0f, 1.0f}, POINTS_COUNT, points);
+}
+
+static void kernel_generate_rounded_rectangle(vec2 *points)
+{
+    geometry_generate_rounded_rectangle((vec2) {0.5f, -0.25f}, (vec2) {2.0f, 1.0f}, 0.5f, POINTS_COUNT / 4, points);
+}
+
+static void kernel_generate_regular_polygon(vec2 *points)
+{
+    geometry_generate_regular_polygon((vec2) {0.5f, -0.25f}, 2.0f, POINTS_COUNT, 0.25f, points);
+}
+
+static void trigonometry_circle(vec2 *points)
+{
+    trigonometry_generate_circle((vec2) {0.5f, -0.25f}, 2.0f, POINTS_COUNT, points);
+}
+
+static void bench_generator(const char *name, void (*generate)(vec2 *points), vec2 *points)
+{
+    double best_time = 1e30;
+
+    for (int run = 0; run < BENCH_RUNS_COUNT; ++run) {
+        double start = bench_now();
+        for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+            generate(points);
+            bench_sink = points[i % POINTS_COUNT][0];
+        }
+        double end = bench_now();
+
+        best_time = end - start < best_time ? end - start : best_time;
+    }
+    printf("%-28s %8.2f ms  %8.1f Mvertices/s\n", name, best_time, (double) POINTS_COUNT * ITERATIONS_COUNT / best_time / 1e3);
+}
+
+static void bench_transform(vec2 *points, vec4 *positions)
+{
+    mat4 transform;
+    double kernel_time = 1e30;
+    double matrix_time = 1e30;
+
+    glm_rotate_make(transform, 0.3f, (vec3) {0.0f, 0.0f, 1.0f});
+    glm_translate(transform, (vec3) {0.5f, -0.25f, 0.0f});
+    for (int run = 0; run < BENCH_RUNS_COUNT; ++run) {
+        double start = bench_now();
+        for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+            geometry_transform_points(transform, (const vec2 *) points, POINTS_COUNT, positions, sizeof(vec4));
+            bench_sink = positions[i % POINTS_COUNT][0];
+        }
+        double middle = bench_now();
+        for (int i = 0; i < ITERATIONS_COUNT; ++i) {
+            for (uint32_t j = 0; j < POINTS_COUNT; ++j)
+                glm_mat4_mulv(transform, (vec4) {points[j][0], points[j][1], 0.0f, 1.0f}, positions[j]);
+            bench_sink = positions[i % POINTS_COUNT][0];
+        }
+        double end = bench_now();
+
+        kernel_time = middle - start < kernel_time ? middle - start : kernel_time;
+        matrix_time = end - middle < matrix_time ? end - middle : matrix_time;
+    }
+    printf("%-28s %8.2f ms  %8.1f Mvertices/s\n", "transform points", kernel_time, (double) POINTS_COUNT * ITERATIONS_COUNT / kernel_time / 1e3);
+    printf("%-28s %8.2f ms  %8.1f Mvertices/s\n", "transform glm_mat4_mulv", matrix_time, (double) POINTS_COUNT * ITERATIONS_COUNT / matrix_time / 1e3);
+}
+
+int main(void)
+{
+    vec2 *points = malloc(sizeof(vec2) * POINTS_COUNT);
+    vec4 *positions = malloc(sizeof(vec4) * POINTS_COUNT);
+    vec2 *reference = malloc(sizeof(vec2) * POINTS_COUNT);
+
+    if (!points || !positions || !reference) {
+        fprintf(stderr, "Failed to allocate the points\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%d points x %d, %s kernels\n", POINTS_COUNT, ITERATIONS_COUNT, geometry_get_simd_name());
+    bench_generator("circle sin/cos per vertex", trigonometry_circle, points);
+    bench_generator("circle", kernel_generate_circle, points);
+    bench_generator("ellipse", kernel_generate_ellipse, points);
+    bench_generator("rounded rectangle", kernel_generate_rounded_rectangle, points);
+    bench_generator("regular polygon", kernel_generate_regular_polygon, points);
+    bench_transform(points, positions);
+
+    // The recurrence of the kernels must stay as precise as the trigonometry
+    float max_error = 0.0f;
+    kernel_generate_circle(points);
+    trigonometry_circle(reference);
+    for (uint32_t i = 0; i < POINTS_COUNT; ++i)
+        max_error = fmaxf(max_error, glm_vec2_distance(points[i], reference[i]));
+    printf("circle max error %g\n", max_error);
+
+    free(points);
+    free(positions);
+    free(reference);
+    return max_error < 1e-5f ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+#include "mesh_optimizer.h"
+#include "bench.h"
+#include <string.h>
+
+/*
+    Measures the vertex cache and vertex fetch optimizations on grids whose triangles are shuffled,
+    the worst case of a user mesh, and the ACMR they reach
+*/
+
+struct grid {
+    vec2 *positions;
+    uint32_t *indices;
+    uint32_t vertices_count;
+    uint32_t indices_count;
+};
+
+static bool grid_create(struct grid *grid, uint32_t size)
+{
+    uint32_t random_state = 1;
+
+    grid->vertices_count = (size + 1) * (size + 1);
+    grid->indices_count = size * size * 6;
+    grid->positions = malloc(sizeof(vec2) * grid->vertices_count);
+    grid->indices = malloc(sizeof(uint32_t) * grid->indices_count);
+    if (!grid->positions || !grid->indices)
+        return false;
+
+    for (uint32_t i = 0; i < grid->vertices_count; ++i) {
+        grid->positions[i][0] = (float) (i % (size + 1));
+        grid->positions[i][1] = (float) (i / (size + 1));
+    }
+    uint32_t *index = grid->indices;
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            uint32_t top_left = y * (size + 1) + x;
+            uint32_t bottom_left = top_left + size + 1;
+
+            *index++ = top_left;
+            *index++ = top_left + 1;
+            *index++ = bottom_left;
+            *index++ = top_left + 1;
+            *index++ = bottom_left + 1;
+            *index++ = bottom_left;
+        }
+    }
+    for (uint32_t i = grid->indices_count / 3 - 1; i > 0; --i) {
+        uint32_t j = bench_random(&random_state) % (i + 1);
+
+        for (uint32_t k = 0; k < 3; ++k) {
+            uint32_t index_value = grid->indices[i * 3 + k];
+            grid->indices[i * 3 + k] = grid->indices[j * 3 + k];
+            grid->indices[j * 3 + k] = index_value;
+        }
+    }
+    return true;
+}
+
+static void grid_destroy(struct grid *grid)
+{
+    free(grid->positions);
+    free(grid->indices);
+}
+
+static bool bench_grid(uint32_t size)
+{
+    struct grid grid;
+    bool result = grid_create(&grid, size);
+    vec2 *positions = malloc(sizeof(vec2) * grid.vertices_count);
+    uint32_t *indices = malloc(sizeof(uint32_t) * grid.indices_count);
+    double cache_time = 1e30;
+    double fetch_time = 1e30;
+
+    if (!result || !positions || !indices) {
+        fprintf(stderr, "Failed to allocate a %ux%u grid\n", size, size);
+        result = false;
+    }
+    for (int run = 0; result && run < BENCH_RUNS_COUNT; ++run) {
+        memcpy(positions, grid.positions, sizeof(vec2) * grid.vertices_count);
+        memcpy(indices, grid.indices, sizeof(uint32_t) * grid.indices_count);
+
+        double start = bench_now();
+        result = mesh_optimize_vertex_cache(NULL, indices, grid.indices_count, grid.vertices_count, MESH_OPTIMIZER_DEFAULT_CACHE_SIZE);
+        double middle = bench_now();
+        result = result && mesh_optimize_vertex_fetch(NULL, positions, grid.vertices_count, indices, grid.indices_count);
+        double end = bench_now();
+
+        cache_time = middle - start < cache_time ? middle - start : cache_time;
+        fetch_time = end - middle < fetch_time ? end - middle : fetch_time;
+    }
+    if (result) {
+        uint32_t triangles_count = grid.indices_count / 3;
+        float acmr_before = mesh_compute_acmr(NULL, grid.indices, grid.indices_count, grid.vertices_count, MESH_OPTIMIZER_DEFAULT_CACHE_SIZE);
+        float acmr_after = mesh_compute_acmr(NULL, indices, grid.indices_count, grid.vertices_count, MESH_OPTIMIZER_DEFAULT_CACHE_SIZE);
+
+        printf("%4ux%-4u %9u triangles  acmr %.3f -> %.3f  cache %8.2f ms (%7.0f triangles/ms)  fetch %8.2f ms\n",
+            size, size, triangles_count, acmr_before, acmr_after, cache_time, triangles_count / cache_time, fetch_time);
+    }
+    free(positions);
+    free(indices);
+    grid_destroy(&grid);
+    return result;
+}
+
+int main(void)
+{
+    const uint32_t sizes[] = {32, 100, 316, 1000};
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        if (!bench_grid(sizes[i]))
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+#include "AntaGL.h"
+#include "bench.h"
+#include <string.h>
+
+/*
+    Measures the glyphs per millisecond of the text subsystem: the SDF rasterization of glyphs into a glyph atlas,
+    the layout of paragraphs whose glyphs are all cached, and whole frames of text recorded against the null driver.
+    Usage: bench_text <font.ttf>, with ANTAGL_SHADER_PATH set when the shaders aren't installed
+*/
+
+#define PARAGRAPHS_COUNT 20
+#define FRAMES_COUNT 100
+
+static const char *words = "The quick brown fox jumps over the lazy dog, sphinx of black quartz judge my vow. ";
+
+static uint32_t paragraph_create(char *paragraph, size_t size)
+{
+    size_t words_length = strlen(words);
+    size_t length = 0;
+    uint32_t glyphs_count = 0;
+
+    while (length + words_length < size) {
+        memcpy(paragraph + length, words, words_length);
+        length += words_length;
+    }
+    paragraph[length] = '\0';
+    for (size_t i = 0; i < length; ++i)
+        glyphs_count += paragraph[i] != ' ';
+    return glyphs_count;
+}
+
+// Every glyph of the Latin-1 and Latin Extended-A blocks is rasterized once in a new atlas
+static bool bench_rasterize(engine_t engine, font_t font)
+{
+    double best_time = 1e30;
+    uint64_t rasterized_count = 0;
+
+    for (int run = 0; run < BENCH_RUNS_COUNT; ++run) {
+        struct glyph_atlas atlas;
+        const struct glyph *glyph;
+
+        if (!glyph_atlas_init(&atlas, &engine->allocator, GLYPH_ATLAS_DEFAULT_SIZE, GLYPH_ATLAS_DEFAULT_CELL_SIZE))
+            return false;
+
+        double start = bench_now();
+        for (uint32_t codepoint = 0x21; codepoint < 0x180; ++codepoint) {
+            uint32_t index = font_get_glyph_index(font, codepoint);
+
+            if (index != 0)
+                glyph_atlas_acquire(&atlas, font, index, &glyph);
+        }
+        double end = bench_now();
+
+        best_time = end - start < best_time ? end - start : best_time;
+        rasterized_count = atlas.rasterized_count;
+        glyph_atlas_cleanup(&atlas);
+    }
+    printf("rasterize %4llu glyphs         %8.2f ms  %8.1f glyphs/ms\n", (unsigned long long) rasterized_count, best_time, rasterized_count / best_time);
+    return true;
+}
+
+static bool bench_layout(engine_t engine, font_t font, const char *paragraph, uint32_t glyphs_count)
+{
+    double layout_time = 1e30;
+    double frame_time = 1e30;
+
+    for (int run = 0; run < BENCH_RUNS_COUNT; ++run) {
+        double layout_start = bench_now();
+        for (int i = 0; i < PARAGRAPHS_COUNT; ++i) {
+            if (!text_draw(engine, font, paragraph, (vec2) {-1.0f, 1.0f - i * 0.1f}, 0.05f, (vec4) {1.0f, 1.0f, 1.0f, 1.0f}))
+                return false;
+        }
+        double layout_end = bench_now();
+        if (!engine_display(engine))
+            return false;
+
+        double frame_start = bench_now();
+        for (int frame = 0; frame < FRAMES_COUNT; ++frame) {
+            for (int i = 0; i < PARAGRAPHS_COUNT; ++i) {
+                if (!text_draw(engine, font, paragraph, (vec2) {-1.0f, 1.0f - i * 0.1f}, 0.05f, (vec4) {1.0f, 1.0f, 1.0f, 1.0f}))
+                    return false;
+            }
+            if (!engine_display(engine))
+                return false;
+        }
+        double frame_end = bench_now();
+
+        layout_time = layout_end - layout_start < layout_time ? layout_end - layout_start : layout_time;
+        frame_time = frame_end - frame_start < frame_time ? frame_end - frame_start : frame_time;
+    }
+    printf("layout %6u glyphs           %8.2f ms  %8.1f glyphs/ms\n", glyphs_count * PARAGRAPHS_COUNT, layout_time, glyphs_count * PARAGRAPHS_COUNT / layout_time);
+    frame_time /= FRAMES_COUNT;
+    printf("frame %7u glyphs           %8.2f ms  %8.1f glyphs/ms\n", glyphs_count * PARAGRAPHS_COUNT, frame_time, glyphs_count * PARAGRAPHS_COUNT / frame_time);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <font.ttf>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct version version = {
+        .major = 1,
+        .minor = 0,
+        .patch = 0
+    };
+    engine_t engine = engine_create("bench_text", version, 800, 600, 16, NULL);
+    if (!engine) {
+        fprintf(stderr, "Failed to create the engine\n");
+        return EXIT_FAILURE;
+    }
+    font_t font = font_load(&engine->allocator, argv[1]);
+    if (!font) {
+        fprintf(stderr, "Failed to load the font %s\n", argv[1]);
+        engine_cleanup(engine);
+        return EXIT_FAILURE;
+    }
+
+    char paragraph[4096];
+    uint32_t glyphs_count = paragraph_create(paragraph, sizeof(paragraph));
+    bool result = bench_rasterize(engine, font) && bench_layout(engine, font, paragraph, glyphs_count);
+
+    if (!result)
+        fprintf(stderr, "Failed to draw the text\n");
+    engine_wait_idle(engine);
+    glyph_atlas_remove_font(&engine->glyph_atlas, font);
+    font_destroy(font);
+    engine_cleanup(engine);
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
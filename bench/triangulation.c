@@ -0,0 +1,127 @@
+#include "triangulation.h"
+#include "bench.h"
+#include <math.h>
+
+/*
+    Measures the triangulation of concave star shaped polygons from 10k to 1M vertices,
+    without holes and with a grid of small square holes
+*/
+
+#define HOLE_VERTICES_COUNT 4
+
+// Outer ring with a radius jittered by the spacing of its vertices, so that about half of them are reflex like on a digitized coastline,
+// followed by square holes in a grid
+static vec2 *polygon_create(uint32_t outer_count, uint32_t holes_side, uint32_t **holes_starts, uint32_t *vertices_count)
+{
+    uint32_t random_state = 1;
+    uint32_t holes_count = holes_side * holes_side;
+
+    *vertices_count = outer_count + holes_count * HOLE_VERTICES_COUNT;
+    vec2 *positions = malloc(sizeof(vec2) * *vertices_count);
+    *holes_starts = holes_count ? malloc(sizeof(uint32_t) * holes_count) : NULL;
+    if (!positions || (holes_count && !*holes_starts)) {
+        free(positions);
+        free(*holes_starts);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < outer_count; ++i) {
+        double angle = 2.0 * GLM_PI * i / outer_count;
+        double radius = 1.0 + 2.0 * GLM_PI / outer_count * ((bench_random(&random_state) & 0xffff) / 65535.0 - 0.5);
+
+        positions[i][0] = (float) (cos(angle) * radius);
+        positions[i][1] = (float) (sin(angle) * radius);
+    }
+    // Holes fill a square inside the ring, each taking half of its cell
+    float cell = 1.2f / (holes_side ? holes_side : 1);
+    for (uint32_t i = 0; i < holes_count; ++i) {
+        float x = -0.6f + (i % holes_side + 0.25f) * cell;
+        float y = -0.6f + (i / holes_side + 0.25f) * cell;
+        vec2 *hole = positions + outer_count + i * HOLE_VERTICES_COUNT;
+
+        (*holes_starts)[i] = outer_count + i * HOLE_VERTICES_COUNT;
+        glm_vec2_copy((vec2) {x, y}, hole[0]);
+        glm_vec2_copy((vec2) {x, y + cell * 0.5f}, hole[1]);
+        glm_vec2_copy((vec2) {x + cell * 0.5f, y + cell * 0.5f}, hole[2]);
+        glm_vec2_copy((vec2) {x + cell * 0.5f, y}, hole[3]);
+    }
+    return positions;
+}
+
+static double ring_area(const vec2 *positions, uint32_t start, uint32_t end)
+{
+    double area = 0.0;
+
+    for (uint32_t i = start, j = end - 1; i < end; j = i++)
+        area += ((double) positions[j][0] - positions[i][0]) * ((double) positions[j][1] + positions[i][1]);
+    return fabs(area) * 0.5;
+}
+
+static double triangles_area(const vec2 *positions, const uint32_t *indices, uint32_t indices_count)
+{
+    double area = 0.0;
+
+    for (uint32_t i = 0; i < indices_count; i += 3) {
+        const float *a = positions[indices[i]];
+        const float *b = positions[indices[i + 1]];
+        const float *c = positions[indices[i + 2]];
+
+        area += fabs(((double) b[0] - a[0]) * ((double) c[1] - a[1]) - ((double) c[0] - a[0]) * ((double) b[1] - a[1])) * 0.5;
+    }
+    return area;
+}
+
+static bool bench_polygon(uint32_t outer_count, uint32_t holes_side)
+{
+    uint32_t *holes_starts;
+    uint32_t vertices_count;
+    uint32_t holes_count = holes_side * holes_side;
+    vec2 *positions = polygon_create(outer_count, holes_side, &holes_starts, &vertices_count);
+    uint32_t indices_count = 0;
+    double covered_area = 0.0;
+    double best_time = 1e30;
+    bool result = positions != NULL;
+
+    if (!result)
+        fprintf(stderr, "Failed to allocate a polygon of %u vertices\n", outer_count);
+    for (int run = 0; result && run < BENCH_RUNS_COUNT; ++run) {
+        uint32_t *indices;
+
+        double start = bench_now();
+        result = triangulate_polygon(NULL, positions, vertices_count, holes_starts, holes_count, &indices, &indices_count);
+        double end = bench_now();
+
+        if (result) {
+            covered_area = triangles_area(positions, indices, indices_count);
+            allocator_free(NULL, indices, ALLOCATOR_SUBSYSTEM_MESH);
+        }
+        best_time = end - start < best_time ? end - start : best_time;
+    }
+    // The triangles must cover the polygon exactly, collinear vertices may be dropped so their count can't be checked
+    if (result) {
+        double area = ring_area(positions, 0, holes_count ? holes_starts[0] : vertices_count);
+
+        for (uint32_t i = 0; i < holes_count; ++i)
+            area -= ring_area(positions, holes_starts[i], i + 1 < holes_count ? holes_starts[i + 1] : vertices_count);
+        if (fabs(covered_area - area) > area * 1e-6) {
+            fprintf(stderr, "The triangles cover %f instead of %f\n", covered_area, area);
+            result = false;
+        }
+    }
+    if (result)
+        printf("%8u vertices %5u holes  %8u triangles  %8.2f ms  (%6.0f vertices/ms)\n", vertices_count, holes_count, indices_count / 3, best_time, vertices_count / best_time);
+    free(positions);
+    free(holes_starts);
+    return result;
+}
+
+int main(void)
+{
+    const uint32_t vertices_counts[] = {10000, 100000, 1000000};
+
+    for (size_t i = 0; i < sizeof(vertices_counts) / sizeof(vertices_counts[0]); ++i) {
+        if (!bench_polygon(vertices_counts[i], 0) || !bench_polygon(vertices_counts[i], 10))
+            return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -11,15 +11,29 @@ namespace AntaGL {
 
     class Engine {
         public :
-            Engine(std::string appName, struct version appVersion, int width, int height, uint32_t maxObjectsToDraw);
+            Engine(std::string appName, struct version appVersion, int width, int height, uint32_t maxObjectsToDraw, allocator_t allocator = nullptr);
             ~Engine();
 
             bool display();
             bool draw(Object object);
+            bool draw(Object object, const struct draw_parameters &parameters);
+            bool drawShape(const struct shape &shape);
+            bool drawQuad(vec2 position, vec2 size, vec4 color);
+            bool drawTilemap(struct tilemap &tilemap);
+            bool drawPointCloud(struct point_cloud &pointCloud);
+            bool drawTimeSeries(struct time_series &timeSeries);
+            bool drawVectorCanvas(struct vector_canvas &canvas);
+            bool drawText(const struct font &font, const std::string &text, vec2 position, float size, vec4 color);
+            texture_t createTexture(uint32_t width, uint32_t height, const void *pixels);
+            void destroyTexture(texture_t texture);
+            bool frameAllocate(VkDeviceSize size, VkDeviceSize alignment, struct frame_allocation &allocation);
             bool pollEvents();
             bool shouldClose();
             void waitIdle();
             void updateCamera();
+            struct allocator_statistics allocationStatistics();
+            void setDynamicBatchThreshold(uint32_t threshold);
+            uint32_t dynamicBatchesCount(uint32_t *batchedObjectsCount = nullptr);
 
             engine_t data() {return _engine;}
 
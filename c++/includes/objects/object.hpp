@@ -9,17 +9,39 @@
 namespace AntaGL {
     class Object {
         public :
-            Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint16_t> indices);
+            Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, bool optimize = false);
+            Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, enum mesh_topology topology);
             Object(object_t object);
             ~Object();
 
             object_t data() {return _object;}
             void destroy(AntaGL::Engine &engine);
+            void setColor(vec3 color);
+            void setTexture(texture_t texture, const float *uvRect = nullptr);
+            void setTexture(const struct texture_region &region);
 
         protected:
             object_t _object;
     };
 
+    class LodObject : public Object {
+        public :
+            LodObject(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, uint32_t lodsCount);
+            ~LodObject();
+    };
+
+    class Polygon : public Object {
+        public :
+            Polygon(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> holesStarts = {});
+            ~Polygon();
+    };
+
+    class Stroke : public Object {
+        public :
+            Stroke(AntaGL::Engine &engine, std::vector<vec2> points, const stroke_style &style, vec3 color, bool closed = false);
+            ~Stroke();
+    };
+
     class Triangle : public Object {
         public :
             Triangle(AntaGL::Engine &engine, mat3x2 verticlesPos, vec3 color);
@@ -34,7 +56,7 @@ namespace AntaGL {
 
     class Circle : public Object {
         public:
-            Circle(AntaGL::Engine &engine, vec2 center, float radius, vec3 color, unsigned int outsideVerticesCount = CIRCLE_DEFAULT_OUTSIDE_VERTICES_COUNT);
+            Circle(AntaGL::Engine &engine, vec2 center, float radius, vec3 color, unsigned int outsideVerticesCount = CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT);
             ~Circle();
     };
 }
@@ -9,16 +9,20 @@
 namespace AntaGL {
     class SceneNode {
         public:
-            SceneNode(Object object);
-            SceneNode(SceneNode &parent, Object object);
+            SceneNode(Engine &engine, Object object);
+            SceneNode(Engine &engine, SceneNode &parent, Object object);
             ~SceneNode();
 
             void removeChild(SceneNode child);
             bool draw(Engine &engine);
+            bool bake();
+            void unbake();
+            void invalidate();
 
             scene_node_t data() {return _node;}
 
         private:
+            engine_t _engine;
             scene_node_t _node;
     };
 }
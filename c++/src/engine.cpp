@@ -2,9 +2,9 @@
 #include <objects/object.hpp>
 
 namespace AntaGL {
-    Engine::Engine(std::string appName, struct version appVersion, int width, int height, uint32_t maxObjectsToDraw)
+    Engine::Engine(std::string appName, struct version appVersion, int width, int height, uint32_t maxObjectsToDraw, allocator_t allocator)
     {
-        _engine = engine_create(appName.data(), appVersion, width, height, maxObjectsToDraw);
+        _engine = engine_create(appName.data(), appVersion, width, height, maxObjectsToDraw, allocator);
     }
 
     Engine::~Engine()
@@ -22,6 +22,61 @@ namespace AntaGL {
         return engine_draw(_engine, object.data());
     }
 
+    bool Engine::draw(Object object, const struct draw_parameters &parameters)
+    {
+        return engine_draw_with_parameters(_engine, object.data(), &parameters);
+    }
+
+    bool Engine::drawShape(const struct shape &shape)
+    {
+        return engine_draw_shape(_engine, &shape);
+    }
+
+    bool Engine::drawQuad(vec2 position, vec2 size, vec4 color)
+    {
+        return engine_draw_quad(_engine, position, size, color);
+    }
+
+    bool Engine::drawTilemap(struct tilemap &tilemap)
+    {
+        return tilemap_draw(_engine, &tilemap);
+    }
+
+    bool Engine::drawPointCloud(struct point_cloud &pointCloud)
+    {
+        return point_cloud_draw(_engine, &pointCloud);
+    }
+
+    bool Engine::drawTimeSeries(struct time_series &timeSeries)
+    {
+        return time_series_draw(_engine, &timeSeries);
+    }
+
+    bool Engine::drawVectorCanvas(struct vector_canvas &canvas)
+    {
+        return vector_canvas_draw(_engine, &canvas);
+    }
+
+    bool Engine::drawText(const struct font &font, const std::string &text, vec2 position, float size, vec4 color)
+    {
+        return text_draw(_engine, &font, text.c_str(), position, size, color);
+    }
+
+    texture_t Engine::createTexture(uint32_t width, uint32_t height, const void *pixels)
+    {
+        return engine_create_texture(_engine, width, height, pixels);
+    }
+
+    void Engine::destroyTexture(texture_t texture)
+    {
+        engine_destroy_texture(_engine, texture);
+    }
+
+    bool Engine::frameAllocate(VkDeviceSize size, VkDeviceSize alignment, struct frame_allocation &allocation)
+    {
+        return engine_frame_allocate(_engine, size, alignment, &allocation);
+    }
+
     bool Engine::pollEvents()
     {
         return engine_poll_events(_engine);
@@ -41,4 +96,22 @@ namespace AntaGL {
     {
         engine_update_camera(_engine);
     }
+
+    struct allocator_statistics Engine::allocationStatistics()
+    {
+        struct allocator_statistics statistics;
+
+        engine_get_allocation_statistics(_engine, &statistics);
+        return statistics;
+    }
+
+    void Engine::setDynamicBatchThreshold(uint32_t threshold)
+    {
+        _engine->dynamic_batch_threshold = threshold;
+    }
+
+    uint32_t Engine::dynamicBatchesCount(uint32_t *batchedObjectsCount)
+    {
+        return engine_get_dynamic_batches_count(_engine, batchedObjectsCount);
+    }
 }
@@ -1,9 +1,17 @@
 #include "objects/object.hpp"
 
 namespace AntaGL {
-    Object::Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint16_t> indices)
+    Object::Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, bool optimize)
+    {
+        if (optimize)
+            _object = object_create_optimized(engine.data(), verticesPos.data(), color, indices.data(), verticesPos.size(), indices.size());
+        else
+            _object = object_create(engine.data(), verticesPos.data(), color, indices.data(), verticesPos.size());
+    }
+
+    Object::Object(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, enum mesh_topology topology):
+        _object(object_create_with_topology(engine.data(), verticesPos.data(), color, indices.data(), verticesPos.size(), indices.size(), topology))
     {
-        _object = object_create(engine.data(), verticesPos.data(), color, indices.data(), verticesPos.size());
     }
 
     Object::Object(object_t object):
@@ -20,6 +28,63 @@ namespace AntaGL {
         object_destroy(engine.data(), _object);
     }
 
+    void Object::setColor(vec3 color)
+    {
+        object_set_color(_object, color);
+    }
+
+    void Object::setTexture(texture_t texture, const float *uvRect)
+    {
+        object_set_texture(_object, texture, uvRect);
+    }
+
+    void Object::setTexture(const struct texture_region &region)
+    {
+        object_set_texture(_object, region.texture, region.uv_rect);
+    }
+
+    // === LEVELS OF DETAIL ===
+    LodObject::LodObject(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> indices, uint32_t lodsCount):
+        Object(object_create_with_lods(engine.data(), verticesPos.data(), color, indices.data(), verticesPos.size(), indices.size(), lodsCount))
+    {
+    }
+
+    LodObject::~LodObject()
+    {
+    }
+
+    // === POLYGONS ===
+    Polygon::Polygon(AntaGL::Engine &engine, std::vector<vec2> verticesPos, vec3 color, std::vector<uint32_t> holesStarts):
+        Object(object_create_polygon(engine.data(), verticesPos.data(), verticesPos.size(), holesStarts.data(), holesStarts.size(), color))
+    {
+    }
+
+    Polygon::~Polygon()
+    {
+    }
+
+    // === STROKES ===
+    static object_t createStroke(AntaGL::Engine &engine, std::vector<vec2> &points, const stroke_style &style, vec3 color, bool closed)
+    {
+        stroke_buffer buffer;
+        object_t object = NULL;
+
+        stroke_buffer_init(&buffer, &engine.data()->allocator);
+        if (stroke_buffer_add_polyline(&buffer, &style, points.data(), points.size(), closed))
+            object = object_create_stroke(engine.data(), &buffer, color);
+        stroke_buffer_cleanup(&buffer);
+        return object;
+    }
+
+    Stroke::Stroke(AntaGL::Engine &engine, std::vector<vec2> points, const stroke_style &style, vec3 color, bool closed):
+        Object(createStroke(engine, points, style, color, closed))
+    {
+    }
+
+    Stroke::~Stroke()
+    {
+    }
+
     // === TRIANGLES ===
     Triangle::Triangle(AntaGL::Engine &engine, mat3x2 verticlesPos, vec3 color):
         Object(object_create_triangle(engine.data(), verticlesPos, color))
@@ -1,19 +1,21 @@
 #include "sceneManager.hpp"
 
 namespace AntaGL {
-    SceneNode::SceneNode(Object object):
-        _node(scene_node_create(NULL, object.data()))
+    SceneNode::SceneNode(Engine &engine, Object object):
+        _engine(engine.data()),
+        _node(scene_node_create(engine.data(), NULL, object.data()))
     {
     }
 
-    SceneNode::SceneNode(SceneNode &parent, Object object):
-        _node(scene_node_create(parent.data(), object.data()))
+    SceneNode::SceneNode(Engine &engine, SceneNode &parent, Object object):
+        _engine(engine.data()),
+        _node(scene_node_create(engine.data(), parent.data(), object.data()))
     {
     }
 
     SceneNode::~SceneNode()
     {
-        scene_node_destroy(_node, false);
+        scene_node_destroy(_engine, _node, false);
     }
 
     bool SceneNode::draw(Engine &engine)
@@ -21,9 +23,24 @@ namespace AntaGL {
         return scene_node_draw(engine.data(), _node);
     }
 
+    bool SceneNode::bake()
+    {
+        return scene_node_bake(_engine, _node);
+    }
+
+    void SceneNode::unbake()
+    {
+        scene_node_unbake(_engine, _node);
+    }
+
+    void SceneNode::invalidate()
+    {
+        scene_node_invalidate(_node);
+    }
+
     void SceneNode::removeChild(SceneNode child)
     {
-        scene_node_remove_child(child.data(), _node);
+        scene_node_remove_child(_engine, child.data(), _node);
     }
 }
 
@@ -16,7 +16,7 @@ void run(engine_t engine)
     };
     object_t triangle = object_create_triangle(engine, tri_pos, color);
 
-    object_t circle = object_create_circle(engine, pos, 0.5f, color, CIRCLE_DEFAULT_OUTSIDE_VERTICES_COUNT);
+    object_t circle = object_create_circle(engine, pos, 0.5f, color, CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT);
 
     while (!engine_should_close(engine)) {
         if (!engine_poll_events(engine)
@@ -59,7 +59,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
         .patch = 0
     };
     const char *app_name = "AntaApplication";
-    engine_t engine = engine_create(app_name, app_version, 800, 600, 10);
+    engine_t engine = engine_create(app_name, app_version, 800, 600, 10, NULL);
 
     run(engine);
 
@@ -79,7 +79,7 @@ int main(const int argc, const char **argv, const char **env)
     };
     const char *app_name = "AntaApplication";
 
-    engine_t engine = engine_create(app_name, app_version, 800, 600, 10);
+    engine_t engine = engine_create(app_name, app_version, 800, 600, 10, NULL);
 
     run(engine);
 
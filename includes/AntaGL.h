@@ -3,6 +3,15 @@
 
 #include "engine.h"
 #include "object.h"
+#include "shape.h"
+#include "text.h"
+#include "texture_atlas.h"
+#include "tilemap.h"
+#include "point_cloud.h"
+#include "time_series.h"
+#include "vector_canvas.h"
+#include "streaming_texture.h"
+#include "static_batch.h"
 #include "scene_manager.h"
 
 #endif
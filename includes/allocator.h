@@ -0,0 +1,167 @@
+#ifndef _ANTA_GL_ALLOCATOR_H
+    #define _ANTA_GL_ALLOCATOR_H
+
+    #include <stddef.h>
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include <vulkan/vulkan.h>
+    #ifdef __cplusplus
+        #include <atomic>
+    #else
+        #include <stdatomic.h>
+    #endif
+
+#ifdef __cplusplus
+typedef std::atomic<uint64_t> allocator_counter_t;
+
+extern "C" {
+#else
+typedef _Atomic uint64_t allocator_counter_t;
+#endif
+
+/**
+ * @enum allocator_subsystem
+ * @brief Part of the engine requesting an allocation, given to every allocator function so that memory can be attributed per subsystem
+ */
+enum allocator_subsystem {
+    ALLOCATOR_SUBSYSTEM_ENGINE = 0,
+    ALLOCATOR_SUBSYSTEM_VULKAN,
+    ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER,
+    ALLOCATOR_SUBSYSTEM_MESH,
+    ALLOCATOR_SUBSYSTEM_OBJECT,
+    ALLOCATOR_SUBSYSTEM_SCENE,
+    ALLOCATOR_SUBSYSTEM_TEXT,
+    ALLOCATOR_SUBSYSTEM_TEXTURE,
+    ALLOCATOR_SUBSYSTEM_TILEMAP,
+    ALLOCATOR_SUBSYSTEM_POINT_CLOUD,
+    ALLOCATOR_SUBSYSTEM_TIME_SERIES,
+    ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS,
+    ALLOCATOR_SUBSYSTEM_COUNT
+};
+
+/**
+ * @struct allocator_statistics
+ * @brief Counters of the calls made to an allocator, per subsystem
+ * @var allocator_statistics::allocations_count
+ * Count of successful allocations and reallocations, indexed by `enum allocator_subsystem`
+ * @var allocator_statistics::deallocations_count
+ * Count of deallocations, indexed by `enum allocator_subsystem`
+ */
+struct allocator_statistics {
+    uint64_t allocations_count[ALLOCATOR_SUBSYSTEM_COUNT];
+    uint64_t deallocations_count[ALLOCATOR_SUBSYSTEM_COUNT];
+};
+
+/**
+ * @struct allocator_counters
+ * @brief Live counters behind `allocator_statistics`, incremented atomically since the Vulkan driver may call the allocator from any thread
+ * @var allocator_counters::allocations_count
+ * Count of successful allocations and reallocations, indexed by `enum allocator_subsystem`
+ * @var allocator_counters::deallocations_count
+ * Count of deallocations, indexed by `enum allocator_subsystem`
+ */
+struct allocator_counters {
+    allocator_counter_t allocations_count[ALLOCATOR_SUBSYSTEM_COUNT];
+    allocator_counter_t deallocations_count[ALLOCATOR_SUBSYSTEM_COUNT];
+};
+
+/**
+ * @struct allocator
+ * @brief Interface through which the engine does every host allocation, including the ones of the Vulkan driver
+ * @var allocator::allocate
+ * Return `size` bytes aligned on `alignment`, a power of two, or NULL on failure
+ * @var allocator::reallocate
+ * Resize an allocation returned by `allocate`, keeping its content and its alignment, and return the new pointer or NULL on failure leaving `memory` untouched
+ * @var allocator::deallocate
+ * Free an allocation returned by `allocate` or `reallocate`, `memory` is never NULL
+ * @var allocator::user_data
+ * Pointer given back to every function of the allocator, such as the arena or tracker state
+ * @var allocator::statistics
+ * Counters updated by the engine on every call to the allocator, reset when the engine is created, read them with `allocator_get_statistics`
+ */
+typedef struct allocator {
+    void *(*allocate)(void *user_data, size_t size, size_t alignment, enum allocator_subsystem subsystem);
+    void *(*reallocate)(void *user_data, void *memory, size_t size, size_t alignment, enum allocator_subsystem subsystem);
+    void (*deallocate)(void *user_data, void *memory, enum allocator_subsystem subsystem);
+    void *user_data;
+
+    struct allocator_counters statistics;
+} * allocator_t;
+
+/**
+ * @brief Initialise an allocator with the default functions of the engine, built on top of `malloc` and `free`
+ *
+ * @param allocator Pointer to the allocator to initialise
+ */
+void allocator_init_default(allocator_t allocator);
+/**
+ * @brief Allocate memory aligned for any type
+ *
+ * @param allocator Pointer to the allocator to use, NULL for the default allocator
+ * @param size Size in bytes of the allocation
+ * @param subsystem Subsystem the allocation is attributed to
+ * @return Pointer to the allocated memory, or NULL on failure
+ */
+void *allocator_allocate(allocator_t allocator, size_t size, enum allocator_subsystem subsystem);
+/**
+ * @brief Allocate zero-initialised memory for an array, aligned for any type
+ *
+ * @param allocator Pointer to the allocator to use, NULL for the default allocator
+ * @param count Count of elements of the array
+ * @param size Size in bytes of an element
+ * @param subsystem Subsystem the allocation is attributed to
+ * @return Pointer to the allocated memory, or NULL on failure or overflow
+ */
+void *allocator_allocate_zeroed(allocator_t allocator, size_t count, size_t size, enum allocator_subsystem subsystem);
+/**
+ * @brief Resize an allocation, behaves like `allocator_allocate` when `memory` is NULL
+ *
+ * @param allocator Pointer to the allocator that allocated `memory`, NULL for the default allocator
+ * @param memory Pointer to the allocation to resize
+ * @param size New size in bytes of the allocation
+ * @param subsystem Subsystem the allocation is attributed to, the same one used to allocate it
+ * @return Pointer to the resized allocation, or NULL on failure leaving `memory` untouched
+ */
+void *allocator_reallocate(allocator_t allocator, void *memory, size_t size, enum allocator_subsystem subsystem);
+/**
+ * @brief Free an allocation, does nothing if `memory` is NULL
+ *
+ * @param allocator Pointer to the allocator that allocated `memory`, NULL for the default allocator
+ * @param memory Pointer to the allocation to free
+ * @param subsystem Subsystem the allocation is attributed to, the same one used to allocate it
+ */
+void allocator_free(allocator_t allocator, void *memory, enum allocator_subsystem subsystem);
+/**
+ * @brief Copy a snapshot of the counters of an allocator, each counter is read atomically but not the whole set
+ *
+ * @param allocator Pointer to the allocator to read
+ * @param statistics Pointer to the structure where the counters will be copied
+ */
+void allocator_get_statistics(allocator_t allocator, struct allocator_statistics *statistics);
+/**
+ * @brief Reset every counter of an allocator to zero
+ *
+ * @param allocator Pointer to the allocator to reset
+ */
+void allocator_reset_statistics(allocator_t allocator);
+/**
+ * @brief Return the total count of allocations and reallocations recorded in statistics, all subsystems together
+ *
+ * @param statistics Pointer to the statistics to sum
+ * @return The count of allocations of every subsystem
+ */
+uint64_t allocator_statistics_total_allocations(const struct allocator_statistics *statistics);
+/**
+ * @brief Fill Vulkan allocation callbacks routing the driver host allocations to an allocator under `ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER`.
+ * The allocator must outlive every Vulkan object created with the callbacks
+ *
+ * @param allocator Pointer to the allocator the callbacks will use
+ * @param callbacks Pointer to the callbacks to fill
+ */
+void allocator_get_vulkan_callbacks(allocator_t allocator, VkAllocationCallbacks *callbacks);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -14,6 +14,7 @@
     #include "surfaces/window.h"
     #include "vulkan/vulkan_wrapper.h"
     #include "utils.h"
+    #include "allocator.h"
     #include "camera.h"
 
     #include "surfaces/surface.h"
@@ -33,6 +34,41 @@
      * Current version of the engine, used by VkApplicationInfo
      */
     #define ENGINE_VERSION VK_MAKE_VERSION(1, 0, 0)
+    /**
+     * @def ENGINE_LOD_ERROR_TOLERANCE_DEFAULT
+     * @brief Default maximum distance in pixels between the outline of an object drawn with levels of detail and its true curve
+     */
+    #define ENGINE_LOD_ERROR_TOLERANCE_DEFAULT 0.5f
+    /**
+     * @def ENGINE_LOD_HYSTERESIS_DEFAULT
+     * @brief Default factor applied to the error tolerance before an object switches to a coarser level of detail
+     */
+    #define ENGINE_LOD_HYSTERESIS_DEFAULT 0.75f
+    /**
+     * @def ENGINE_DYNAMIC_BATCH_THRESHOLD_DEFAULT
+     * @brief Default maximum count of vertices of the objects merged into dynamic batches
+     */
+    #define ENGINE_DYNAMIC_BATCH_THRESHOLD_DEFAULT 64
+    /**
+     * @def ENGINE_MAX_TILEMAPS_TO_DRAW
+     * @brief Maximum count of tilemaps drawn per call of `engine_display()`
+     */
+    #define ENGINE_MAX_TILEMAPS_TO_DRAW 16
+    /**
+     * @def ENGINE_MAX_POINT_CLOUDS_TO_DRAW
+     * @brief Maximum count of point clouds drawn per call of `engine_display()`
+     */
+    #define ENGINE_MAX_POINT_CLOUDS_TO_DRAW 16
+    /**
+     * @def ENGINE_MAX_TIME_SERIES_TO_DRAW
+     * @brief Maximum count of time series drawn per call of `engine_display()`
+     */
+    #define ENGINE_MAX_TIME_SERIES_TO_DRAW 16
+    /**
+     * @def ENGINE_MAX_VECTOR_CANVASES_TO_DRAW
+     * @brief Maximum count of vector canvases drawn per call of `engine_display()`
+     */
+    #define ENGINE_MAX_VECTOR_CANVASES_TO_DRAW 16
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,29 +77,95 @@ extern "C" {
 /**
  * @struct engine
  * @brief Structure representing the engine
+ * @var engine::allocator
+ * Allocator used for every host allocation of the engine and of the Vulkan driver, set upon creation in `engine_create()`
  * @var engine::window
  * Active window created by the engine containing its properties and properties of inputs
  * @var engine::camera
  * Active camera rendering the scene
  * @var engine::objects_to_draw
- * Array of objects that will be drawn when `engine_display()` is called.
- * Objects can be added using `engine_draw()`
+ * Array of draw commands, objects and the offset of their draw parameters, that will be drawn when `engine_display()` is called.
+ * Objects can be added using `engine_draw()` or `engine_draw_with_parameters()`
  * @var engine::objects_to_draw_count
  * Count of objects to draw in the next `engine_display()` call.
  * All objects from indices 0 to `objects_to_draw_count`will be drawn
  * @var engine::max_objects_to_draw
  * Maximum count of objects that can be drawn, it is set upon initialisation in `engine_create()`
+ * @var engine::tilemaps_to_draw
+ * Tilemaps that will be drawn behind the objects when `engine_display()` is called, their visible chunks are selected by `tilemap_draw()`
+ * @var engine::tilemaps_to_draw_count
+ * Count of tilemaps to draw in the next `engine_display()` call
+ * @var engine::point_clouds_to_draw
+ * Point clouds that will be drawn on top of the tilemaps and behind the objects when `engine_display()` is called, their visible chunks are selected by `point_cloud_draw()`
+ * @var engine::point_clouds_to_draw_count
+ * Count of point clouds to draw in the next `engine_display()` call
+ * @var engine::time_series_to_draw
+ * Time series that will be drawn on top of the objects and behind the shapes when `engine_display()` is called, their visible entries are selected by `time_series_draw()`
+ * @var engine::time_series_to_draw_count
+ * Count of time series to draw in the next `engine_display()` call
+ * @var engine::vector_canvases_to_draw
+ * Vector canvases that will be rasterized before the rendering and composited on top of the time series and behind the shapes when `engine_display()` is called,
+ * their visible paths are bounded by `vector_canvas_draw()`
+ * @var engine::vector_canvases_to_draw_count
+ * Count of vector canvases to draw in the next `engine_display()` call
+ * @var engine::shapes_to_draw
+ * Array of shapes that will be drawn on top of the objects when `engine_display()` is called, holding up to `max_objects_to_draw` shapes.
+ * Shapes can be added using `engine_draw_shape()`
+ * @var engine::shapes_to_draw_count
+ * Count of shapes to draw in the next `engine_display()` call
+ * @var engine::quad_batch
+ * Quads that will be drawn on top of the shapes when `engine_display()` is called, written in the transient memory of the frame.
+ * Quads can be added using `engine_draw_quad()`
+ * @var engine::text_batch
+ * Glyph quads of the text that will be drawn on top of the quads when `engine_display()` is called, written in the transient memory of the frame.
+ * Text can be added using `text_draw()`
+ * @var engine::glyph_atlas
+ * Atlas of the glyphs drawn by `text_draw()`, rasterized on their first use and evicted when they haven't been drawn for the longest time
+ * @var engine::glyph_atlas_texture
+ * Texture sampled by the text, the rows of the glyph atlas changed during a frame are uploaded by the next `engine_display()` call
+ * @var engine::lod_error_tolerance
+ * Maximum distance in pixels between the drawn outline of objects with levels of detail, such as adaptive circles, and their true curve.
+ * Their level of detail is selected from their projected size when they are added to the objects to draw, lower values trade vertices for smoother outlines
+ * @var engine::lod_hysteresis
+ * Factor between 0 and 1 applied to `lod_error_tolerance` before an object switches to a coarser level of detail than the one it was drawn with,
+ * so that objects whose size hovers around a threshold don't pop between two levels every frame. 1 disables the hysteresis
+ * @var engine::dynamic_batch_threshold
+ * Maximum count of vertices of an object merged into a dynamic batch. Consecutive draws of such objects sharing their draw parameters
+ * and being all textured or all untextured are transformed on the CPU into the transient memory of the frame and drawn in one call. 0 disables the batching
+ * @var engine::mesh_cache
+ * Cache of every mesh used by the objects of the engine, letting objects with the same geometry share their GPU buffers
  * @var engine::vulkan_context
  * Vulkan context containing all the necessary variables for the vulkan wrapper to work
  */
 typedef struct engine
 {
+    struct allocator allocator;
+
     window_t window;
     struct camera camera;
 
-    object_t *objects_to_draw;
+    struct draw_command *objects_to_draw;
     uint32_t objects_to_draw_count;
     uint32_t max_objects_to_draw;
+    tilemap_t tilemaps_to_draw[ENGINE_MAX_TILEMAPS_TO_DRAW];
+    uint32_t tilemaps_to_draw_count;
+    point_cloud_t point_clouds_to_draw[ENGINE_MAX_POINT_CLOUDS_TO_DRAW];
+    uint32_t point_clouds_to_draw_count;
+    time_series_t time_series_to_draw[ENGINE_MAX_TIME_SERIES_TO_DRAW];
+    uint32_t time_series_to_draw_count;
+    vector_canvas_t vector_canvases_to_draw[ENGINE_MAX_VECTOR_CANVASES_TO_DRAW];
+    uint32_t vector_canvases_to_draw_count;
+    struct shape *shapes_to_draw;
+    uint32_t shapes_to_draw_count;
+    struct quad_batch quad_batch;
+    struct quad_batch text_batch;
+    struct glyph_atlas glyph_atlas;
+    struct texture glyph_atlas_texture;
+    float lod_error_tolerance;
+    float lod_hysteresis;
+    uint32_t dynamic_batch_threshold;
+
+    struct mesh_cache mesh_cache;
 
     struct vulkan_context vulkan_context;
     surface_context surface_context;
@@ -83,10 +185,12 @@ void engine_cleanup(engine_t engine);
  * @param application_version Current version of the application created by the engine
  * @param window_width Original width of the window upon creation
  * @param window_height Original height of the window upon creation
- * @param max_objects_to_draw Maximum allowed objects to draw per call of `engine_display()`, will be used to allocate the sizeof the `objects_to_draw` array from the engine
+ * @param max_objects_to_draw Maximum allowed objects to draw per call of `engine_display()`, will be used to allocate the sizeof the `objects_to_draw` array from the engine,
+ * the same count of shapes can be drawn per call
+ * @param allocator Pointer to the allocator the engine will use for all its host allocations, copied into the engine. NULL to use the default allocator
  * @return engine_t
  */
-engine_t engine_create(const char *application_name, const struct version application_version, int window_width, int window_height, uint32_t max_objects_to_draw);
+engine_t engine_create(const char *application_name, const struct version application_version, int window_width, int window_height, uint32_t max_objects_to_draw, allocator_t allocator);
 /**
  * @brief Display the objects on the screen and render a frame, also reset the `objects_to_draw_count` to 0
  * 
@@ -105,6 +209,72 @@ bool engine_display(engine_t engine);
  * @return false  if the count of objects to draw per `engine_display()` call has reach the maximum set upon creation
  */
 bool engine_draw(engine_t engine, object_t object);
+/**
+ * @brief Add an object to the array of objects to draw on the next `engine_display()` call with its own draw parameters.
+ * The parameters are copied in the transient memory of the current frame, the caller doesn't need to keep them alive
+ * 
+ * @param engine Pointer to the engine where the object will be drawn
+ * @param object Pointer to the object to draw
+ * @param parameters Pointer to the draw parameters applied on top of the object's push constant, transform and color
+ * @return true if the object will be drawn
+ * @return false if the maximum count of objects to draw has been reached or the frame's transient memory is full
+ */
+bool engine_draw_with_parameters(engine_t engine, object_t object, const struct draw_parameters *parameters);
+/**
+ * @brief Add an analytic shape to the shapes to draw on the next `engine_display()` call, the shape is copied.
+ * All shapes of a frame are drawn in one instanced draw call after the objects, in the order they were added
+ * 
+ * @param engine Pointer to the engine where the shape will be drawn
+ * @param shape Pointer to the shape to draw
+ * @return true if the count of shapes to draw per `engine_display()` call hasn't reach the maximum set upon creation
+ * @return false otherwise
+ */
+bool engine_draw_shape(engine_t engine, const struct shape *shape);
+/**
+ * @brief Add a colored axis aligned quad to the quads to draw on the next `engine_display()` call.
+ * The quad is written straight into the transient memory of the current frame, there is no limit on the count of quads besides that memory.
+ * All quads of a frame are drawn after the shapes in a few instanced draw calls, in the order they were added
+ * 
+ * @param engine Pointer to the engine where the quad will be drawn
+ * @param position Position of the bottom left corner of the quad in world units
+ * @param size Width and height of the quad in world units
+ * @param color Color of the quad
+ * @return true if the quad will be drawn
+ * @return false if the frame's transient memory is full
+ */
+bool engine_draw_quad(engine_t engine, vec2 position, vec2 size, vec4 color);
+/**
+ * @brief Create a texture from 8 bits sRGB RGBA pixels, uploaded to device local memory through a staging buffer before returning.
+ * Many small images should rather be packed in a `struct texture_atlas` so that the objects drawn with them share a few textures
+ * 
+ * @param engine Pointer to the engine creating the texture
+ * @param width Width of the texture in pixels
+ * @param height Height of the texture in pixels
+ * @param pixels Pointer to `width` * `height` pixels of 4 bytes, row by row from the top left one
+ * @return texture_t, NULL if the texture couldn't be created or `TEXTURE_MAX_COUNT` textures are already alive
+ */
+texture_t engine_create_texture(engine_t engine, uint32_t width, uint32_t height, const void *pixels);
+/**
+ * @brief Destroy a texture created by `engine_create_texture()`.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still samples it
+ * 
+ * @param engine Pointer to the engine that created the texture
+ * @param texture Pointer to the texture to destroy
+ */
+void engine_destroy_texture(engine_t engine, texture_t texture);
+/**
+ * @brief Allocate a block of GPU visible memory valid until the end of the next `engine_display()` call.
+ * Allocating is a pointer bump, the whole memory of the frame is reclaimed at once when the GPU is done with it,
+ * the first allocation of a frame waits for the GPU to finish the frame previously using the same memory
+ * 
+ * @param engine Pointer to the engine to allocate from
+ * @param size Size in bytes of the block
+ * @param alignment Alignment of the offset of the block, a power of two, or `FRAME_ALLOCATOR_UNIFORM_ALIGNMENT` for blocks read as uniform or storage buffers
+ * @param allocation Pointer to the structure filled with the buffer, offset and mapped pointer of the block
+ * @return true if the block has been allocated
+ * @return false if the frame's transient memory is full
+ */
+bool engine_frame_allocate(engine_t engine, VkDeviceSize size, VkDeviceSize alignment, frame_allocation_t allocation);
 /**
  * @brief Poll window's and input's events
  * It is highly recommended to call it at the top of main loop and once per iteration of the loop
@@ -135,6 +305,23 @@ void engine_wait_idle(engine_t engine);
  * @param engine Pointer to the engine where the camera view and projection will be updated
  */
 void engine_update_camera(engine_t engine);
+/**
+ * @brief Get the counters of host allocations made by each subsystem of the engine since its creation, including the Vulkan driver ones.
+ * A steady-state frame (`engine_poll_events()`, `engine_draw()` and `engine_display()`) doesn't allocate,
+ * comparing the counters around a frame lets you check it
+ * 
+ * @param engine Pointer to the engine to query
+ * @param statistics Pointer to the structure where the counters will be copied
+ */
+void engine_get_allocation_statistics(engine_t engine, struct allocator_statistics *statistics);
+/**
+ * @brief Get the count of dynamic batches drawn by the last `engine_display()` call
+ *
+ * @param engine Pointer to the engine to query
+ * @param batched_objects_count Pointer where the count of objects merged into those batches will be written, can be NULL
+ * @return Count of draw calls issued for dynamic batches, each replacing the draws of at least two objects
+ */
+uint32_t engine_get_dynamic_batches_count(engine_t engine, uint32_t *batched_objects_count);
 
 #ifdef __cplusplus
     }
@@ -0,0 +1,174 @@
+#ifndef _FONT_H
+    #define _FONT_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+
+    /**
+     * @def FONT_ASCII_GLYPHS_COUNT
+     * @brief Count of codepoints, from 0, whose glyph index is looked up once when the font is loaded instead of on every use
+     */
+    #define FONT_ASCII_GLYPHS_COUNT 128
+    /**
+     * @def FONT_FLATTENING_TOLERANCE
+     * @brief Maximum distance in pixels between the curves of a glyph and the segments approximating them when it is rasterized
+     */
+    #define FONT_FLATTENING_TOLERANCE 0.05f
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct font
+ * @brief TrueType font read in place from the bytes of its file, only the offsets of the tables used to lay out and rasterize glyphs are kept.
+ * Every metric is in font units, `units_per_em` units making the size of the font
+ * @var font::allocator
+ * Allocator owning `data` when the font has been loaded with `font_load()`, NULL when the bytes belong to the caller
+ * @var font::data
+ * Bytes of the font file
+ * @var font::size
+ * Size in bytes of `data`
+ * @var font::cmap
+ * Offset of the character to glyph mapping subtable used, of format 4 or 12
+ * @var font::cmap_format
+ * Format of the subtable at `cmap`
+ * @var font::loca
+ * Offset of the table of the offsets of the glyphs outlines
+ * @var font::glyf
+ * Offset of the table of the glyphs outlines
+ * @var font::hmtx
+ * Offset of the table of the horizontal metrics of the glyphs
+ * @var font::kern
+ * Offset of the horizontal kerning pairs, 0 if the font has none
+ * @var font::kern_pairs_count
+ * Count of kerning pairs at `kern`
+ * @var font::glyphs_count
+ * Count of glyphs in the font
+ * @var font::long_metrics_count
+ * Count of glyphs with their own advance in `hmtx`, the following glyphs share the advance of the last one
+ * @var font::long_locations
+ * Boolean telling if the offsets of `loca` are 32 bits, they are 16 bits halved offsets otherwise
+ * @var font::units_per_em
+ * Count of font units in the size of the font
+ * @var font::ascender
+ * Distance from the baseline to the top of the lines
+ * @var font::descender
+ * Distance from the baseline to the bottom of the lines, negative below the baseline
+ * @var font::line_gap
+ * Space between the bottom of a line and the top of the next one
+ * @var font::ascii_glyphs
+ * Glyph index of the first `FONT_ASCII_GLYPHS_COUNT` codepoints
+ */
+typedef struct font {
+    allocator_t allocator;
+    const uint8_t *data;
+    uint32_t size;
+
+    uint32_t cmap;
+    uint16_t cmap_format;
+    uint32_t loca;
+    uint32_t glyf;
+    uint32_t hmtx;
+    uint32_t kern;
+    uint32_t kern_pairs_count;
+
+    uint16_t glyphs_count;
+    uint16_t long_metrics_count;
+    bool long_locations;
+    uint16_t units_per_em;
+    int16_t ascender;
+    int16_t descender;
+    int16_t line_gap;
+
+    uint16_t ascii_glyphs[FONT_ASCII_GLYPHS_COUNT];
+} * font_t;
+
+/**
+ * @brief Initialise a font over the bytes of a TrueType file, the bytes are read in place and must stay valid as long as the font is used
+ *
+ * @param font Pointer to the font to initialise
+ * @param data Pointer to the bytes of the file
+ * @param size Size in bytes of the file
+ * @return true if the font has every table needed to draw text
+ * @return false if the bytes aren't a TrueType font with outlines, CFF outlines aren't supported
+ */
+bool font_init(font_t font, const void *data, uint32_t size);
+/**
+ * @brief Allocate a font and load the TrueType file at `path` into it
+ *
+ * @param allocator Pointer to the allocator owning the font and the bytes of its file
+ * @param path Path of the TrueType file
+ * @return The allocated font, to destroy with `font_destroy()`, or NULL if the file couldn't be read or isn't a font
+ */
+font_t font_load(allocator_t allocator, const char *path);
+/**
+ * @brief Free a font loaded with `font_load()`
+ *
+ * @param font Pointer to the font to destroy
+ */
+void font_destroy(font_t font);
+/**
+ * @brief Get the glyph drawing a unicode codepoint
+ *
+ * @param font Pointer to the font
+ * @param codepoint Unicode codepoint
+ * @return The index of the glyph, 0 being the glyph of missing characters
+ */
+uint32_t font_get_glyph_index(const struct font *font, uint32_t codepoint);
+/**
+ * @brief Get the horizontal metrics of a glyph
+ *
+ * @param font Pointer to the font
+ * @param glyph Index of the glyph
+ * @param advance Pointer receiving the distance from the origin of the glyph to the origin of the next one, can be NULL
+ * @param left_side_bearing Pointer receiving the distance from the origin of the glyph to the left of its outline, can be NULL
+ */
+void font_get_glyph_horizontal_metrics(const struct font *font, uint32_t glyph, int32_t *advance, int32_t *left_side_bearing);
+/**
+ * @brief Get the adjustment of the advance between two glyphs from the kerning table of the font
+ *
+ * @param font Pointer to the font
+ * @param left Index of the first glyph
+ * @param right Index of the glyph following `left`
+ * @return The adjustment to add to the advance of `left`, 0 if the pair isn't kerned
+ */
+int32_t font_get_kerning(const struct font *font, uint32_t left, uint32_t right);
+/**
+ * @brief Get the bounding box of the outline of a glyph
+ *
+ * @param font Pointer to the font
+ * @param glyph Index of the glyph
+ * @param box Array receiving the left, bottom, right and top of the box
+ * @return true if the glyph has an outline
+ * @return false if the glyph is empty, such as a space
+ */
+bool font_get_glyph_box(const struct font *font, uint32_t glyph, int16_t box[4]);
+/**
+ * @brief Rasterize the signed distance field of a glyph into an 8 bits image.
+ * A point of the glyph at (x, y) font units is at pixel (`origin[0]` + x * `scale`, `origin[1]` - y * `scale`), rows going down.
+ * A pixel stores 128 on the outline, 255 at `spread` pixels inside or further and 0 at `spread` pixels outside or further
+ *
+ * @param font Pointer to the font
+ * @param allocator Pointer to the allocator of the temporary outline of the glyph
+ * @param glyph Index of the glyph
+ * @param scale Size in pixels of a font unit
+ * @param origin Position in pixels of the origin of the glyph
+ * @param spread Distance in pixels from the outline at which the field saturates
+ * @param pixels Pointer to the first pixel of the image
+ * @param width Width in pixels of the image
+ * @param height Height in pixels of the image
+ * @param stride Count of bytes between two rows of the image
+ * @return true if the glyph has been rasterized
+ * @return false if its outline couldn't be read or allocated, the image is left untouched
+ */
+bool font_rasterize_glyph_sdf(const struct font *font, allocator_t allocator, uint32_t glyph, float scale, const vec2 origin, float spread,
+    uint8_t *pixels, uint32_t width, uint32_t height, uint32_t stride);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef _GEOMETRY_H
+    #define _GEOMETRY_H
+
+    #include <stddef.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+
+    /**
+     * @def GEOMETRY_RESEED_INTERVAL
+     * @brief Count of points generated by rotation before the kernels compute the next point with sine and cosine again,
+     * bounding the drift of the recurrence to a few float ulps
+     */
+    #define GEOMETRY_RESEED_INTERVAL 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the instruction set used by the geometry kernels, selected when the library is compiled
+ *
+ * @return "avx2", "sse2", "neon" or "scalar"
+ */
+const char *geometry_get_simd_name(void);
+/**
+ * @brief Transform 2D points lying in the z = 0 plane by a matrix into homogeneous vec4 positions
+ *
+ * @param transform Matrix applied to every point
+ * @param points Pointer to an array of `points_count` points to transform
+ * @param points_count Count of points to transform
+ * @param dest Pointer to the first vec4 receiving the transformed points, it doesn't need to be aligned
+ * @param dest_stride Distance in bytes between two consecutive vec4 of `dest`, so that positions can be written straight into vertices
+ */
+void geometry_transform_points(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride);
+/**
+ * @brief Generate points on an axis aligned ellipse, at angles `start_angle + i * angle_step`.
+ * Only the first point and one point every `GEOMETRY_RESEED_INTERVAL` use trigonometry, the others are rotated from their predecessors
+ *
+ * @param center Center of the ellipse
+ * @param radii Radius of the ellipse along x and y, equal for a circle
+ * @param start_angle Angle of the first point in radians
+ * @param angle_step Angle between two consecutive points in radians
+ * @param points_count Count of points to generate
+ * @param dest Pointer to an array of at least `points_count` points receiving the positions
+ */
+void geometry_generate_arc(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest);
+/**
+ * @brief Generate `points_count` points evenly spread on a circle, counter-clockwise from the positive x axis
+ *
+ * @param center Center of the circle
+ * @param radius Radius of the circle
+ * @param points_count Count of points to generate
+ * @param dest Pointer to an array of at least `points_count` points receiving the positions
+ */
+void geometry_generate_circle(const vec2 center, float radius, uint32_t points_count, vec2 *dest);
+/**
+ * @brief Generate `points_count` points evenly spread on an axis aligned ellipse, counter-clockwise from the positive x axis
+ *
+ * @param center Center of the ellipse
+ * @param radii Radius of the ellipse along x and y
+ * @param points_count Count of points to generate
+ * @param dest Pointer to an array of at least `points_count` points receiving the positions
+ */
+void geometry_generate_ellipse(const vec2 center, const vec2 radii, uint32_t points_count, vec2 *dest);
+/**
+ * @brief Generate the corners of a regular polygon, counter-clockwise
+ *
+ * @param center Center of the polygon
+ * @param radius Distance between the center and the corners
+ * @param sides_count Count of sides of the polygon
+ * @param rotation Angle of the first corner in radians
+ * @param dest Pointer to an array of at least `sides_count` points receiving the positions
+ */
+void geometry_generate_regular_polygon(const vec2 center, float radius, uint32_t sides_count, float rotation, vec2 *dest);
+/**
+ * @brief Generate the outline of an axis aligned rounded rectangle, counter-clockwise from the end of the right side.
+ * Each corner is a quarter circle of `corner_points_count` points including both its ends
+ *
+ * @param center Center of the rectangle
+ * @param half_size Half of the width and height of the rectangle
+ * @param corner_radius Radius of the corners, clamped to the smallest half size
+ * @param corner_points_count Count of points of each corner, at least 1
+ * @param dest Pointer to an array of at least `4 * corner_points_count` points receiving the positions
+ */
+void geometry_generate_rounded_rectangle(const vec2 center, const vec2 half_size, float corner_radius, uint32_t corner_points_count, vec2 *dest);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
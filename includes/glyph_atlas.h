@@ -0,0 +1,191 @@
+#ifndef _GLYPH_ATLAS_H
+    #define _GLYPH_ATLAS_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "font.h"
+
+    /**
+     * @def GLYPH_ATLAS_DEFAULT_SIZE
+     * @brief Default width and height in pixels of the glyph atlas of the engine
+     */
+    #define GLYPH_ATLAS_DEFAULT_SIZE 1024
+    /**
+     * @def GLYPH_ATLAS_DEFAULT_CELL_SIZE
+     * @brief Default width and height in pixels of the cell holding one glyph, the atlas of the engine holds 441 glyphs
+     */
+    #define GLYPH_ATLAS_DEFAULT_CELL_SIZE 48
+    /**
+     * @def GLYPH_ATLAS_SPREAD
+     * @brief Distance in pixels of the atlas around the outline of the glyphs covered by their distance field,
+     * it bounds the width of the anti-aliased edge when text is drawn smaller than the atlas resolution
+     */
+    #define GLYPH_ATLAS_SPREAD 4.0f
+    /**
+     * @def GLYPH_ATLAS_EM_PER_CELL
+     * @brief Size in em of the area of a cell inside the spread, glyphs taller or wider are rasterized at a lower resolution to fit
+     */
+    #define GLYPH_ATLAS_EM_PER_CELL 1.25f
+    /**
+     * @def GLYPH_ATLAS_NONE
+     * @brief Index of no cell, ending the lists of the atlas
+     */
+    #define GLYPH_ATLAS_NONE UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct glyph
+ * @brief Glyph of a font rasterized in a cell of an atlas as a signed distance field, so that it can be drawn at any size
+ * @var glyph::font
+ * Font of the glyph, NULL if the cell is free
+ * @var glyph::index
+ * Index of the glyph in its font
+ * @var glyph::plane
+ * Left, bottom, right and top of the quad drawing the glyph in em from the origin of the glyph, scaled by the size of the text
+ * @var glyph::uv_rect
+ * Texture coordinates of the bottom left then of the top right corner of the quad in the atlas
+ * @var glyph::frame
+ * Frame of the atlas the glyph was last drawn in, glyphs of the current frame are never evicted
+ * @var glyph::previous
+ * Cell of the glyph drawn more recently in the least recently used list, `GLYPH_ATLAS_NONE` for the most recent one
+ * @var glyph::next
+ * Cell of the glyph drawn less recently in the least recently used list, `GLYPH_ATLAS_NONE` for the least recent one
+ * @var glyph::hash_next
+ * Next cell in the same bucket of the hash table, `GLYPH_ATLAS_NONE` ending the bucket
+ */
+struct glyph {
+    const struct font *font;
+    uint32_t index;
+    vec4 plane;
+    vec4 uv_rect;
+    uint64_t frame;
+
+    uint32_t previous;
+    uint32_t next;
+    uint32_t hash_next;
+};
+
+/**
+ * @struct glyph_atlas
+ * @brief Square 8 bits image split in cells of one glyph each, filled on demand when text is drawn.
+ * When every cell is used the least recently drawn glyph is evicted, rows changed since the last upload are tracked to upload only them
+ * @var glyph_atlas::allocator
+ * Allocator of the atlas and of the temporary outlines of the glyphs
+ * @var glyph_atlas::pixels
+ * Pixels of the atlas, `size` rows of `size` bytes
+ * @var glyph_atlas::size
+ * Width and height of the atlas in pixels
+ * @var glyph_atlas::cell_size
+ * Width and height of a cell in pixels
+ * @var glyph_atlas::cells_per_row
+ * Count of cells in a row of the atlas
+ * @var glyph_atlas::cells_count
+ * Count of cells of the atlas
+ * @var glyph_atlas::used_cells_count
+ * Count of cells holding a glyph, the cells are used in order before any glyph is evicted
+ * @var glyph_atlas::glyphs
+ * Glyph of every cell
+ * @var glyph_atlas::buckets
+ * First cell of every bucket of the hash table mapping a font and a glyph index to its cell
+ * @var glyph_atlas::buckets_count
+ * Count of buckets, a power of two
+ * @var glyph_atlas::most_recent
+ * Cell of the glyph drawn most recently
+ * @var glyph_atlas::least_recent
+ * Cell of the glyph drawn least recently, the next one to be evicted
+ * @var glyph_atlas::dirty_first_row
+ * First row of the atlas changed since the last call to `glyph_atlas_flush()`
+ * @var glyph_atlas::dirty_last_row
+ * Row after the last row changed since the last call to `glyph_atlas_flush()`, equal to `dirty_first_row` if nothing changed
+ * @var glyph_atlas::frame
+ * Current frame of the atlas, increased by `glyph_atlas_next_frame()`
+ * @var glyph_atlas::rasterized_count
+ * Count of glyphs rasterized since the atlas was initialised
+ * @var glyph_atlas::evicted_count
+ * Count of glyphs evicted since the atlas was initialised
+ */
+typedef struct glyph_atlas {
+    allocator_t allocator;
+    uint8_t *pixels;
+    uint32_t size;
+    uint32_t cell_size;
+    uint32_t cells_per_row;
+    uint32_t cells_count;
+    uint32_t used_cells_count;
+
+    struct glyph *glyphs;
+    uint32_t *buckets;
+    uint32_t buckets_count;
+    uint32_t most_recent;
+    uint32_t least_recent;
+
+    uint32_t dirty_first_row;
+    uint32_t dirty_last_row;
+    uint64_t frame;
+
+    uint64_t rasterized_count;
+    uint64_t evicted_count;
+} * glyph_atlas_t;
+
+/**
+ * @brief Initialise an empty atlas, every pixel is dirty so that the first upload clears the texture
+ *
+ * @param atlas Pointer to the atlas to initialise
+ * @param allocator Pointer to the allocator of the atlas
+ * @param size Width and height of the atlas in pixels
+ * @param cell_size Width and height of a cell in pixels, at most `size`
+ * @return true if the atlas has been allocated
+ * @return false otherwise
+ */
+bool glyph_atlas_init(glyph_atlas_t atlas, allocator_t allocator, uint32_t size, uint32_t cell_size);
+/**
+ * @brief Free the memory of an atlas
+ *
+ * @param atlas Pointer to the atlas to cleanup
+ */
+void glyph_atlas_cleanup(glyph_atlas_t atlas);
+/**
+ * @brief Find the cell of a glyph, rasterizing it in a free or evicted cell on the first use, and mark it drawn in the current frame
+ *
+ * @param atlas Pointer to the atlas
+ * @param font Pointer to the font of the glyph, its cells are looked up by address
+ * @param index Index of the glyph in the font
+ * @param glyph Pointer receiving the glyph, NULL for glyphs without outline such as spaces
+ * @return true if the glyph can be drawn
+ * @return false if every cell holds a glyph drawn in the current frame or the glyph couldn't be rasterized
+ */
+bool glyph_atlas_acquire(glyph_atlas_t atlas, const struct font *font, uint32_t index, const struct glyph **glyph);
+/**
+ * @brief Evict every glyph of a font, to call before destroying a font whose glyphs have been drawn
+ *
+ * @param atlas Pointer to the atlas
+ * @param font Pointer to the font
+ */
+void glyph_atlas_remove_font(glyph_atlas_t atlas, const struct font *font);
+/**
+ * @brief Get and clear the rows of the atlas changed since the last flush
+ *
+ * @param atlas Pointer to the atlas
+ * @param first_row Pointer receiving the first changed row
+ * @param rows_count Pointer receiving the count of changed rows
+ * @return true if rows have changed and must be uploaded
+ * @return false otherwise
+ */
+bool glyph_atlas_flush(glyph_atlas_t atlas, uint32_t *first_row, uint32_t *rows_count);
+/**
+ * @brief Start a new frame, letting the glyphs drawn in the previous one be evicted
+ *
+ * @param atlas Pointer to the atlas
+ */
+void glyph_atlas_next_frame(glyph_atlas_t atlas);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
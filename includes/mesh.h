@@ -0,0 +1,274 @@
+#ifndef _MESH_H
+    #define _MESH_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "vertex.h"
+
+    /**
+     * @def MESH_CACHE_DEFAULT_BUCKETS_COUNT
+     * @brief Initial count of buckets of the mesh cache, the cache grows when its load factor exceeds 3/4
+     */
+    #define MESH_CACHE_DEFAULT_BUCKETS_COUNT 64
+    /**
+     * @def MESH_LODS_MAX_COUNT
+     * @brief Maximum count of levels of detail, index ranges, a mesh can hold
+     */
+    #define MESH_LODS_MAX_COUNT 6
+    /**
+     * @def MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT
+     * @brief Count of segments of the coarsest level of detail of `MESH_PRIMITIVE_CIRCLE_LOD`, every next level doubles it
+     */
+    #define MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT 8
+    /**
+     * @def MESH_PRIMITIVE_RESTART_INDEX
+     * @brief Index ending the strip being drawn in the indices of a mesh with a strip topology, the next index starting a new strip
+     */
+    #define MESH_PRIMITIVE_RESTART_INDEX UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief typedef to the engine structure needed by some mesh functions from "engine.h"
+ */
+typedef struct engine * engine_t;
+
+/**
+ * @enum mesh_primitive
+ * @brief Primitives generated by the mesh cache in unit space, objects place them using their model matrix
+ */
+enum mesh_primitive {
+    MESH_PRIMITIVE_NONE = 0,
+    MESH_PRIMITIVE_RECTANGLE,
+    MESH_PRIMITIVE_CIRCLE,
+    MESH_PRIMITIVE_CIRCLE_LOD
+};
+
+/**
+ * @enum mesh_topology
+ * @brief How the indices of a mesh are assembled into primitives, every mesh being a triangle list unless created with another topology.
+ * Strips share the vertices of consecutive primitives and are cut by `MESH_PRIMITIVE_RESTART_INDEX`,
+ * so long connected geometry needs about one index per vertex instead of three per triangle or two per segment
+ */
+enum mesh_topology {
+    MESH_TOPOLOGY_TRIANGLE_LIST = 0,
+    MESH_TOPOLOGY_TRIANGLE_STRIP,
+    MESH_TOPOLOGY_LINE_LIST,
+    MESH_TOPOLOGY_LINE_STRIP,
+    MESH_TOPOLOGY_POINT_LIST
+};
+
+/**
+ * @struct mesh_lod
+ * @brief Range of the index buffer of a mesh drawing it at a given level of detail
+ * @var mesh_lod::first_index
+ * Index of the first index of the range in the index buffer
+ * @var mesh_lod::indices_count
+ * Count of indices of the range
+ * @var mesh_lod::segments_count
+ * Count of segments approximating the curved outline of the mesh in this range, 0 for meshes without curved outline
+ * @var mesh_lod::error
+ * Maximum distance in mesh units between the outline drawn by this range and the one of the finest level, 0 for the finest level
+ */
+struct mesh_lod {
+    uint32_t first_index;
+    uint32_t indices_count;
+    uint32_t segments_count;
+    float error;
+};
+
+/**
+ * @struct mesh
+ * @brief Structure representing a geometry uploaded to the GPU, shared by every object using the same vertices and indices
+ * @var mesh::hash
+ * Hash of the mesh, computed from its content or from its primitive parameters
+ * @var mesh::ref_count
+ * Count of objects currently using the mesh, the mesh is destroyed when it reaches 0
+ * @var mesh::primitive
+ * Primitive the mesh was generated from, `MESH_PRIMITIVE_NONE` for meshes created from user data
+ * @var mesh::primitive_parameter
+ * Parameter of the primitive the mesh was generated from, such as the count of segments of a circle
+ * @var mesh::topology
+ * How the indices of the mesh are assembled into primitives
+ * @var mesh::vertices_count
+ * Count of vertices of the mesh
+ * @var mesh::indices_count
+ * Count of indices of the mesh
+ * @var mesh::positions
+ * CPU copy of the vertices positions, used to tell apart meshes with the same hash
+ * @var mesh::indices
+ * CPU copy of the indices, used to tell apart meshes with the same hash
+ * @var mesh::uv_origin
+ * Position mapped to the texture coordinates (0, 0), the bottom left corner of the bounds of the mesh
+ * @var mesh::uv_scale
+ * Factors turning a position relative to `uv_origin` into texture coordinates, the inverse of the extent of the mesh, 0 along an axis of null extent
+ * @var mesh::vertex_buffer
+ * Buffer storing all the vertices data
+ * @var mesh::vertex_memory
+ * GPU memory storing all the vertices data
+ * @var mesh::index_buffer
+ * Buffer storing all the indices data
+ * @var mesh::index_memory
+ * GPU memory storing all the indices data
+ * @var mesh::index_type
+ * Type of the indices stored in `index_buffer`, `VK_INDEX_TYPE_UINT16` unless the mesh has more vertices than 16-bit indices can address,
+ * the restart index of strips taking the last one
+ * @var mesh::lods
+ * Index ranges of the levels of detail of the mesh, from the coarsest to the finest, sharing the same vertex buffer
+ * @var mesh::lods_count
+ * Count of levels of detail in `lods`, 1 for meshes drawn whole
+ * @var mesh::next
+ * Next mesh in the same bucket of the mesh cache
+ */
+typedef struct mesh {
+    uint64_t hash;
+    uint32_t ref_count;
+    enum mesh_primitive primitive;
+    uint32_t primitive_parameter;
+    enum mesh_topology topology;
+
+    uint32_t vertices_count;
+    uint32_t indices_count;
+    vec2 *positions;
+    uint32_t *indices;
+    vec2 uv_origin;
+    vec2 uv_scale;
+
+    VkBuffer vertex_buffer;
+    VkDeviceMemory vertex_memory;
+    VkBuffer index_buffer;
+    VkDeviceMemory index_memory;
+    VkIndexType index_type;
+
+    struct mesh_lod lods[MESH_LODS_MAX_COUNT];
+    uint32_t lods_count;
+
+    struct mesh *next;
+} * mesh_t;
+
+/**
+ * @struct mesh_cache
+ * @brief Hash table of every mesh alive in an engine
+ * @var mesh_cache::allocator
+ * Allocator used for the buckets, the meshes and their CPU copies
+ * @var mesh_cache::buckets
+ * Array of singly linked lists of meshes
+ * @var mesh_cache::buckets_count
+ * Count of buckets, always a power of two
+ * @var mesh_cache::meshes_count
+ * Count of meshes stored in the cache
+ */
+typedef struct mesh_cache {
+    allocator_t allocator;
+    mesh_t *buckets;
+    uint32_t buckets_count;
+    uint32_t meshes_count;
+} * mesh_cache_t;
+
+/**
+ * @brief Initialise an empty mesh cache
+ * 
+ * @param cache Pointer to the mesh cache to initialise
+ * @param allocator Pointer to the allocator used by the cache, it must outlive the cache
+ * @param buckets_count Initial count of buckets, must be a power of two
+ * @return true if the buckets could be allocated
+ * @return false otherwise
+ */
+bool mesh_cache_init(mesh_cache_t cache, allocator_t allocator, uint32_t buckets_count);
+/**
+ * @brief Destroy every mesh left in the cache and free the cache buckets
+ * 
+ * @param engine Pointer to the engine owning the cache
+ */
+void mesh_cache_cleanup(engine_t engine);
+/**
+ * @brief Return the mesh matching the given vertices and indices, uploading it if no object uses it yet.
+ * The reference count of the returned mesh is incremented
+ * 
+ * @param engine Pointer to the engine owning the cache
+ * @param positions Pointer to an array of `vertices_count` vertices positions
+ * @param vertices_count Count of vertices in `positions`
+ * @param indices Pointer to an array of `indices_count` indices
+ * @param indices_count Count of indices in `indices`
+ * @return The shared mesh, or NULL if it couldn't be created
+ */
+mesh_t mesh_cache_acquire(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count);
+/**
+ * @brief Return the mesh matching the given vertices, indices and levels of detail, uploading it if no object uses it yet.
+ * The reference count of the returned mesh is incremented
+ * 
+ * @param engine Pointer to the engine owning the cache
+ * @param positions Pointer to an array of `vertices_count` vertices positions
+ * @param vertices_count Count of vertices in `positions`
+ * @param indices Pointer to an array of `indices_count` indices holding the index ranges of every level of detail
+ * @param indices_count Count of indices in `indices`
+ * @param lods Pointer to an array of `lods_count` index ranges in `indices`, from the coarsest to the finest, NULL to draw the indices whole
+ * @param lods_count Count of levels of detail in `lods`, at most `MESH_LODS_MAX_COUNT`
+ * @return The shared mesh, or NULL if it couldn't be created
+ */
+mesh_t mesh_cache_acquire_with_lods(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    const struct mesh_lod *lods, uint32_t lods_count);
+/**
+ * @brief Return the mesh matching the given vertices and indices assembled with the given topology, uploading it if no object uses it yet.
+ * The reference count of the returned mesh is incremented
+ * 
+ * @param engine Pointer to the engine owning the cache
+ * @param positions Pointer to an array of `vertices_count` vertices positions
+ * @param vertices_count Count of vertices in `positions`
+ * @param indices Pointer to an array of `indices_count` indices, strips being separated by `MESH_PRIMITIVE_RESTART_INDEX`
+ * @param indices_count Count of indices in `indices`
+ * @param topology How the indices are assembled into primitives
+ * @return The shared mesh, or NULL if it couldn't be created
+ */
+mesh_t mesh_cache_acquire_with_topology(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count, enum mesh_topology topology);
+/**
+ * @brief Return the unit space mesh of a primitive, generating and uploading it only if no object uses it yet.
+ * The reference count of the returned mesh is incremented
+ * 
+ * @param engine Pointer to the engine owning the cache
+ * @param primitive Primitive to generate
+ * @param parameter Parameter of the primitive, the count of outside vertices for `MESH_PRIMITIVE_CIRCLE`, ignored otherwise.
+ * `MESH_PRIMITIVE_CIRCLE_LOD` holds a fan per level of detail, from `MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT` segments up, all indexing one ring of vertices
+ * @return The shared mesh, or NULL if it couldn't be created
+ */
+mesh_t mesh_cache_acquire_primitive(engine_t engine, enum mesh_primitive primitive, uint32_t parameter);
+/**
+ * @brief Decrement the reference count of a mesh and destroy it once no object uses it anymore
+ * You should call `engine_wait_idle` beforehand to make sure no process are using the mesh
+ * 
+ * @param engine Pointer to the engine owning the cache
+ * @param mesh Pointer to the mesh to release
+ */
+void mesh_cache_release(engine_t engine, mesh_t mesh);
+/**
+ * @brief Build the vertices of a mesh from its positions, with texture coordinates mapping the bounds of the positions to the unit square
+ * 
+ * @param positions Pointer to an array of `vertices_count` vertices positions
+ * @param vertices_count Count of vertices in `positions`
+ * @param vertices Pointer to an allocated array of `vertices_count` vertices where the vertices will be stored
+ */
+void mesh_generate_uvs(vec2 *positions, uint32_t vertices_count, struct vertex *vertices);
+/**
+ * @brief Select the coarsest level of detail of a mesh whose outline stays within an error tolerance of the finest one once on screen.
+ * To avoid popping between two levels when the size of the mesh hovers around a threshold, switching to a coarser level than
+ * the current one requires its error to be below `error_tolerance * hysteresis`, while the current level is kept as long as its error is below `error_tolerance`
+ * 
+ * @param mesh Pointer to the mesh to draw
+ * @param pixels_per_unit Size in pixels of one mesh unit once projected on screen, the radius in pixels of unit space circles
+ * @param error_tolerance Maximum distance in pixels allowed between the drawn outline and the finest one
+ * @param current_lod Index in `mesh->lods` of the level of detail drawn last time
+ * @param hysteresis Factor between 0 and 1 applied to the tolerance to switch to coarser levels, 1 to disable the hysteresis
+ * @return Index in `mesh->lods` of the level of detail to draw, always 0 for meshes without levels of detail
+ */
+uint32_t mesh_select_lod(mesh_t mesh, float pixels_per_unit, float error_tolerance, uint32_t current_lod, float hysteresis);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
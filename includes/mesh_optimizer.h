@@ -0,0 +1,84 @@
+#ifndef _MESH_OPTIMIZER_H
+    #define _MESH_OPTIMIZER_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+
+    /**
+     * @def MESH_OPTIMIZER_DEFAULT_CACHE_SIZE
+     * @brief Size of the post-transform vertex cache assumed when optimizing meshes, small enough to suit most GPUs
+     */
+    #define MESH_OPTIMIZER_DEFAULT_CACHE_SIZE 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reorder the triangles of an index buffer so that consecutive triangles reuse the vertices still in the GPU post-transform cache.
+ * Uses the Tipsify algorithm (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"), which runs in linear time
+ *
+ * @param allocator Pointer to the allocator used for the temporary buffers, NULL for the default allocator
+ * @param indices Pointer to an array of `indices_count` indices, reordered in place
+ * @param indices_count Count of indices in `indices`, must be a multiple of 3
+ * @param vertices_count Count of vertices referenced by `indices`
+ * @param cache_size Size of the vertex cache to optimize for
+ * @return true if the indices have been reordered
+ * @return false if the temporary buffers couldn't be allocated, `indices` is left untouched
+ */
+bool mesh_optimize_vertex_cache(allocator_t allocator, uint32_t *indices, uint32_t indices_count, uint32_t vertices_count, uint32_t cache_size);
+/**
+ * @brief Reorder the vertices in the order of their first use by the index buffer so the GPU fetches them sequentially,
+ * the indices are remapped accordingly and vertices unused by the indices are moved at the end
+ *
+ * @param allocator Pointer to the allocator used for the temporary buffers, NULL for the default allocator
+ * @param positions Pointer to an array of `vertices_count` vertices positions, reordered in place
+ * @param vertices_count Count of vertices in `positions`
+ * @param indices Pointer to an array of `indices_count` indices, remapped in place
+ * @param indices_count Count of indices in `indices`
+ * @return true if the vertices have been reordered
+ * @return false if the temporary buffers couldn't be allocated, `positions` and `indices` are left untouched
+ */
+bool mesh_optimize_vertex_fetch(allocator_t allocator, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count);
+/**
+ * @brief Compute the average cache miss ratio (ACMR) of an index buffer, the count of vertices transformed per triangle with a FIFO vertex cache.
+ * It ranges from 0.5 for an ideal grid to 3 when no vertex is ever reused
+ *
+ * @param allocator Pointer to the allocator used for the simulated cache, NULL for the default allocator
+ * @param indices Pointer to an array of `indices_count` indices
+ * @param indices_count Count of indices in `indices`, must be a multiple of 3
+ * @param vertices_count Count of vertices referenced by `indices`
+ * @param cache_size Size of the simulated vertex cache
+ * @return The ACMR of the index buffer, or a negative value if the simulation couldn't allocate its memory
+ */
+float mesh_compute_acmr(allocator_t allocator, const uint32_t *indices, uint32_t indices_count, uint32_t vertices_count, uint32_t cache_size);
+/**
+ * @brief Simplify a mesh by collapsing edges until its index count reaches a target or the next collapse would exceed an error.
+ * A vertex is only ever merged into one of its neighbours, so the simplified indices still index the original vertices and
+ * every level of detail can share one vertex buffer. The error of a collapse is the distance between the outline of the mesh
+ * and the merged vertex, measured with the quadrics of the outline edges it absorbed, interior vertices are collapsed for free
+ * as long as no triangle flips. Vertices where more than two outline edges meet are never moved
+ *
+ * @param allocator Pointer to the allocator used for the temporary buffers, NULL for the default allocator
+ * @param positions Pointer to an array of `vertices_count` vertices positions
+ * @param vertices_count Count of vertices in `positions`
+ * @param indices Pointer to an array of `indices_count` indices
+ * @param indices_count Count of indices in `indices`, must be a multiple of 3
+ * @param target_indices_count Count of indices to reach, the result may have more if no collapse is possible anymore
+ * @param target_error Maximum error allowed in mesh units, `FLT_MAX` for no limit
+ * @param destination Pointer to an array of at least `indices_count` indices receiving the simplified indices, can be `indices`
+ * @param destination_count Pointer receiving the count of indices written to `destination`
+ * @param result_error Pointer receiving the error of the simplified mesh in mesh units, can be NULL
+ * @return true if the mesh has been simplified
+ * @return false if the temporary buffers couldn't be allocated, `destination` is left untouched
+ */
+bool mesh_simplify(allocator_t allocator, const vec2 *positions, uint32_t vertices_count, const uint32_t *indices, uint32_t indices_count,
+    uint32_t target_indices_count, float target_error, uint32_t *destination, uint32_t *destination_count, float *result_error);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
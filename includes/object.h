@@ -2,65 +2,175 @@
     #define _OBJECT_H
 
     #include "vertex.h"
+    #include "mesh.h"
+    #include "mesh_optimizer.h"
+    #include "triangulation.h"
+    #include "stroke.h"
     #include "vulkan/shaders.h"
+    #include "vulkan/texture.h"
 
     #define CIRCLE_DEFAULT_OUTSIDE_VERTICES_COUNT 40
+    /**
+     * @def CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT
+     * @brief Count of outside vertices to give to `object_create_circle()` to let the engine pick it every frame from the circle's size on screen
+     */
+    #define CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT 0
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/**
- * @brief typedef to the engine structure needed by some objects functions from "engine.h"
- */
-typedef struct engine * engine_t;
-
 /**
  * @struct object
- * @brief Structure representing an object it's properties and buffers
- * @var object::indices_count
- * Count of indices when drawing all the sub triangles composing the model
+ * @brief Structure representing an object and it's properties
  * @var object::vertex_push_constant
- * Push constant variable for the vertex shader stage of the model
- * @var object::vertex_buffer
- * Buffer storing all the vertices data
- * @var object::vertex_memory
- * GPU memory storing all the vertices data
- * @var object::index_buffer
- * Buffer storing all the indices data from the sub triangles composing the model
- * @var object::index_memory
- * GPU memory storing all the indices data from the sub triangles composing the model
+ * Push constant variable for the vertex shader stage of the model, holding its model matrix, its color and the region of its texture it is mapped on
+ * @var object::texture
+ * Texture sampled by the object and multiplied by its color, NULL for a plain colored object
+ * @var object::mesh
+ * Geometry of the object, shared with every other object using the same vertices and indices
+ * @var object::lod
+ * Index in `mesh->lods` of the level of detail the object was last drawn with
  */
 typedef struct object {
-    uint32_t indices_count;
-
     struct push_constant vertex_push_constant;
+    texture_t texture;
 
-    VkBuffer vertex_buffer;
-    VkDeviceMemory vertex_memory;
-    VkBuffer index_buffer;
-    VkDeviceMemory index_memory;
+    mesh_t mesh;
+    uint32_t lod;
 } * object_t;
 
 /**
- * @brief Create an object and allocate it's buffers and GPU memory
+ * @struct object_lod
+ * @brief Level of detail supplied by the user to `object_create_from_lods()`
+ * @var object_lod::indices
+ * Pointer to an array of `indices_count` indices, every 3 indices forming a triangle, indexing the vertices shared by every level
+ * @var object_lod::indices_count
+ * Count of indices in `indices`, must be a multiple of 3
+ * @var object_lod::error
+ * Maximum distance in mesh units between the outline of this level and the one of the finest level, 0 for the finest level
+ */
+struct object_lod {
+    uint32_t *indices;
+    uint32_t indices_count;
+    float error;
+};
+
+/**
+ * @brief Create an object, its geometry is shared with every other object created with the same vertices and indices
  * 
  * @param engine Pointer to the engine that will create the object
  * @param vertices_pos Pointer to an array of vec2 representing the positions of every vertices
  * @param color Initial color of the created object
- * @param indices Pointer to an array of indices that will create the sub triangles composing the model
+ * @param indices Pointer to an array of indices that will create the sub triangles composing the model,
+ * they are stored on the GPU as 16-bit indices when `vertices_count` is small enough and as 32-bit indices otherwise
  * @param vertices_count Count of vertices in the array `vertices_pos`
  * @return An allocated `struct object` of the object
  */
-object_t object_create(engine_t engine, vec2 *vertices_pos, vec3 color, uint16_t *indices, uint32_t vertices_count);
+object_t object_create(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count);
 /**
- * @brief Destroy and free all the allocated memory of an object
+ * @brief Create an object whose indices are assembled with any topology, such as lines, points, or strips cut by `MESH_PRIMITIVE_RESTART_INDEX`.
+ * Objects that aren't triangle lists are never merged into dynamic batches, points are a pixel wide
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param vertices_pos Pointer to an array of vec2 representing the positions of every vertices
+ * @param color Initial color of the created object
+ * @param indices Pointer to an array of `indices_count` indices
+ * @param vertices_count Count of vertices in the array `vertices_pos`
+ * @param indices_count Count of indices in the array `indices`
+ * @param topology How the indices are assembled into primitives
+ * @return An allocated `struct object` of the object, or NULL if it couldn't be created
+ */
+object_t object_create_with_topology(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count, enum mesh_topology topology);
+/**
+ * @brief Create an object from an arbitrary triangle list, reordering its triangles for the GPU vertex cache and its vertices for fetch locality before the upload.
+ * Worth it for big meshes drawn often, the caller's arrays are left untouched
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param vertices_pos Pointer to an array of vec2 representing the positions of every vertices
+ * @param color Initial color of the created object
+ * @param indices Pointer to an array of `indices_count` indices, every 3 indices forming a triangle
+ * @param vertices_count Count of vertices in the array `vertices_pos`
+ * @param indices_count Count of indices in the array `indices`, must be a multiple of 3
+ * @return An allocated `struct object` of the object, or NULL if it couldn't be created
+ */
+object_t object_create_optimized(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count);
+/**
+ * @brief Create an object with levels of detail generated by `mesh_simplify()`, each level aiming at half the triangles of the next finer one.
+ * Every level indexes the same vertex buffer and the engine draws the coarsest one within `engine::lod_error_tolerance` pixels of the full mesh.
+ * Fewer levels are generated when the mesh can't be simplified further
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param vertices_pos Pointer to an array of vec2 representing the positions of every vertices
+ * @param color Initial color of the created object
+ * @param indices Pointer to an array of `indices_count` indices, every 3 indices forming a triangle
+ * @param vertices_count Count of vertices in the array `vertices_pos`
+ * @param indices_count Count of indices in the array `indices`, must be a multiple of 3
+ * @param lods_count Count of levels of detail to generate, the full mesh included, at most `MESH_LODS_MAX_COUNT`
+ * @return An allocated `struct object` of the object, or NULL if it couldn't be created
+ */
+object_t object_create_with_lods(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count, uint32_t lods_count);
+/**
+ * @brief Create an object from levels of detail supplied by the user, all indexing the same vertices
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param vertices_pos Pointer to an array of vec2 representing the positions of every vertices
+ * @param color Initial color of the created object
+ * @param lods Pointer to an array of `lods_count` levels of detail, from the coarsest to the finest
+ * @param vertices_count Count of vertices in the array `vertices_pos`
+ * @param lods_count Count of levels of detail in `lods`, between 1 and `MESH_LODS_MAX_COUNT`
+ * @return An allocated `struct object` of the object, or NULL if it couldn't be created
+ */
+object_t object_create_from_lods(engine_t engine, vec2 *vertices_pos, vec3 color, const struct object_lod *lods, uint32_t vertices_count, uint32_t lods_count);
+/**
+ * @brief Create an object from every stroke tessellated in a stroke buffer, drawn in one call whatever the count of strokes.
+ * The buffer is copied, it can be cleared or grown with `stroke_append()` and turned into a new object afterwards
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param buffer Pointer to the stroke buffer holding the triangles of the strokes
+ * @param color Initial color of the created object
+ * @return An allocated `struct object` of the object, or NULL if the buffer is empty or the object couldn't be created
+ */
+object_t object_create_stroke(engine_t engine, const struct stroke_buffer *buffer, vec3 color);
+/**
+ * @brief Create an object from a simple polygon, convex or concave, with optional holes, triangulated with `triangulate_polygon()`.
+ * Rings may be given in any winding, consecutive duplicated points and collinear points are dropped
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param vertices_pos Pointer to an array of `vertices_count` positions, the outer ring followed by every hole ring
+ * @param vertices_count Count of positions in `vertices_pos`
+ * @param holes_starts Pointer to an array of `holes_count` indices in `vertices_pos` where each hole ring starts, in increasing order, NULL if there is no hole
+ * @param holes_count Count of holes
+ * @param color Initial color of the created object
+ * @return An allocated `struct object` of the object, or NULL if the polygon is degenerate or the object couldn't be created
+ */
+object_t object_create_polygon(engine_t engine, vec2 *vertices_pos, uint32_t vertices_count, const uint32_t *holes_starts, uint32_t holes_count, vec3 color);
+/**
+ * @brief Destroy and free all the allocated memory of an object, its geometry is destroyed once no other object uses it
  * You should call `engine_wait_idle` beforehand to make sure no process are running while you want to destroy the object
  * 
  * @param engine Pointer to the engine that will destroy the object, it should be the same engine that created it
  * @param object Pointer to the object to destroy
  */
 void object_destroy(engine_t engine, object_t object);
+/**
+ * @brief Change the color of an object
+ * Only the object's push constant is updated, its vertex buffer is left untouched
+ * 
+ * @param object Pointer to the object to recolor
+ * @param color New color of the object
+ */
+void object_set_color(object_t object, vec3 color);
+/**
+ * @brief Map a texture on an object, stretched over the bounds of its geometry.
+ * The texture must stay alive as long as the object is drawn with it, objects sharing a texture are drawn without rebinding it
+ * 
+ * @param object Pointer to the object to texture
+ * @param texture Pointer to the texture, NULL to draw the object with its plain color again
+ * @param uv_rect Texture coordinates of the bottom left then of the top right corner of the region of the texture mapped on the object,
+ * such as the `uv_rect` of a `struct texture_region` returned by a texture atlas. NULL maps the whole texture
+ */
+void object_set_texture(object_t object, texture_t texture, const vec4 uv_rect);
 /**
  * @brief Create a triangle object
  * 
@@ -71,7 +181,7 @@ void object_destroy(engine_t engine, object_t object);
  */
 object_t object_create_triangle(engine_t engine, mat3x2 vertices_pos, vec3 color); // todo change pos by mat3 ? to have only 3 vec2 no more
 /**
- * @brief Create a rectangle object
+ * @brief Create a rectangle object, every rectangle shares the same unit square geometry scaled and moved by its model matrix
  * 
  * @param engine Pointer to the engine that will create the object
  * @param pos Position of the bottom-right corner of the rectangle
@@ -81,6 +191,17 @@ object_t object_create_triangle(engine_t engine, mat3x2 vertices_pos, vec3 color
  */
 object_t object_create_rectangle(engine_t engine, vec2 pos, vec2 size, vec3 color);
 
+/**
+ * @brief Create a circle object, every circle with the same count of outside vertices shares the same unit circle geometry scaled and moved by its model matrix
+ * 
+ * @param engine Pointer to the engine that will create the object
+ * @param pos Position of the center of the circle
+ * @param radius Radius of the circle
+ * @param color Color of the circle
+ * @param outside_vertices_count Count of vertices on the edge of the circle, at least 3, or `CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT`
+ * to select it each time the circle is drawn so that its outline stays within `engine::lod_error_tolerance` pixels of a true circle
+ * @return The allocated object structure of the circle, or NULL if `outside_vertices_count` is neither adaptive nor at least 3
+ */
 object_t object_create_circle(engine_t engine, vec2 pos, float radius, vec3 color, unsigned int outside_vertices_count);
 
 #ifdef __cplusplus
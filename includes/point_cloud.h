@@ -0,0 +1,201 @@
+#ifndef _POINT_CLOUD_H
+    #define _POINT_CLOUD_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "vulkan/shaders.h"
+    #include "vulkan/frame_allocator.h"
+
+    /**
+     * @def POINT_CLOUD_CHUNK_POINTS_COUNT
+     * @brief Count of points of a chunk, the unit of culling, of draw and of vertex buffer of a point cloud
+     */
+    #define POINT_CLOUD_CHUNK_POINTS_COUNT 65536
+    /**
+     * @def POINT_CLOUD_MAX_UPLOAD_POINTS_COUNT
+     * @brief Maximum count of points of a point cloud uploaded per frame, staged through the transient memory of the frame.
+     * Points appended beyond it are uploaded and drawn by the next frames
+     */
+    #define POINT_CLOUD_MAX_UPLOAD_POINTS_COUNT (FRAME_ALLOCATOR_FRAME_SIZE / 4 / sizeof(struct point_cloud_point))
+    /**
+     * @def POINT_CLOUD_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of vertex attributes read by the point pipelines from a `struct point_cloud_point`
+     */
+    #define POINT_CLOUD_ATTRIBUTE_DESCRIPTIONS_COUNT 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct point_cloud_point
+ * @brief Point of a point cloud, uploaded as is as vertex data
+ * @var point_cloud_point::position
+ * Position of the point in the space of the point cloud
+ * @var point_cloud_point::color
+ * Color of the point packed in 8 bits per channel, red in the lowest byte, see `point_cloud_pack_color()`
+ */
+struct point_cloud_point {
+    vec2 position;
+    uint32_t color;
+};
+
+/**
+ * @struct point_cloud_chunk
+ * @brief `POINT_CLOUD_CHUNK_POINTS_COUNT` consecutive points of a point cloud, owning their vertex buffer
+ * @var point_cloud_chunk::buffer
+ * Device local vertex buffer of the points of the chunk
+ * @var point_cloud_chunk::memory
+ * Memory bound to `buffer`
+ * @var point_cloud_chunk::points
+ * Host copy of the points of the chunk, read when their upload is recorded
+ * @var point_cloud_chunk::points_count
+ * Count of points appended to the chunk
+ * @var point_cloud_chunk::uploaded_count
+ * Count of points of the chunk queued for upload, only those are drawn
+ * @var point_cloud_chunk::bounds
+ * Axis aligned box holding the points of the chunk, in the space of the point cloud
+ */
+struct point_cloud_chunk {
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    struct point_cloud_point *points;
+    uint32_t points_count;
+    uint32_t uploaded_count;
+    vec3 bounds[2];
+};
+
+/**
+ * @struct point_cloud
+ * @brief Points appended in chunks drawn one draw call per visible chunk, as points or as instanced sprites when the device can't draw points of their size.
+ * Points can only be appended, so only the tail of the last chunks is ever uploaded
+ * @var point_cloud::engine
+ * Engine drawing the point cloud
+ * @var point_cloud::chunks
+ * Chunks of the point cloud, every chunk but the last one being full
+ * @var point_cloud::chunks_count
+ * Count of chunks holding points
+ * @var point_cloud::chunks_capacity
+ * Count of chunks allocated in `chunks`, those past `chunks_count` keep the buffers of the chunks emptied by `point_cloud_clear()`
+ * @var point_cloud::points_count
+ * Count of points of the point cloud
+ * @var point_cloud::push_constant
+ * Push constant of the point pipelines: the model matrix maps the points to the world, the color tints them and `uv_rect[0]` is their size in pixels
+ * @var point_cloud::draws
+ * Indices of the visible chunks drawn on the next `engine_display()` call
+ * @var point_cloud::draws_count
+ * Count of chunks in `draws`
+ */
+typedef struct point_cloud {
+    engine_t engine;
+    struct point_cloud_chunk *chunks;
+    uint32_t chunks_count;
+    uint32_t chunks_capacity;
+    uint64_t points_count;
+    struct push_constant push_constant;
+
+    uint32_t *draws;
+    uint32_t draws_count;
+} * point_cloud_t;
+
+/**
+ * @brief Initialise an empty point cloud
+ *
+ * @param point_cloud Pointer to the point cloud to initialise
+ * @param engine Pointer to the engine drawing the point cloud
+ * @param point_size Width and height of the points in pixels
+ */
+void point_cloud_init(point_cloud_t point_cloud, engine_t engine, float point_size);
+/**
+ * @brief Destroy the buffers and free the memory of a point cloud.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still draws it
+ *
+ * @param point_cloud Pointer to the point cloud to cleanup
+ */
+void point_cloud_cleanup(point_cloud_t point_cloud);
+/**
+ * @brief Append points to a point cloud, they are uploaded the next times it is drawn
+ *
+ * @param point_cloud Pointer to the point cloud
+ * @param points Pointer to an array of `points_count` points, copied
+ * @param points_count Count of points in `points`
+ * @return true if every point has been appended
+ * @return false if a chunk couldn't be allocated, the points that fit in the existing chunks are appended
+ */
+bool point_cloud_append(point_cloud_t point_cloud, const struct point_cloud_point *points, uint32_t points_count);
+/**
+ * @brief Remove every point of a point cloud, keeping its chunks for the next appended points
+ *
+ * @param point_cloud Pointer to the point cloud
+ */
+void point_cloud_clear(point_cloud_t point_cloud);
+/**
+ * @brief Set the matrix mapping the points to the world, the identity by default
+ *
+ * @param point_cloud Pointer to the point cloud
+ * @param model New model matrix of the point cloud
+ */
+void point_cloud_set_model(point_cloud_t point_cloud, mat4 model);
+/**
+ * @brief Set the color multiplied with the color of every point, white by default
+ *
+ * @param point_cloud Pointer to the point cloud
+ * @param color New color of the point cloud
+ */
+void point_cloud_set_color(point_cloud_t point_cloud, vec4 color);
+/**
+ * @brief Set the width and height of the points in pixels
+ *
+ * @param point_cloud Pointer to the point cloud
+ * @param point_size New size of the points
+ */
+void point_cloud_set_point_size(point_cloud_t point_cloud, float point_size);
+/**
+ * @brief Pack a color in the 32 bits of `point_cloud_point::color`
+ *
+ * @param color Color to pack, each channel clamped between 0 and 1
+ * @return The packed color
+ */
+uint32_t point_cloud_pack_color(vec4 color);
+/**
+ * @brief Add the chunks of a point cloud visible from the camera to the next `engine_display()` call,
+ * point clouds are drawn on top of the tilemaps and behind the objects.
+ * The points appended since the last upload are queued, up to `POINT_CLOUD_MAX_UPLOAD_POINTS_COUNT` per frame
+ *
+ * @param engine Pointer to the engine where the point cloud will be drawn
+ * @param point_cloud Pointer to the point cloud, drawn once per frame however many times it is added
+ * @return true if the point cloud will be drawn
+ * @return false if `ENGINE_MAX_POINT_CLOUDS_TO_DRAW` point clouds are already drawn in this frame
+ */
+bool point_cloud_draw(engine_t engine, point_cloud_t point_cloud);
+/**
+ * @brief Getter for the input binding descriptions of the point structure, read once per vertex when points are drawn as points
+ * and once per instance when they are drawn as sprites.
+ * If `point_cloud_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `point_cloud_binding_descriptions_count`.
+ * Otherwise populate the allocated array `point_cloud_binding_descriptions`
+ *
+ * @param point_cloud_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param point_cloud_binding_descriptions Pointer to an allocated array of `point_cloud_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ * @param input_rate `VK_VERTEX_INPUT_RATE_VERTEX` for points, `VK_VERTEX_INPUT_RATE_INSTANCE` for sprites
+ */
+void point_cloud_get_binding_description(uint32_t *point_cloud_binding_descriptions_count, VkVertexInputBindingDescription *point_cloud_binding_descriptions, VkVertexInputRate input_rate);
+/**
+ * @brief Getter for the input attribute descriptions of the point structure
+ * If `point_cloud_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `point_cloud_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `point_cloud_attribute_descriptions`
+ *
+ * @param point_cloud_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param point_cloud_attribute_descriptions Pointer to an allocated array of `point_cloud_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void point_cloud_get_attribute_description(uint32_t *point_cloud_attribute_descriptions_count, VkVertexInputAttributeDescription *point_cloud_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef _QUAD_BATCH_H
+    #define _QUAD_BATCH_H
+
+    #include <stdint.h>
+    #include <stdbool.h>
+    #include <stddef.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+
+    /**
+     * @def QUAD_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of per-instance vertex attributes read by the quad pipeline from a `struct quad`
+     */
+    #define QUAD_ATTRIBUTE_DESCRIPTIONS_COUNT 3
+    /**
+     * @def QUAD_BATCH_FIRST_CHUNK_QUADS_COUNT
+     * @brief Count of quads of the first chunk of transient memory of a frame, every next chunk doubles it
+     */
+    #define QUAD_BATCH_FIRST_CHUNK_QUADS_COUNT 1024
+    /**
+     * @def QUAD_BATCH_MAX_DRAWS_COUNT
+     * @brief Maximum count of chunks, and of draw calls, of the quads of a frame
+     */
+    #define QUAD_BATCH_MAX_DRAWS_COUNT 16
+
+struct vulkan_context;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct quad
+ * @brief Axis aligned colored rectangle drawn as a single instanced quad on the z = 0 plane, uploaded as is as instance data
+ * @var quad::position
+ * Position of the bottom left corner of the quad in world units
+ * @var quad::size
+ * Width and height of the quad in world units
+ * @var quad::color
+ * Color of the quad, blended with what is behind it using its alpha
+ */
+struct quad {
+    vec2 position;
+    vec2 size;
+    vec4 color;
+};
+
+/**
+ * @struct quad_batch_draw
+ * @brief Range of quads of a frame stored contiguously in the frame allocator buffer, drawn in one instanced draw call
+ * @var quad_batch_draw::offset
+ * Offset in bytes of the first quad of the range in the frame allocator buffer
+ * @var quad_batch_draw::quads_count
+ * Count of quads of the range
+ */
+struct quad_batch_draw {
+    VkDeviceSize offset;
+    uint32_t quads_count;
+};
+
+/**
+ * @struct quad_batch
+ * @brief Instanced quads of the current frame written straight into chunks of the frame allocator, so adding a quad is a bounds check and a store.
+ * The batch is emptied by `engine_display()`
+ * @var quad_batch::quads
+ * Pointer to the mapped memory of the chunk being filled, an array of `quad_size` bytes elements such as `struct quad`
+ * @var quad_batch::quads_count
+ * Count of quads written to the chunk being filled
+ * @var quad_batch::quads_capacity
+ * Count of quads the chunk being filled can hold
+ * @var quad_batch::draws
+ * Ranges of every chunk of the frame, the last one being filled, its count is `quads_count`
+ * @var quad_batch::draws_count
+ * Count of chunks of the frame
+ * @var quad_batch::quad_size
+ * Size in bytes of the instance data of a quad, the stride of its vertex binding
+ */
+typedef struct quad_batch {
+    void *quads;
+    uint32_t quads_count;
+    uint32_t quads_capacity;
+
+    struct quad_batch_draw draws[QUAD_BATCH_MAX_DRAWS_COUNT];
+    uint32_t draws_count;
+    uint32_t quad_size;
+} * quad_batch_t;
+
+/**
+ * @brief Initialise an empty quad batch
+ *
+ * @param batch Pointer to the batch to initialise
+ * @param quad_size Size in bytes of the instance data of a quad
+ */
+void quad_batch_init(quad_batch_t batch, uint32_t quad_size);
+/**
+ * @brief Empty a quad batch, the memory of its chunks belongs to the frame allocator and is reused with its frame
+ *
+ * @param batch Pointer to the batch to empty
+ */
+void quad_batch_reset(quad_batch_t batch);
+/**
+ * @brief Close the chunk being filled and open a new one in the frame allocator, twice as big as the previous one when the frame has room for it
+ *
+ * @param batch Pointer to the batch to grow
+ * @param context Pointer to the Vulkan context owning the frame allocator
+ * @return true if a new chunk has been opened
+ * @return false if every chunk has been used or the frame's transient memory is full
+ */
+bool quad_batch_grow(quad_batch_t batch, struct vulkan_context *context);
+/**
+ * @brief Count the quads of a batch
+ *
+ * @param batch Pointer to the batch
+ * @return The count of quads in every chunk of the batch
+ */
+uint32_t quad_batch_get_quads_count(const struct quad_batch *batch);
+/**
+ * @brief Getter for the input binding descriptions of the quad structure, read once per instance
+ * If `quad_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `quad_binding_descriptions_count`.
+ * Otherwise populate the allocated array `quad_binding_descriptions`
+ * 
+ * @param quad_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param quad_binding_descriptions Pointer to an allocated array of `quad_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void quad_get_binding_description(uint32_t *quad_binding_descriptions_count, VkVertexInputBindingDescription *quad_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the quad structure
+ * If `quad_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `quad_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `quad_attribute_descriptions`
+ * 
+ * @param quad_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param quad_attribute_descriptions Pointer to an allocated array of `quad_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void quad_get_attribute_description(uint32_t *quad_attribute_descriptions_count, VkVertexInputAttributeDescription *quad_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "object.h"
 #include "engine.h"
+#include "static_batch.h"
 
 #include <memory.h>
 
@@ -17,12 +18,23 @@ typedef struct scene_node {
     int index;
     int childrens_size;
     object_t object;
+    // Baked subtrees draw their objects merged by material, see `scene_node_bake()`
+    struct static_batch *batch;
+    uint32_t batch_entry;
+    bool batch_outdated;
 } * scene_node_t;
 
-scene_node_t scene_node_create(scene_node_t parent, object_t object);
-void scene_node_remove_child(scene_node_t child, scene_node_t node);
-void scene_node_destroy(scene_node_t node, bool recursive);
+scene_node_t scene_node_create(engine_t engine, scene_node_t parent, object_t object);
+void scene_node_remove_child(engine_t engine, scene_node_t child, scene_node_t node);
+void scene_node_destroy(engine_t engine, scene_node_t node, bool recursive);
 bool scene_node_draw(engine_t engine, scene_node_t node);
+// Merge the objects of a subtree that seldom moves into one draw per material, nodes added or removed below it are baked again on its next draw
+bool scene_node_bake(engine_t engine, scene_node_t node);
+// Draw the objects of a baked subtree one by one again, you should call `engine_wait_idle` beforehand
+void scene_node_unbake(engine_t engine, scene_node_t node);
+// Call after editing the object of a node of a baked subtree, only this object is baked again on the next draw.
+// Changing its material or its mesh may rebuild the groups it leaves and joins, which waits for the queue to be idle
+void scene_node_invalidate(scene_node_t node);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,134 @@
+#ifndef _SHAPE_H
+    #define _SHAPE_H
+
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+
+    /**
+     * @def SHAPE_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of per-instance vertex attributes read by the shape pipeline from a `struct shape`
+     */
+    #define SHAPE_ATTRIBUTE_DESCRIPTIONS_COUNT 5
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum shape_type
+ * @brief Signed distance function used by the fragment shader to draw a shape
+ */
+enum shape_type {
+    SHAPE_TYPE_CIRCLE = 0,
+    SHAPE_TYPE_ELLIPSE,
+    SHAPE_TYPE_RING,
+    SHAPE_TYPE_ROUNDED_RECTANGLE,
+    SHAPE_TYPE_CAPSULE
+};
+
+/**
+ * @struct shape
+ * @brief Analytic shape drawn as a single instanced quad, its coverage and anti-aliased edge are computed per pixel from its signed distance.
+ * The structure is uploaded as is as instance data, every size is in world units on the z = 0 plane
+ * @var shape::center
+ * Position of the center of the shape
+ * @var shape::half_size
+ * Half of the width and height of the shape, the radius of circles and rings is `half_size[0]`
+ * and the radius of a capsule, laid along its width, is `half_size[1]`
+ * @var shape::color
+ * Color of the shape, its alpha is multiplied by the coverage of the pixels on the edge
+ * @var shape::rotation
+ * Rotation of the shape around its center in radians
+ * @var shape::corner_radius
+ * Radius of the corners of rounded rectangles, ignored by other shapes
+ * @var shape::thickness
+ * Thickness of the outline of rings, other shapes are drawn as an outline of this thickness when it is greater than 0
+ * @var shape::type
+ * Type of the shape, a `enum shape_type`
+ */
+typedef struct shape {
+    vec2 center;
+    vec2 half_size;
+    vec4 color;
+    float rotation;
+    float corner_radius;
+    float thickness;
+    uint32_t type;
+} * shape_t;
+
+/**
+ * @brief Initialise a filled circle
+ * 
+ * @param shape Pointer to the shape to initialise
+ * @param center Position of the center of the circle
+ * @param radius Radius of the circle
+ * @param color Color of the circle
+ */
+void shape_init_circle(shape_t shape, vec2 center, float radius, vec4 color);
+/**
+ * @brief Initialise a filled ellipse
+ * 
+ * @param shape Pointer to the shape to initialise
+ * @param center Position of the center of the ellipse
+ * @param radii Radii of the ellipse along its width and its height
+ * @param rotation Rotation of the ellipse in radians
+ * @param color Color of the ellipse
+ */
+void shape_init_ellipse(shape_t shape, vec2 center, vec2 radii, float rotation, vec4 color);
+/**
+ * @brief Initialise a ring, the outline of a circle
+ * 
+ * @param shape Pointer to the shape to initialise
+ * @param center Position of the center of the ring
+ * @param radius Radius of the middle of the outline
+ * @param thickness Thickness of the outline
+ * @param color Color of the ring
+ */
+void shape_init_ring(shape_t shape, vec2 center, float radius, float thickness, vec4 color);
+/**
+ * @brief Initialise a filled rectangle with rounded corners
+ * 
+ * @param shape Pointer to the shape to initialise
+ * @param center Position of the center of the rectangle
+ * @param size Width and height of the rectangle
+ * @param corner_radius Radius of the corners, clamped to half of the smallest side by the shader
+ * @param rotation Rotation of the rectangle in radians
+ * @param color Color of the rectangle
+ */
+void shape_init_rounded_rectangle(shape_t shape, vec2 center, vec2 size, float corner_radius, float rotation, vec4 color);
+/**
+ * @brief Initialise a filled capsule, a segment between two points thickened by a radius
+ * 
+ * @param shape Pointer to the shape to initialise
+ * @param start First end of the segment
+ * @param end Second end of the segment
+ * @param radius Radius of the capsule
+ * @param color Color of the capsule
+ */
+void shape_init_capsule(shape_t shape, vec2 start, vec2 end, float radius, vec4 color);
+/**
+ * @brief Getter for the input binding descriptions of the shape structure, read once per instance
+ * If `shape_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `shape_binding_descriptions_count`.
+ * Otherwise populate the allocated array `shape_binding_descriptions`
+ * 
+ * @param shape_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param shape_binding_descriptions Pointer to an allocated array of `shape_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void shape_get_binding_description(uint32_t *shape_binding_descriptions_count, VkVertexInputBindingDescription *shape_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the shape structure
+ * If `shape_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `shape_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `shape_attribute_descriptions`
+ * 
+ * @param shape_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param shape_attribute_descriptions Pointer to an allocated array of `shape_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void shape_get_attribute_description(uint32_t *shape_attribute_descriptions_count, VkVertexInputAttributeDescription *shape_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _SKYLINE_H
+    #define _SKYLINE_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include "allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct skyline_node
+ * @brief Horizontal segment of the top outline of the rectangles packed in a skyline
+ * @var skyline_node::x
+ * Left of the segment
+ * @var skyline_node::y
+ * Height of the outline along the segment, the first free row above the rectangles under it
+ * @var skyline_node::width
+ * Width of the segment
+ */
+struct skyline_node {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+};
+
+/**
+ * @struct skyline
+ * @brief Rectangle packer keeping only the top outline of the packed rectangles, rectangles are placed where their top is the lowest.
+ * Packing is linear in the count of segments of the outline, the free space under the outline is never reused
+ * @var skyline::allocator
+ * Allocator of the segments
+ * @var skyline::width
+ * Width of the packed area
+ * @var skyline::height
+ * Height of the packed area
+ * @var skyline::nodes
+ * Segments of the outline from left to right, covering the whole width
+ * @var skyline::nodes_count
+ * Count of segments of the outline
+ * @var skyline::used_area
+ * Sum of the areas of the packed rectangles
+ */
+typedef struct skyline {
+    allocator_t allocator;
+    uint32_t width;
+    uint32_t height;
+    struct skyline_node *nodes;
+    uint32_t nodes_count;
+    uint64_t used_area;
+} * skyline_t;
+
+/**
+ * @brief Initialise an empty skyline, the outline can't have more segments than the width so none is allocated afterwards
+ *
+ * @param skyline Pointer to the skyline to initialise
+ * @param allocator Pointer to the allocator of the segments
+ * @param width Width of the packed area
+ * @param height Height of the packed area
+ * @return true if the segments have been allocated
+ * @return false otherwise
+ */
+bool skyline_init(skyline_t skyline, allocator_t allocator, uint32_t width, uint32_t height);
+/**
+ * @brief Free the segments of a skyline
+ *
+ * @param skyline Pointer to the skyline to cleanup
+ */
+void skyline_cleanup(skyline_t skyline);
+/**
+ * @brief Empty a skyline, forgetting every packed rectangle
+ *
+ * @param skyline Pointer to the skyline to reset
+ */
+void skyline_reset(skyline_t skyline);
+/**
+ * @brief Find room for a rectangle at the position where its top is the lowest, the narrowest segment winning ties.
+ * Packing rectangles sorted by decreasing height wastes the least space
+ *
+ * @param skyline Pointer to the skyline
+ * @param width Width of the rectangle
+ * @param height Height of the rectangle
+ * @param x Pointer receiving the left of the rectangle
+ * @param y Pointer receiving the top of the rectangle, rows grow downwards from 0
+ * @return true if the rectangle has been packed
+ * @return false if it doesn't fit anywhere
+ */
+bool skyline_pack(skyline_t skyline, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
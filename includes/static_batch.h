@@ -0,0 +1,137 @@
+#ifndef _STATIC_BATCH_H
+    #define _STATIC_BATCH_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "object.h"
+
+    /**
+     * @def STATIC_BATCH_LOOSE_GROUP
+     * @brief Group of the entries that can't be baked because their model matrix leaves the plane of their geometry, drawn one by one
+     */
+    #define STATIC_BATCH_LOOSE_GROUP UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct static_batch_entry
+ * @brief Object baked in a static batch
+ * @var static_batch_entry::object
+ * Object baked, it must stay alive as long as it is part of the batch
+ * @var static_batch_entry::mesh
+ * Mesh of the object when it was baked, the group of the entry is rebuilt if the object changes of mesh
+ * @var static_batch_entry::group
+ * Index in `static_batch::groups` of the group holding the geometry of the object, or `STATIC_BATCH_LOOSE_GROUP`
+ * @var static_batch_entry::first_vertex
+ * Index of the first vertex of the object in the vertices of its group
+ * @var static_batch_entry::dirty
+ * true if the object has been edited since it was baked
+ */
+struct static_batch_entry {
+    object_t object;
+    mesh_t mesh;
+    uint32_t group;
+    uint32_t first_vertex;
+    bool dirty;
+};
+
+/**
+ * @struct static_batch_group
+ * @brief Geometry of every baked object sharing a material, transformed in world space and drawn in one call
+ * @var static_batch_group::object
+ * Object drawn for the group, holding the texture, the color and the plane of its material, its mesh is `mesh`
+ * @var static_batch_group::mesh
+ * Merged geometry of the group, owned by the group instead of the mesh cache
+ * @var static_batch_group::vertices
+ * Host copy of the vertices of the group, read when the updates of edited objects are recorded
+ * @var static_batch_group::entries_count
+ * Count of entries baked in the group, an empty group is reused by the next new material
+ * @var static_batch_group::dirty
+ * true if objects joined or left the group since its geometry was built
+ */
+struct static_batch_group {
+    struct object object;
+    struct mesh mesh;
+    struct vertex *vertices;
+    uint32_t entries_count;
+    bool dirty;
+};
+
+/**
+ * @struct static_batch
+ * @brief Objects that seldom move merged into one vertex and index buffer per material, replacing one draw per object by one per material.
+ * Objects are baked at their finest level of detail, in their plane: the z of their model matrix
+ * @var static_batch::engine
+ * Engine drawing the batch
+ * @var static_batch::entries
+ * Objects baked, in the order they were given to `static_batch_build()`
+ * @var static_batch::entries_count
+ * Count of entries in `entries`
+ * @var static_batch::groups
+ * Groups of the batch, allocated one by one so that the objects drawn for them keep their address
+ * @var static_batch::groups_count
+ * Count of groups in `groups`
+ */
+typedef struct static_batch {
+    engine_t engine;
+    struct static_batch_entry *entries;
+    uint32_t entries_count;
+    struct static_batch_group **groups;
+    uint32_t groups_count;
+} * static_batch_t;
+
+/**
+ * @brief Initialise an empty static batch
+ *
+ * @param batch Pointer to the batch to initialise
+ * @param engine Pointer to the engine drawing the batch
+ */
+void static_batch_init(static_batch_t batch, engine_t engine);
+/**
+ * @brief Destroy the buffers and free the memory of a static batch, the baked objects are left untouched.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still draws it
+ *
+ * @param batch Pointer to the batch to cleanup
+ */
+void static_batch_cleanup(static_batch_t batch);
+/**
+ * @brief Bake objects, replacing every object baked before. Objects sharing a texture, a color and a plane are merged in the same group,
+ * drawn in the reverse order they are given like `engine_draw()` would. Groups are drawn one after the other, so overlapping objects of different materials
+ * may not be drawn in the same order as when they are drawn one by one
+ *
+ * @param batch Pointer to the batch
+ * @param objects Pointer to an array of `objects_count` objects to bake
+ * @param objects_count Count of objects in `objects`
+ * @return true if every object has been baked
+ * @return false if an allocation failed, the batch is then empty
+ */
+bool static_batch_build(static_batch_t batch, const object_t *objects, uint32_t objects_count);
+/**
+ * @brief Tell the batch that a baked object has been edited, its new model matrix, color, texture or mesh is baked the next time the batch is drawn.
+ * An object keeping its material and its mesh, or alone in its group and taking a material no other group has, is only transformed again and uploaded alone.
+ * Otherwise the groups it leaves and joins are rebuilt during `static_batch_draw()`, each rebuild waiting for the queue to be idle
+ *
+ * @param batch Pointer to the batch
+ * @param entry Index in `entries` of the edited object
+ */
+void static_batch_invalidate(static_batch_t batch, uint32_t entry);
+/**
+ * @brief Bake the edited objects then add the groups of the batch to the next `engine_display()` call
+ *
+ * @param engine Pointer to the engine where the batch will be drawn
+ * @param batch Pointer to the batch
+ * @return true if every group and loose object will be drawn
+ * @return false if a group couldn't be rebuilt or the engine can't draw more objects
+ */
+bool static_batch_draw(engine_t engine, static_batch_t batch);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef _STREAMING_TEXTURE_H
+    #define _STREAMING_TEXTURE_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <vulkan/vulkan.h>
+    #include "vulkan/texture.h"
+    #ifdef __cplusplus
+        #include <atomic>
+    #else
+        #include <stdatomic.h>
+    #endif
+
+    /**
+     * @def STREAMING_TEXTURE_SLICES_COUNT
+     * @brief Count of staging slices of a streaming texture: one per frame in flight copying it, one submitted and one being written
+     */
+    #define STREAMING_TEXTURE_SLICES_COUNT 4
+    /**
+     * @def STREAMING_TEXTURE_MAX_COUNT
+     * @brief Maximum count of streaming textures alive at once
+     */
+    #define STREAMING_TEXTURE_MAX_COUNT 16
+    /**
+     * @def STREAMING_TEXTURE_SLICE_ALIGNMENT
+     * @brief Alignment in bytes of the slices in the staging buffer, enough for the optimal copy offset alignment of every device
+     */
+    #define STREAMING_TEXTURE_SLICE_ALIGNMENT 256
+
+#ifdef __cplusplus
+typedef std::atomic<uint32_t> streaming_texture_atomic_t;
+
+extern "C" {
+#else
+typedef _Atomic uint32_t streaming_texture_atomic_t;
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @enum streaming_texture_slice_state
+ * @brief Owner of a staging slice, changed atomically since producers and the frame recording run on different threads
+ */
+enum streaming_texture_slice_state {
+    STREAMING_TEXTURE_SLICE_FREE,
+    STREAMING_TEXTURE_SLICE_WRITING,
+    STREAMING_TEXTURE_SLICE_READY,
+    STREAMING_TEXTURE_SLICE_PENDING
+};
+
+/**
+ * @struct streaming_texture_slice
+ * @brief Image sized part of the persistently mapped staging buffer of a streaming texture, laid out like the texture
+ * @var streaming_texture_slice::state
+ * `enum streaming_texture_slice_state` of the slice, only a producer that moved it from free to writing may write its texels
+ * @var streaming_texture_slice::pixels
+ * Mapped pointer to the top left texel of the slice, rows being `streaming_texture::row_pitch` bytes apart
+ * @var streaming_texture_slice::offset
+ * Offset in bytes of the slice in the staging buffer
+ * @var streaming_texture_slice::sequence
+ * Order in which the slice has been submitted, the submitted slices are copied in that order
+ * @var streaming_texture_slice::x
+ * Left of the rectangle written in the slice
+ * @var streaming_texture_slice::y
+ * Top of the rectangle written in the slice
+ * @var streaming_texture_slice::width
+ * Width of the rectangle written in the slice
+ * @var streaming_texture_slice::height
+ * Height of the rectangle written in the slice
+ * @var streaming_texture_slice::frame
+ * Frame in flight whose command buffer copies the slice, the slice is free again once its fence is signaled
+ */
+typedef struct streaming_texture_slice {
+    streaming_texture_atomic_t state;
+    void *pixels;
+    VkDeviceSize offset;
+    uint32_t sequence;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t frame;
+} * streaming_texture_slice_t;
+
+/**
+ * @struct streaming_texture
+ * @brief Texture updated every frame through a ring of staging slices, each slice submitted by a producer being copied into the texture
+ * with `vkCmdCopyBufferToImage` at the start of the next recorded frame.
+ * Producers may write straight into the mapped slices from any thread, a slice whose rectangle is covered by a later one is released without being copied
+ * @var streaming_texture::engine
+ * Engine owning the texture
+ * @var streaming_texture::texture
+ * Sampled texture, drawn like any other texture
+ * @var streaming_texture::buffer
+ * Host visible staging buffer holding the slices
+ * @var streaming_texture::memory
+ * Memory bound to `buffer`, mapped for the lifetime of the streaming texture
+ * @var streaming_texture::texel_size
+ * Size in bytes of a texel
+ * @var streaming_texture::row_pitch
+ * Distance in bytes between two rows of a slice
+ * @var streaming_texture::slices
+ * Staging slices of the ring
+ * @var streaming_texture::next_sequence
+ * Sequence given to the next submitted slice
+ * @var streaming_texture::copied_sequence
+ * Sequence of the next slice to copy, read by the frame recording only. Slices are copied without gaps in their sequences,
+ * so a slice submitted while the ready ones are gathered never overtakes one submitted before it
+ * @var streaming_texture::skipped_count
+ * Count of submitted slices released without being copied since a later slice covered them
+ */
+typedef struct streaming_texture {
+    engine_t engine;
+    struct texture texture;
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    uint32_t texel_size;
+    uint32_t row_pitch;
+    struct streaming_texture_slice slices[STREAMING_TEXTURE_SLICES_COUNT];
+    streaming_texture_atomic_t next_sequence;
+    uint32_t copied_sequence;
+    uint32_t skipped_count;
+} * streaming_texture_t;
+
+/**
+ * @brief Initialise a streaming texture and map its staging slices.
+ * Its first update should cover the whole texture, the texture being sampled only after it
+ *
+ * @param streaming_texture Pointer to the streaming texture to initialise
+ * @param engine Pointer to the engine drawing the texture
+ * @param width Width of the texture in texels
+ * @param height Height of the texture in texels
+ * @param format Format of the texels, one of the uncompressed color formats supported by the textures
+ * @return true if the streaming texture has been initialised
+ * @return false if its texture or its staging buffer couldn't be created, or `STREAMING_TEXTURE_MAX_COUNT` streaming textures are already alive
+ */
+bool streaming_texture_init(streaming_texture_t streaming_texture, engine_t engine, uint32_t width, uint32_t height, VkFormat format);
+/**
+ * @brief Destroy the texture and the staging buffer of a streaming texture.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still copies or samples it, and no producer may still hold a slice
+ *
+ * @param streaming_texture Pointer to the streaming texture to cleanup
+ */
+void streaming_texture_cleanup(streaming_texture_t streaming_texture);
+/**
+ * @brief Take a free staging slice to write texels into, from any thread
+ *
+ * @param streaming_texture Pointer to the streaming texture
+ * @return The slice now owned by the caller until it is submitted, NULL if every slice is written, submitted or still copied by a frame in flight
+ */
+streaming_texture_slice_t streaming_texture_acquire(streaming_texture_t streaming_texture);
+/**
+ * @brief Give back a slice taken by `streaming_texture_acquire()`, its rectangle being copied into the texture by the next recorded frame.
+ * The texels of the rectangle must be written at their place in the slice, an empty rectangle releases the slice without copying it
+ *
+ * @param streaming_texture Pointer to the streaming texture
+ * @param slice Slice owned by the caller
+ * @param x Left of the rectangle written in the slice
+ * @param y Top of the rectangle written in the slice
+ * @param width Width of the rectangle, the rectangle must fit in the texture
+ * @param height Height of the rectangle
+ */
+void streaming_texture_submit(streaming_texture_t streaming_texture, streaming_texture_slice_t slice, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+/**
+ * @brief Copy a rectangle of texels into a free slice and submit it, from any thread
+ *
+ * @param streaming_texture Pointer to the streaming texture
+ * @param pixels Pointer to the top left texel of the rectangle
+ * @param x Left of the rectangle in the texture
+ * @param y Top of the rectangle in the texture
+ * @param width Width of the rectangle, the rectangle must fit in the texture
+ * @param height Height of the rectangle
+ * @param row_length Count of texels between two rows of `pixels`
+ * @return true if the rectangle will be copied by the next recorded frame
+ * @return false if no slice is free
+ */
+bool streaming_texture_update(streaming_texture_t streaming_texture, const void *pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t row_length);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef _STROKE_H
+    #define _STROKE_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+
+    /**
+     * @def STROKE_MITER_LIMIT_DEFAULT
+     * @brief Default ratio between the length of a miter and half the width of the stroke above which a miter join is drawn as a bevel
+     */
+    #define STROKE_MITER_LIMIT_DEFAULT 4.0f
+    /**
+     * @def STROKE_ROUND_SEGMENTS_PER_HALF_TURN
+     * @brief Count of segments used to approximate half a turn of round joins and caps
+     */
+    #define STROKE_ROUND_SEGMENTS_PER_HALF_TURN 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum stroke_join
+ * @brief Shape of the corner drawn between two segments of a stroke
+ */
+enum stroke_join {
+    STROKE_JOIN_MITER = 0,
+    STROKE_JOIN_ROUND,
+    STROKE_JOIN_BEVEL
+};
+
+/**
+ * @enum stroke_cap
+ * @brief Shape of the ends of an open stroke
+ */
+enum stroke_cap {
+    STROKE_CAP_BUTT = 0,
+    STROKE_CAP_ROUND,
+    STROKE_CAP_SQUARE
+};
+
+/**
+ * @struct stroke_style
+ * @brief Parameters of the tessellation of a stroke
+ * @var stroke_style::width
+ * Width of the stroke in world units
+ * @var stroke_style::join
+ * Shape of the corners between segments
+ * @var stroke_style::cap
+ * Shape of the ends of open strokes
+ * @var stroke_style::miter_limit
+ * Maximum ratio between the length of a miter and half the width, sharper corners are drawn as a bevel
+ */
+struct stroke_style {
+    float width;
+    enum stroke_join join;
+    enum stroke_cap cap;
+    float miter_limit;
+};
+
+/**
+ * @struct stroke_buffer
+ * @brief Growing triangle list receiving the tessellation of any count of strokes, so that they can be uploaded and drawn as one mesh.
+ * Clearing the buffer keeps its memory, tessellating the strokes of every frame in the same buffer doesn't allocate once it is big enough
+ * @var stroke_buffer::allocator
+ * Allocator used to grow the arrays of the buffer
+ * @var stroke_buffer::positions
+ * Array of the positions of the vertices
+ * @var stroke_buffer::vertices_count
+ * Count of vertices in `positions`
+ * @var stroke_buffer::vertices_capacity
+ * Count of vertices `positions` can hold before growing
+ * @var stroke_buffer::indices
+ * Array of indices, every 3 indices forming a counter-clockwise triangle
+ * @var stroke_buffer::indices_count
+ * Count of indices in `indices`
+ * @var stroke_buffer::indices_capacity
+ * Count of indices `indices` can hold before growing
+ */
+typedef struct stroke_buffer {
+    allocator_t allocator;
+
+    vec2 *positions;
+    uint32_t vertices_count;
+    uint32_t vertices_capacity;
+
+    uint32_t *indices;
+    uint32_t indices_count;
+    uint32_t indices_capacity;
+} * stroke_buffer_t;
+
+/**
+ * @struct stroke
+ * @brief State of a stroke being tessellated point by point, only the segments of new points are tessellated when it grows
+ * @var stroke::style
+ * Style of the stroke, copied when it begins
+ * @var stroke::first_point
+ * First point of the stroke
+ * @var stroke::first_direction
+ * Normalized direction of the first segment of the stroke
+ * @var stroke::last_point
+ * Last point appended to the stroke
+ * @var stroke::last_direction
+ * Normalized direction of the last segment of the stroke
+ * @var stroke::segments_count
+ * Count of segments tessellated, segments of zero length are skipped
+ * @var stroke::closed
+ * Boolean telling if the stroke is a closed loop, drawn without caps and joined at its first point
+ */
+typedef struct stroke {
+    struct stroke_style style;
+
+    vec2 first_point;
+    vec2 first_direction;
+    vec2 last_point;
+    vec2 last_direction;
+    uint32_t segments_count;
+    bool closed;
+} * stroke_t;
+
+/**
+ * @brief Initialise a style with miter joins limited to `STROKE_MITER_LIMIT_DEFAULT` and butt caps
+ *
+ * @param style Pointer to the style to initialise
+ * @param width Width of the stroke in world units
+ */
+void stroke_style_init(struct stroke_style *style, float width);
+/**
+ * @brief Initialise an empty stroke buffer, no memory is allocated until the first stroke
+ *
+ * @param buffer Pointer to the buffer to initialise
+ * @param allocator Pointer to the allocator used to grow the buffer, NULL for the default allocator
+ */
+void stroke_buffer_init(stroke_buffer_t buffer, allocator_t allocator);
+/**
+ * @brief Remove every stroke from a buffer, keeping its memory for the next strokes
+ *
+ * @param buffer Pointer to the buffer to clear
+ */
+void stroke_buffer_clear(stroke_buffer_t buffer);
+/**
+ * @brief Free the memory of a buffer
+ *
+ * @param buffer Pointer to the buffer to cleanup
+ */
+void stroke_buffer_cleanup(stroke_buffer_t buffer);
+/**
+ * @brief Tessellate a whole polyline into a buffer
+ *
+ * @param buffer Pointer to the buffer receiving the triangles
+ * @param style Pointer to the style of the stroke
+ * @param points Pointer to an array of `points_count` points
+ * @param points_count Count of points in `points`
+ * @param closed true to join the last point to the first one and draw no caps
+ * @return true if the stroke has been tessellated
+ * @return false if the buffer couldn't grow, the triangles of the stroke already added are kept
+ */
+bool stroke_buffer_add_polyline(stroke_buffer_t buffer, const struct stroke_style *style, const vec2 *points, uint32_t points_count, bool closed);
+/**
+ * @brief Begin an open stroke at a point, its segments are tessellated as points are appended with `stroke_append()`
+ *
+ * @param stroke Pointer to the stroke state to initialise
+ * @param style Pointer to the style of the stroke, copied
+ * @param point First point of the stroke
+ */
+void stroke_begin(stroke_t stroke, const struct stroke_style *style, vec2 point);
+/**
+ * @brief Append points to a stroke, tessellating into a buffer the join at the previous last point and the new segments only
+ *
+ * @param buffer Pointer to the buffer receiving the triangles, the same for the whole stroke
+ * @param stroke Pointer to the stroke to grow
+ * @param points Pointer to an array of `points_count` points
+ * @param points_count Count of points in `points`
+ * @return true if the points have been tessellated
+ * @return false if the buffer couldn't grow
+ */
+bool stroke_append(stroke_buffer_t buffer, stroke_t stroke, const vec2 *points, uint32_t points_count);
+/**
+ * @brief End a stroke, tessellating the caps at both of its ends
+ *
+ * @param buffer Pointer to the buffer receiving the triangles, the same for the whole stroke
+ * @param stroke Pointer to the stroke to end
+ * @return true if the caps have been tessellated
+ * @return false if the buffer couldn't grow
+ */
+bool stroke_end(stroke_buffer_t buffer, stroke_t stroke);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
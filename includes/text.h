@@ -0,0 +1,89 @@
+#ifndef _TEXT_H
+    #define _TEXT_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <stddef.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "font.h"
+    #include "glyph_atlas.h"
+
+    /**
+     * @def TEXT_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of per-instance vertex attributes read by the text pipeline from a `struct text_quad`
+     */
+    #define TEXT_ATTRIBUTE_DESCRIPTIONS_COUNT 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct text_quad
+ * @brief Quad drawing one glyph from the glyph atlas, uploaded as is as instance data on the z = 0 plane
+ * @var text_quad::position
+ * Position of the bottom left corner of the quad in world units
+ * @var text_quad::size
+ * Width and height of the quad in world units
+ * @var text_quad::uv_rect
+ * Texture coordinates in the glyph atlas of the bottom left then of the top right corner of the quad
+ * @var text_quad::color
+ * Color of the glyph, blended with what is behind it using its alpha
+ */
+struct text_quad {
+    vec2 position;
+    vec2 size;
+    vec4 uv_rect;
+    vec4 color;
+};
+
+/**
+ * @brief Lay out a string and add its glyphs to the text drawn on the next `engine_display()` call.
+ * Glyphs missing from the glyph atlas of the engine are rasterized, all the text of a frame is drawn after the quads in a few instanced draw calls
+ *
+ * @param engine Pointer to the engine where the text will be drawn
+ * @param font Pointer to the font of the text, it must stay valid until `engine_display()` is called
+ * @param string UTF-8 string to draw, every `\n` starts a new line
+ * @param position Position in world units of the origin of the first glyph, on the baseline of the first line
+ * @param size Size of the font in world units, the height of an em
+ * @param color Color of the text
+ * @return true if the whole string will be drawn
+ * @return false if the frame's transient memory or the glyph atlas is full, the glyphs laid out before are drawn
+ */
+bool text_draw(engine_t engine, const struct font *font, const char *string, vec2 position, float size, vec4 color);
+/**
+ * @brief Measure the box of a string laid out as `text_draw()` would
+ *
+ * @param font Pointer to the font of the text
+ * @param string UTF-8 string to measure
+ * @param size Size of the font in world units
+ * @param dimensions Receives the advance of the longest line and the height of the lines, from the top of the first to the bottom of the last
+ */
+void text_measure(const struct font *font, const char *string, float size, vec2 dimensions);
+/**
+ * @brief Getter for the input binding descriptions of the text quad structure, read once per instance
+ * If `text_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `text_binding_descriptions_count`.
+ * Otherwise populate the allocated array `text_binding_descriptions`
+ *
+ * @param text_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param text_binding_descriptions Pointer to an allocated array of `text_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void text_get_binding_description(uint32_t *text_binding_descriptions_count, VkVertexInputBindingDescription *text_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the text quad structure
+ * If `text_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `text_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `text_attribute_descriptions`
+ *
+ * @param text_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param text_attribute_descriptions Pointer to an allocated array of `text_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void text_get_attribute_description(uint32_t *text_attribute_descriptions_count, VkVertexInputAttributeDescription *text_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef _TEXTURE_ATLAS_H
+    #define _TEXTURE_ATLAS_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "skyline.h"
+    #include "vulkan/texture.h"
+
+    /**
+     * @def TEXTURE_ATLAS_DEFAULT_PAGE_SIZE
+     * @brief Default width and height in pixels of the textures images are packed in
+     */
+    #define TEXTURE_ATLAS_DEFAULT_PAGE_SIZE 2048
+    /**
+     * @def TEXTURE_ATLAS_PADDING
+     * @brief Pixels around every packed image repeating its border, so that filtering at its edges never reads its neighbours
+     */
+    #define TEXTURE_ATLAS_PADDING 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct texture_region
+ * @brief Region of a texture holding one image, given to `object_set_texture()`
+ * @var texture_region::texture
+ * Texture holding the image
+ * @var texture_region::uv_rect
+ * Texture coordinates of the bottom left then of the top right corner of the image in the texture
+ */
+struct texture_region {
+    texture_t texture;
+    vec4 uv_rect;
+};
+
+/**
+ * @struct texture_atlas_page
+ * @brief One texture of an atlas and the images packed in it
+ * @var texture_atlas_page::skyline
+ * Packer placing the images in the page
+ * @var texture_atlas_page::pixels
+ * Pixels of the page, uploaded by `texture_atlas_upload()`
+ * @var texture_atlas_page::texture
+ * Texture of the page
+ * @var texture_atlas_page::dirty
+ * true if images have been added to the page since its last upload
+ */
+struct texture_atlas_page {
+    struct skyline skyline;
+    uint8_t *pixels;
+    texture_t texture;
+    bool dirty;
+};
+
+/**
+ * @struct texture_atlas
+ * @brief Packs many small RGBA images into a few large textures, a new page is created when an image fits in none of the others.
+ * Pages are few textures sampled by many objects, so that thousands of images fit within `TEXTURE_MAX_COUNT`
+ * @var texture_atlas::engine
+ * Engine creating the textures of the pages
+ * @var texture_atlas::page_size
+ * Width and height in pixels of every page
+ * @var texture_atlas::pages
+ * Pages of the atlas
+ * @var texture_atlas::pages_count
+ * Count of pages of the atlas
+ * @var texture_atlas::pages_capacity
+ * Count of pages allocated in `pages`
+ */
+typedef struct texture_atlas {
+    engine_t engine;
+    uint32_t page_size;
+    struct texture_atlas_page *pages;
+    uint32_t pages_count;
+    uint32_t pages_capacity;
+} * texture_atlas_t;
+
+/**
+ * @brief Initialise an empty atlas, pages are created when images are added
+ *
+ * @param atlas Pointer to the atlas to initialise
+ * @param engine Pointer to the engine creating the textures
+ * @param page_size Width and height in pixels of the pages, `TEXTURE_ATLAS_DEFAULT_PAGE_SIZE` fits any GPU
+ * @return true if the atlas has been initialised
+ * @return false if the page size leaves no room inside the padding
+ */
+bool texture_atlas_init(texture_atlas_t atlas, engine_t engine, uint32_t page_size);
+/**
+ * @brief Destroy the textures and free the memory of an atlas.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still samples its pages
+ *
+ * @param atlas Pointer to the atlas to cleanup
+ */
+void texture_atlas_cleanup(texture_atlas_t atlas);
+/**
+ * @brief Pack an image into the first page with room for it, adding images by decreasing height wastes the least space.
+ * The image is copied, its pages are uploaded by the next `texture_atlas_upload()` call which must be made before it is drawn
+ *
+ * @param atlas Pointer to the atlas
+ * @param width Width of the image in pixels, at most `page_size - 2 * TEXTURE_ATLAS_PADDING`
+ * @param height Height of the image in pixels, at most `page_size - 2 * TEXTURE_ATLAS_PADDING`
+ * @param pixels Pointer to `width` * `height` 8 bits sRGB RGBA pixels, row by row from the top left one
+ * @param region Pointer receiving the texture and the texture coordinates of the image
+ * @return true if the image has been packed
+ * @return false if it is larger than a page or a page couldn't be created
+ */
+bool texture_atlas_add(texture_atlas_t atlas, uint32_t width, uint32_t height, const void *pixels, struct texture_region *region);
+/**
+ * @brief Upload every page images have been added to since the last upload
+ *
+ * @param atlas Pointer to the atlas
+ * @return true if every changed page has been uploaded
+ * @return false otherwise
+ */
+bool texture_atlas_upload(texture_atlas_t atlas);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
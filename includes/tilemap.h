@@ -0,0 +1,228 @@
+#ifndef _TILEMAP_H
+    #define _TILEMAP_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "vulkan/shaders.h"
+    #include "vulkan/texture.h"
+
+    /**
+     * @def TILEMAP_CHUNK_SIZE
+     * @brief Width and height in tiles of a chunk, the unit of culling, of upload and of draw of a tilemap
+     */
+    #define TILEMAP_CHUNK_SIZE 32
+    /**
+     * @def TILEMAP_CHUNK_TILES_COUNT
+     * @brief Count of tiles of a chunk, and of instances reserved for it in the instance buffer of its tilemap
+     */
+    #define TILEMAP_CHUNK_TILES_COUNT (TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE)
+    /**
+     * @def TILEMAP_MAX_SIZE
+     * @brief Maximum width and height in tiles of a tilemap, tile coordinates are uploaded as 16 bits integers
+     */
+    #define TILEMAP_MAX_SIZE 65536
+    /**
+     * @def TILEMAP_EMPTY_TILE
+     * @brief Tile that isn't drawn, every other tile `t` is the cell `t - 1` of the tileset
+     */
+    #define TILEMAP_EMPTY_TILE 0
+    /**
+     * @def TILEMAP_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of per-instance vertex attributes read by the tile pipeline from a `struct tile_instance`
+     */
+    #define TILEMAP_ATTRIBUTE_DESCRIPTIONS_COUNT 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct tile_instance
+ * @brief Tile drawn as one instanced quad, uploaded as is as instance data
+ * @var tile_instance::x
+ * Column of the tile in the tilemap
+ * @var tile_instance::y
+ * Row of the tile in the tilemap, row 0 being the bottom one
+ * @var tile_instance::tile
+ * Tile drawn, never `TILEMAP_EMPTY_TILE`
+ */
+struct tile_instance {
+    uint16_t x;
+    uint16_t y;
+    uint32_t tile;
+};
+
+/**
+ * @struct tilemap_chunk
+ * @brief Square of `TILEMAP_CHUNK_SIZE` tiles whose non empty tiles are uploaded together
+ * @var tilemap_chunk::instances_count
+ * Count of non empty tiles of the chunk, packed at the start of its range of the instance buffer
+ * @var tilemap_chunk::dirty
+ * true if tiles of the chunk have changed since its instances were last queued for upload
+ */
+struct tilemap_chunk {
+    uint32_t instances_count;
+    bool dirty;
+};
+
+/**
+ * @struct tilemap_draw
+ * @brief Range of the instance buffer of a tilemap drawn in one instanced draw call, covering one or more visible chunks
+ * @var tilemap_draw::first_instance
+ * Index of the first instance of the range
+ * @var tilemap_draw::instances_count
+ * Count of instances of the range
+ */
+struct tilemap_draw {
+    uint32_t first_instance;
+    uint32_t instances_count;
+};
+
+/**
+ * @struct tilemap
+ * @brief Grid of tiles sampled from a tileset texture, drawn one instanced draw per visible chunk.
+ * Each chunk owns a fixed range of a device local instance buffer, only the chunks whose tiles changed are uploaded again
+ * @var tilemap::engine
+ * Engine drawing the tilemap
+ * @var tilemap::width
+ * Width of the tilemap in tiles
+ * @var tilemap::height
+ * Height of the tilemap in tiles
+ * @var tilemap::chunks_width
+ * Count of chunks along the width
+ * @var tilemap::chunks_height
+ * Count of chunks along the height
+ * @var tilemap::tiles
+ * Tiles of the tilemap, row by row from the bottom left one
+ * @var tilemap::chunks
+ * Chunks of the tilemap, row by row from the bottom left one
+ * @var tilemap::instances
+ * Host copy of the instance buffer, read when the updates of the chunks are recorded
+ * @var tilemap::instance_buffer
+ * Device local buffer of `TILEMAP_CHUNK_TILES_COUNT` instances per chunk
+ * @var tilemap::instance_memory
+ * Memory bound to the instance buffer
+ * @var tilemap::push_constant
+ * Push constant of the tile pipeline: the model matrix maps tile coordinates to the world, the color tints the tileset,
+ * `uv_rect` holds the size of a cell in texture coordinates then the count of columns of the tileset, and `texture_index` is the tileset
+ * @var tilemap::draws
+ * Ranges of the visible chunks drawn on the next `engine_display()` call, at most one per chunk
+ * @var tilemap::draws_count
+ * Count of ranges in `draws`
+ */
+typedef struct tilemap {
+    engine_t engine;
+    uint32_t width;
+    uint32_t height;
+    uint32_t chunks_width;
+    uint32_t chunks_height;
+
+    uint16_t *tiles;
+    struct tilemap_chunk *chunks;
+    struct tile_instance *instances;
+    VkBuffer instance_buffer;
+    VkDeviceMemory instance_memory;
+    struct push_constant push_constant;
+
+    struct tilemap_draw *draws;
+    uint32_t draws_count;
+} * tilemap_t;
+
+/**
+ * @brief Initialise a tilemap filled with `TILEMAP_EMPTY_TILE` and create its instance buffer
+ *
+ * @param tilemap Pointer to the tilemap to initialise
+ * @param engine Pointer to the engine drawing the tilemap
+ * @param width Width of the tilemap in tiles, at most `TILEMAP_MAX_SIZE`
+ * @param height Height of the tilemap in tiles, at most `TILEMAP_MAX_SIZE`
+ * @param position Position in world units of the bottom left corner of the tilemap
+ * @param tile_size Width and height of a tile in world units
+ * @param tileset Texture holding the tiles in a grid of cells of the same size, row by row from the top left one
+ * @param tileset_columns Count of columns of cells of the tileset
+ * @param tileset_rows Count of rows of cells of the tileset
+ * @return true if the tilemap has been initialised
+ * @return false if it is too large, the tileset is missing or an allocation failed
+ */
+bool tilemap_init(tilemap_t tilemap, engine_t engine, uint32_t width, uint32_t height, vec2 position, float tile_size, texture_t tileset, uint32_t tileset_columns, uint32_t tileset_rows);
+/**
+ * @brief Destroy the instance buffer and free the memory of a tilemap.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still draws it
+ *
+ * @param tilemap Pointer to the tilemap to cleanup
+ */
+void tilemap_cleanup(tilemap_t tilemap);
+/**
+ * @brief Getter for a tile
+ *
+ * @param tilemap Pointer to the tilemap
+ * @param x Column of the tile
+ * @param y Row of the tile, row 0 being the bottom one
+ * @return The tile, `TILEMAP_EMPTY_TILE` outside of the tilemap
+ */
+uint16_t tilemap_get_tile(const struct tilemap *tilemap, uint32_t x, uint32_t y);
+/**
+ * @brief Change a tile, its chunk is uploaded again the next time it is drawn. Does nothing outside of the tilemap
+ *
+ * @param tilemap Pointer to the tilemap
+ * @param x Column of the tile
+ * @param y Row of the tile, row 0 being the bottom one
+ * @param tile New tile, `TILEMAP_EMPTY_TILE` to remove it
+ */
+void tilemap_set_tile(tilemap_t tilemap, uint32_t x, uint32_t y, uint16_t tile);
+/**
+ * @brief Change a rectangle of tiles at once, the part of the rectangle outside of the tilemap is ignored
+ *
+ * @param tilemap Pointer to the tilemap
+ * @param x Column of the bottom left tile of the rectangle
+ * @param y Row of the bottom left tile of the rectangle
+ * @param width Width of the rectangle in tiles
+ * @param height Height of the rectangle in tiles
+ * @param tiles Pointer to `width` * `height` tiles, row by row from the bottom left one
+ */
+void tilemap_set_tiles(tilemap_t tilemap, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t *tiles);
+/**
+ * @brief Set the color multiplied with the tileset when the tilemap is drawn, white by default
+ *
+ * @param tilemap Pointer to the tilemap
+ * @param color New color of the tilemap
+ */
+void tilemap_set_color(tilemap_t tilemap, vec4 color);
+/**
+ * @brief Add the chunks of a tilemap visible from the camera to the next `engine_display()` call, tilemaps are drawn behind the objects.
+ * The visible chunks whose tiles changed are queued for upload, those that don't fit in the frame are uploaded by the next ones
+ *
+ * @param engine Pointer to the engine where the tilemap will be drawn
+ * @param tilemap Pointer to the tilemap, drawn once per frame however many times it is added
+ * @return true if the tilemap will be drawn
+ * @return false if `ENGINE_MAX_TILEMAPS_TO_DRAW` tilemaps are already drawn in this frame
+ */
+bool tilemap_draw(engine_t engine, tilemap_t tilemap);
+/**
+ * @brief Getter for the input binding descriptions of the tile instance structure, read once per instance
+ * If `tilemap_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `tilemap_binding_descriptions_count`.
+ * Otherwise populate the allocated array `tilemap_binding_descriptions`
+ *
+ * @param tilemap_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param tilemap_binding_descriptions Pointer to an allocated array of `tilemap_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void tilemap_get_binding_description(uint32_t *tilemap_binding_descriptions_count, VkVertexInputBindingDescription *tilemap_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the tile instance structure
+ * If `tilemap_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `tilemap_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `tilemap_attribute_descriptions`
+ *
+ * @param tilemap_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param tilemap_attribute_descriptions Pointer to an allocated array of `tilemap_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void tilemap_get_attribute_description(uint32_t *tilemap_attribute_descriptions_count, VkVertexInputAttributeDescription *tilemap_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
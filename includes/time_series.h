@@ -0,0 +1,191 @@
+#ifndef _TIME_SERIES_H
+    #define _TIME_SERIES_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "vulkan/shaders.h"
+    #include "vulkan/frame_allocator.h"
+
+    /**
+     * @def TIME_SERIES_MAX_LEVELS_COUNT
+     * @brief Maximum count of levels of the decimation pyramid, enough for any capacity held by 32 bits
+     */
+    #define TIME_SERIES_MAX_LEVELS_COUNT 32
+    /**
+     * @def TIME_SERIES_APPEND_BATCH_SIZE
+     * @brief Count of samples reduced together by `time_series_append()`, bounding the memory it uses on the stack
+     */
+    #define TIME_SERIES_APPEND_BATCH_SIZE 1024
+    /**
+     * @def TIME_SERIES_MAX_UPLOAD_SIZE
+     * @brief Maximum size in bytes of the entries of a time series uploaded per frame, staged through the transient memory of the frame.
+     * A level missing more entries catches up over the next frames
+     */
+    #define TIME_SERIES_MAX_UPLOAD_SIZE (FRAME_ALLOCATOR_FRAME_SIZE / 4)
+    /**
+     * @def TIME_SERIES_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of vertex attributes read by the series pipeline: a value of the pyramid and the color of its series
+     */
+    #define TIME_SERIES_ATTRIBUTE_DESCRIPTIONS_COUNT 2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @struct time_series_level
+ * @brief Level of the decimation pyramid of a time series, each entry holding the minimum and the maximum of `2^level` consecutive samples.
+ * The entries of a level are a ring per series, the ring of the level `level` holds `capacity >> level` entries
+ * @var time_series_level::offset
+ * Index of the first entry of the level in the pyramid, the ring of the series `s` starting at `offset + s * slots_count`
+ * @var time_series_level::slots_count
+ * Count of entries of the ring of each series, a power of two
+ * @var time_series_level::first_uploaded
+ * First entry of the level still held by the buffer, counted from the first sample ever appended
+ * @var time_series_level::uploaded_samples_count
+ * Count of samples appended when the entries of the level were last uploaded, the entry holding the next sample is uploaded again
+ */
+struct time_series_level {
+    uint64_t offset;
+    uint32_t slots_count;
+    uint64_t first_uploaded;
+    uint64_t uploaded_samples_count;
+};
+
+/**
+ * @struct time_series
+ * @brief Series of values sampled together and plotted as lines, the `x` axis being the index of the samples.
+ * The samples are appended to rings of `capacity` samples mirrored in a device local buffer, only the entries changed since their last upload are uploaded.
+ * Each draw picks the level of the pyramid with about one entry per pixel column, that is two vertices, whatever the count of samples shown,
+ * and draws every series with a single indirect draw
+ * @var time_series::engine
+ * Engine drawing the time series
+ * @var time_series::series_count
+ * Count of series, each sample holds one value per series
+ * @var time_series::capacity
+ * Count of samples kept per series, a power of two, the oldest samples being overwritten
+ * @var time_series::levels_count
+ * Count of levels of the pyramid, the last one holding one entry per series
+ * @var time_series::levels
+ * Levels of the pyramid, the level 0 holding the samples themselves
+ * @var time_series::pyramid
+ * Host copy of the entries of every level, read when their upload is recorded
+ * @var time_series::buffer
+ * Device local vertex buffer mirroring `pyramid`, its values are read one per vertex
+ * @var time_series::memory
+ * Memory bound to `buffer`
+ * @var time_series::samples_count
+ * Count of samples appended since the initialisation of the time series
+ * @var time_series::position
+ * Position in the world of the first sample ever appended, at value 0
+ * @var time_series::sample_size
+ * Distance in the world between two consecutive samples along `x`, and scale of the values along `y`
+ * @var time_series::colors
+ * Color of each series
+ * @var time_series::push_constant
+ * Push constant of the series pipeline: the model matrix maps the newest drawn entry to the world,
+ * `uv_rect` holds the count of samples per entry then `slots_count` and `texture_index` is the ring slot of the newest drawn entry
+ * @var time_series::level
+ * Level of the pyramid drawn on the next `engine_display()` call
+ * @var time_series::draws
+ * Draws of the visible entries, one per series and per contiguous part of their ring
+ * @var time_series::draws_count
+ * Count of draws in `draws`
+ */
+typedef struct time_series {
+    engine_t engine;
+    uint32_t series_count;
+    uint32_t capacity;
+    uint32_t levels_count;
+    struct time_series_level levels[TIME_SERIES_MAX_LEVELS_COUNT];
+    vec2 *pyramid;
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    uint64_t samples_count;
+    vec2 position;
+    vec2 sample_size;
+    vec4 *colors;
+    struct push_constant push_constant;
+
+    uint32_t level;
+    VkDrawIndirectCommand *draws;
+    uint32_t draws_count;
+} * time_series_t;
+
+/**
+ * @brief Initialise an empty time series and create its buffer, every series being white
+ *
+ * @param time_series Pointer to the time series to initialise
+ * @param engine Pointer to the engine drawing the time series
+ * @param series_count Count of series sampled together
+ * @param capacity Count of samples kept per series, rounded up to a power of two
+ * @param position Position in the world of the first sample, at value 0
+ * @param sample_size Distance in the world between two samples along `x`, and scale of the values along `y`
+ * @return true if the time series has been initialised
+ * @return false if its memory or its buffer couldn't be allocated
+ */
+bool time_series_init(time_series_t time_series, engine_t engine, uint32_t series_count, uint32_t capacity, vec2 position, vec2 sample_size);
+/**
+ * @brief Destroy the buffer and free the memory of a time series.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still draws it
+ *
+ * @param time_series Pointer to the time series to cleanup
+ */
+void time_series_cleanup(time_series_t time_series);
+/**
+ * @brief Append samples to a time series, updating every level of its pyramid. They are uploaded the next times they are drawn
+ *
+ * @param time_series Pointer to the time series
+ * @param values Pointer to `samples_count` samples of `series_count` values each, the values of a sample being consecutive
+ * @param samples_count Count of samples in `values`
+ */
+void time_series_append(time_series_t time_series, const float *values, uint32_t samples_count);
+/**
+ * @brief Set the color of a series
+ *
+ * @param time_series Pointer to the time series
+ * @param series Index of the series
+ * @param color New color of the series
+ */
+void time_series_set_color(time_series_t time_series, uint32_t series, vec4 color);
+/**
+ * @brief Add the samples of a time series visible from the camera to the next `engine_display()` call,
+ * time series are drawn on top of the objects and behind the shapes.
+ * The entries of the drawn level changed since their last upload are queued, up to `TIME_SERIES_MAX_UPLOAD_SIZE` bytes per frame
+ *
+ * @param engine Pointer to the engine where the time series will be drawn
+ * @param time_series Pointer to the time series, drawn once per frame however many times it is added
+ * @return true if the time series will be drawn
+ * @return false if `ENGINE_MAX_TIME_SERIES_TO_DRAW` time series are already drawn in this frame
+ */
+bool time_series_draw(engine_t engine, time_series_t time_series);
+/**
+ * @brief Getter for the input binding descriptions of the series pipeline, the values of the pyramid read once per vertex
+ * and the colors of the series read once per instance.
+ * If `time_series_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `time_series_binding_descriptions_count`.
+ * Otherwise populate the allocated array `time_series_binding_descriptions`
+ *
+ * @param time_series_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param time_series_binding_descriptions Pointer to an allocated array of `time_series_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void time_series_get_binding_description(uint32_t *time_series_binding_descriptions_count, VkVertexInputBindingDescription *time_series_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the series pipeline
+ * If `time_series_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `time_series_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `time_series_attribute_descriptions`
+ *
+ * @param time_series_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param time_series_attribute_descriptions Pointer to an allocated array of `time_series_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void time_series_get_attribute_description(uint32_t *time_series_attribute_descriptions_count, VkVertexInputAttributeDescription *time_series_attribute_descriptions);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
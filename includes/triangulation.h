@@ -0,0 +1,35 @@
+#ifndef _TRIANGULATION_H
+    #define _TRIANGULATION_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Triangulate a simple polygon, convex or concave, with optional holes.
+ * Uses ear clipping accelerated by a z-order curve hash of the vertices (the earcut algorithm), so that finding an ear only tests
+ * the vertices close to it, and bridges every hole to the outer ring before clipping. Both windings are accepted for every ring
+ * and the triangles are returned counter-clockwise. Degenerate or self-intersecting input still produces triangles, at best effort
+ * 
+ * @param allocator Pointer to the allocator used for the temporary nodes and the returned indices, NULL for the default allocator
+ * @param positions Pointer to an array of `vertices_count` positions, the outer ring followed by every hole ring
+ * @param vertices_count Count of positions in `positions`
+ * @param holes_starts Pointer to an array of `holes_count` indices in `positions` where each hole ring starts, in increasing order, NULL if there is no hole
+ * @param holes_count Count of holes
+ * @param indices Pointer where the allocated array of triangle indices is stored, to free with `allocator_free` under `ALLOCATOR_SUBSYSTEM_MESH`
+ * @param indices_count Pointer where the count of indices, a multiple of 3, is stored
+ * @return true if the polygon has been triangulated, `*indices_count` may be 0 for degenerate polygons
+ * @return false if the memory couldn't be allocated
+ */
+bool triangulate_polygon(allocator_t allocator, const vec2 *positions, uint32_t vertices_count, const uint32_t *holes_starts, uint32_t holes_count, uint32_t **indices, uint32_t *indices_count);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -5,6 +5,7 @@
     #include <stdlib.h>
     #include <stdint.h>
     #include <cglm/cglm.h>
+    #include "allocator.h"
     #ifdef _WIN32
         #include <Windows.h>
         #include <io.h>
@@ -27,6 +28,11 @@
     #define NONE 0
     #define PTR_OFFSET(ptr, offset) ((void *)(((char *)(ptr)) + (offset)))
     #define DEGREES_TO_RADIANS(x) ((x) * (M_PI / 180.f))
+    /**
+     * @def HASH_FNV1A_OFFSET_BASIS
+     * @brief Initial value to give to `hash_fnv1a()` when starting a new hash
+     */
+    #define HASH_FNV1A_OFFSET_BASIS 14695981039346656037ull
 
 #ifdef __cplusplus
 extern "C" {
@@ -79,14 +85,27 @@ int max_int(int val, int max);
 /**
  * @brief Read a file and store it's content into an allocated string
  * 
+ * @param allocator Pointer to the allocator used to allocate the string, it should be used to free it
  * @param file_name Absolute or relative path of the file to read
  * @param buffer_size Pointer to a unsigned int, storing the size of the buffer
+ * @param subsystem Subsystem the string is attributed to
  * @return An allocated string containing the content of a file
  */
-char *read_file(const char *file_name, uint32_t *buffer_size);
+char *read_file(allocator_t allocator, const char *file_name, uint32_t *buffer_size, enum allocator_subsystem subsystem);
 
 void find_circle_point(vec2 center, float radius, float degreesAngle, vec2 dest);
 
+/**
+ * @brief Hash a buffer using the 64-bit FNV-1a algorithm
+ * Hashes of multiple buffers can be chained by giving the previous result as `hash`
+ * 
+ * @param data Pointer to the data to hash
+ * @param size Size in bytes of `data`
+ * @param hash Current value of the hash, `HASH_FNV1A_OFFSET_BASIS` for a new hash
+ * @return The updated hash
+ */
+uint64_t hash_fnv1a(const void *data, size_t size, uint64_t hash);
+
 #ifdef __cplusplus
     }
 #endif
@@ -0,0 +1,422 @@
+#ifndef _VECTOR_CANVAS_H
+    #define _VECTOR_CANVAS_H
+
+    #include <stdbool.h>
+    #include <stdint.h>
+    #include <stdalign.h>
+    #include <vulkan/vulkan.h>
+    #include <cglm/cglm.h>
+    #include "allocator.h"
+    #include "vulkan/texture.h"
+    #include "vulkan/frame_allocator.h"
+
+    /**
+     * @def VECTOR_CANVAS_TILE_SIZE
+     * @brief Width and height in pixels of the screen tiles the paths are binned into, one compute workgroup rasterizing each tile
+     */
+    #define VECTOR_CANVAS_TILE_SIZE 16
+    /**
+     * @def VECTOR_CANVAS_WORKGROUP_SIZE
+     * @brief Count of threads of the workgroups binning the segments and summing the backdrops of the tile rows
+     */
+    #define VECTOR_CANVAS_WORKGROUP_SIZE 64
+    /**
+     * @def VECTOR_CANVAS_COARSE_SIZE
+     * @brief Width and height in screen tiles of the blocks the paths are culled against before listing the paths of each tile,
+     * one compute workgroup listing each block
+     */
+    #define VECTOR_CANVAS_COARSE_SIZE 16
+    /**
+     * @def VECTOR_CANVAS_MAX_CURVE_SEGMENTS
+     * @brief Maximum count of line segments a single curve is flattened into, whatever its size
+     */
+    #define VECTOR_CANVAS_MAX_CURVE_SEGMENTS 128
+    /**
+     * @def VECTOR_CANVAS_MAX_TILES_COUNT
+     * @brief Maximum count of tiles covered by the visible paths of a canvas in a frame, the paths past it are not drawn
+     */
+    #define VECTOR_CANVAS_MAX_TILES_COUNT (1 << 17)
+    /**
+     * @def VECTOR_CANVAS_MIN_NODES_COUNT
+     * @brief Minimum count of segment pieces binned per frame into the tiles of a canvas, it holds 4 pieces per segment otherwise.
+     * The pieces past it are dropped for the frame
+     */
+    #define VECTOR_CANVAS_MIN_NODES_COUNT (1 << 16)
+    /**
+     * @def VECTOR_CANVAS_MAX_COUNT
+     * @brief Maximum count of vector canvases alive at once
+     */
+    #define VECTOR_CANVAS_MAX_COUNT 16
+    /**
+     * @def VECTOR_CANVAS_MAX_UPLOAD_SIZE
+     * @brief Maximum size in bytes of the segments of a canvas uploaded per frame, staged through the transient memory of the frame.
+     * The paths whose segments aren't all uploaded yet are drawn from the next frames on
+     */
+    #define VECTOR_CANVAS_MAX_UPLOAD_SIZE (FRAME_ALLOCATOR_FRAME_SIZE / 4)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct engine * engine_t;
+
+/**
+ * @enum vector_fill_rule
+ * @brief Rule deciding from the winding number of a point whether it is inside a path
+ */
+enum vector_fill_rule {
+    VECTOR_FILL_RULE_NON_ZERO = 0,
+    VECTOR_FILL_RULE_EVEN_ODD
+};
+
+/**
+ * @struct vector_segment
+ * @brief Line segment of a flattened path, in canvas units, read by the binning shader
+ * @var vector_segment::from
+ * Start of the segment
+ * @var vector_segment::to
+ * End of the segment
+ * @var vector_segment::path
+ * Index of the path the segment belongs to
+ * @var vector_segment::padding
+ * Unused, keeps the layout of the shader
+ */
+struct vector_segment {
+    vec2 from;
+    vec2 to;
+    uint32_t path;
+    uint32_t padding;
+};
+
+/**
+ * @struct vector_path
+ * @brief Filled path of a canvas, made of the closed contours of consecutive segments
+ * @var vector_path::first_segment
+ * Index of the first segment of the path
+ * @var vector_path::segments_count
+ * Count of segments of the path
+ * @var vector_path::min
+ * Bottom left corner of the bounds of the path in canvas units
+ * @var vector_path::max
+ * Top right corner of the bounds of the path in canvas units
+ * @var vector_path::color
+ * Color the path is filled with, blended over the paths filled before it
+ * @var vector_path::fill_rule
+ * `enum vector_fill_rule` of the path
+ */
+struct vector_path {
+    uint32_t first_segment;
+    uint32_t segments_count;
+    vec2 min;
+    vec2 max;
+    vec4 color;
+    enum vector_fill_rule fill_rule;
+};
+
+/**
+ * @struct vector_path_tiles
+ * @brief Rectangle of screen tiles covered by a path in a frame, read by every pass of the rasterizer
+ * @var vector_path_tiles::x
+ * Column of the left tiles of the rectangle
+ * @var vector_path_tiles::y
+ * Row of the top tiles of the rectangle
+ * @var vector_path_tiles::width
+ * Count of columns of the rectangle, 0 when the path is not visible
+ * @var vector_path_tiles::height
+ * Count of rows of the rectangle, 0 when the path is not visible
+ * @var vector_path_tiles::first_tile
+ * Index of the top left tile of the rectangle in the tiles of the frame, the tiles following row after row
+ * @var vector_path_tiles::first_row
+ * Index of the top row of the rectangle in the rows of every path of the frame
+ * @var vector_path_tiles::fill_rule
+ * `enum vector_fill_rule` of the path
+ * @var vector_path_tiles::padding
+ * Unused, keeps the layout of the shader
+ * @var vector_path_tiles::color
+ * Color of the path
+ */
+struct vector_path_tiles {
+    int32_t x;
+    int32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t first_tile;
+    uint32_t first_row;
+    uint32_t fill_rule;
+    uint32_t padding;
+    vec4 color;
+};
+
+/**
+ * @struct vector_tile
+ * @brief Screen tile covered by a path, written by the binning pass and read by the raster pass
+ * @var vector_tile::backdrop
+ * Winding number of the path at the top left corner of the tile, summed from the crossings of the segments at its left
+ * @var vector_tile::head
+ * Index of the last segment piece binned into the tile, 0 when it has none
+ * @var vector_tile::path
+ * Index of the path of the tile, written when the tile is listed in its screen tile
+ * @var vector_tile::next
+ * Index plus one of the tile of the next path covering the same screen tile, 0 for the last one
+ */
+struct vector_tile {
+    int32_t backdrop;
+    uint32_t head;
+    uint32_t path;
+    uint32_t next;
+};
+
+/**
+ * @struct vector_node
+ * @brief Segment piece binned into a tile, in pixels, the pieces of a tile being chained from its head
+ * @var vector_node::from
+ * Start of the segment in pixels
+ * @var vector_node::to
+ * End of the segment in pixels
+ * @var vector_node::next
+ * Index of the previous piece binned into the same tile, 0 for the first one.
+ * The first node of the buffer only counts the allocated pieces
+ * @var vector_node::padding
+ * Unused, keeps the layout of the shader
+ */
+struct vector_node {
+    vec2 from;
+    vec2 to;
+    uint32_t next;
+    uint32_t padding;
+};
+
+/**
+ * @struct vector_push_constant
+ * @brief Push constant of the compute passes of the rasterizer
+ * @var vector_push_constant::transform
+ * Matrix from canvas units to clip space
+ * @var vector_push_constant::size
+ * Width and height in pixels of the image the paths are rasterized into
+ * @var vector_push_constant::columns_count
+ * Count of tile columns of the image
+ * @var vector_push_constant::paths_count
+ * Count of paths drawn, the first ones of the canvas
+ * @var vector_push_constant::segments_count
+ * Count of segments of the drawn paths
+ * @var vector_push_constant::rows_count
+ * Count of tile rows of every visible path
+ * @var vector_push_constant::nodes_capacity
+ * Count of segment pieces the tiles can hold, the first one being the allocation counter
+ * @var vector_push_constant::padding
+ * Unused, keeps the layout of the shader
+ */
+struct vector_push_constant {
+    alignas(16) mat4 transform;
+    vec2 size;
+    uint32_t columns_count;
+    uint32_t paths_count;
+    uint32_t segments_count;
+    uint32_t rows_count;
+    uint32_t nodes_capacity;
+    uint32_t padding;
+};
+
+/**
+ * @struct vector_canvas
+ * @brief Filled Bézier paths rasterized with analytic coverage by compute shaders, then composited over the frame.
+ * Curves are flattened into line segments once, when the paths are built, and the segments are uploaded once.
+ * Every frame the CPU only bounds each path in screen tiles, the GPU bins the segments into the tiles they cross,
+ * sums the winding numbers at the tile edges, lists the paths covering each screen tile
+ * and computes the coverage of every pixel from the segments of the paths of its screen tile
+ * @var vector_canvas::engine
+ * Engine drawing the canvas
+ * @var vector_canvas::tolerance
+ * Maximum distance in canvas units between a curve and the segments it is flattened into
+ * @var vector_canvas::model
+ * Model matrix placing the canvas in the world, the canvas lying in its `z = 0` plane
+ * @var vector_canvas::paths
+ * Filled paths, drawn in order
+ * @var vector_canvas::paths_count
+ * Count of filled paths
+ * @var vector_canvas::paths_capacity
+ * Maximum count of paths
+ * @var vector_canvas::segments
+ * Segments of the filled paths then of the path being built
+ * @var vector_canvas::segments_count
+ * Count of segments in `segments`
+ * @var vector_canvas::segments_capacity
+ * Maximum count of segments
+ * @var vector_canvas::path_first_segment
+ * First segment of the path being built
+ * @var vector_canvas::subpath_start
+ * Start of the contour being built, joined by `vector_canvas_close()`
+ * @var vector_canvas::pen
+ * End of the last segment of the contour being built
+ * @var vector_canvas::has_subpath
+ * Whether a contour is being built
+ * @var vector_canvas::is_path_dropped
+ * Whether a segment of the path being built didn't fit, the path being dropped by the next `vector_canvas_fill()` call
+ * @var vector_canvas::uploaded_segments_count
+ * Count of first segments already queued for upload
+ * @var vector_canvas::segments_buffer
+ * Device local storage buffer mirroring `segments`
+ * @var vector_canvas::segments_memory
+ * Memory bound to `segments_buffer`
+ * @var vector_canvas::scratch_buffer
+ * Device local storage buffer holding the rectangles of the paths, then the tiles, then the segment pieces binned into them
+ * @var vector_canvas::scratch_memory
+ * Memory bound to `scratch_buffer`
+ * @var vector_canvas::tiles_offset
+ * Offset in bytes of the tiles in `scratch_buffer`
+ * @var vector_canvas::nodes_offset
+ * Offset in bytes of the segment pieces in `scratch_buffer`
+ * @var vector_canvas::nodes_capacity
+ * Count of segment pieces `scratch_buffer` holds
+ * @var vector_canvas::coarse_buffer
+ * Device local storage buffer holding, for every screen tile of the target, the index plus one of the first tile listed in it
+ * @var vector_canvas::coarse_memory
+ * Memory bound to `coarse_buffer`
+ * @var vector_canvas::target
+ * Storage texture the paths are rasterized into, sized like the swapchain
+ * @var vector_canvas::descriptor_set
+ * Descriptor set of the compute passes, pointing at the buffers and the target of the canvas
+ * @var vector_canvas::path_tiles
+ * Rectangles of screen tiles of the drawn paths, copied to `scratch_buffer` when the frame is recorded
+ * @var vector_canvas::tiles_count
+ * Count of tiles of the drawn paths, 0 when nothing is rasterized in the next frame
+ * @var vector_canvas::push_constant
+ * Push constant of the compute passes of the next frame
+ */
+typedef struct vector_canvas {
+    engine_t engine;
+    float tolerance;
+    mat4 model;
+
+    struct vector_path *paths;
+    uint32_t paths_count;
+    uint32_t paths_capacity;
+    struct vector_segment *segments;
+    uint32_t segments_count;
+    uint32_t segments_capacity;
+
+    uint32_t path_first_segment;
+    vec2 subpath_start;
+    vec2 pen;
+    bool has_subpath;
+    bool is_path_dropped;
+
+    uint32_t uploaded_segments_count;
+    VkBuffer segments_buffer;
+    VkDeviceMemory segments_memory;
+    VkBuffer scratch_buffer;
+    VkDeviceMemory scratch_memory;
+    VkDeviceSize tiles_offset;
+    VkDeviceSize nodes_offset;
+    uint32_t nodes_capacity;
+    VkBuffer coarse_buffer;
+    VkDeviceMemory coarse_memory;
+    struct texture target;
+    VkDescriptorSet descriptor_set;
+
+    struct vector_path_tiles *path_tiles;
+    uint32_t tiles_count;
+    struct vector_push_constant push_constant;
+} * vector_canvas_t;
+
+/**
+ * @brief Initialise an empty vector canvas, create its buffers and its target
+ *
+ * @param canvas Pointer to the canvas to initialise
+ * @param engine Pointer to the engine drawing the canvas
+ * @param paths_capacity Maximum count of paths of the canvas
+ * @param segments_capacity Maximum count of line segments of the canvas, each curve being flattened into several ones
+ * @param tolerance Maximum distance in canvas units between a curve and its segments
+ * @return true if the canvas has been initialised
+ * @return false if its memory, its buffers, its target or its descriptor set couldn't be allocated
+ */
+bool vector_canvas_init(vector_canvas_t canvas, engine_t engine, uint32_t paths_capacity, uint32_t segments_capacity, float tolerance);
+/**
+ * @brief Destroy the buffers, the target and free the memory of a canvas.
+ * You should call `engine_wait_idle` beforehand to make sure no frame still draws it
+ *
+ * @param canvas Pointer to the canvas to cleanup
+ */
+void vector_canvas_cleanup(vector_canvas_t canvas);
+/**
+ * @brief Remove every path of a canvas, including the one being built
+ *
+ * @param canvas Pointer to the canvas
+ */
+void vector_canvas_clear(vector_canvas_t canvas);
+/**
+ * @brief Start a new contour of the path being built, closing the previous one
+ *
+ * @param canvas Pointer to the canvas
+ * @param point Start of the contour
+ * @return true if the contour has been started
+ * @return false if the path is dropped
+ */
+bool vector_canvas_move_to(vector_canvas_t canvas, vec2 point);
+/**
+ * @brief Add a line to the contour being built, starting a contour at `point` if there is none
+ *
+ * @param canvas Pointer to the canvas
+ * @param point End of the line
+ * @return true if the line has been added
+ * @return false if the canvas holds `segments_capacity` segments, the path then being dropped
+ */
+bool vector_canvas_line_to(vector_canvas_t canvas, vec2 point);
+/**
+ * @brief Add a quadratic Bézier curve to the contour being built, flattened within the tolerance of the canvas.
+ * Without a contour being built, a contour is only started at `point`
+ *
+ * @param canvas Pointer to the canvas
+ * @param control Control point of the curve
+ * @param point End of the curve
+ * @return true if the curve has been added
+ * @return false if its segments don't fit in the canvas, the path then being dropped
+ */
+bool vector_canvas_quadratic_to(vector_canvas_t canvas, vec2 control, vec2 point);
+/**
+ * @brief Add a cubic Bézier curve to the contour being built, flattened within the tolerance of the canvas.
+ * Without a contour being built, a contour is only started at `point`
+ *
+ * @param canvas Pointer to the canvas
+ * @param control0 First control point of the curve
+ * @param control1 Second control point of the curve
+ * @param point End of the curve
+ * @return true if the curve has been added
+ * @return false if its segments don't fit in the canvas, the path then being dropped
+ */
+bool vector_canvas_cubic_to(vector_canvas_t canvas, vec2 control0, vec2 control1, vec2 point);
+/**
+ * @brief Close the contour being built with a line back to its start
+ *
+ * @param canvas Pointer to the canvas
+ * @return true if the contour has been closed
+ * @return false if the closing line doesn't fit in the canvas, the path then being dropped
+ */
+bool vector_canvas_close(vector_canvas_t canvas);
+/**
+ * @brief Close the contours of the path being built and add it to the canvas, on top of the paths filled before it
+ *
+ * @param canvas Pointer to the canvas
+ * @param color Color of the path
+ * @param fill_rule Rule deciding which points are inside the path
+ * @return true if the path has been added, or had no segment
+ * @return false if the canvas holds `paths_capacity` paths or if the path has been dropped
+ */
+bool vector_canvas_fill(vector_canvas_t canvas, vec4 color, enum vector_fill_rule fill_rule);
+/**
+ * @brief Add a canvas to the next `engine_display()` call, canvases are rasterized before the rendering begins
+ * and composited on top of the time series and behind the shapes.
+ * The segments not uploaded yet are queued, up to `VECTOR_CANVAS_MAX_UPLOAD_SIZE` bytes per frame
+ *
+ * @param engine Pointer to the engine where the canvas will be drawn
+ * @param canvas Pointer to the canvas, drawn once per frame however many times it is added
+ * @return true if the canvas will be drawn
+ * @return false if `ENGINE_MAX_VECTOR_CANVASES_TO_DRAW` canvases are already drawn in this frame, or if its target couldn't be resized
+ */
+bool vector_canvas_draw(engine_t engine, vector_canvas_t canvas);
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
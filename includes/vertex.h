@@ -5,6 +5,12 @@
     #include <cglm/cglm.h>
     #include <stddef.h>
 
+    /**
+     * @def BATCHED_VERTEX_ATTRIBUTE_DESCRIPTIONS_COUNT
+     * @brief Count of vertex attributes read by the dynamic batch pipelines from a `struct batched_vertex`
+     */
+    #define BATCHED_VERTEX_ATTRIBUTE_DESCRIPTIONS_COUNT 4
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -14,14 +20,33 @@ extern "C" {
  * @brief Structure representing a vertex
  * @var vertex::pos
  * Position of the vertex in a 2D space
- * @var vertex::color
- * RGB color of the vertex from 0.0f to 1.0f
+ * @var vertex::uv
+ * Texture coordinates of the vertex in the texture region of its object, (0, 0) at the bottom left and (1, 1) at the top right of the region
  */
 typedef struct vertex {
     vec2 pos;
-    vec3 color;
+    vec2 uv;
 } * vertex_t;
 
+/**
+ * @struct batched_vertex
+ * @brief Vertex of a dynamic batch, small objects already transformed by their model matrix and carrying what they would push as constants
+ * @var batched_vertex::position
+ * Position of the vertex in world space
+ * @var batched_vertex::color
+ * Color of the object of the vertex
+ * @var batched_vertex::uv
+ * Texture coordinates of the vertex, already mapped in the texture region of its object
+ * @var batched_vertex::texture_index
+ * Index in the bindless texture array of the texture of the object of the vertex
+ */
+struct batched_vertex {
+    vec4 position;
+    vec4 color;
+    vec2 uv;
+    uint32_t texture_index;
+};
+
 /**
  * @brief Getter for the input binding descriptions of the vertex structure
  * If `vertex_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `vertex_binding_descriptions_count`.
@@ -42,6 +67,25 @@ void vertex_get_binding_description(uint32_t *vertex_binding_descriptions_count,
  */
 void vertex_get_attribute_description(uint32_t *vertex_attribute_descriptions_count, VkVertexInputAttributeDescription *vertex_attribute_descriptions);
 
+/**
+ * @brief Getter for the input binding descriptions of the batched vertex structure
+ * If `batched_vertex_binding_descriptions` is `NULL` returns the total number of input binding descriptions in `batched_vertex_binding_descriptions_count`.
+ * Otherwise populate the allocated array `batched_vertex_binding_descriptions`
+ * 
+ * @param batched_vertex_binding_descriptions_count Pointer to an unsigned int where the total count of input binding descriptions will be stored
+ * @param batched_vertex_binding_descriptions Pointer to an allocated array of `batched_vertex_binding_descriptions_count` * sizeof(VkVertexInputBindingDescription) where the input binding descriptions will be stored
+ */
+void batched_vertex_get_binding_description(uint32_t *batched_vertex_binding_descriptions_count, VkVertexInputBindingDescription *batched_vertex_binding_descriptions);
+/**
+ * @brief Getter for the input attribute descriptions of the batched vertex structure
+ * If `batched_vertex_attribute_descriptions` is `NULL` returns the total number of input attribute descriptions in `batched_vertex_attribute_descriptions_count`.
+ * Otherwise populate the allocated array `batched_vertex_attribute_descriptions`
+ * 
+ * @param batched_vertex_attribute_descriptions_count Pointer to an unsigned int where the total count of input attribute descriptions will be stored
+ * @param batched_vertex_attribute_descriptions Pointer to an allocated array of `batched_vertex_attribute_descriptions_count` * sizeof(VkVertexInputAttributeDescription) where the input attribute descriptions will be stored
+ */
+void batched_vertex_get_attribute_description(uint32_t *batched_vertex_attribute_descriptions_count, VkVertexInputAttributeDescription *batched_vertex_attribute_descriptions);
+
 #ifdef __cplusplus
     }
 #endif
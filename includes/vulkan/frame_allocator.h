@@ -0,0 +1,105 @@
+#ifndef _FRAME_ALLOCATOR_H
+#define _FRAME_ALLOCATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+/**
+ * @def FRAME_ALLOCATOR_FRAME_SIZE
+ * @brief Size in bytes of the transient memory available to each frame in flight
+ */
+#define FRAME_ALLOCATOR_FRAME_SIZE (4 * 1024 * 1024)
+/**
+ * @def FRAME_ALLOCATOR_UNIFORM_ALIGNMENT
+ * @brief Alignment to request for blocks read as uniform or storage buffers, replaced by the device's minimal offset alignment
+ */
+#define FRAME_ALLOCATOR_UNIFORM_ALIGNMENT 0
+/**
+ * @def FRAME_ALLOCATOR_DEFAULT_PARAMETERS
+ * @brief Offset of a draw command using the default draw parameters, identity transform and white color
+ */
+#define FRAME_ALLOCATOR_DEFAULT_PARAMETERS UINT32_MAX
+/**
+ * @def FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT
+ * @brief Maximum count of buffer updates queued between two frames
+ */
+#define FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct frame_allocator
+ * @brief Linear allocator over a persistently mapped buffer split in one region per frame in flight.
+ * A region is reset once the fence of its frame signals, allocating is a single offset bump
+ * @var frame_allocator::buffer
+ * Buffer usable as vertex, index, uniform and storage buffer holding every region
+ * @var frame_allocator::memory
+ * Host visible and coherent memory of the buffer
+ * @var frame_allocator::mapped
+ * Pointer to the persistently mapped memory of the buffer
+ * @var frame_allocator::frame_size
+ * Size in bytes of the region of each frame in flight
+ * @var frame_allocator::frame_start
+ * Offset of the region of the current frame in the buffer
+ * @var frame_allocator::offset
+ * Offset of the next free byte in the buffer
+ * @var frame_allocator::uniform_alignment
+ * Minimal offset alignment of uniform and storage buffers of the device
+ * @var frame_allocator::frame_begun
+ * Boolean telling if the region of the current frame has been waited for and reset
+ */
+typedef struct frame_allocator {
+    VkBuffer buffer;
+    VkDeviceMemory memory;
+    void *mapped;
+
+    VkDeviceSize frame_size;
+    VkDeviceSize frame_start;
+    VkDeviceSize offset;
+    VkDeviceSize uniform_alignment;
+    bool frame_begun;
+} * frame_allocator_t;
+
+/**
+ * @struct frame_allocation
+ * @brief Block of transient memory valid until the end of the frame it was allocated for
+ * @var frame_allocation::buffer
+ * Buffer the block belongs to, to bind as vertex, index, uniform or storage buffer
+ * @var frame_allocation::offset
+ * Offset of the block in `buffer`, to use as bind offset or dynamic offset
+ * @var frame_allocation::data
+ * Pointer to the mapped memory of the block, the written data is visible to the GPU without flush
+ */
+typedef struct frame_allocation {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    void *data;
+} * frame_allocation_t;
+
+/**
+ * @struct buffer_update
+ * @brief Range of a device local buffer copied at the start of the next recorded frame, staged through the frame allocator
+ * @var buffer_update::buffer
+ * Buffer to update
+ * @var buffer_update::offset
+ * Offset in bytes of the range in `buffer`
+ * @var buffer_update::data
+ * Pointer to the new content of the range in host memory, read when the frame is recorded
+ * @var buffer_update::size
+ * Size in bytes of the range
+ */
+struct buffer_update {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+    const void *data;
+    VkDeviceSize size;
+};
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
@@ -11,10 +11,20 @@ extern "C" {
 struct uniform_buffer {
     alignas(16) mat4 view;
     alignas(16) mat4 proj;
+    alignas(16) vec4 viewport;
 };
 
 struct push_constant {
     alignas(16) mat4 model;
+    alignas(16) vec4 color;
+    alignas(16) vec4 uv_rect;
+    uint32_t texture_index;
+};
+
+struct draw_parameters {
+    alignas(16) mat4 transform;
+    alignas(16) vec4 color;
+    alignas(16) vec4 parameters;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,86 @@
+#ifndef _TEXTURE_H
+#define _TEXTURE_H
+
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+/**
+ * @def TEXTURE_MAX_COUNT
+ * @brief Size of the bindless texture array, the maximum count of textures alive at once
+ */
+#define TEXTURE_MAX_COUNT 4096
+/**
+ * @def TEXTURE_MAX_UPDATES_COUNT
+ * @brief Maximum count of texture updates queued between two frames
+ */
+#define TEXTURE_MAX_UPDATES_COUNT 32
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct texture
+ * @brief Sampled 2D image with a single mip level in device local memory
+ * @var texture::image
+ * Image of the texture
+ * @var texture::memory
+ * Device local memory bound to the image
+ * @var texture::view
+ * View of the whole image, written in the descriptor sets
+ * @var texture::index
+ * Element of the bindless texture array the texture is written in, given to the shaders by the objects drawn with it
+ * @var texture::format
+ * Format of the texels
+ * @var texture::width
+ * Width of the texture in texels
+ * @var texture::height
+ * Height of the texture in texels
+ * @var texture::layout
+ * Layout of the image after the last recorded command buffer, `VK_IMAGE_LAYOUT_UNDEFINED` until its first update.
+ * A texture must be fully updated once before it is sampled
+ */
+typedef struct texture {
+    VkImage image;
+    VkDeviceMemory memory;
+    VkImageView view;
+    uint32_t index;
+    VkFormat format;
+    uint32_t width;
+    uint32_t height;
+    VkImageLayout layout;
+} * texture_t;
+
+/**
+ * @struct texture_update
+ * @brief Rectangle of texels copied into a texture at the start of the next recorded frame, through the frame allocator
+ * @var texture_update::texture
+ * Texture to update
+ * @var texture_update::pixels
+ * Pointer to the first texel of the rectangle in host memory, read when the frame is recorded
+ * @var texture_update::x
+ * Left of the rectangle in the texture
+ * @var texture_update::y
+ * Top of the rectangle in the texture
+ * @var texture_update::width
+ * Width of the rectangle
+ * @var texture_update::height
+ * Height of the rectangle
+ * @var texture_update::row_length
+ * Count of texels between two rows of `pixels`
+ */
+struct texture_update {
+    texture_t texture;
+    const void *pixels;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t row_length;
+};
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif
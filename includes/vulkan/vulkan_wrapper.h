@@ -17,9 +17,22 @@
 
     #include "../surfaces/window.h"
     #include "../utils.h"
+    #include "../allocator.h"
     #include "vulkan_extension_wrapper.h"
+    #include "frame_allocator.h"
+    #include "texture.h"
     #include "../vertex.h"
+    #include "../geometry.h"
+    #include "../mesh.h"
     #include "../object.h"
+    #include "../shape.h"
+    #include "../quad_batch.h"
+    #include "../text.h"
+    #include "../tilemap.h"
+    #include "../point_cloud.h"
+    #include "../time_series.h"
+    #include "../vector_canvas.h"
+    #include "../streaming_texture.h"
     #include "../camera.h"
 
 #ifdef DEBUG
@@ -31,7 +44,27 @@ extern const char *validation_layers[];
 #define QUEUE_FAMILY_INDICE_DEFAULT 0
 #define SHADER_VERTEX_ENTRY_POINT "vertMain"
 #define SHADER_FRAGMENT_ENTRY_POINT "fragMain"
+#define SHADER_TEXTURED_FRAGMENT_ENTRY_POINT "texturedFragMain"
+#define SHADER_BATCHED_VERTEX_ENTRY_POINT "batchedVertMain"
+#define SHADER_SHAPE_VERTEX_ENTRY_POINT "shapeVertMain"
+#define SHADER_SHAPE_FRAGMENT_ENTRY_POINT "shapeFragMain"
+#define SHADER_QUAD_VERTEX_ENTRY_POINT "quadVertMain"
+#define SHADER_TEXT_VERTEX_ENTRY_POINT "textVertMain"
+#define SHADER_TEXT_FRAGMENT_ENTRY_POINT "textFragMain"
+#define SHADER_TILE_VERTEX_ENTRY_POINT "tileVertMain"
+#define SHADER_TILE_FRAGMENT_ENTRY_POINT "tileFragMain"
+#define SHADER_POINT_VERTEX_ENTRY_POINT "pointVertMain"
+#define SHADER_POINT_SPRITE_VERTEX_ENTRY_POINT "pointSpriteVertMain"
+#define SHADER_POINT_FRAGMENT_ENTRY_POINT "pointFragMain"
+#define SHADER_SERIES_VERTEX_ENTRY_POINT "seriesVertMain"
+#define SHADER_OBJECT_POINT_VERTEX_ENTRY_POINT "objectPointVertMain"
+#define SHADER_VECTOR_BIN_ENTRY_POINT "vectorBinMain"
+#define SHADER_VECTOR_BACKDROP_ENTRY_POINT "vectorBackdropMain"
+#define SHADER_VECTOR_COARSE_ENTRY_POINT "vectorCoarseMain"
+#define SHADER_VECTOR_RASTER_ENTRY_POINT "vectorRasterMain"
+#define SHADER_VECTOR_VERTEX_ENTRY_POINT "vectorVertMain"
 #define MAX_FRAMES_IN_FLIGHT 2
+#define VECTOR_DESCRIPTOR_BINDINGS_COUNT 6
 
 #ifdef _WIN32
     #define SHADER_FILE_PATH "C:/Program Files (x86)/AntaGL/share/AntaGL/shaders/slang.spv"
@@ -48,7 +81,44 @@ struct queue_family_indices {
     uint32_t present;
 };
 
+struct pipeline_description {
+    const char *vertex_entry_point;
+    const char *fragment_entry_point;
+    const VkPipelineVertexInputStateCreateInfo *vertex_input;
+    VkPrimitiveTopology topology;
+    VkCullModeFlags cull_mode;
+    bool blend_enable;
+    bool dynamic_topology;
+};
+
+struct draw_command {
+    object_t object;
+    uint32_t parameters_offset;
+    uint32_t lod;
+};
+
+// Everything drawn in a frame, the arrays are read while the frame is recorded only
+struct draw_lists {
+    struct draw_command *draw_commands;
+    uint32_t draw_commands_count;
+    tilemap_t *tilemaps;
+    uint32_t tilemaps_count;
+    point_cloud_t *point_clouds;
+    uint32_t point_clouds_count;
+    time_series_t *time_series;
+    uint32_t time_series_count;
+    vector_canvas_t *vector_canvases;
+    uint32_t vector_canvases_count;
+    struct shape *shapes;
+    uint32_t shapes_count;
+    const struct quad_batch *quads;
+    const struct quad_batch *text;
+};
+
 typedef struct vulkan_context {
+    allocator_t allocator;
+    VkAllocationCallbacks allocation_callbacks;
+
     VkInstance instance;
     VkDebugUtilsMessengerEXT debug_messenger;
     VkPhysicalDevice physical_device;
@@ -59,6 +129,32 @@ typedef struct vulkan_context {
     VkSwapchainKHR swapchain;
     VkPipelineLayout pipeline_layout;
     VkPipeline graphic_pipeline;
+    VkPipeline textured_pipeline;
+    // Objects whose mesh is made of lines or points, the triangle ones being drawn by graphic_pipeline and textured_pipeline
+    VkPipeline line_pipeline;
+    VkPipeline textured_line_pipeline;
+    VkPipeline object_point_pipeline;
+    VkPipeline textured_object_point_pipeline;
+    VkPipeline batched_pipeline;
+    VkPipeline batched_textured_pipeline;
+    VkPipeline shape_pipeline;
+    VkPipeline quad_pipeline;
+    VkPipeline text_pipeline;
+    VkPipeline tile_pipeline;
+    VkPipeline point_pipeline;
+    VkPipeline point_sprite_pipeline;
+    // Largest points the device draws, 1 without the largePoints feature
+    float max_point_size;
+    VkPipeline series_pipeline;
+    // Whether a single indirect draw can hold every series of a time series, each one starting at its own instance
+    bool multi_draw_indirect;
+    // Compute passes rasterizing the vector canvases into their target, then the pipeline compositing the targets over the frame
+    VkPipelineLayout vector_pipeline_layout;
+    VkPipeline vector_bin_pipeline;
+    VkPipeline vector_backdrop_pipeline;
+    VkPipeline vector_coarse_pipeline;
+    VkPipeline vector_raster_pipeline;
+    VkPipeline vector_composite_pipeline;
     VkCommandPool command_pool;
     VkCommandBuffer *command_buffers;
     VkViewport viewport;
@@ -68,10 +164,31 @@ typedef struct vulkan_context {
     VkDescriptorSetLayout descriptor_set_layout;
     VkDescriptorPool descriptor_pool;
     VkDescriptorSet *descriptor_sets;
+    VkDescriptorSetLayout texture_descriptor_set_layout;
+    VkDescriptorPool texture_descriptor_pool;
+    VkDescriptorSet texture_descriptor_set;
+    VkDescriptorSetLayout vector_descriptor_set_layout;
+    VkDescriptorPool vector_descriptor_pool;
+    uint32_t texture_free_indices[TEXTURE_MAX_COUNT];
+    uint32_t texture_free_indices_count;
+    VkSampler sampler;
+    texture_t glyph_atlas_texture;
+    struct texture_update texture_updates[TEXTURE_MAX_UPDATES_COUNT];
+    uint32_t texture_updates_count;
+    streaming_texture_t streaming_textures[STREAMING_TEXTURE_MAX_COUNT];
+    uint32_t streaming_textures_count;
+    struct buffer_update buffer_updates[FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT];
+    uint32_t buffer_updates_count;
 
     VkBuffer *uniform_buffers;
     VkDeviceMemory *uniform_buffers_memory;
     void **uniform_buffers_mapped;
+    mat4 view;
+    mat4 proj;
+
+    struct frame_allocator frame_allocator;
+    uint32_t dynamic_batches_count;
+    uint32_t dynamic_batched_objects_count;
 
     struct queue_family_indices queue_family_indices;
     VkQueue graphic_queue;
@@ -87,9 +204,12 @@ typedef struct vulkan_context {
     struct vulkan_extensions_functions vulkan_extensions_functions;
 } * vulkan_context_t;
 
-bool vulkan_draw_frame(vulkan_context_t vulkan_context, window_t window, object_t *objects, uint32_t objects_count);
+bool vulkan_draw_frame(vulkan_context_t vulkan_context, window_t window, const struct draw_lists *draw_lists, uint32_t dynamic_batch_threshold);
+void vulkan_begin_frame(vulkan_context_t context);
+bool vulkan_frame_allocate(vulkan_context_t context, VkDeviceSize size, VkDeviceSize alignment, frame_allocation_t allocation);
 
 bool vulkan_init(vulkan_context_t vulkan_context,
+    allocator_t allocator,
     surface_context_t surface_context,
     window_t window,
     const char *engine_name,
@@ -98,8 +218,25 @@ bool vulkan_init(vulkan_context_t vulkan_context,
     uint32_t application_version);
 
 void vulkan_cleanup(vulkan_context_t vulkan_context);
-bool vulkan_create_vertex_buffer(vulkan_context_t context, object_t object, struct vertex *vertices, uint32_t vertices_count);
-bool vulkan_create_index_buffer(vulkan_context_t context, object_t object, uint16_t *indices, uint32_t indices_count);
+bool vulkan_create_vertex_buffer(vulkan_context_t context, mesh_t mesh, struct vertex *vertices, uint32_t vertices_count);
+bool vulkan_create_index_buffer(vulkan_context_t context, mesh_t mesh, uint32_t *indices, uint32_t indices_count, uint32_t vertices_count);
+bool vulkan_create_texture(vulkan_context_t context, uint32_t width, uint32_t height, VkFormat format, texture_t texture);
+bool vulkan_create_storage_texture(vulkan_context_t context, uint32_t width, uint32_t height, VkFormat format, texture_t texture);
+void vulkan_destroy_texture(vulkan_context_t context, texture_t texture);
+bool vulkan_upload_texture(vulkan_context_t context, texture_t texture, const void *pixels);
+bool vulkan_queue_texture_update(vulkan_context_t context, texture_t texture, const void *pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t row_length);
+void vulkan_set_glyph_atlas_texture(vulkan_context_t context, texture_t texture);
+uint32_t vulkan_get_texel_size(VkFormat format);
+bool vulkan_add_streaming_texture(vulkan_context_t context, streaming_texture_t streaming_texture);
+void vulkan_remove_streaming_texture(vulkan_context_t context, streaming_texture_t streaming_texture);
+bool vulkan_create_instance_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory);
+bool vulkan_create_storage_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory);
+bool vulkan_create_staging_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, void **mapped);
+bool vulkan_queue_buffer_update(vulkan_context_t context, VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size);
+void vulkan_cancel_buffer_updates(vulkan_context_t context, VkBuffer buffer);
+bool vulkan_allocate_vector_descriptor_set(vulkan_context_t context, VkDescriptorSet *descriptor_set);
+void vulkan_free_vector_descriptor_set(vulkan_context_t context, VkDescriptorSet descriptor_set);
+void vulkan_write_vector_descriptor_set(vulkan_context_t context, vector_canvas_t canvas);
 
 void vulkan_update_proj(vulkan_context_t context, camera_t camera);
 void vulkan_update_view(vulkan_context_t context, camera_t camera);
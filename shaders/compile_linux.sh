@@ -1 +1 @@
-$HOME/VulkanSDK/1.4.309.0/x86_64/bin/slangc shader.slang -target spirv -profile spirv_1_4 -emit-spirv-directly -fvk-use-entrypoint-name -entry vertMain -entry fragMain -o slang.spv
+$HOME/VulkanSDK/1.4.309.0/x86_64/bin/slangc shader.slang -target spirv -profile spirv_1_4 -emit-spirv-directly -fvk-use-entrypoint-name -entry vertMain -entry fragMain -entry texturedFragMain -entry batchedVertMain -entry shapeVertMain -entry shapeFragMain -entry quadVertMain -entry textVertMain -entry textFragMain -entry tileVertMain -entry tileFragMain -entry pointVertMain -entry pointSpriteVertMain -entry pointFragMain -entry seriesVertMain -entry objectPointVertMain -entry vectorBinMain -entry vectorBackdropMain -entry vectorCoarseMain -entry vectorRasterMain -entry vectorVertMain -o slang.spv
@@ -0,0 +1,198 @@
+#include "allocator.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+
+#define ALLOCATOR_DEFAULT_ALIGNMENT alignof(max_align_t)
+
+/*
+    Header stored right before every block of the default allocator,
+    malloc can't align beyond max_align_t so the block is over-allocated and aligned by hand
+*/
+struct allocator_header {
+    void *base;
+    size_t size;
+};
+
+static struct allocator_header *allocator_get_header(void *memory)
+{
+    return (struct allocator_header *) memory - 1;
+}
+
+static void *allocator_default_allocate(void *user_data, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    if (alignment < ALLOCATOR_DEFAULT_ALIGNMENT)
+        alignment = ALLOCATOR_DEFAULT_ALIGNMENT;
+
+    char *base = malloc(size + alignment + sizeof(struct allocator_header));
+    if (!base)
+        return NULL;
+
+    uintptr_t memory = ((uintptr_t) (base + sizeof(struct allocator_header)) + alignment - 1) & ~((uintptr_t) alignment - 1);
+    struct allocator_header *header = allocator_get_header((void *) memory);
+
+    header->base = base;
+    header->size = size;
+    return (void *) memory;
+}
+
+static void allocator_default_deallocate(void *user_data, void *memory, enum allocator_subsystem subsystem)
+{
+    free(allocator_get_header(memory)->base);
+}
+
+static void *allocator_default_reallocate(void *user_data, void *memory, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    void *new_memory = allocator_default_allocate(user_data, size, alignment, subsystem);
+    size_t old_size = allocator_get_header(memory)->size;
+
+    if (!new_memory)
+        return NULL;
+
+    memcpy(new_memory, memory, old_size < size ? old_size : size);
+    allocator_default_deallocate(user_data, memory, subsystem);
+    return new_memory;
+}
+
+static struct allocator allocator_default = {
+    .allocate = allocator_default_allocate,
+    .reallocate = allocator_default_reallocate,
+    .deallocate = allocator_default_deallocate,
+    .user_data = NULL
+};
+
+static void *allocator_call_allocate(allocator_t allocator, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    void *memory = allocator->allocate(allocator->user_data, size, alignment, subsystem);
+
+    if (memory)
+        atomic_fetch_add_explicit(&allocator->statistics.allocations_count[subsystem], 1, memory_order_relaxed);
+    return memory;
+}
+
+static void *allocator_call_reallocate(allocator_t allocator, void *memory, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    void *new_memory = allocator->reallocate(allocator->user_data, memory, size, alignment, subsystem);
+
+    if (new_memory)
+        atomic_fetch_add_explicit(&allocator->statistics.allocations_count[subsystem], 1, memory_order_relaxed);
+    return new_memory;
+}
+
+static void allocator_call_deallocate(allocator_t allocator, void *memory, enum allocator_subsystem subsystem)
+{
+    allocator->deallocate(allocator->user_data, memory, subsystem);
+    atomic_fetch_add_explicit(&allocator->statistics.deallocations_count[subsystem], 1, memory_order_relaxed);
+}
+
+void allocator_init_default(allocator_t allocator)
+{
+    *allocator = allocator_default;
+    allocator_reset_statistics(allocator);
+}
+
+void *allocator_allocate(allocator_t allocator, size_t size, enum allocator_subsystem subsystem)
+{
+    if (!allocator)
+        allocator = &allocator_default;
+
+    return allocator_call_allocate(allocator, size, ALLOCATOR_DEFAULT_ALIGNMENT, subsystem);
+}
+
+void *allocator_allocate_zeroed(allocator_t allocator, size_t count, size_t size, enum allocator_subsystem subsystem)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+
+    void *memory = allocator_allocate(allocator, count * size, subsystem);
+
+    if (memory)
+        memset(memory, 0, count * size);
+    return memory;
+}
+
+void *allocator_reallocate(allocator_t allocator, void *memory, size_t size, enum allocator_subsystem subsystem)
+{
+    if (!allocator)
+        allocator = &allocator_default;
+    if (!memory)
+        return allocator_allocate(allocator, size, subsystem);
+
+    return allocator_call_reallocate(allocator, memory, size, ALLOCATOR_DEFAULT_ALIGNMENT, subsystem);
+}
+
+void allocator_free(allocator_t allocator, void *memory, enum allocator_subsystem subsystem)
+{
+    if (!memory)
+        return;
+    if (!allocator)
+        allocator = &allocator_default;
+
+    allocator_call_deallocate(allocator, memory, subsystem);
+}
+
+void allocator_get_statistics(allocator_t allocator, struct allocator_statistics *statistics)
+{
+    for (uint32_t i = 0; i < ALLOCATOR_SUBSYSTEM_COUNT; ++i) {
+        statistics->allocations_count[i] = atomic_load_explicit(&allocator->statistics.allocations_count[i], memory_order_relaxed);
+        statistics->deallocations_count[i] = atomic_load_explicit(&allocator->statistics.deallocations_count[i], memory_order_relaxed);
+    }
+}
+
+void allocator_reset_statistics(allocator_t allocator)
+{
+    for (uint32_t i = 0; i < ALLOCATOR_SUBSYSTEM_COUNT; ++i) {
+        atomic_store_explicit(&allocator->statistics.allocations_count[i], 0, memory_order_relaxed);
+        atomic_store_explicit(&allocator->statistics.deallocations_count[i], 0, memory_order_relaxed);
+    }
+}
+
+uint64_t allocator_statistics_total_allocations(const struct allocator_statistics *statistics)
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < ALLOCATOR_SUBSYSTEM_COUNT; ++i)
+        total += statistics->allocations_count[i];
+    return total;
+}
+
+static VKAPI_ATTR void *VKAPI_CALL allocator_vulkan_allocation(void *user_data, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    allocator_t allocator = user_data;
+
+    return allocator_call_allocate(allocator, size, alignment, ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER);
+}
+
+static VKAPI_ATTR void *VKAPI_CALL allocator_vulkan_reallocation(void *user_data, void *original, size_t size, size_t alignment, VkSystemAllocationScope scope)
+{
+    allocator_t allocator = user_data;
+
+    if (!original)
+        return allocator_call_allocate(allocator, size, alignment, ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER);
+    if (size == 0) {
+        allocator_call_deallocate(allocator, original, ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER);
+        return NULL;
+    }
+
+    return allocator_call_reallocate(allocator, original, size, alignment, ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER);
+}
+
+static VKAPI_ATTR void VKAPI_CALL allocator_vulkan_free(void *user_data, void *memory)
+{
+    allocator_t allocator = user_data;
+
+    if (memory)
+        allocator_call_deallocate(allocator, memory, ALLOCATOR_SUBSYSTEM_VULKAN_DRIVER);
+}
+
+void allocator_get_vulkan_callbacks(allocator_t allocator, VkAllocationCallbacks *callbacks)
+{
+    *callbacks = (VkAllocationCallbacks) {
+        .pUserData = allocator,
+        .pfnAllocation = allocator_vulkan_allocation,
+        .pfnReallocation = allocator_vulkan_reallocation,
+        .pfnFree = allocator_vulkan_free,
+        .pfnInternalAllocation = NULL,
+        .pfnInternalFree = NULL
+    };
+}
@@ -19,12 +19,20 @@ void engine_cleanup(engine_t engine)
     if (!engine)
         return;
 
+    struct allocator allocator = engine->allocator;
+
+    mesh_cache_cleanup(engine);
+    if (engine->vulkan_context.device)
+        vulkan_destroy_texture(&engine->vulkan_context, &engine->glyph_atlas_texture);
     vulkan_cleanup(&engine->vulkan_context);
+    glyph_atlas_cleanup(&engine->glyph_atlas);
 
     end_surface(&engine->surface_context);
 
-    free(engine->window);
-    free(engine);
+    allocator_free(&allocator, engine->objects_to_draw, ALLOCATOR_SUBSYSTEM_ENGINE);
+    allocator_free(&allocator, engine->shapes_to_draw, ALLOCATOR_SUBSYSTEM_ENGINE);
+    allocator_free(&allocator, engine->window, ALLOCATOR_SUBSYSTEM_ENGINE);
+    allocator_free(&allocator, engine, ALLOCATOR_SUBSYSTEM_ENGINE);
 }
 
 static bool engine_init_window(window_t window, surface_context_t surface)
@@ -43,8 +51,42 @@ static void engine_init(engine_t engine, const char *application_name, uint32_t
 
     if (!engine_init_window(engine->window, &engine->surface_context))
         engine_error(engine, "engine_init: window couldn't be inited\n", true);
-    if (!vulkan_init(&engine->vulkan_context, &engine->surface_context, engine->window, ENGINE_NAME, ENGINE_VERSION, application_name, application_version))
+    if (!mesh_cache_init(&engine->mesh_cache, &engine->allocator, MESH_CACHE_DEFAULT_BUCKETS_COUNT))
+        engine_error(engine, "engine_init: failed to init the mesh cache\n", true);
+    if (!vulkan_init(&engine->vulkan_context, &engine->allocator, &engine->surface_context, engine->window, ENGINE_NAME, ENGINE_VERSION, application_name, application_version))
         engine_error(engine, "engine_init: failed to init vulkan\n", true);
+    if (!glyph_atlas_init(&engine->glyph_atlas, &engine->allocator, GLYPH_ATLAS_DEFAULT_SIZE, GLYPH_ATLAS_DEFAULT_CELL_SIZE)
+        || !vulkan_create_texture(&engine->vulkan_context, GLYPH_ATLAS_DEFAULT_SIZE, GLYPH_ATLAS_DEFAULT_SIZE, VK_FORMAT_R8_UNORM, &engine->glyph_atlas_texture))
+        engine_error(engine, "engine_init: failed to create the glyph atlas\n", true);
+    vulkan_set_glyph_atlas_texture(&engine->vulkan_context, &engine->glyph_atlas_texture);
+}
+
+/*
+    Pixels per unit of the object's mesh: the larger scale of its model matrix scaled by the projection's focal length,
+    divided by the clip space w which is the view depth with a perspective projection.
+    The selected level is remembered by the object for the hysteresis of the next selection
+*/
+static uint32_t engine_select_lod(engine_t engine, object_t object, mat4 transform)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    mat4 model;
+    vec4 view_center;
+    vec4 clip_center;
+
+    if (object->mesh->lods_count <= 1)
+        return 0;
+
+    glm_mat4_mul(transform, object->vertex_push_constant.model, model);
+    glm_mat4_mulv(context->view, model[3], view_center);
+    glm_mat4_mulv(context->proj, view_center, clip_center);
+    if (fabsf(clip_center[3]) < FLT_EPSILON)
+        return object->mesh->lods_count - 1;
+
+    float scale = fmaxf(glm_vec3_norm(model[0]), glm_vec3_norm(model[1]));
+    float pixels_per_unit = scale * fabsf(context->proj[1][1]) * context->swapchain_extent.height * 0.5f / fabsf(clip_center[3]);
+
+    object->lod = mesh_select_lod(object->mesh, pixels_per_unit, engine->lod_error_tolerance, object->lod, engine->lod_hysteresis);
+    return object->lod;
 }
 
 bool engine_draw(engine_t engine, object_t object)
@@ -56,10 +98,94 @@ bool engine_draw(engine_t engine, object_t object)
         return false;
     }
 
-    engine->objects_to_draw[engine->objects_to_draw_count++] = object;
+    engine->objects_to_draw[engine->objects_to_draw_count++] = (struct draw_command) {
+        .object = object,
+        .parameters_offset = FRAME_ALLOCATOR_DEFAULT_PARAMETERS,
+        .lod = engine_select_lod(engine, object, GLM_MAT4_IDENTITY)
+    };
+    return true;
+}
+
+bool engine_draw_with_parameters(engine_t engine, object_t object, const struct draw_parameters *parameters)
+{
+    struct frame_allocation allocation;
+
+    if (engine->objects_to_draw_count >= engine->max_objects_to_draw) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Cannot draw more objects\n", 26);
+        #endif
+        return false;
+    }
+    if (!vulkan_frame_allocate(&engine->vulkan_context, sizeof(struct draw_parameters), FRAME_ALLOCATOR_UNIFORM_ALIGNMENT, &allocation))
+        return false;
+
+    memcpy(allocation.data, parameters, sizeof(struct draw_parameters));
+    engine->objects_to_draw[engine->objects_to_draw_count++] = (struct draw_command) {
+        .object = object,
+        .parameters_offset = (uint32_t) allocation.offset,
+        .lod = engine_select_lod(engine, object, (vec4 *) parameters->transform)
+    };
     return true;
 }
 
+bool engine_draw_shape(engine_t engine, const struct shape *shape)
+{
+    if (engine->shapes_to_draw_count >= engine->max_objects_to_draw) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Cannot draw more shapes\n", 25);
+        #endif
+        return false;
+    }
+
+    engine->shapes_to_draw[engine->shapes_to_draw_count++] = *shape;
+    return true;
+}
+
+bool engine_draw_quad(engine_t engine, vec2 position, vec2 size, vec4 color)
+{
+    quad_batch_t batch = &engine->quad_batch;
+
+    if (batch->quads_count == batch->quads_capacity && !quad_batch_grow(batch, &engine->vulkan_context))
+        return false;
+
+    struct quad *quad = (struct quad *) batch->quads + batch->quads_count++;
+
+    quad->position[0] = position[0];
+    quad->position[1] = position[1];
+    quad->size[0] = size[0];
+    quad->size[1] = size[1];
+    glm_vec4_copy(color, quad->color);
+    return true;
+}
+
+texture_t engine_create_texture(engine_t engine, uint32_t width, uint32_t height, const void *pixels)
+{
+    texture_t texture = allocator_allocate(&engine->allocator, sizeof(struct texture), ALLOCATOR_SUBSYSTEM_TEXTURE);
+
+    if (!texture)
+        return NULL;
+    if (!vulkan_create_texture(&engine->vulkan_context, width, height, VK_FORMAT_R8G8B8A8_SRGB, texture)) {
+        allocator_free(&engine->allocator, texture, ALLOCATOR_SUBSYSTEM_TEXTURE);
+        return NULL;
+    }
+    if (!vulkan_upload_texture(&engine->vulkan_context, texture, pixels)) {
+        engine_destroy_texture(engine, texture);
+        return NULL;
+    }
+    return texture;
+}
+
+void engine_destroy_texture(engine_t engine, texture_t texture)
+{
+    vulkan_destroy_texture(&engine->vulkan_context, texture);
+    allocator_free(&engine->allocator, texture, ALLOCATOR_SUBSYSTEM_TEXTURE);
+}
+
+bool engine_frame_allocate(engine_t engine, VkDeviceSize size, VkDeviceSize alignment, frame_allocation_t allocation)
+{
+    return vulkan_frame_allocate(&engine->vulkan_context, size, alignment, allocation);
+}
+
 void engine_wait_idle(engine_t engine)
 {
     vkDeviceWaitIdle(engine->vulkan_context.device);
@@ -79,29 +205,96 @@ bool engine_should_close(engine_t engine)
     return engine->window->should_close;
 }
 
+// Only the band of rows of the glyph atlas rasterized since the last upload is copied to its texture
+static void engine_upload_glyph_atlas(engine_t engine)
+{
+    glyph_atlas_t atlas = &engine->glyph_atlas;
+    uint32_t first_row;
+    uint32_t rows_count;
+
+    if (engine->vulkan_context.texture_updates_count >= TEXTURE_MAX_UPDATES_COUNT || !glyph_atlas_flush(atlas, &first_row, &rows_count))
+        return;
+    vulkan_queue_texture_update(&engine->vulkan_context, &engine->glyph_atlas_texture, atlas->pixels + (size_t) first_row * atlas->size, 0, first_row, atlas->size, rows_count, atlas->size);
+}
+
 bool engine_display(engine_t engine)
 {
-    bool result = vulkan_draw_frame(&engine->vulkan_context, engine->window, engine->objects_to_draw, engine->objects_to_draw_count);
+    engine_upload_glyph_atlas(engine);
+
+    struct draw_lists draw_lists = {
+        .draw_commands = engine->objects_to_draw,
+        .draw_commands_count = engine->objects_to_draw_count,
+        .tilemaps = engine->tilemaps_to_draw,
+        .tilemaps_count = engine->tilemaps_to_draw_count,
+        .point_clouds = engine->point_clouds_to_draw,
+        .point_clouds_count = engine->point_clouds_to_draw_count,
+        .time_series = engine->time_series_to_draw,
+        .time_series_count = engine->time_series_to_draw_count,
+        .vector_canvases = engine->vector_canvases_to_draw,
+        .vector_canvases_count = engine->vector_canvases_to_draw_count,
+        .shapes = engine->shapes_to_draw,
+        .shapes_count = engine->shapes_to_draw_count,
+        .quads = &engine->quad_batch,
+        .text = &engine->text_batch
+    };
+    bool result = vulkan_draw_frame(&engine->vulkan_context, engine->window, &draw_lists, engine->dynamic_batch_threshold);
     engine->objects_to_draw_count = 0;
+    engine->shapes_to_draw_count = 0;
+    engine->tilemaps_to_draw_count = 0;
+    engine->point_clouds_to_draw_count = 0;
+    engine->time_series_to_draw_count = 0;
+    engine->vector_canvases_to_draw_count = 0;
+    quad_batch_reset(&engine->quad_batch);
+    quad_batch_reset(&engine->text_batch);
+    glyph_atlas_next_frame(&engine->glyph_atlas);
 
     return result;
 }
 
+void engine_get_allocation_statistics(engine_t engine, struct allocator_statistics *statistics)
+{
+    allocator_get_statistics(&engine->allocator, statistics);
+}
+
+uint32_t engine_get_dynamic_batches_count(engine_t engine, uint32_t *batched_objects_count)
+{
+    if (batched_objects_count)
+        *batched_objects_count = engine->vulkan_context.dynamic_batched_objects_count;
+    return engine->vulkan_context.dynamic_batches_count;
+}
+
 void engine_update_camera(engine_t engine)
 {
     vulkan_update_proj(&engine->vulkan_context, &engine->camera);
     vulkan_update_view(&engine->vulkan_context, &engine->camera);
 }
 
-engine_t engine_create(const char *application_name, const struct version application_version, int window_width, int window_height, uint32_t max_objects_to_draw)
+engine_t engine_create(const char *application_name, const struct version application_version, int window_width, int window_height, uint32_t max_objects_to_draw, allocator_t allocator)
 {
-    engine_t engine = calloc(1, sizeof(struct engine));
-    engine->window = calloc(1, sizeof(struct window));
-    engine->objects_to_draw = calloc(max_objects_to_draw, sizeof(object_t));
-    engine->max_objects_to_draw = max_objects_to_draw;
+    struct allocator engine_allocator;
 
+    if (allocator)
+        engine_allocator = *allocator;
+    else
+        allocator_init_default(&engine_allocator);
+    allocator_reset_statistics(&engine_allocator);
+
+    engine_t engine = allocator_allocate_zeroed(&engine_allocator, 1, sizeof(struct engine), ALLOCATOR_SUBSYSTEM_ENGINE);
     if (!engine)
         engine_error(engine, "engine_create: engine_t engine is NULL\n", true);
+
+    engine->allocator = engine_allocator;
+    engine->window = allocator_allocate_zeroed(&engine->allocator, 1, sizeof(struct window), ALLOCATOR_SUBSYSTEM_ENGINE);
+    engine->objects_to_draw = allocator_allocate_zeroed(&engine->allocator, max_objects_to_draw, sizeof(struct draw_command), ALLOCATOR_SUBSYSTEM_ENGINE);
+    engine->max_objects_to_draw = max_objects_to_draw;
+    engine->shapes_to_draw = allocator_allocate_zeroed(&engine->allocator, max_objects_to_draw, sizeof(struct shape), ALLOCATOR_SUBSYSTEM_ENGINE);
+    quad_batch_init(&engine->quad_batch, sizeof(struct quad));
+    quad_batch_init(&engine->text_batch, sizeof(struct text_quad));
+    engine->lod_error_tolerance = ENGINE_LOD_ERROR_TOLERANCE_DEFAULT;
+    engine->lod_hysteresis = ENGINE_LOD_HYSTERESIS_DEFAULT;
+    engine->dynamic_batch_threshold = ENGINE_DYNAMIC_BATCH_THRESHOLD_DEFAULT;
+    if (!engine->window || !engine->objects_to_draw || !engine->shapes_to_draw)
+        engine_error(engine, "engine_create: failed to allocate the engine\n", true);
     engine_init(engine, application_name, VK_MAKE_VERSION(application_version.major, application_version.minor, application_version.patch), window_width, window_height);
     camera_init(&engine->camera);
     engine_update_camera(engine);
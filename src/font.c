@@ -0,0 +1,662 @@
+#include "font.h"
+#include "utils.h"
+#include <math.h>
+#include <string.h>
+
+/*
+    The tables are read in place from the file, big endian, every read is bounds checked and reads 0 outside of the file
+    so that a malformed font draws garbage instead of reading out of its bytes.
+    Glyph outlines are flattened into segments in pixel space, the distance field is the distance to the nearest segment
+    signed by the nonzero winding of the pixel center
+*/
+#define FONT_TAG(a, b, c, d) ((uint32_t) (a) << 24 | (uint32_t) (b) << 16 | (uint32_t) (c) << 8 | (uint32_t) (d))
+#define FONT_MAX_COMPOSITE_DEPTH 8
+#define FONT_MAX_CURVE_SEGMENTS 32
+#define FONT_OUTLINE_MIN_CAPACITY 64
+
+#define FONT_POINT_ON_CURVE 0x01
+#define FONT_POINT_X_SHORT 0x02
+#define FONT_POINT_Y_SHORT 0x04
+#define FONT_POINT_REPEAT 0x08
+#define FONT_POINT_X_SAME_OR_POSITIVE 0x10
+#define FONT_POINT_Y_SAME_OR_POSITIVE 0x20
+
+#define FONT_COMPONENT_ARGS_ARE_WORDS 0x0001
+#define FONT_COMPONENT_ARGS_ARE_OFFSETS 0x0002
+#define FONT_COMPONENT_SCALE 0x0008
+#define FONT_COMPONENT_MORE 0x0020
+#define FONT_COMPONENT_XY_SCALE 0x0040
+#define FONT_COMPONENT_TWO_BY_TWO 0x0080
+
+struct font_segment {
+    float x0;
+    float y0;
+    float x1;
+    float y1;
+};
+
+// Segments of a glyph in pixel space, `transform` maps the font units of the component being read to pixels
+struct font_outline {
+    allocator_t allocator;
+    struct font_segment *segments;
+    uint32_t segments_count;
+    uint32_t segments_capacity;
+    float transform[6];
+};
+
+struct font_crossing {
+    float x;
+    int winding;
+};
+
+static uint8_t font_read_u8(const struct font *font, uint32_t offset)
+{
+    return offset < font->size ? font->data[offset] : 0;
+}
+
+static uint16_t font_read_u16(const struct font *font, uint32_t offset)
+{
+    // Written without `offset + 2` so that an offset close to UINT32_MAX can't wrap around the check
+    return offset < font->size && font->size - offset >= 2 ? (uint16_t) (font->data[offset] << 8 | font->data[offset + 1]) : 0;
+}
+
+static int16_t font_read_i16(const struct font *font, uint32_t offset)
+{
+    return (int16_t) font_read_u16(font, offset);
+}
+
+static uint32_t font_read_u32(const struct font *font, uint32_t offset)
+{
+    if (offset >= font->size || font->size - offset < 4)
+        return 0;
+    return (uint32_t) font_read_u16(font, offset) << 16 | font_read_u16(font, offset + 2);
+}
+
+static uint32_t font_find_table(const struct font *font, uint32_t tag)
+{
+    uint16_t tables_count = font_read_u16(font, 4);
+
+    for (uint32_t i = 0; i < tables_count; ++i) {
+        uint32_t record = 12 + 16 * i;
+
+        if (font_read_u32(font, record) == tag)
+            return font_read_u32(font, record + 8);
+    }
+    return 0;
+}
+
+// Pick the unicode subtable, full repertoire format 12 first then BMP format 4
+static bool font_find_cmap(font_t font, uint32_t cmap)
+{
+    uint16_t encodings_count = font_read_u16(font, cmap + 2);
+    uint32_t bmp = 0;
+
+    for (uint32_t i = 0; i < encodings_count; ++i) {
+        uint32_t record = cmap + 4 + 8 * i;
+        uint16_t platform = font_read_u16(font, record);
+        uint16_t encoding = font_read_u16(font, record + 2);
+        uint32_t subtable = cmap + font_read_u32(font, record + 4);
+        uint16_t format = font_read_u16(font, subtable);
+
+        if (platform != 0 && !(platform == 3 && (encoding == 1 || encoding == 10)))
+            continue;
+        if (format == 12) {
+            font->cmap = subtable;
+            font->cmap_format = 12;
+            return true;
+        }
+        if (format == 4 && !bmp)
+            bmp = subtable;
+    }
+    font->cmap = bmp;
+    font->cmap_format = 4;
+    return bmp != 0;
+}
+
+static void font_find_kern(font_t font)
+{
+    uint32_t kern = font_find_table(font, FONT_TAG('k', 'e', 'r', 'n'));
+    uint16_t tables_count = font_read_u16(font, kern + 2);
+    uint32_t subtable = kern + 4;
+
+    font->kern = 0;
+    font->kern_pairs_count = 0;
+    if (!kern)
+        return;
+    for (uint32_t i = 0; i < tables_count; ++i) {
+        uint16_t coverage = font_read_u16(font, subtable + 4);
+
+        // Horizontal format 0 pairs, neither minimum values nor cross stream
+        if ((coverage & 0xFF07) == 0x0001) {
+            font->kern_pairs_count = font_read_u16(font, subtable + 6);
+            font->kern = subtable + 14;
+            return;
+        }
+        subtable += font_read_u16(font, subtable + 2);
+    }
+}
+
+static uint32_t font_lookup_glyph_index(const struct font *font, uint32_t codepoint)
+{
+    if (font->cmap_format == 12) {
+        uint32_t low = 0;
+        uint32_t high = font_read_u32(font, font->cmap + 12);
+
+        while (low < high) {
+            uint32_t middle = (low + high) / 2;
+            uint32_t group = font->cmap + 16 + 12 * middle;
+
+            if (codepoint < font_read_u32(font, group))
+                high = middle;
+            else if (codepoint > font_read_u32(font, group + 4))
+                low = middle + 1;
+            else
+                return font_read_u32(font, group + 8) + codepoint - font_read_u32(font, group);
+        }
+        return 0;
+    }
+
+    if (codepoint > UINT16_MAX)
+        return 0;
+
+    uint32_t segments_count = font_read_u16(font, font->cmap + 6) / 2;
+    uint32_t end_codes = font->cmap + 14;
+    uint32_t start_codes = end_codes + 2 * segments_count + 2;
+    uint32_t deltas = start_codes + 2 * segments_count;
+    uint32_t range_offsets = deltas + 2 * segments_count;
+    uint32_t low = 0;
+    uint32_t high = segments_count;
+
+    // The first segment whose end code is at least the codepoint
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+
+        if (font_read_u16(font, end_codes + 2 * middle) < codepoint)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low >= segments_count || font_read_u16(font, start_codes + 2 * low) > codepoint)
+        return 0;
+
+    uint16_t start = font_read_u16(font, start_codes + 2 * low);
+    uint16_t delta = font_read_u16(font, deltas + 2 * low);
+    uint16_t range_offset = font_read_u16(font, range_offsets + 2 * low);
+    uint16_t glyph;
+
+    if (range_offset == 0)
+        return (uint16_t) (codepoint + delta);
+    glyph = font_read_u16(font, range_offsets + 2 * low + range_offset + 2 * (codepoint - start));
+    return glyph ? (uint16_t) (glyph + delta) : 0;
+}
+
+bool font_init(font_t font, const void *data, uint32_t size)
+{
+    memset(font, 0, sizeof(struct font));
+    font->data = data;
+    font->size = size;
+
+    uint32_t version = font_read_u32(font, 0);
+    uint32_t head = font_find_table(font, FONT_TAG('h', 'e', 'a', 'd'));
+    uint32_t hhea = font_find_table(font, FONT_TAG('h', 'h', 'e', 'a'));
+    uint32_t maxp = font_find_table(font, FONT_TAG('m', 'a', 'x', 'p'));
+    uint32_t cmap = font_find_table(font, FONT_TAG('c', 'm', 'a', 'p'));
+
+    if (version != 0x00010000 && version != FONT_TAG('t', 'r', 'u', 'e'))
+        return false;
+    font->loca = font_find_table(font, FONT_TAG('l', 'o', 'c', 'a'));
+    font->glyf = font_find_table(font, FONT_TAG('g', 'l', 'y', 'f'));
+    font->hmtx = font_find_table(font, FONT_TAG('h', 'm', 't', 'x'));
+    if (!head || !hhea || !maxp || !cmap || !font->loca || !font->glyf || !font->hmtx || !font_find_cmap(font, cmap))
+        return false;
+
+    font->units_per_em = font_read_u16(font, head + 18);
+    font->long_locations = font_read_i16(font, head + 50) != 0;
+    font->glyphs_count = font_read_u16(font, maxp + 4);
+    font->ascender = font_read_i16(font, hhea + 4);
+    font->descender = font_read_i16(font, hhea + 6);
+    font->line_gap = font_read_i16(font, hhea + 8);
+    font->long_metrics_count = font_read_u16(font, hhea + 34);
+    if (font->units_per_em == 0 || font->long_metrics_count == 0)
+        return false;
+    font_find_kern(font);
+
+    for (uint32_t i = 0; i < FONT_ASCII_GLYPHS_COUNT; ++i)
+        font->ascii_glyphs[i] = (uint16_t) font_lookup_glyph_index(font, i);
+    return true;
+}
+
+font_t font_load(allocator_t allocator, const char *path)
+{
+    uint32_t size;
+    char *data = read_file(allocator, path, &size, ALLOCATOR_SUBSYSTEM_TEXT);
+    font_t font;
+
+    if (!data)
+        return NULL;
+    font = allocator_allocate(allocator, sizeof(struct font), ALLOCATOR_SUBSYSTEM_TEXT);
+    if (!font || !font_init(font, data, size)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Failed to load the font\n", 25);
+        #endif
+        if (font)
+            allocator_free(allocator, font, ALLOCATOR_SUBSYSTEM_TEXT);
+        allocator_free(allocator, data, ALLOCATOR_SUBSYSTEM_TEXT);
+        return NULL;
+    }
+    font->allocator = allocator;
+    return font;
+}
+
+void font_destroy(font_t font)
+{
+    if (!font || !font->allocator)
+        return;
+    allocator_free(font->allocator, (void *) font->data, ALLOCATOR_SUBSYSTEM_TEXT);
+    allocator_free(font->allocator, font, ALLOCATOR_SUBSYSTEM_TEXT);
+}
+
+uint32_t font_get_glyph_index(const struct font *font, uint32_t codepoint)
+{
+    if (codepoint < FONT_ASCII_GLYPHS_COUNT)
+        return font->ascii_glyphs[codepoint];
+    return font_lookup_glyph_index(font, codepoint);
+}
+
+void font_get_glyph_horizontal_metrics(const struct font *font, uint32_t glyph, int32_t *advance, int32_t *left_side_bearing)
+{
+    uint32_t last_long = font->long_metrics_count - 1u;
+
+    if (advance)
+        *advance = font_read_u16(font, font->hmtx + 4 * (glyph < last_long ? glyph : last_long));
+    if (left_side_bearing) {
+        if (glyph < font->long_metrics_count)
+            *left_side_bearing = font_read_i16(font, font->hmtx + 4 * glyph + 2);
+        else
+            *left_side_bearing = font_read_i16(font, font->hmtx + 4 * font->long_metrics_count + 2 * (glyph - font->long_metrics_count));
+    }
+}
+
+int32_t font_get_kerning(const struct font *font, uint32_t left, uint32_t right)
+{
+    uint32_t key = left << 16 | right;
+    uint32_t low = 0;
+    uint32_t high = font->kern_pairs_count;
+
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        uint32_t pair = font_read_u32(font, font->kern + 6 * middle);
+
+        if (pair < key)
+            low = middle + 1;
+        else if (pair > key)
+            high = middle;
+        else
+            return font_read_i16(font, font->kern + 6 * middle + 4);
+    }
+    return 0;
+}
+
+// Offset of the outline of a glyph in the file, 0 for empty glyphs
+static uint32_t font_get_glyph_offset(const struct font *font, uint32_t glyph)
+{
+    uint32_t start;
+    uint32_t end;
+
+    if (glyph >= font->glyphs_count)
+        return 0;
+    if (font->long_locations) {
+        start = font_read_u32(font, font->loca + 4 * glyph);
+        end = font_read_u32(font, font->loca + 4 * glyph + 4);
+    } else {
+        start = font_read_u16(font, font->loca + 2 * glyph) * 2u;
+        end = font_read_u16(font, font->loca + 2 * glyph + 2) * 2u;
+    }
+    return end > start ? font->glyf + start : 0;
+}
+
+bool font_get_glyph_box(const struct font *font, uint32_t glyph, int16_t box[4])
+{
+    uint32_t offset = font_get_glyph_offset(font, glyph);
+
+    if (!offset)
+        return false;
+    for (uint32_t i = 0; i < 4; ++i)
+        box[i] = font_read_i16(font, offset + 2 + 2 * i);
+    return box[2] > box[0] && box[3] > box[1];
+}
+
+static bool font_outline_push_line(struct font_outline *outline, float x0, float y0, float x1, float y1)
+{
+    if (outline->segments_count == outline->segments_capacity) {
+        uint32_t capacity = outline->segments_capacity ? outline->segments_capacity * 2 : FONT_OUTLINE_MIN_CAPACITY;
+        struct font_segment *segments = allocator_reallocate(outline->allocator, outline->segments, capacity * sizeof(struct font_segment), ALLOCATOR_SUBSYSTEM_TEXT);
+
+        if (!segments)
+            return false;
+        outline->segments = segments;
+        outline->segments_capacity = capacity;
+    }
+    outline->segments[outline->segments_count++] = (struct font_segment) {x0, y0, x1, y1};
+    return true;
+}
+
+// Points are in pixels, the curve is split so that its chords stay within FONT_FLATTENING_TOLERANCE of it
+static bool font_outline_push_curve(struct font_outline *outline, const float *from, const float *control, const float *to)
+{
+    float dx = from[0] - 2.0f * control[0] + to[0];
+    float dy = from[1] - 2.0f * control[1] + to[1];
+    uint32_t count = (uint32_t) ceilf(sqrtf(sqrtf(dx * dx + dy * dy) / (8.0f * FONT_FLATTENING_TOLERANCE)));
+    float previous[2] = {from[0], from[1]};
+
+    count = count < 1 ? 1 : count > FONT_MAX_CURVE_SEGMENTS ? FONT_MAX_CURVE_SEGMENTS : count;
+    for (uint32_t i = 1; i <= count; ++i) {
+        float t = (float) i / count;
+        float u = 1.0f - t;
+        float point[2] = {
+            u * u * from[0] + 2.0f * u * t * control[0] + t * t * to[0],
+            u * u * from[1] + 2.0f * u * t * control[1] + t * t * to[1]
+        };
+
+        if (!font_outline_push_line(outline, previous[0], previous[1], point[0], point[1]))
+            return false;
+        previous[0] = point[0];
+        previous[1] = point[1];
+    }
+    return true;
+}
+
+static void font_outline_transform(const struct font_outline *outline, float x, float y, float *point)
+{
+    point[0] = outline->transform[0] * x + outline->transform[2] * y + outline->transform[4];
+    point[1] = outline->transform[1] * x + outline->transform[3] * y + outline->transform[5];
+}
+
+/*
+    Two consecutive off curve points imply an on curve point between them, a contour starts on its first on curve point,
+    or on the implied point between its last and first points when none is on the curve
+*/
+static bool font_outline_push_contour(struct font_outline *outline, const float (*points)[2], const uint8_t *flags, uint32_t count)
+{
+    uint32_t start = 0;
+    float start_point[2];
+    float previous[2];
+    float control[2];
+    bool has_control = false;
+
+    while (start < count && !(flags[start] & FONT_POINT_ON_CURVE))
+        ++start;
+    if (start == count) {
+        start_point[0] = (points[0][0] + points[count - 1][0]) * 0.5f;
+        start_point[1] = (points[0][1] + points[count - 1][1]) * 0.5f;
+        start = count - 1;
+    } else {
+        start_point[0] = points[start][0];
+        start_point[1] = points[start][1];
+    }
+    previous[0] = start_point[0];
+    previous[1] = start_point[1];
+
+    for (uint32_t i = 1; i <= count; ++i) {
+        uint32_t index = (start + i) % count;
+        const float *point = i == count ? start_point : points[index];
+        bool on_curve = i == count || (flags[index] & FONT_POINT_ON_CURVE);
+
+        if (!on_curve) {
+            if (has_control) {
+                float middle[2] = {(control[0] + point[0]) * 0.5f, (control[1] + point[1]) * 0.5f};
+
+                if (!font_outline_push_curve(outline, previous, control, middle))
+                    return false;
+                previous[0] = middle[0];
+                previous[1] = middle[1];
+            }
+            control[0] = point[0];
+            control[1] = point[1];
+            has_control = true;
+            continue;
+        }
+        if (has_control ? !font_outline_push_curve(outline, previous, control, point)
+            : !font_outline_push_line(outline, previous[0], previous[1], point[0], point[1]))
+            return false;
+        previous[0] = point[0];
+        previous[1] = point[1];
+        has_control = false;
+    }
+    return true;
+}
+
+static bool font_outline_push_simple_glyph(const struct font *font, struct font_outline *outline, uint32_t offset, int16_t contours_count)
+{
+    uint32_t points_count = font_read_u16(font, offset + 10 + 2 * (contours_count - 1)) + 1u;
+    uint32_t cursor = offset + 10 + 2 * contours_count;
+    uint8_t *flags;
+    float (*points)[2];
+    bool result = true;
+
+    cursor += 2 + font_read_u16(font, cursor);
+    // The points follow the flags, padded to 8 bytes so that they are aligned
+    flags = allocator_allocate(outline->allocator, ((points_count + 7) & ~7u) + points_count * sizeof(float[2]), ALLOCATOR_SUBSYSTEM_TEXT);
+    if (!flags)
+        return false;
+    points = PTR_OFFSET(flags, (points_count + 7) & ~7u);
+
+    for (uint32_t i = 0; i < points_count;) {
+        uint8_t flag = font_read_u8(font, cursor++);
+        uint32_t repeat = flag & FONT_POINT_REPEAT ? font_read_u8(font, cursor++) : 0;
+
+        for (uint32_t r = 0; r <= repeat && i < points_count; ++r)
+            flags[i++] = flag;
+    }
+    // Coordinates are deltas from the previous point, x for every point then y for every point
+    for (uint32_t axis = 0; axis < 2; ++axis) {
+        uint8_t short_flag = axis ? FONT_POINT_Y_SHORT : FONT_POINT_X_SHORT;
+        uint8_t same_flag = axis ? FONT_POINT_Y_SAME_OR_POSITIVE : FONT_POINT_X_SAME_OR_POSITIVE;
+        int32_t value = 0;
+
+        for (uint32_t i = 0; i < points_count; ++i) {
+            if (flags[i] & short_flag) {
+                int32_t delta = font_read_u8(font, cursor++);
+
+                value += flags[i] & same_flag ? delta : -delta;
+            } else if (!(flags[i] & same_flag)) {
+                value += font_read_i16(font, cursor);
+                cursor += 2;
+            }
+            points[i][axis] = (float) value;
+        }
+    }
+    for (uint32_t i = 0; i < points_count; ++i)
+        font_outline_transform(outline, points[i][0], points[i][1], points[i]);
+
+    uint32_t first = 0;
+    for (int16_t contour = 0; contour < contours_count && result; ++contour) {
+        uint32_t last = font_read_u16(font, offset + 10 + 2 * contour);
+
+        if (last >= points_count || last < first)
+            break;
+        if (last > first)
+            result = font_outline_push_contour(outline, points + first, flags + first, last - first + 1);
+        first = last + 1;
+    }
+    allocator_free(outline->allocator, flags, ALLOCATOR_SUBSYSTEM_TEXT);
+    return result;
+}
+
+static bool font_outline_push_glyph(const struct font *font, struct font_outline *outline, uint32_t glyph, uint32_t depth)
+{
+    uint32_t offset = font_get_glyph_offset(font, glyph);
+    int16_t contours_count;
+
+    if (!offset)
+        return true;
+    contours_count = font_read_i16(font, offset);
+    if (contours_count > 0)
+        return font_outline_push_simple_glyph(font, outline, offset, contours_count);
+    if (contours_count == 0 || depth >= FONT_MAX_COMPOSITE_DEPTH)
+        return true;
+
+    // Composite glyphs draw other glyphs with an affine transform, matched points aren't supported and are drawn unmoved
+    float parent[6];
+    uint32_t cursor = offset + 10;
+    uint16_t flags;
+
+    memcpy(parent, outline->transform, sizeof(parent));
+    do {
+        float matrix[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+        float dx = 0.0f;
+        float dy = 0.0f;
+        uint32_t component;
+
+        flags = font_read_u16(font, cursor);
+        component = font_read_u16(font, cursor + 2);
+        cursor += 4;
+        if (flags & FONT_COMPONENT_ARGS_ARE_WORDS) {
+            if (flags & FONT_COMPONENT_ARGS_ARE_OFFSETS) {
+                dx = font_read_i16(font, cursor);
+                dy = font_read_i16(font, cursor + 2);
+            }
+            cursor += 4;
+        } else {
+            if (flags & FONT_COMPONENT_ARGS_ARE_OFFSETS) {
+                dx = (int8_t) font_read_u8(font, cursor);
+                dy = (int8_t) font_read_u8(font, cursor + 1);
+            }
+            cursor += 2;
+        }
+        if (flags & FONT_COMPONENT_SCALE) {
+            matrix[0] = matrix[3] = font_read_i16(font, cursor) / 16384.0f;
+            cursor += 2;
+        } else if (flags & FONT_COMPONENT_XY_SCALE) {
+            matrix[0] = font_read_i16(font, cursor) / 16384.0f;
+            matrix[3] = font_read_i16(font, cursor + 2) / 16384.0f;
+            cursor += 4;
+        } else if (flags & FONT_COMPONENT_TWO_BY_TWO) {
+            for (uint32_t i = 0; i < 4; ++i)
+                matrix[i] = font_read_i16(font, cursor + 2 * i) / 16384.0f;
+            cursor += 8;
+        }
+
+        outline->transform[0] = parent[0] * matrix[0] + parent[2] * matrix[1];
+        outline->transform[1] = parent[1] * matrix[0] + parent[3] * matrix[1];
+        outline->transform[2] = parent[0] * matrix[2] + parent[2] * matrix[3];
+        outline->transform[3] = parent[1] * matrix[2] + parent[3] * matrix[3];
+        outline->transform[4] = parent[0] * dx + parent[2] * dy + parent[4];
+        outline->transform[5] = parent[1] * dx + parent[3] * dy + parent[5];
+        if (!font_outline_push_glyph(font, outline, component, depth + 1))
+            return false;
+    } while (flags & FONT_COMPONENT_MORE);
+    memcpy(outline->transform, parent, sizeof(parent));
+    return true;
+}
+
+static int font_compare_crossings(const void *a, const void *b)
+{
+    float xa = ((const struct font_crossing *) a)->x;
+    float xb = ((const struct font_crossing *) b)->x;
+
+    return (xa > xb) - (xa < xb);
+}
+
+static float font_segment_distance_squared(const struct font_segment *segment, float x, float y)
+{
+    float dx = segment->x1 - segment->x0;
+    float dy = segment->y1 - segment->y0;
+    float px = x - segment->x0;
+    float py = y - segment->y0;
+    float length_squared = dx * dx + dy * dy;
+    float t = length_squared > 0.0f ? (px * dx + py * dy) / length_squared : 0.0f;
+
+    t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+    px -= dx * t;
+    py -= dy * t;
+    return px * px + py * py;
+}
+
+/*
+    Rows are swept once: the crossings of the row's pixel centers with the outline give the winding of every pixel of the row,
+    and only the segments within `spread` of the row are tested for the distance of its pixels
+*/
+static void font_rasterize_outline_sdf(const struct font_outline *outline, struct font_crossing *crossings, uint32_t *nearby,
+    float spread, uint8_t *pixels, uint32_t width, uint32_t height, uint32_t stride)
+{
+    float spread_squared = spread * spread;
+
+    for (uint32_t row = 0; row < height; ++row) {
+        float y = row + 0.5f;
+        uint32_t crossings_count = 0;
+        uint32_t nearby_count = 0;
+
+        for (uint32_t i = 0; i < outline->segments_count; ++i) {
+            const struct font_segment *segment = &outline->segments[i];
+            float min_y = fminf(segment->y0, segment->y1);
+            float max_y = fmaxf(segment->y0, segment->y1);
+
+            if (min_y - spread <= y && y <= max_y + spread)
+                nearby[nearby_count++] = i;
+            if ((segment->y0 <= y) != (segment->y1 <= y)) {
+                float t = (y - segment->y0) / (segment->y1 - segment->y0);
+
+                crossings[crossings_count++] = (struct font_crossing) {
+                    .x = segment->x0 + t * (segment->x1 - segment->x0),
+                    .winding = segment->y1 > segment->y0 ? 1 : -1
+                };
+            }
+        }
+        if (crossings_count > 1)
+            qsort(crossings, crossings_count, sizeof(struct font_crossing), font_compare_crossings);
+
+        uint32_t crossing = 0;
+        int winding = 0;
+        for (uint32_t column = 0; column < width; ++column) {
+            float x = column + 0.5f;
+            float distance_squared = spread_squared;
+
+            while (crossing < crossings_count && crossings[crossing].x <= x)
+                winding += crossings[crossing++].winding;
+            for (uint32_t i = 0; i < nearby_count; ++i) {
+                const struct font_segment *segment = &outline->segments[nearby[i]];
+
+                if (fminf(segment->x0, segment->x1) - spread > x || fmaxf(segment->x0, segment->x1) + spread < x)
+                    continue;
+                distance_squared = fminf(distance_squared, font_segment_distance_squared(segment, x, y));
+            }
+
+            float distance = sqrtf(distance_squared) * (winding != 0 ? 1.0f : -1.0f);
+            float value = 0.5f + distance / (2.0f * spread);
+
+            value = value < 0.0f ? 0.0f : value > 1.0f ? 1.0f : value;
+            pixels[row * stride + column] = (uint8_t) (value * 255.0f + 0.5f);
+        }
+    }
+}
+
+bool font_rasterize_glyph_sdf(const struct font *font, allocator_t allocator, uint32_t glyph, float scale, const vec2 origin, float spread,
+    uint8_t *pixels, uint32_t width, uint32_t height, uint32_t stride)
+{
+    struct font_outline outline = {
+        .allocator = allocator,
+        .segments = NULL,
+        .segments_count = 0,
+        .segments_capacity = 0,
+        .transform = {scale, 0.0f, 0.0f, -scale, origin[0], origin[1]}
+    };
+    void *scratch = NULL;
+    bool result = font_outline_push_glyph(font, &outline, glyph, 0);
+
+    if (result && outline.segments_count > 0) {
+        scratch = allocator_allocate(allocator, outline.segments_count * (sizeof(struct font_crossing) + sizeof(uint32_t)), ALLOCATOR_SUBSYSTEM_TEXT);
+        result = scratch != NULL;
+    }
+    if (result) {
+        uint32_t *nearby = PTR_OFFSET(scratch, outline.segments_count * sizeof(struct font_crossing));
+
+        font_rasterize_outline_sdf(&outline, scratch, nearby, spread, pixels, width, height, stride);
+    }
+
+    if (scratch)
+        allocator_free(allocator, scratch, ALLOCATOR_SUBSYSTEM_TEXT);
+    if (outline.segments)
+        allocator_free(allocator, outline.segments, ALLOCATOR_SUBSYSTEM_TEXT);
+    return result;
+}
@@ -0,0 +1,311 @@
+#include "geometry.h"
+#include "utils.h"
+#include <math.h>
+#include <string.h>
+
+/*
+    Points of an arc are generated by rotating the previous ones by the angle step, a complex multiplication,
+    instead of calling sine and cosine per point. The SIMD kernels hold as many consecutive points as they have lanes
+    and rotate the whole block by the step times the lane count, cosine and sine are stored in separate registers
+    and interleaved to (x, y) pairs when stored. The instruction set is selected when the library is compiled
+*/
+#if defined(GEOMETRY_NO_SIMD)
+    #define GEOMETRY_SIMD_NAME "scalar"
+#elif defined(__AVX2__)
+    #include <immintrin.h>
+    #define GEOMETRY_SIMD_AVX2
+    #define GEOMETRY_SIMD_NAME "avx2"
+    #define GEOMETRY_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GEOMETRY_SIMD_SSE2
+    #define GEOMETRY_SIMD_NAME "sse2"
+    #define GEOMETRY_SIMD_WIDTH 4
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define GEOMETRY_SIMD_NEON
+    #define GEOMETRY_SIMD_NAME "neon"
+    #define GEOMETRY_SIMD_WIDTH 4
+#else
+    #define GEOMETRY_SIMD_NAME "scalar"
+#endif
+
+const char *geometry_get_simd_name(void)
+{
+    return GEOMETRY_SIMD_NAME;
+}
+
+static void geometry_generate_arc_scalar(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest)
+{
+    float step_cos = cosf(angle_step);
+    float step_sin = sinf(angle_step);
+    float c = 0.0f;
+    float s = 0.0f;
+
+    for (uint32_t i = 0; i < points_count; ++i) {
+        if (i % GEOMETRY_RESEED_INTERVAL == 0) {
+            c = cosf(start_angle + angle_step * i);
+            s = sinf(start_angle + angle_step * i);
+        }
+        dest[i][0] = center[0] + radii[0] * c;
+        dest[i][1] = center[1] + radii[1] * s;
+
+        float next_c = c * step_cos - s * step_sin;
+        s = c * step_sin + s * step_cos;
+        c = next_c;
+    }
+}
+
+#ifdef GEOMETRY_SIMD_WIDTH
+static void geometry_seed_lanes(float start_angle, float angle_step, uint32_t first, float *lanes_cos, float *lanes_sin)
+{
+    for (uint32_t lane = 0; lane < GEOMETRY_SIMD_WIDTH; ++lane) {
+        float angle = start_angle + angle_step * (first + lane);
+
+        lanes_cos[lane] = cosf(angle);
+        lanes_sin[lane] = sinf(angle);
+    }
+}
+#endif
+
+#if defined(GEOMETRY_SIMD_AVX2)
+static void geometry_generate_arc_simd(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest)
+{
+    __m256 center_x = _mm256_set1_ps(center[0]);
+    __m256 center_y = _mm256_set1_ps(center[1]);
+    __m256 radius_x = _mm256_set1_ps(radii[0]);
+    __m256 radius_y = _mm256_set1_ps(radii[1]);
+    __m256 block_cos = _mm256_set1_ps(cosf(angle_step * GEOMETRY_SIMD_WIDTH));
+    __m256 block_sin = _mm256_set1_ps(sinf(angle_step * GEOMETRY_SIMD_WIDTH));
+    __m256 c = _mm256_setzero_ps();
+    __m256 s = _mm256_setzero_ps();
+    float lanes_cos[GEOMETRY_SIMD_WIDTH];
+    float lanes_sin[GEOMETRY_SIMD_WIDTH];
+
+    for (uint32_t i = 0; i < points_count; i += GEOMETRY_SIMD_WIDTH) {
+        if (i % GEOMETRY_RESEED_INTERVAL == 0) {
+            geometry_seed_lanes(start_angle, angle_step, i, lanes_cos, lanes_sin);
+            c = _mm256_loadu_ps(lanes_cos);
+            s = _mm256_loadu_ps(lanes_sin);
+        }
+        __m256 x = _mm256_add_ps(center_x, _mm256_mul_ps(radius_x, c));
+        __m256 y = _mm256_add_ps(center_y, _mm256_mul_ps(radius_y, s));
+        // Unpacking interleaves within each 128 bits half, the halves are then reordered
+        __m256 low = _mm256_unpacklo_ps(x, y);
+        __m256 high = _mm256_unpackhi_ps(x, y);
+        __m256 first = _mm256_permute2f128_ps(low, high, 0x20);
+        __m256 second = _mm256_permute2f128_ps(low, high, 0x31);
+
+        if (i + GEOMETRY_SIMD_WIDTH <= points_count) {
+            _mm256_storeu_ps(dest[i], first);
+            _mm256_storeu_ps(dest[i + 4], second);
+        } else {
+            vec2 tail[GEOMETRY_SIMD_WIDTH];
+
+            _mm256_storeu_ps(tail[0], first);
+            _mm256_storeu_ps(tail[4], second);
+            memcpy(dest[i], tail, sizeof(vec2) * (points_count - i));
+        }
+
+        __m256 next_c = _mm256_sub_ps(_mm256_mul_ps(c, block_cos), _mm256_mul_ps(s, block_sin));
+        s = _mm256_add_ps(_mm256_mul_ps(c, block_sin), _mm256_mul_ps(s, block_cos));
+        c = next_c;
+    }
+}
+#elif defined(GEOMETRY_SIMD_SSE2)
+static void geometry_generate_arc_simd(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest)
+{
+    __m128 center_x = _mm_set1_ps(center[0]);
+    __m128 center_y = _mm_set1_ps(center[1]);
+    __m128 radius_x = _mm_set1_ps(radii[0]);
+    __m128 radius_y = _mm_set1_ps(radii[1]);
+    __m128 block_cos = _mm_set1_ps(cosf(angle_step * GEOMETRY_SIMD_WIDTH));
+    __m128 block_sin = _mm_set1_ps(sinf(angle_step * GEOMETRY_SIMD_WIDTH));
+    __m128 c = _mm_setzero_ps();
+    __m128 s = _mm_setzero_ps();
+    float lanes_cos[GEOMETRY_SIMD_WIDTH];
+    float lanes_sin[GEOMETRY_SIMD_WIDTH];
+
+    for (uint32_t i = 0; i < points_count; i += GEOMETRY_SIMD_WIDTH) {
+        if (i % GEOMETRY_RESEED_INTERVAL == 0) {
+            geometry_seed_lanes(start_angle, angle_step, i, lanes_cos, lanes_sin);
+            c = _mm_loadu_ps(lanes_cos);
+            s = _mm_loadu_ps(lanes_sin);
+        }
+        __m128 x = _mm_add_ps(center_x, _mm_mul_ps(radius_x, c));
+        __m128 y = _mm_add_ps(center_y, _mm_mul_ps(radius_y, s));
+        __m128 low = _mm_unpacklo_ps(x, y);
+        __m128 high = _mm_unpackhi_ps(x, y);
+
+        if (i + GEOMETRY_SIMD_WIDTH <= points_count) {
+            _mm_storeu_ps(dest[i], low);
+            _mm_storeu_ps(dest[i + 2], high);
+        } else {
+            vec2 tail[GEOMETRY_SIMD_WIDTH];
+
+            _mm_storeu_ps(tail[0], low);
+            _mm_storeu_ps(tail[2], high);
+            memcpy(dest[i], tail, sizeof(vec2) * (points_count - i));
+        }
+
+        __m128 next_c = _mm_sub_ps(_mm_mul_ps(c, block_cos), _mm_mul_ps(s, block_sin));
+        s = _mm_add_ps(_mm_mul_ps(c, block_sin), _mm_mul_ps(s, block_cos));
+        c = next_c;
+    }
+}
+#elif defined(GEOMETRY_SIMD_NEON)
+static void geometry_generate_arc_simd(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest)
+{
+    float32x4_t center_x = vdupq_n_f32(center[0]);
+    float32x4_t center_y = vdupq_n_f32(center[1]);
+    float32x4_t radius_x = vdupq_n_f32(radii[0]);
+    float32x4_t radius_y = vdupq_n_f32(radii[1]);
+    float32x4_t block_cos = vdupq_n_f32(cosf(angle_step * GEOMETRY_SIMD_WIDTH));
+    float32x4_t block_sin = vdupq_n_f32(sinf(angle_step * GEOMETRY_SIMD_WIDTH));
+    float32x4_t c = vdupq_n_f32(0.0f);
+    float32x4_t s = vdupq_n_f32(0.0f);
+    float lanes_cos[GEOMETRY_SIMD_WIDTH];
+    float lanes_sin[GEOMETRY_SIMD_WIDTH];
+
+    for (uint32_t i = 0; i < points_count; i += GEOMETRY_SIMD_WIDTH) {
+        if (i % GEOMETRY_RESEED_INTERVAL == 0) {
+            geometry_seed_lanes(start_angle, angle_step, i, lanes_cos, lanes_sin);
+            c = vld1q_f32(lanes_cos);
+            s = vld1q_f32(lanes_sin);
+        }
+        float32x4x2_t points = {{vmlaq_f32(center_x, radius_x, c), vmlaq_f32(center_y, radius_y, s)}};
+
+        if (i + GEOMETRY_SIMD_WIDTH <= points_count) {
+            vst2q_f32(dest[i], points);
+        } else {
+            vec2 tail[GEOMETRY_SIMD_WIDTH];
+
+            vst2q_f32(tail[0], points);
+            memcpy(dest[i], tail, sizeof(vec2) * (points_count - i));
+        }
+
+        float32x4_t next_c = vmlsq_f32(vmulq_f32(c, block_cos), s, block_sin);
+        s = vmlaq_f32(vmulq_f32(c, block_sin), s, block_cos);
+        c = next_c;
+    }
+}
+#endif
+
+/*
+    Points are transformed as (x, y, 0, 1), the third column of the matrix never contributes. Each point is
+    the sum of the first two columns scaled by its coordinates and of the last column, the SIMD kernels keep
+    the columns in registers and compute a whole vec4 per lane group
+*/
+// Only the AVX2 kernel, for its last odd point, and the scalar fallback need the scalar transform
+#if !defined(GEOMETRY_SIMD_WIDTH) || defined(GEOMETRY_SIMD_AVX2)
+static void geometry_transform_points_scalar(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride)
+{
+    for (uint32_t i = 0; i < points_count; ++i) {
+        float *point = PTR_OFFSET(dest, i * dest_stride);
+
+        for (uint32_t row = 0; row < 4; ++row)
+            point[row] = transform[0][row] * points[i][0] + transform[1][row] * points[i][1] + transform[3][row];
+    }
+}
+#endif
+
+#if defined(GEOMETRY_SIMD_AVX2)
+static void geometry_transform_points_simd(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride)
+{
+    __m256 column_x = _mm256_broadcast_ps((const __m128 *) transform[0]);
+    __m256 column_y = _mm256_broadcast_ps((const __m128 *) transform[1]);
+    __m256 column_w = _mm256_broadcast_ps((const __m128 *) transform[3]);
+    uint32_t i = 0;
+
+    // Two points per iteration, one per 128 bits half
+    for (; i + 2 <= points_count; i += 2) {
+        __m128 pair = _mm_loadu_ps(points[i]);
+        __m256 x = _mm256_set_m128(_mm_shuffle_ps(pair, pair, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(0, 0, 0, 0)));
+        __m256 y = _mm256_set_m128(_mm_shuffle_ps(pair, pair, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(pair, pair, _MM_SHUFFLE(1, 1, 1, 1)));
+        __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(column_x, x), _mm256_mul_ps(column_y, y)), column_w);
+
+        _mm_storeu_ps(PTR_OFFSET(dest, i * dest_stride), _mm256_castps256_ps128(result));
+        _mm_storeu_ps(PTR_OFFSET(dest, (i + 1) * dest_stride), _mm256_extractf128_ps(result, 1));
+    }
+    if (i < points_count)
+        geometry_transform_points_scalar(transform, points + i, points_count - i, PTR_OFFSET(dest, i * dest_stride), dest_stride);
+}
+#elif defined(GEOMETRY_SIMD_SSE2)
+static void geometry_transform_points_simd(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride)
+{
+    __m128 column_x = _mm_loadu_ps(transform[0]);
+    __m128 column_y = _mm_loadu_ps(transform[1]);
+    __m128 column_w = _mm_loadu_ps(transform[3]);
+
+    for (uint32_t i = 0; i < points_count; ++i) {
+        __m128 x = _mm_set1_ps(points[i][0]);
+        __m128 y = _mm_set1_ps(points[i][1]);
+
+        _mm_storeu_ps(PTR_OFFSET(dest, i * dest_stride), _mm_add_ps(_mm_add_ps(_mm_mul_ps(column_x, x), _mm_mul_ps(column_y, y)), column_w));
+    }
+}
+#elif defined(GEOMETRY_SIMD_NEON)
+static void geometry_transform_points_simd(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride)
+{
+    float32x4_t column_x = vld1q_f32(transform[0]);
+    float32x4_t column_y = vld1q_f32(transform[1]);
+    float32x4_t column_w = vld1q_f32(transform[3]);
+
+    for (uint32_t i = 0; i < points_count; ++i)
+        vst1q_f32(PTR_OFFSET(dest, i * dest_stride), vmlaq_n_f32(vmlaq_n_f32(column_w, column_x, points[i][0]), column_y, points[i][1]));
+}
+#endif
+
+void geometry_transform_points(mat4 transform, const vec2 *points, uint32_t points_count, void *dest, size_t dest_stride)
+{
+#ifdef GEOMETRY_SIMD_WIDTH
+    geometry_transform_points_simd(transform, points, points_count, dest, dest_stride);
+#else
+    geometry_transform_points_scalar(transform, points, points_count, dest, dest_stride);
+#endif
+}
+
+void geometry_generate_arc(const vec2 center, const vec2 radii, float start_angle, float angle_step, uint32_t points_count, vec2 *dest)
+{
+#ifdef GEOMETRY_SIMD_WIDTH
+    if (points_count >= GEOMETRY_SIMD_WIDTH) {
+        geometry_generate_arc_simd(center, radii, start_angle, angle_step, points_count, dest);
+        return;
+    }
+#endif
+    geometry_generate_arc_scalar(center, radii, start_angle, angle_step, points_count, dest);
+}
+
+void geometry_generate_circle(const vec2 center, float radius, uint32_t points_count, vec2 *dest)
+{
+    geometry_generate_arc(center, (vec2) {radius, radius}, 0.0f, 2.0f * GLM_PIf / points_count, points_count, dest);
+}
+
+void geometry_generate_ellipse(const vec2 center, const vec2 radii, uint32_t points_count, vec2 *dest)
+{
+    geometry_generate_arc(center, radii, 0.0f, 2.0f * GLM_PIf / points_count, points_count, dest);
+}
+
+void geometry_generate_regular_polygon(const vec2 center, float radius, uint32_t sides_count, float rotation, vec2 *dest)
+{
+    geometry_generate_arc(center, (vec2) {radius, radius}, rotation, 2.0f * GLM_PIf / sides_count, sides_count, dest);
+}
+
+void geometry_generate_rounded_rectangle(const vec2 center, const vec2 half_size, float corner_radius, uint32_t corner_points_count, vec2 *dest)
+{
+    float radius = fminf(corner_radius, fminf(half_size[0], half_size[1]));
+    float inner_x = half_size[0] - radius;
+    float inner_y = half_size[1] - radius;
+    float angle_step = corner_points_count > 1 ? GLM_PI_2f / (corner_points_count - 1) : 0.0f;
+    float start_offset = corner_points_count > 1 ? 0.0f : GLM_PI_4f;
+    vec2 corners[] = {
+        {center[0] + inner_x, center[1] + inner_y},
+        {center[0] - inner_x, center[1] + inner_y},
+        {center[0] - inner_x, center[1] - inner_y},
+        {center[0] + inner_x, center[1] - inner_y}
+    };
+
+    for (uint32_t corner = 0; corner < 4; ++corner)
+        geometry_generate_arc(corners[corner], (vec2) {radius, radius}, GLM_PI_2f * corner + start_offset, angle_step,
+            corner_points_count, dest + corner * corner_points_count);
+}
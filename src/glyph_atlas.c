@@ -0,0 +1,243 @@
+#include "glyph_atlas.h"
+#include "utils.h"
+#include <math.h>
+#include <string.h>
+
+static uint32_t glyph_atlas_hash(const glyph_atlas_t atlas, const struct font *font, uint32_t index)
+{
+    uint64_t key = (uint64_t) (uintptr_t) font ^ ((uint64_t) index * 0x9E3779B97F4A7C15ull);
+
+    return (uint32_t) (key ^ key >> 29 ^ key >> 47) & (atlas->buckets_count - 1);
+}
+
+bool glyph_atlas_init(glyph_atlas_t atlas, allocator_t allocator, uint32_t size, uint32_t cell_size)
+{
+    memset(atlas, 0, sizeof(struct glyph_atlas));
+    if (cell_size == 0 || cell_size > size)
+        return false;
+
+    atlas->allocator = allocator;
+    atlas->size = size;
+    atlas->cell_size = cell_size;
+    atlas->cells_per_row = size / cell_size;
+    atlas->cells_count = atlas->cells_per_row * atlas->cells_per_row;
+    atlas->buckets_count = 1;
+    while (atlas->buckets_count < atlas->cells_count * 2)
+        atlas->buckets_count *= 2;
+
+    atlas->pixels = allocator_allocate_zeroed(allocator, size, size, ALLOCATOR_SUBSYSTEM_TEXT);
+    atlas->glyphs = allocator_allocate_zeroed(allocator, atlas->cells_count, sizeof(struct glyph), ALLOCATOR_SUBSYSTEM_TEXT);
+    atlas->buckets = allocator_allocate(allocator, atlas->buckets_count * sizeof(uint32_t), ALLOCATOR_SUBSYSTEM_TEXT);
+    if (!atlas->pixels || !atlas->glyphs || !atlas->buckets) {
+        glyph_atlas_cleanup(atlas);
+        return false;
+    }
+    memset(atlas->buckets, 0xFF, atlas->buckets_count * sizeof(uint32_t));
+    atlas->most_recent = GLYPH_ATLAS_NONE;
+    atlas->least_recent = GLYPH_ATLAS_NONE;
+    atlas->dirty_first_row = 0;
+    atlas->dirty_last_row = size;
+    // Free cells are of frame 0, never the current one
+    atlas->frame = 1;
+    return true;
+}
+
+void glyph_atlas_cleanup(glyph_atlas_t atlas)
+{
+    if (atlas->pixels)
+        allocator_free(atlas->allocator, atlas->pixels, ALLOCATOR_SUBSYSTEM_TEXT);
+    if (atlas->glyphs)
+        allocator_free(atlas->allocator, atlas->glyphs, ALLOCATOR_SUBSYSTEM_TEXT);
+    if (atlas->buckets)
+        allocator_free(atlas->allocator, atlas->buckets, ALLOCATOR_SUBSYSTEM_TEXT);
+    atlas->pixels = NULL;
+    atlas->glyphs = NULL;
+    atlas->buckets = NULL;
+}
+
+static void glyph_atlas_unlink(glyph_atlas_t atlas, uint32_t cell)
+{
+    struct glyph *glyph = &atlas->glyphs[cell];
+
+    if (glyph->previous != GLYPH_ATLAS_NONE)
+        atlas->glyphs[glyph->previous].next = glyph->next;
+    else
+        atlas->most_recent = glyph->next;
+    if (glyph->next != GLYPH_ATLAS_NONE)
+        atlas->glyphs[glyph->next].previous = glyph->previous;
+    else
+        atlas->least_recent = glyph->previous;
+}
+
+static void glyph_atlas_link_most_recent(glyph_atlas_t atlas, uint32_t cell)
+{
+    struct glyph *glyph = &atlas->glyphs[cell];
+
+    glyph->previous = GLYPH_ATLAS_NONE;
+    glyph->next = atlas->most_recent;
+    if (atlas->most_recent != GLYPH_ATLAS_NONE)
+        atlas->glyphs[atlas->most_recent].previous = cell;
+    else
+        atlas->least_recent = cell;
+    atlas->most_recent = cell;
+}
+
+// Free cells are linked as the least recent ones so that they are used before any glyph is evicted
+static void glyph_atlas_link_free(glyph_atlas_t atlas, uint32_t cell)
+{
+    struct glyph *glyph = &atlas->glyphs[cell];
+
+    glyph->font = NULL;
+    glyph->frame = 0;
+    glyph->hash_next = GLYPH_ATLAS_NONE;
+    glyph->previous = atlas->least_recent;
+    glyph->next = GLYPH_ATLAS_NONE;
+    if (atlas->least_recent != GLYPH_ATLAS_NONE)
+        atlas->glyphs[atlas->least_recent].next = cell;
+    else
+        atlas->most_recent = cell;
+    atlas->least_recent = cell;
+}
+
+static void glyph_atlas_remove_from_bucket(glyph_atlas_t atlas, uint32_t cell)
+{
+    struct glyph *glyph = &atlas->glyphs[cell];
+    uint32_t *link = &atlas->buckets[glyph_atlas_hash(atlas, glyph->font, glyph->index)];
+
+    while (*link != cell)
+        link = &atlas->glyphs[*link].hash_next;
+    *link = glyph->hash_next;
+}
+
+// A free cell, or the cell of the least recently drawn glyph if it wasn't drawn in the current frame
+static uint32_t glyph_atlas_take_cell(glyph_atlas_t atlas)
+{
+    uint32_t cell = atlas->least_recent;
+
+    if (atlas->used_cells_count < atlas->cells_count)
+        return atlas->used_cells_count++;
+    if (cell == GLYPH_ATLAS_NONE || atlas->glyphs[cell].frame == atlas->frame)
+        return GLYPH_ATLAS_NONE;
+
+    glyph_atlas_unlink(atlas, cell);
+    if (atlas->glyphs[cell].font) {
+        glyph_atlas_remove_from_bucket(atlas, cell);
+        atlas->evicted_count++;
+    }
+    return cell;
+}
+
+/*
+    The glyph is scaled to GLYPH_ATLAS_EM_PER_CELL em per cell, or less if its box doesn't fit, and its box is placed
+    at the top left of the cell inside the spread. The quad covers the box and the spread around it, the whole cell is
+    rasterized so that no pixel of an evicted glyph is left around the new one
+*/
+static bool glyph_atlas_rasterize(glyph_atlas_t atlas, uint32_t cell, const struct font *font, uint32_t index, const int16_t box[4])
+{
+    struct glyph *glyph = &atlas->glyphs[cell];
+    float inner_size = atlas->cell_size - 2.0f * GLYPH_ATLAS_SPREAD;
+    float box_width = (float) (box[2] - box[0]);
+    float box_height = (float) (box[3] - box[1]);
+    float scale = inner_size / (GLYPH_ATLAS_EM_PER_CELL * font->units_per_em);
+    uint32_t cell_x = (cell % atlas->cells_per_row) * atlas->cell_size;
+    uint32_t cell_y = (cell / atlas->cells_per_row) * atlas->cell_size;
+
+    if (inner_size <= 0.0f)
+        return false;
+    scale = fminf(scale, inner_size / fmaxf(box_width, box_height));
+
+    vec2 origin = {GLYPH_ATLAS_SPREAD - box[0] * scale, GLYPH_ATLAS_SPREAD + box[3] * scale};
+    float used_width = fminf(ceilf(box_width * scale) + 2.0f * GLYPH_ATLAS_SPREAD, (float) atlas->cell_size);
+    float used_height = fminf(ceilf(box_height * scale) + 2.0f * GLYPH_ATLAS_SPREAD, (float) atlas->cell_size);
+    float em_per_pixel = 1.0f / (scale * font->units_per_em);
+
+    if (!font_rasterize_glyph_sdf(font, atlas->allocator, index, scale, origin, GLYPH_ATLAS_SPREAD,
+        atlas->pixels + (size_t) cell_y * atlas->size + cell_x, atlas->cell_size, atlas->cell_size, atlas->size))
+        return false;
+
+    glyph->plane[0] = -origin[0] * em_per_pixel;
+    glyph->plane[1] = (origin[1] - used_height) * em_per_pixel;
+    glyph->plane[2] = (used_width - origin[0]) * em_per_pixel;
+    glyph->plane[3] = origin[1] * em_per_pixel;
+    glyph->uv_rect[0] = (float) cell_x / atlas->size;
+    glyph->uv_rect[1] = (cell_y + used_height) / atlas->size;
+    glyph->uv_rect[2] = (cell_x + used_width) / atlas->size;
+    glyph->uv_rect[3] = (float) cell_y / atlas->size;
+
+    if (atlas->dirty_first_row == atlas->dirty_last_row) {
+        atlas->dirty_first_row = cell_y;
+        atlas->dirty_last_row = cell_y + atlas->cell_size;
+    } else {
+        atlas->dirty_first_row = cell_y < atlas->dirty_first_row ? cell_y : atlas->dirty_first_row;
+        atlas->dirty_last_row = cell_y + atlas->cell_size > atlas->dirty_last_row ? cell_y + atlas->cell_size : atlas->dirty_last_row;
+    }
+    atlas->rasterized_count++;
+    return true;
+}
+
+bool glyph_atlas_acquire(glyph_atlas_t atlas, const struct font *font, uint32_t index, const struct glyph **glyph)
+{
+    uint32_t bucket = glyph_atlas_hash(atlas, font, index);
+    uint32_t cell = atlas->buckets[bucket];
+    int16_t box[4];
+
+    while (cell != GLYPH_ATLAS_NONE && (atlas->glyphs[cell].font != font || atlas->glyphs[cell].index != index))
+        cell = atlas->glyphs[cell].hash_next;
+
+    if (cell == GLYPH_ATLAS_NONE) {
+        *glyph = NULL;
+        if (!font_get_glyph_box(font, index, box))
+            return true;
+        cell = glyph_atlas_take_cell(atlas);
+        if (cell == GLYPH_ATLAS_NONE) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Glyph atlas is full\n", 21);
+            #endif
+            return false;
+        }
+        if (!glyph_atlas_rasterize(atlas, cell, font, index, box)) {
+            glyph_atlas_link_free(atlas, cell);
+            return false;
+        }
+        atlas->glyphs[cell].font = font;
+        atlas->glyphs[cell].index = index;
+        atlas->glyphs[cell].hash_next = atlas->buckets[bucket];
+        atlas->buckets[bucket] = cell;
+        glyph_atlas_link_most_recent(atlas, cell);
+    } else if (atlas->most_recent != cell) {
+        glyph_atlas_unlink(atlas, cell);
+        glyph_atlas_link_most_recent(atlas, cell);
+    }
+
+    atlas->glyphs[cell].frame = atlas->frame;
+    *glyph = &atlas->glyphs[cell];
+    return true;
+}
+
+void glyph_atlas_remove_font(glyph_atlas_t atlas, const struct font *font)
+{
+    for (uint32_t cell = 0; cell < atlas->used_cells_count; ++cell) {
+        if (atlas->glyphs[cell].font != font)
+            continue;
+        glyph_atlas_remove_from_bucket(atlas, cell);
+        glyph_atlas_unlink(atlas, cell);
+        glyph_atlas_link_free(atlas, cell);
+    }
+}
+
+bool glyph_atlas_flush(glyph_atlas_t atlas, uint32_t *first_row, uint32_t *rows_count)
+{
+    if (atlas->dirty_first_row == atlas->dirty_last_row)
+        return false;
+
+    *first_row = atlas->dirty_first_row;
+    *rows_count = atlas->dirty_last_row - atlas->dirty_first_row;
+    atlas->dirty_first_row = 0;
+    atlas->dirty_last_row = 0;
+    return true;
+}
+
+void glyph_atlas_next_frame(glyph_atlas_t atlas)
+{
+    atlas->frame++;
+}
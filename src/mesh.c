@@ -0,0 +1,412 @@
+#include "mesh.h"
+#include "engine.h"
+#include "geometry.h"
+
+static uint64_t mesh_hash_content(vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    const struct mesh_lod *lods, uint32_t lods_count, enum mesh_topology topology)
+{
+    uint32_t key[] = {vertices_count, (uint32_t) topology};
+    uint64_t hash = hash_fnv1a(key, sizeof(key), HASH_FNV1A_OFFSET_BASIS);
+
+    hash = hash_fnv1a(positions, sizeof(vec2) * vertices_count, hash);
+    hash = hash_fnv1a(&indices_count, sizeof(uint32_t), hash);
+    hash = hash_fnv1a(indices, sizeof(uint32_t) * indices_count, hash);
+    return hash_fnv1a(lods, sizeof(struct mesh_lod) * lods_count, hash);
+}
+
+static uint64_t mesh_hash_primitive(enum mesh_primitive primitive, uint32_t parameter)
+{
+    uint32_t key[] = {(uint32_t) primitive, parameter};
+
+    return hash_fnv1a(key, sizeof(key), HASH_FNV1A_OFFSET_BASIS);
+}
+
+static bool mesh_match_content(mesh_t mesh, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    const struct mesh_lod *lods, uint32_t lods_count, enum mesh_topology topology)
+{
+    return mesh->primitive == MESH_PRIMITIVE_NONE
+        && mesh->topology == topology
+        && mesh->vertices_count == vertices_count
+        && mesh->indices_count == indices_count
+        && mesh->lods_count == lods_count
+        && memcmp(mesh->positions, positions, sizeof(vec2) * vertices_count) == 0
+        && memcmp(mesh->indices, indices, sizeof(uint32_t) * indices_count) == 0
+        && memcmp(mesh->lods, lods, sizeof(struct mesh_lod) * lods_count) == 0;
+}
+
+/*
+    Texture coordinates are a planar mapping of the bounds of the mesh, so that a texture covers any geometry,
+    an axis of null extent maps to 0
+*/
+static void mesh_compute_uv_mapping(vec2 *positions, uint32_t vertices_count, vec2 origin, vec2 scale)
+{
+    vec2 max = {-FLT_MAX, -FLT_MAX};
+
+    glm_vec2_copy((vec2) {FLT_MAX, FLT_MAX}, origin);
+    for (uint32_t i = 0; i < vertices_count; ++i) {
+        glm_vec2_minv(origin, positions[i], origin);
+        glm_vec2_maxv(max, positions[i], max);
+    }
+    scale[0] = max[0] > origin[0] ? 1.0f / (max[0] - origin[0]) : 0.0f;
+    scale[1] = max[1] > origin[1] ? 1.0f / (max[1] - origin[1]) : 0.0f;
+}
+
+void mesh_generate_uvs(vec2 *positions, uint32_t vertices_count, struct vertex *vertices)
+{
+    vec2 origin;
+    vec2 scale;
+
+    mesh_compute_uv_mapping(positions, vertices_count, origin, scale);
+    for (uint32_t i = 0; i < vertices_count; ++i) {
+        glm_vec2_copy(positions[i], vertices[i].pos);
+        vertices[i].uv[0] = (positions[i][0] - origin[0]) * scale[0];
+        vertices[i].uv[1] = (positions[i][1] - origin[1]) * scale[1];
+    }
+}
+
+static void mesh_destroy(engine_t engine, mesh_t mesh)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    allocator_t allocator = engine->mesh_cache.allocator;
+
+    vkDestroyBuffer(context->device, mesh->vertex_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, mesh->vertex_memory, &context->allocation_callbacks);
+    vkDestroyBuffer(context->device, mesh->index_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, mesh->index_memory, &context->allocation_callbacks);
+
+    allocator_free(allocator, mesh->positions, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, mesh->indices, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, mesh, ALLOCATOR_SUBSYSTEM_MESH);
+}
+
+static bool mesh_cache_grow(mesh_cache_t cache)
+{
+    uint32_t new_buckets_count = cache->buckets_count * 2;
+    mesh_t *new_buckets = allocator_allocate_zeroed(cache->allocator, new_buckets_count, sizeof(mesh_t), ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (!new_buckets)
+        return false;
+
+    for (uint32_t i = 0; i < cache->buckets_count; ++i) {
+        mesh_t mesh = cache->buckets[i];
+
+        while (mesh) {
+            mesh_t next = mesh->next;
+            uint32_t bucket = (uint32_t) (mesh->hash & (new_buckets_count - 1));
+
+            mesh->next = new_buckets[bucket];
+            new_buckets[bucket] = mesh;
+            mesh = next;
+        }
+    }
+
+    allocator_free(cache->allocator, cache->buckets, ALLOCATOR_SUBSYSTEM_MESH);
+    cache->buckets = new_buckets;
+    cache->buckets_count = new_buckets_count;
+    return true;
+}
+
+static mesh_t mesh_cache_insert(engine_t engine, uint64_t hash, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    enum mesh_topology topology)
+{
+    mesh_cache_t cache = &engine->mesh_cache;
+    mesh_t mesh = allocator_allocate_zeroed(cache->allocator, 1, sizeof(struct mesh), ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (!mesh)
+        return NULL;
+
+    mesh->hash = hash;
+    mesh->ref_count = 1;
+    mesh->topology = topology;
+    mesh->vertices_count = vertices_count;
+    mesh->indices_count = indices_count;
+    mesh->lods[0] = (struct mesh_lod) {
+        .first_index = 0,
+        .indices_count = indices_count,
+        .segments_count = 0,
+        .error = 0.0f
+    };
+    mesh->lods_count = 1;
+    mesh->positions = allocator_allocate(cache->allocator, sizeof(vec2) * vertices_count, ALLOCATOR_SUBSYSTEM_MESH);
+    mesh->indices = allocator_allocate(cache->allocator, sizeof(uint32_t) * indices_count, ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (!mesh->positions || !mesh->indices) {
+        mesh_destroy(engine, mesh);
+        return NULL;
+    }
+    memcpy(mesh->positions, positions, sizeof(vec2) * vertices_count);
+    memcpy(mesh->indices, indices, sizeof(uint32_t) * indices_count);
+    mesh_compute_uv_mapping(positions, vertices_count, mesh->uv_origin, mesh->uv_scale);
+
+    struct vertex *vertices = allocator_allocate(cache->allocator, sizeof(struct vertex) * vertices_count, ALLOCATOR_SUBSYSTEM_MESH);
+    if (!vertices) {
+        mesh_destroy(engine, mesh);
+        return NULL;
+    }
+    mesh_generate_uvs(positions, vertices_count, vertices);
+
+    if (!vulkan_create_vertex_buffer(&engine->vulkan_context, mesh, vertices, vertices_count)
+        || !vulkan_create_index_buffer(&engine->vulkan_context, mesh, indices, indices_count, vertices_count)) {
+        allocator_free(cache->allocator, vertices, ALLOCATOR_SUBSYSTEM_MESH);
+        mesh_destroy(engine, mesh);
+        return NULL;
+    }
+    allocator_free(cache->allocator, vertices, ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (cache->meshes_count + 1 > cache->buckets_count / 4 * 3)
+        mesh_cache_grow(cache);
+
+    uint32_t bucket = (uint32_t) (hash & (cache->buckets_count - 1));
+    mesh->next = cache->buckets[bucket];
+    cache->buckets[bucket] = mesh;
+    cache->meshes_count++;
+
+    return mesh;
+}
+
+static void mesh_generate_rectangle(allocator_t allocator, vec2 **positions, uint32_t *vertices_count, uint32_t **indices, uint32_t *indices_count)
+{
+    static const uint32_t rectangle_indices[] = {
+        0, 1, 2, 2, 3, 0
+    };
+
+    *vertices_count = 4;
+    *indices_count = 6;
+    *positions = allocator_allocate(allocator, sizeof(vec2) * (*vertices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    *indices = allocator_allocate(allocator, sizeof(uint32_t) * (*indices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    if (!*positions || !*indices)
+        return;
+
+    glm_vec2_copy((vec2) {0.0f, 0.0f}, (*positions)[0]);
+    glm_vec2_copy((vec2) {1.0f, 0.0f}, (*positions)[1]);
+    glm_vec2_copy((vec2) {1.0f, 1.0f}, (*positions)[2]);
+    glm_vec2_copy((vec2) {0.0f, 1.0f}, (*positions)[3]);
+    memcpy(*indices, rectangle_indices, sizeof(rectangle_indices));
+}
+
+/*
+    Unit circle drawn as a triangle fan around its center,
+    vertex 0 is the center and vertices 1 to outside_vertices_count are on the circle
+*/
+static void mesh_generate_circle(allocator_t allocator, uint32_t outside_vertices_count, vec2 **positions, uint32_t *vertices_count, uint32_t **indices, uint32_t *indices_count)
+{
+    *vertices_count = outside_vertices_count + 1;
+    *indices_count = outside_vertices_count * 3;
+    *positions = allocator_allocate(allocator, sizeof(vec2) * (*vertices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    *indices = allocator_allocate(allocator, sizeof(uint32_t) * (*indices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    if (!*positions || !*indices)
+        return;
+
+    uint32_t indices_index = 0;
+
+    glm_vec2_zero((*positions)[0]);
+    geometry_generate_circle((vec2) {0.0f, 0.0f}, 1.0f, outside_vertices_count, *positions + 1);
+    for (uint32_t i = 1; i <= outside_vertices_count; ++i) {
+        (*indices)[indices_index++] = 0;
+        (*indices)[indices_index++] = i;
+        (*indices)[indices_index++] = (i % outside_vertices_count) + 1;
+    }
+}
+
+/*
+    Unit circle with one triangle fan per level of detail, vertex 0 is the center and vertices 1 to the finest
+    count of segments are on the circle. A coarser fan uses every other vertex of the next finer one,
+    so all levels share the vertex buffer and only the drawn index range changes
+*/
+static void mesh_generate_circle_lod(allocator_t allocator, vec2 **positions, uint32_t *vertices_count, uint32_t **indices, uint32_t *indices_count, struct mesh_lod *lods)
+{
+    uint32_t max_segments_count = MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT << (MESH_LODS_MAX_COUNT - 1);
+
+    *vertices_count = max_segments_count + 1;
+    *indices_count = 0;
+    for (uint32_t lod = 0; lod < MESH_LODS_MAX_COUNT; ++lod)
+        *indices_count += (MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT << lod) * 3;
+    *positions = allocator_allocate(allocator, sizeof(vec2) * (*vertices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    *indices = allocator_allocate(allocator, sizeof(uint32_t) * (*indices_count), ALLOCATOR_SUBSYSTEM_MESH);
+    if (!*positions || !*indices)
+        return;
+
+    uint32_t indices_index = 0;
+
+    glm_vec2_zero((*positions)[0]);
+    geometry_generate_circle((vec2) {0.0f, 0.0f}, 1.0f, max_segments_count, *positions + 1);
+
+    for (uint32_t lod = 0; lod < MESH_LODS_MAX_COUNT; ++lod) {
+        uint32_t segments_count = MESH_CIRCLE_LOD_MIN_SEGMENTS_COUNT << lod;
+        uint32_t stride = max_segments_count / segments_count;
+
+        // The chord of a segment of a circle of radius r drawn with n segments deviates from it by r * (1 - cos(pi / n))
+        lods[lod] = (struct mesh_lod) {
+            .first_index = indices_index,
+            .indices_count = segments_count * 3,
+            .segments_count = segments_count,
+            .error = lod == MESH_LODS_MAX_COUNT - 1 ? 0.0f : 1.0f - cosf(GLM_PIf / segments_count)
+        };
+        for (uint32_t i = 0; i < segments_count; ++i) {
+            (*indices)[indices_index++] = 0;
+            (*indices)[indices_index++] = i * stride + 1;
+            (*indices)[indices_index++] = ((i + 1) % segments_count) * stride + 1;
+        }
+    }
+}
+
+bool mesh_cache_init(mesh_cache_t cache, allocator_t allocator, uint32_t buckets_count)
+{
+    cache->allocator = allocator;
+    cache->buckets = allocator_allocate_zeroed(allocator, buckets_count, sizeof(mesh_t), ALLOCATOR_SUBSYSTEM_MESH);
+    cache->buckets_count = buckets_count;
+    cache->meshes_count = 0;
+
+    return cache->buckets != NULL;
+}
+
+void mesh_cache_cleanup(engine_t engine)
+{
+    mesh_cache_t cache = &engine->mesh_cache;
+
+    if (!cache->buckets)
+        return;
+
+    for (uint32_t i = 0; i < cache->buckets_count; ++i) {
+        mesh_t mesh = cache->buckets[i];
+
+        while (mesh) {
+            mesh_t next = mesh->next;
+            mesh_destroy(engine, mesh);
+            mesh = next;
+        }
+    }
+
+    allocator_free(cache->allocator, cache->buckets, ALLOCATOR_SUBSYSTEM_MESH);
+    cache->buckets = NULL;
+    cache->buckets_count = 0;
+    cache->meshes_count = 0;
+}
+
+mesh_t mesh_cache_acquire(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count)
+{
+    return mesh_cache_acquire_with_lods(engine, positions, vertices_count, indices, indices_count, NULL, 0);
+}
+
+static mesh_t mesh_cache_acquire_content(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    const struct mesh_lod *lods, uint32_t lods_count, enum mesh_topology topology)
+{
+    mesh_cache_t cache = &engine->mesh_cache;
+    struct mesh_lod whole = {
+        .first_index = 0,
+        .indices_count = indices_count,
+        .segments_count = 0,
+        .error = 0.0f
+    };
+
+    if (!lods || lods_count == 0) {
+        lods = &whole;
+        lods_count = 1;
+    }
+    if (lods_count > MESH_LODS_MAX_COUNT)
+        return NULL;
+
+    uint64_t hash = mesh_hash_content(positions, vertices_count, indices, indices_count, lods, lods_count, topology);
+
+    for (mesh_t mesh = cache->buckets[hash & (cache->buckets_count - 1)]; mesh; mesh = mesh->next) {
+        if (mesh->hash == hash && mesh_match_content(mesh, positions, vertices_count, indices, indices_count, lods, lods_count, topology)) {
+            mesh->ref_count++;
+            return mesh;
+        }
+    }
+
+    mesh_t mesh = mesh_cache_insert(engine, hash, positions, vertices_count, indices, indices_count, topology);
+
+    if (mesh) {
+        memcpy(mesh->lods, lods, sizeof(struct mesh_lod) * lods_count);
+        mesh->lods_count = lods_count;
+    }
+    return mesh;
+}
+
+mesh_t mesh_cache_acquire_with_lods(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count,
+    const struct mesh_lod *lods, uint32_t lods_count)
+{
+    return mesh_cache_acquire_content(engine, positions, vertices_count, indices, indices_count, lods, lods_count, MESH_TOPOLOGY_TRIANGLE_LIST);
+}
+
+mesh_t mesh_cache_acquire_with_topology(engine_t engine, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count, enum mesh_topology topology)
+{
+    return mesh_cache_acquire_content(engine, positions, vertices_count, indices, indices_count, NULL, 0, topology);
+}
+
+mesh_t mesh_cache_acquire_primitive(engine_t engine, enum mesh_primitive primitive, uint32_t parameter)
+{
+    mesh_cache_t cache = &engine->mesh_cache;
+
+    if (primitive != MESH_PRIMITIVE_CIRCLE)
+        parameter = 0;
+    if (primitive == MESH_PRIMITIVE_NONE || (primitive == MESH_PRIMITIVE_CIRCLE && parameter < 3))
+        return NULL;
+
+    uint64_t hash = mesh_hash_primitive(primitive, parameter);
+
+    for (mesh_t mesh = cache->buckets[hash & (cache->buckets_count - 1)]; mesh; mesh = mesh->next) {
+        if (mesh->hash == hash && mesh->primitive == primitive && mesh->primitive_parameter == parameter) {
+            mesh->ref_count++;
+            return mesh;
+        }
+    }
+
+    vec2 *positions = NULL;
+    uint32_t *indices = NULL;
+    uint32_t vertices_count = 0;
+    uint32_t indices_count = 0;
+    struct mesh_lod lods[MESH_LODS_MAX_COUNT];
+    mesh_t mesh = NULL;
+
+    if (primitive == MESH_PRIMITIVE_RECTANGLE)
+        mesh_generate_rectangle(cache->allocator, &positions, &vertices_count, &indices, &indices_count);
+    else if (primitive == MESH_PRIMITIVE_CIRCLE_LOD)
+        mesh_generate_circle_lod(cache->allocator, &positions, &vertices_count, &indices, &indices_count, lods);
+    else
+        mesh_generate_circle(cache->allocator, parameter, &positions, &vertices_count, &indices, &indices_count);
+
+    if (positions && indices)
+        mesh = mesh_cache_insert(engine, hash, positions, vertices_count, indices, indices_count, MESH_TOPOLOGY_TRIANGLE_LIST);
+    if (mesh) {
+        mesh->primitive = primitive;
+        mesh->primitive_parameter = parameter;
+        if (primitive == MESH_PRIMITIVE_CIRCLE_LOD) {
+            memcpy(mesh->lods, lods, sizeof(lods));
+            mesh->lods_count = MESH_LODS_MAX_COUNT;
+        }
+    }
+
+    allocator_free(cache->allocator, positions, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(cache->allocator, indices, ALLOCATOR_SUBSYSTEM_MESH);
+    return mesh;
+}
+
+void mesh_cache_release(engine_t engine, mesh_t mesh)
+{
+    mesh_cache_t cache = &engine->mesh_cache;
+
+    if (!mesh || --mesh->ref_count > 0)
+        return;
+
+    mesh_t *link = &cache->buckets[mesh->hash & (cache->buckets_count - 1)];
+    while (*link && *link != mesh)
+        link = &(*link)->next;
+    if (*link)
+        *link = mesh->next;
+    cache->meshes_count--;
+
+    mesh_destroy(engine, mesh);
+}
+
+uint32_t mesh_select_lod(mesh_t mesh, float pixels_per_unit, float error_tolerance, uint32_t current_lod, float hysteresis)
+{
+    for (uint32_t i = 0; i + 1 < mesh->lods_count; ++i) {
+        float tolerance = i < current_lod ? error_tolerance * hysteresis : error_tolerance;
+
+        if (mesh->lods[i].error * pixels_per_unit <= tolerance)
+            return i;
+    }
+    return mesh->lods_count - 1;
+}
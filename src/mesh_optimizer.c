@@ -0,0 +1,519 @@
+#include "mesh_optimizer.h"
+#include <string.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+#define MESH_OPTIMIZER_NO_VERTEX UINT32_MAX
+
+/*
+    Vertex cache emulated with timestamps, as in Tipsify:
+    a vertex is in the FIFO cache if less than `cache_size` vertices were loaded since its own loading
+*/
+static bool mesh_optimizer_is_cached(uint32_t *cache_time, uint32_t timestamp, uint32_t vertex, uint32_t cache_size)
+{
+    return timestamp - cache_time[vertex] <= cache_size;
+}
+
+static uint32_t mesh_optimizer_skip_dead_end(uint32_t *live, uint32_t *dead_end, uint32_t *dead_end_count, uint32_t *cursor, uint32_t vertices_count)
+{
+    while (*dead_end_count > 0) {
+        uint32_t vertex = dead_end[--(*dead_end_count)];
+
+        if (live[vertex] > 0)
+            return vertex;
+    }
+
+    for (; *cursor < vertices_count; ++(*cursor)) {
+        if (live[*cursor] > 0)
+            return *cursor;
+    }
+
+    return MESH_OPTIMIZER_NO_VERTEX;
+}
+
+static uint32_t mesh_optimizer_next_vertex(uint32_t *live, uint32_t *cache_time, uint32_t timestamp, uint32_t cache_size,
+    uint32_t *candidates, uint32_t candidates_count)
+{
+    uint32_t best_vertex = MESH_OPTIMIZER_NO_VERTEX;
+    int64_t best_priority = -1;
+
+    for (uint32_t i = 0; i < candidates_count; ++i) {
+        uint32_t vertex = candidates[i];
+        int64_t priority = 0;
+
+        if (live[vertex] == 0)
+            continue;
+        // prefer the oldest vertex still in the cache once all its remaining triangles are emitted
+        if ((int64_t) (timestamp - cache_time[vertex]) + 2 * (int64_t) live[vertex] <= cache_size)
+            priority = timestamp - cache_time[vertex];
+        if (priority > best_priority) {
+            best_priority = priority;
+            best_vertex = vertex;
+        }
+    }
+
+    return best_vertex;
+}
+
+bool mesh_optimize_vertex_cache(allocator_t allocator, uint32_t *indices, uint32_t indices_count, uint32_t vertices_count, uint32_t cache_size)
+{
+    uint32_t triangles_count = indices_count / 3;
+
+    if (triangles_count == 0 || vertices_count == 0)
+        return true;
+
+    // offsets, live, cache_time, adjacency, dead_end, candidates, output, emitted
+    size_t buffer_size = (size_t) (vertices_count + 1) + vertices_count * 2 + (size_t) indices_count * 4 + triangles_count;
+    uint32_t *buffer = allocator_allocate_zeroed(allocator, buffer_size, sizeof(uint32_t), ALLOCATOR_SUBSYSTEM_MESH);
+    if (!buffer)
+        return false;
+
+    uint32_t *offsets = buffer;
+    uint32_t *live = offsets + vertices_count + 1;
+    uint32_t *cache_time = live + vertices_count;
+    uint32_t *adjacency = cache_time + vertices_count;
+    uint32_t *dead_end = adjacency + indices_count;
+    uint32_t *candidates = dead_end + indices_count;
+    uint32_t *output = candidates + indices_count;
+    uint32_t *emitted = output + indices_count;
+
+    for (uint32_t i = 0; i < triangles_count * 3; ++i)
+        live[indices[i]]++;
+    for (uint32_t i = 0; i < vertices_count; ++i) {
+        offsets[i + 1] = offsets[i] + live[i];
+        cache_time[i] = offsets[i];
+    }
+    for (uint32_t i = 0; i < triangles_count * 3; ++i)
+        adjacency[cache_time[indices[i]]++] = i / 3;
+    memset(cache_time, 0, sizeof(uint32_t) * vertices_count);
+
+    uint32_t timestamp = cache_size + 1;
+    uint32_t cursor = 0;
+    uint32_t dead_end_count = 0;
+    uint32_t output_count = 0;
+    uint32_t fanning_vertex = 0;
+
+    while (fanning_vertex != MESH_OPTIMIZER_NO_VERTEX) {
+        uint32_t candidates_count = 0;
+
+        for (uint32_t i = offsets[fanning_vertex]; i < offsets[fanning_vertex + 1]; ++i) {
+            uint32_t triangle = adjacency[i];
+
+            if (emitted[triangle])
+                continue;
+            for (uint32_t j = 0; j < 3; ++j) {
+                uint32_t vertex = indices[triangle * 3 + j];
+
+                output[output_count++] = vertex;
+                dead_end[dead_end_count++] = vertex;
+                candidates[candidates_count++] = vertex;
+                live[vertex]--;
+                if (!mesh_optimizer_is_cached(cache_time, timestamp, vertex, cache_size))
+                    cache_time[vertex] = timestamp++;
+            }
+            emitted[triangle] = 1;
+        }
+
+        fanning_vertex = mesh_optimizer_next_vertex(live, cache_time, timestamp, cache_size, candidates, candidates_count);
+        if (fanning_vertex == MESH_OPTIMIZER_NO_VERTEX)
+            fanning_vertex = mesh_optimizer_skip_dead_end(live, dead_end, &dead_end_count, &cursor, vertices_count);
+    }
+
+    memcpy(indices, output, sizeof(uint32_t) * output_count);
+    allocator_free(allocator, buffer, ALLOCATOR_SUBSYSTEM_MESH);
+    return true;
+}
+
+bool mesh_optimize_vertex_fetch(allocator_t allocator, vec2 *positions, uint32_t vertices_count, uint32_t *indices, uint32_t indices_count)
+{
+    uint32_t *remap = allocator_allocate(allocator, sizeof(uint32_t) * vertices_count, ALLOCATOR_SUBSYSTEM_MESH);
+    vec2 *reordered_positions = allocator_allocate(allocator, sizeof(vec2) * vertices_count, ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (!remap || !reordered_positions) {
+        allocator_free(allocator, remap, ALLOCATOR_SUBSYSTEM_MESH);
+        allocator_free(allocator, reordered_positions, ALLOCATOR_SUBSYSTEM_MESH);
+        return false;
+    }
+
+    uint32_t next_vertex = 0;
+    memset(remap, 0xff, sizeof(uint32_t) * vertices_count);
+
+    for (uint32_t i = 0; i < indices_count; ++i) {
+        uint32_t vertex = indices[i];
+
+        if (remap[vertex] == MESH_OPTIMIZER_NO_VERTEX)
+            remap[vertex] = next_vertex++;
+        indices[i] = remap[vertex];
+    }
+    for (uint32_t i = 0; i < vertices_count; ++i) {
+        if (remap[i] == MESH_OPTIMIZER_NO_VERTEX)
+            remap[i] = next_vertex++;
+        glm_vec2_copy(positions[i], reordered_positions[remap[i]]);
+    }
+
+    memcpy(positions, reordered_positions, sizeof(vec2) * vertices_count);
+    allocator_free(allocator, remap, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, reordered_positions, ALLOCATOR_SUBSYSTEM_MESH);
+    return true;
+}
+
+float mesh_compute_acmr(allocator_t allocator, const uint32_t *indices, uint32_t indices_count, uint32_t vertices_count, uint32_t cache_size)
+{
+    uint32_t triangles_count = indices_count / 3;
+
+    if (triangles_count == 0)
+        return 0.0f;
+
+    uint32_t *cache_time = allocator_allocate_zeroed(allocator, vertices_count, sizeof(uint32_t), ALLOCATOR_SUBSYSTEM_MESH);
+    if (!cache_time)
+        return -1.0f;
+
+    uint32_t timestamp = cache_size + 1;
+    uint32_t misses = 0;
+
+    for (uint32_t i = 0; i < triangles_count * 3; ++i) {
+        if (!mesh_optimizer_is_cached(cache_time, timestamp, indices[i], cache_size)) {
+            cache_time[indices[i]] = timestamp++;
+            misses++;
+        }
+    }
+
+    allocator_free(allocator, cache_time, ALLOCATOR_SUBSYSTEM_MESH);
+    return (float) misses / triangles_count;
+}
+
+/*
+    Simplification by half-edge collapses, the quadric error metric of Garland and Heckbert reduced to 2D:
+    only the outline of a flat mesh carries error, so a quadric is the sum of the squared distances to the lines
+    of the outline edges a vertex absorbed. Every pass collapses the cheapest independent edges, no two collapses
+    of a pass touching the same triangle, then the index buffer and its adjacency are rebuilt.
+    Lines are weighted by the length of their edge and the error is the weighted root mean square distance to them,
+    a plain sum would grow with the count of absorbed edges and overestimate the error of long curved outlines
+*/
+enum mesh_simplify_kind {
+    MESH_SIMPLIFY_INTERIOR = 0,
+    MESH_SIMPLIFY_BORDER,
+    MESH_SIMPLIFY_LOCKED
+};
+
+struct mesh_simplify_quadric {
+    double a2;
+    double ab;
+    double ac;
+    double b2;
+    double bc;
+    double c2;
+    double weight;
+};
+
+struct mesh_simplify_collapse {
+    uint32_t vertex;
+    uint32_t target;
+    uint32_t removed_triangles_count;
+    double cost;
+};
+
+struct mesh_simplify_adjacency {
+    uint32_t *offsets;
+    uint32_t *triangles;
+};
+
+static void mesh_simplify_add_line(struct mesh_simplify_quadric *quadric, const vec2 from, const vec2 to)
+{
+    double dx = (double) to[0] - from[0];
+    double dy = (double) to[1] - from[1];
+    double length = sqrt(dx * dx + dy * dy);
+
+    if (length <= 0.0)
+        return;
+
+    double a = -dy / length;
+    double b = dx / length;
+    double c = -(a * from[0] + b * from[1]);
+
+    quadric->a2 += a * a * length;
+    quadric->ab += a * b * length;
+    quadric->ac += a * c * length;
+    quadric->b2 += b * b * length;
+    quadric->bc += b * c * length;
+    quadric->c2 += c * c * length;
+    quadric->weight += length;
+}
+
+static void mesh_simplify_add_quadric(struct mesh_simplify_quadric *quadric, const struct mesh_simplify_quadric *other)
+{
+    quadric->a2 += other->a2;
+    quadric->ab += other->ab;
+    quadric->ac += other->ac;
+    quadric->b2 += other->b2;
+    quadric->bc += other->bc;
+    quadric->c2 += other->c2;
+    quadric->weight += other->weight;
+}
+
+static double mesh_simplify_quadric_error(const struct mesh_simplify_quadric *quadric, const vec2 position)
+{
+    double x = position[0];
+    double y = position[1];
+    double error = quadric->a2 * x * x + 2.0 * quadric->ab * x * y + 2.0 * quadric->ac * x
+        + quadric->b2 * y * y + 2.0 * quadric->bc * y + quadric->c2;
+
+    return error > 0.0 && quadric->weight > 0.0 ? error / quadric->weight : 0.0;
+}
+
+static float mesh_simplify_area(const vec2 *positions, uint32_t a, uint32_t b, uint32_t c)
+{
+    return (positions[b][0] - positions[a][0]) * (positions[c][1] - positions[a][1])
+        - (positions[b][1] - positions[a][1]) * (positions[c][0] - positions[a][0]);
+}
+
+static void mesh_simplify_build_adjacency(struct mesh_simplify_adjacency *adjacency, uint32_t *cursors, const uint32_t *indices, uint32_t indices_count, uint32_t vertices_count)
+{
+    memset(adjacency->offsets, 0, sizeof(uint32_t) * (vertices_count + 1));
+    for (uint32_t i = 0; i < indices_count; ++i)
+        adjacency->offsets[indices[i] + 1]++;
+    for (uint32_t i = 0; i < vertices_count; ++i) {
+        adjacency->offsets[i + 1] += adjacency->offsets[i];
+        cursors[i] = adjacency->offsets[i];
+    }
+    for (uint32_t i = 0; i < indices_count; ++i)
+        adjacency->triangles[cursors[indices[i]]++] = i / 3;
+}
+
+static bool mesh_simplify_has_edge(const struct mesh_simplify_adjacency *adjacency, const uint32_t *indices, uint32_t from, uint32_t to)
+{
+    for (uint32_t i = adjacency->offsets[from]; i < adjacency->offsets[from + 1]; ++i) {
+        const uint32_t *triangle = &indices[adjacency->triangles[i] * 3];
+
+        for (uint32_t j = 0; j < 3; ++j) {
+            if (triangle[j] == from && triangle[(j + 1) % 3] == to)
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool mesh_simplify_is_border_edge(const struct mesh_simplify_adjacency *adjacency, const uint32_t *indices, uint32_t a, uint32_t b)
+{
+    return mesh_simplify_has_edge(adjacency, indices, a, b) != mesh_simplify_has_edge(adjacency, indices, b, a);
+}
+
+static bool mesh_simplify_is_neighbour(const struct mesh_simplify_adjacency *adjacency, const uint32_t *indices, uint32_t vertex, uint32_t other)
+{
+    for (uint32_t i = adjacency->offsets[vertex]; i < adjacency->offsets[vertex + 1]; ++i) {
+        const uint32_t *triangle = &indices[adjacency->triangles[i] * 3];
+
+        if (triangle[0] == other || triangle[1] == other || triangle[2] == other)
+            return true;
+    }
+    return false;
+}
+
+/*
+    A collapse of `vertex` into `target` is valid if the outline keeps its topology, the only common neighbours
+    of both vertices are the ones of the triangles they share, and no remaining triangle of `vertex` flips or vanishes.
+    Returns the count of triangles removed by the collapse, 0 if it is invalid
+*/
+static uint32_t mesh_simplify_check_collapse(const struct mesh_simplify_adjacency *adjacency, const uint32_t *indices, const vec2 *positions,
+    uint32_t vertex, uint32_t target)
+{
+    uint32_t shared_triangles_count = 0;
+    uint32_t common_neighbours_count = 0;
+
+    for (uint32_t i = adjacency->offsets[vertex]; i < adjacency->offsets[vertex + 1]; ++i) {
+        const uint32_t *triangle = &indices[adjacency->triangles[i] * 3];
+
+        if (triangle[0] == target || triangle[1] == target || triangle[2] == target) {
+            // A triangle bordered on its three sides is the last one of its piece of mesh
+            if (mesh_simplify_is_border_edge(adjacency, indices, triangle[0], triangle[1])
+                && mesh_simplify_is_border_edge(adjacency, indices, triangle[1], triangle[2])
+                && mesh_simplify_is_border_edge(adjacency, indices, triangle[2], triangle[0]))
+                return 0;
+            shared_triangles_count++;
+            continue;
+        }
+
+        uint32_t corners[3] = {triangle[0], triangle[1], triangle[2]};
+        float area = mesh_simplify_area(positions, corners[0], corners[1], corners[2]);
+
+        for (uint32_t j = 0; j < 3; ++j) {
+            if (corners[j] == vertex)
+                corners[j] = target;
+        }
+        float collapsed_area = mesh_simplify_area(positions, corners[0], corners[1], corners[2]);
+
+        if (area > 0.0f ? collapsed_area <= area * 1e-3f : collapsed_area >= area * 1e-3f)
+            return 0;
+
+        // Both other corners are neighbours of `vertex`, count the ones also neighbours of `target` once per corner
+        for (uint32_t j = 0; j < 3; ++j) {
+            if (triangle[j] != vertex && mesh_simplify_is_neighbour(adjacency, indices, triangle[j], target))
+                common_neighbours_count++;
+        }
+    }
+
+    /*
+        The corner opposite to the collapsed edge in each shared triangle is also a corner of the next triangle around `vertex`,
+        so it is counted once. Any other common neighbour would fold the mesh once both vertices are merged
+    */
+    if (common_neighbours_count > shared_triangles_count)
+        return 0;
+    return shared_triangles_count;
+}
+
+static int mesh_simplify_compare_collapses(const void *a, const void *b)
+{
+    double cost_a = ((const struct mesh_simplify_collapse *) a)->cost;
+    double cost_b = ((const struct mesh_simplify_collapse *) b)->cost;
+
+    return (cost_a > cost_b) - (cost_a < cost_b);
+}
+
+bool mesh_simplify(allocator_t allocator, const vec2 *positions, uint32_t vertices_count, const uint32_t *indices, uint32_t indices_count,
+    uint32_t target_indices_count, float target_error, uint32_t *destination, uint32_t *destination_count, float *result_error)
+{
+    // offsets, triangles, cursors, kinds, touched, remap
+    size_t buffer_size = (size_t) (vertices_count + 1) + indices_count + (size_t) vertices_count * 4;
+    uint32_t *buffer = allocator_allocate(allocator, sizeof(uint32_t) * buffer_size, ALLOCATOR_SUBSYSTEM_MESH);
+    struct mesh_simplify_quadric *quadrics = allocator_allocate_zeroed(allocator, vertices_count, sizeof(struct mesh_simplify_quadric), ALLOCATOR_SUBSYSTEM_MESH);
+    struct mesh_simplify_collapse *collapses = allocator_allocate(allocator, sizeof(struct mesh_simplify_collapse) * vertices_count, ALLOCATOR_SUBSYSTEM_MESH);
+
+    if (!buffer || !quadrics || !collapses) {
+        allocator_free(allocator, buffer, ALLOCATOR_SUBSYSTEM_MESH);
+        allocator_free(allocator, quadrics, ALLOCATOR_SUBSYSTEM_MESH);
+        allocator_free(allocator, collapses, ALLOCATOR_SUBSYSTEM_MESH);
+        return false;
+    }
+
+    struct mesh_simplify_adjacency adjacency = {
+        .offsets = buffer,
+        .triangles = buffer + vertices_count + 1
+    };
+    uint32_t *cursors = adjacency.triangles + indices_count;
+    uint32_t *kinds = cursors + vertices_count;
+    uint32_t *touched = kinds + vertices_count;
+    uint32_t *remap = touched + vertices_count;
+    double max_cost = (double) target_error * target_error;
+    double error = 0.0;
+    uint32_t count = indices_count - indices_count % 3;
+
+    if (destination != indices)
+        memmove(destination, indices, sizeof(uint32_t) * count);
+
+    mesh_simplify_build_adjacency(&adjacency, cursors, destination, count, vertices_count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t from = destination[i];
+        uint32_t to = destination[i - i % 3 + (i + 1) % 3];
+
+        if (!mesh_simplify_has_edge(&adjacency, destination, to, from)) {
+            mesh_simplify_add_line(&quadrics[from], positions[from], positions[to]);
+            mesh_simplify_add_line(&quadrics[to], positions[from], positions[to]);
+        }
+    }
+
+    while (count > target_indices_count) {
+        uint32_t collapses_count = 0;
+        uint32_t triangles_count = count / 3;
+        uint32_t collapsed_count = 0;
+
+        // cursors count the border edges of every vertex until the kinds are known
+        memset(cursors, 0, sizeof(uint32_t) * vertices_count);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t from = destination[i];
+            uint32_t to = destination[i - i % 3 + (i + 1) % 3];
+
+            if (!mesh_simplify_has_edge(&adjacency, destination, to, from)) {
+                cursors[from]++;
+                cursors[to]++;
+            }
+        }
+        for (uint32_t i = 0; i < vertices_count; ++i) {
+            kinds[i] = cursors[i] == 0 ? MESH_SIMPLIFY_INTERIOR : (cursors[i] == 2 ? MESH_SIMPLIFY_BORDER : MESH_SIMPLIFY_LOCKED);
+            touched[i] = 0;
+            remap[i] = i;
+        }
+
+        for (uint32_t vertex = 0; vertex < vertices_count; ++vertex) {
+            struct mesh_simplify_collapse best = {.vertex = vertex, .target = MESH_OPTIMIZER_NO_VERTEX, .cost = DBL_MAX};
+
+            if (kinds[vertex] == MESH_SIMPLIFY_LOCKED || adjacency.offsets[vertex] == adjacency.offsets[vertex + 1])
+                continue;
+            for (uint32_t i = adjacency.offsets[vertex]; i < adjacency.offsets[vertex + 1]; ++i) {
+                const uint32_t *triangle = &destination[adjacency.triangles[i] * 3];
+
+                for (uint32_t j = 0; j < 3; ++j) {
+                    uint32_t target = triangle[j];
+
+                    if (target == vertex)
+                        continue;
+                    // A border vertex may only slide along the border, into its neighbours on it
+                    if (kinds[vertex] == MESH_SIMPLIFY_BORDER && (kinds[target] == MESH_SIMPLIFY_INTERIOR
+                        || !mesh_simplify_is_border_edge(&adjacency, destination, vertex, target)))
+                        continue;
+
+                    double cost = mesh_simplify_quadric_error(&quadrics[vertex], positions[target]);
+                    if (cost >= best.cost || cost > max_cost)
+                        continue;
+
+                    uint32_t removed_triangles_count = mesh_simplify_check_collapse(&adjacency, destination, positions, vertex, target);
+                    if (removed_triangles_count == 0)
+                        continue;
+                    best.target = target;
+                    best.cost = cost;
+                    best.removed_triangles_count = removed_triangles_count;
+                }
+            }
+            if (best.target != MESH_OPTIMIZER_NO_VERTEX)
+                collapses[collapses_count++] = best;
+        }
+        qsort(collapses, collapses_count, sizeof(struct mesh_simplify_collapse), mesh_simplify_compare_collapses);
+
+        for (uint32_t i = 0; i < collapses_count && triangles_count * 3 > target_indices_count; ++i) {
+            struct mesh_simplify_collapse *collapse = &collapses[i];
+
+            if (touched[collapse->vertex] || touched[collapse->target])
+                continue;
+
+            // Lock every vertex of the triangles changed by the collapse for the rest of the pass
+            for (uint32_t j = adjacency.offsets[collapse->vertex]; j < adjacency.offsets[collapse->vertex + 1]; ++j) {
+                const uint32_t *triangle = &destination[adjacency.triangles[j] * 3];
+
+                touched[triangle[0]] = 1;
+                touched[triangle[1]] = 1;
+                touched[triangle[2]] = 1;
+            }
+            remap[collapse->vertex] = collapse->target;
+            mesh_simplify_add_quadric(&quadrics[collapse->target], &quadrics[collapse->vertex]);
+            triangles_count -= collapse->removed_triangles_count;
+            collapsed_count++;
+            if (collapse->cost > error)
+                error = collapse->cost;
+        }
+        if (collapsed_count == 0)
+            break;
+
+        uint32_t write = 0;
+        for (uint32_t i = 0; i < count; i += 3) {
+            uint32_t a = remap[destination[i]];
+            uint32_t b = remap[destination[i + 1]];
+            uint32_t c = remap[destination[i + 2]];
+
+            if (a == b || b == c || a == c)
+                continue;
+            destination[write++] = a;
+            destination[write++] = b;
+            destination[write++] = c;
+        }
+        count = write;
+        mesh_simplify_build_adjacency(&adjacency, cursors, destination, count, vertices_count);
+    }
+
+    *destination_count = count;
+    if (result_error)
+        *result_error = (float) sqrt(error);
+    allocator_free(allocator, buffer, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, quadrics, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, collapses, ALLOCATOR_SUBSYSTEM_MESH);
+    return true;
+}
@@ -1,43 +1,204 @@
 #include "object.h"
 #include "engine.h"
 
-object_t object_create(engine_t engine, vec2 *vertices_pos, vec3 color, uint16_t *indices, uint32_t vertices_count)
+static object_t object_create_from_mesh(engine_t engine, mesh_t mesh, vec3 color)
 {
-    object_t object = calloc(1, sizeof(struct object));
-    struct vertex *vertices = malloc(sizeof(struct vertex) * vertices_count);
-    object->indices_count = (vertices_count - 2) * 3;
+    if (!mesh)
+        return NULL;
+
+    object_t object = allocator_allocate_zeroed(&engine->allocator, 1, sizeof(struct object), ALLOCATOR_SUBSYSTEM_OBJECT);
+    if (!object)
+        return NULL;
+
+    object->mesh = mesh;
     glm_mat4_identity(object->vertex_push_constant.model);
+    object_set_color(object, color);
+    object_set_texture(object, NULL, NULL);
+
+    return object;
+}
+
+object_t object_create(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count)
+{
+    mesh_t mesh = mesh_cache_acquire(engine, vertices_pos, vertices_count, indices, (vertices_count - 2) * 3);
+    object_t object = object_create_from_mesh(engine, mesh, color);
+
+    if (!object)
+        mesh_cache_release(engine, mesh);
+    return object;
+}
+
+object_t object_create_with_topology(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count, enum mesh_topology topology)
+{
+    mesh_t mesh = mesh_cache_acquire_with_topology(engine, vertices_pos, vertices_count, indices, indices_count, topology);
+    object_t object = object_create_from_mesh(engine, mesh, color);
+
+    if (!object)
+        mesh_cache_release(engine, mesh);
+    return object;
+}
 
-    for (uint32_t i = 0; i < vertices_count; ++i) {
-        glm_vec3(color, vertices[i].color);
-        glm_vec2(vertices_pos[i], vertices[i].pos);
+object_t object_create_optimized(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count)
+{
+    allocator_t allocator = &engine->allocator;
+    vec2 *optimized_positions = allocator_allocate(allocator, sizeof(vec2) * vertices_count, ALLOCATOR_SUBSYSTEM_OBJECT);
+    uint32_t *optimized_indices = allocator_allocate(allocator, sizeof(uint32_t) * indices_count, ALLOCATOR_SUBSYSTEM_OBJECT);
+    object_t object = NULL;
+
+    if (!optimized_positions || !optimized_indices) {
+        allocator_free(allocator, optimized_positions, ALLOCATOR_SUBSYSTEM_OBJECT);
+        allocator_free(allocator, optimized_indices, ALLOCATOR_SUBSYSTEM_OBJECT);
+        return NULL;
     }
+    memcpy(optimized_positions, vertices_pos, sizeof(vec2) * vertices_count);
+    memcpy(optimized_indices, indices, sizeof(uint32_t) * indices_count);
+
+    // a failed pass leaves its arrays untouched so the mesh is still valid, only unoptimized
+    mesh_optimize_vertex_cache(allocator, optimized_indices, indices_count, vertices_count, MESH_OPTIMIZER_DEFAULT_CACHE_SIZE);
+    mesh_optimize_vertex_fetch(allocator, optimized_positions, vertices_count, optimized_indices, indices_count);
 
-    if (!vulkan_create_vertex_buffer(&engine->vulkan_context, object, vertices, vertices_count)
-        || !vulkan_create_index_buffer(&engine->vulkan_context, object, indices, object->indices_count)) {
-        free(vertices);
-        free(object);
+    mesh_t mesh = mesh_cache_acquire(engine, optimized_positions, vertices_count, optimized_indices, indices_count);
+    object = object_create_from_mesh(engine, mesh, color);
+    if (!object)
+        mesh_cache_release(engine, mesh);
+
+    allocator_free(allocator, optimized_positions, ALLOCATOR_SUBSYSTEM_OBJECT);
+    allocator_free(allocator, optimized_indices, ALLOCATOR_SUBSYSTEM_OBJECT);
+    return object;
+}
+
+object_t object_create_polygon(engine_t engine, vec2 *vertices_pos, uint32_t vertices_count, const uint32_t *holes_starts, uint32_t holes_count, vec3 color)
+{
+    uint32_t *indices = NULL;
+    uint32_t indices_count = 0;
+    object_t object = NULL;
+
+    if (!triangulate_polygon(&engine->allocator, vertices_pos, vertices_count, holes_starts, holes_count, &indices, &indices_count))
         return NULL;
+
+    if (indices_count > 0) {
+        mesh_t mesh = mesh_cache_acquire(engine, vertices_pos, vertices_count, indices, indices_count);
+
+        object = object_create_from_mesh(engine, mesh, color);
+        if (!object)
+            mesh_cache_release(engine, mesh);
     }
-    free(vertices);
 
+    allocator_free(&engine->allocator, indices, ALLOCATOR_SUBSYSTEM_MESH);
+    return object;
+}
+
+object_t object_create_with_lods(engine_t engine, vec2 *vertices_pos, vec3 color, uint32_t *indices, uint32_t vertices_count, uint32_t indices_count, uint32_t lods_count)
+{
+    allocator_t allocator = &engine->allocator;
+    struct object_lod lods[MESH_LODS_MAX_COUNT];
+    uint32_t generated_count = 1;
+
+    if (lods_count == 0 || lods_count > MESH_LODS_MAX_COUNT)
+        return NULL;
+
+    uint32_t *simplified = NULL;
+    if (lods_count > 1) {
+        simplified = allocator_allocate(allocator, sizeof(uint32_t) * indices_count * (lods_count - 1), ALLOCATOR_SUBSYSTEM_OBJECT);
+        if (!simplified)
+            return NULL;
+    }
+
+    // Levels are generated from the finest down and stored from the coarsest up, as `mesh::lods` expects
+    struct object_lod *finest = &lods[MESH_LODS_MAX_COUNT - 1];
+    *finest = (struct object_lod) {.indices = indices, .indices_count = indices_count, .error = 0.0f};
+    for (; generated_count < lods_count; ++generated_count) {
+        struct object_lod *previous = &lods[MESH_LODS_MAX_COUNT - generated_count];
+        struct object_lod *lod = previous - 1;
+
+        lod->indices = simplified + indices_count * (generated_count - 1);
+        if (!mesh_simplify(allocator, (const vec2 *) vertices_pos, vertices_count, indices, indices_count, previous->indices_count / 2, FLT_MAX,
+            lod->indices, &lod->indices_count, &lod->error) || lod->indices_count == 0 || lod->indices_count >= previous->indices_count)
+            break;
+    }
+
+    object_t object = object_create_from_lods(engine, vertices_pos, color, &lods[MESH_LODS_MAX_COUNT - generated_count], vertices_count, generated_count);
+
+    allocator_free(allocator, simplified, ALLOCATOR_SUBSYSTEM_OBJECT);
+    return object;
+}
+
+object_t object_create_from_lods(engine_t engine, vec2 *vertices_pos, vec3 color, const struct object_lod *lods, uint32_t vertices_count, uint32_t lods_count)
+{
+    allocator_t allocator = &engine->allocator;
+    struct mesh_lod mesh_lods[MESH_LODS_MAX_COUNT];
+    uint32_t indices_count = 0;
+
+    if (lods_count == 0 || lods_count > MESH_LODS_MAX_COUNT)
+        return NULL;
+    for (uint32_t i = 0; i < lods_count; ++i)
+        indices_count += lods[i].indices_count;
+
+    uint32_t *indices = allocator_allocate(allocator, sizeof(uint32_t) * indices_count, ALLOCATOR_SUBSYSTEM_OBJECT);
+    if (!indices)
+        return NULL;
+
+    uint32_t first_index = 0;
+    for (uint32_t i = 0; i < lods_count; ++i) {
+        memcpy(indices + first_index, lods[i].indices, sizeof(uint32_t) * lods[i].indices_count);
+        mesh_lods[i] = (struct mesh_lod) {
+            .first_index = first_index,
+            .indices_count = lods[i].indices_count,
+            .segments_count = 0,
+            .error = lods[i].error
+        };
+        first_index += lods[i].indices_count;
+    }
+
+    mesh_t mesh = mesh_cache_acquire_with_lods(engine, vertices_pos, vertices_count, indices, indices_count, mesh_lods, lods_count);
+    object_t object = object_create_from_mesh(engine, mesh, color);
+    if (!object)
+        mesh_cache_release(engine, mesh);
+
+    allocator_free(allocator, indices, ALLOCATOR_SUBSYSTEM_OBJECT);
+    return object;
+}
+
+object_t object_create_stroke(engine_t engine, const struct stroke_buffer *buffer, vec3 color)
+{
+    object_t object;
+    mesh_t mesh;
+
+    if (buffer->indices_count == 0)
+        return NULL;
+
+    mesh = mesh_cache_acquire(engine, buffer->positions, buffer->vertices_count, buffer->indices, buffer->indices_count);
+    object = object_create_from_mesh(engine, mesh, color);
+    if (!object)
+        mesh_cache_release(engine, mesh);
     return object;
 }
 
 void object_destroy(engine_t engine, object_t object)
 {
-    vkDestroyBuffer(engine->vulkan_context.device, object->vertex_buffer, NULL);
-    vkFreeMemory(engine->vulkan_context.device, object->vertex_memory, NULL);
+    mesh_cache_release(engine, object->mesh);
+
+    allocator_free(&engine->allocator, object, ALLOCATOR_SUBSYSTEM_OBJECT);
+}
 
-    vkDestroyBuffer(engine->vulkan_context.device, object->index_buffer, NULL);
-    vkFreeMemory(engine->vulkan_context.device, object->index_memory, NULL);
+void object_set_color(object_t object, vec3 color)
+{
+    glm_vec4(color, 1.0f, object->vertex_push_constant.color);
+}
 
-    free(object);
+void object_set_texture(object_t object, texture_t texture, const vec4 uv_rect)
+{
+    object->texture = texture;
+    object->vertex_push_constant.texture_index = texture ? texture->index : 0;
+    if (uv_rect)
+        glm_vec4_copy((float *) uv_rect, object->vertex_push_constant.uv_rect);
+    else
+        glm_vec4_copy((vec4) {0.0f, 1.0f, 1.0f, 0.0f}, object->vertex_push_constant.uv_rect);
 }
 
 object_t object_create_triangle(engine_t engine, mat3x2 vertices_pos, vec3 color)
 {
-    uint16_t indices[] = {
+    uint32_t indices[] = {
         0, 1, 2
     };
 
@@ -46,56 +207,43 @@ object_t object_create_triangle(engine_t engine, mat3x2 vertices_pos, vec3 color
 
 object_t object_create_rectangle(engine_t engine, vec2 pos, vec2 size, vec3 color)
 {
-    uint16_t indices[] = {
-        0, 1, 2, 2, 3, 0
-    };
-
-    vec2 opposite_vertice;
-    glm_vec2_add(pos, size, opposite_vertice);
+    mesh_t mesh = mesh_cache_acquire_primitive(engine, MESH_PRIMITIVE_RECTANGLE, 0);
+    object_t object = object_create_from_mesh(engine, mesh, color);
 
-    mat4x2 vertices = {
-        {pos[0], pos[1]},
-        {opposite_vertice[0], pos[1]},
-        {opposite_vertice[0], opposite_vertice[1]},
-        {pos[0], opposite_vertice[1]}
-    };
+    if (!object) {
+        mesh_cache_release(engine, mesh);
+        return NULL;
+    }
 
-    return object_create(engine, vertices, color, indices, 4);
+    glm_translate(object->vertex_push_constant.model, (vec3) {pos[0], pos[1], 0.0f});
+    glm_scale(object->vertex_push_constant.model, (vec3) {size[0], size[1], 1.0f});
+    return object;
 }
 
 /*
-    Drawing circles with triangles fans by default, because we will use big circles most of the time
-    but need to do an option to draw it with fragmentation shader (maybe ?)
+    Drawing circles with triangles fans by default, because we will use big circles most of the time,
+    circles drawn in the fragment shader are available as shapes, see `engine_draw_shape()`
     https://www.reddit.com/r/vulkan/comments/vx5xyb/rendering_circles_triangle_fans_vs_code_in_the/
 */
 object_t object_create_circle(engine_t engine, vec2 pos, float radius, vec3 color, unsigned int outside_vertices_count)
 {
-    if (outside_vertices_count < 3)
-        return NULL;
-
-    int vertices_count = outside_vertices_count + 2; // +1 for center point == ending point
-    vec2 *vertices_pos = malloc(sizeof(vec2) * vertices_count);
-    uint16_t *indices = malloc(sizeof(uint16_t) * ((vertices_count + 1) * 3)); // +1 for center point == ending point
-
-    glm_vec2_copy(pos, vertices_pos[0]);
+    mesh_t mesh = NULL;
 
-    float degreesStep = 360.f / outside_vertices_count;
-    float currentAngle = 0.f;
-    int indicesIndex = 0;
+    if (outside_vertices_count == CIRCLE_ADAPTIVE_OUTSIDE_VERTICES_COUNT)
+        mesh = mesh_cache_acquire_primitive(engine, MESH_PRIMITIVE_CIRCLE_LOD, 0);
+    else if (outside_vertices_count >= 3)
+        mesh = mesh_cache_acquire_primitive(engine, MESH_PRIMITIVE_CIRCLE, outside_vertices_count);
+    else
+        return NULL;
 
-    for (unsigned int i = 1; i < outside_vertices_count + 1; ++i) {
-        find_circle_point(pos, radius, currentAngle, vertices_pos[i]);
-        currentAngle += degreesStep;
+    object_t object = object_create_from_mesh(engine, mesh, color);
 
-        indices[indicesIndex++] = 0;
-        indices[indicesIndex++] = i;
-        indices[indicesIndex++] = i + 1;
+    if (!object) {
+        mesh_cache_release(engine, mesh);
+        return NULL;
     }
 
-    find_circle_point(pos, radius, currentAngle, vertices_pos[outside_vertices_count + 1]);
-    indices[indicesIndex++] = 0;
-    indices[indicesIndex++] = outside_vertices_count + 1;
-    indices[indicesIndex++] = 1;
-
-    return object_create(engine, vertices_pos, color, indices, vertices_count);
+    glm_translate(object->vertex_push_constant.model, (vec3) {pos[0], pos[1], 0.0f});
+    glm_scale(object->vertex_push_constant.model, (vec3) {radius, radius, 1.0f});
+    return object;
 }
@@ -0,0 +1,248 @@
+#include "point_cloud.h"
+#include "engine.h"
+
+void point_cloud_init(point_cloud_t point_cloud, engine_t engine, float point_size)
+{
+    memset(point_cloud, 0, sizeof(struct point_cloud));
+    point_cloud->engine = engine;
+    glm_mat4_identity(point_cloud->push_constant.model);
+    glm_vec4_one(point_cloud->push_constant.color);
+    point_cloud->push_constant.uv_rect[0] = point_size;
+}
+
+void point_cloud_cleanup(point_cloud_t point_cloud)
+{
+    engine_t engine = point_cloud->engine;
+    vulkan_context_t context;
+    uint32_t kept_count = 0;
+
+    if (!engine)
+        return;
+    context = &engine->vulkan_context;
+
+    // Forget the point cloud in the frame being built, with the updates still reading its points
+    for (uint32_t i = 0; i < engine->point_clouds_to_draw_count; ++i) {
+        if (engine->point_clouds_to_draw[i] != point_cloud)
+            engine->point_clouds_to_draw[kept_count++] = engine->point_clouds_to_draw[i];
+    }
+    engine->point_clouds_to_draw_count = kept_count;
+
+    for (uint32_t i = 0; i < point_cloud->chunks_capacity; ++i) {
+        struct point_cloud_chunk *chunk = &point_cloud->chunks[i];
+
+        if (!chunk->points)
+            continue;
+        vulkan_cancel_buffer_updates(context, chunk->buffer);
+        vkDestroyBuffer(context->device, chunk->buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, chunk->memory, &context->allocation_callbacks);
+        allocator_free(&engine->allocator, chunk->points, ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+    }
+    allocator_free(&engine->allocator, point_cloud->chunks, ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+    allocator_free(&engine->allocator, point_cloud->draws, ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+    memset(point_cloud, 0, sizeof(struct point_cloud));
+}
+
+// Get the first chunk that isn't holding points yet, growing the chunks geometrically and creating its buffer on its first use
+static struct point_cloud_chunk *point_cloud_next_chunk(point_cloud_t point_cloud)
+{
+    engine_t engine = point_cloud->engine;
+    struct point_cloud_chunk *chunk;
+
+    if (point_cloud->chunks_count == point_cloud->chunks_capacity) {
+        uint32_t capacity = point_cloud->chunks_capacity > 0 ? point_cloud->chunks_capacity * 2 : 4;
+        struct point_cloud_chunk *chunks = allocator_reallocate(&engine->allocator, point_cloud->chunks, capacity * sizeof(struct point_cloud_chunk), ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+
+        if (!chunks)
+            return NULL;
+        point_cloud->chunks = chunks;
+
+        uint32_t *draws = allocator_reallocate(&engine->allocator, point_cloud->draws, capacity * sizeof(uint32_t), ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+
+        if (!draws)
+            return NULL;
+        point_cloud->draws = draws;
+        memset(&chunks[point_cloud->chunks_capacity], 0, (capacity - point_cloud->chunks_capacity) * sizeof(struct point_cloud_chunk));
+        point_cloud->chunks_capacity = capacity;
+    }
+
+    chunk = &point_cloud->chunks[point_cloud->chunks_count];
+    if (!chunk->points) {
+        chunk->points = allocator_allocate(&engine->allocator, POINT_CLOUD_CHUNK_POINTS_COUNT * sizeof(struct point_cloud_point), ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+        if (!chunk->points)
+            return NULL;
+        if (!vulkan_create_instance_buffer(&engine->vulkan_context, POINT_CLOUD_CHUNK_POINTS_COUNT * sizeof(struct point_cloud_point), &chunk->buffer, &chunk->memory)) {
+            allocator_free(&engine->allocator, chunk->points, ALLOCATOR_SUBSYSTEM_POINT_CLOUD);
+            chunk->points = NULL;
+            return NULL;
+        }
+    }
+    point_cloud->chunks_count++;
+    return chunk;
+}
+
+bool point_cloud_append(point_cloud_t point_cloud, const struct point_cloud_point *points, uint32_t points_count)
+{
+    while (points_count > 0) {
+        struct point_cloud_chunk *chunk = point_cloud->chunks_count > 0 ? &point_cloud->chunks[point_cloud->chunks_count - 1] : NULL;
+        uint32_t appended_count;
+
+        if (!chunk || chunk->points_count == POINT_CLOUD_CHUNK_POINTS_COUNT) {
+            chunk = point_cloud_next_chunk(point_cloud);
+            if (!chunk) {
+                #ifdef DEBUG
+                write(STDERR_FILENO, "Failed to allocate a point cloud chunk\n", 40);
+                #endif
+                return false;
+            }
+        }
+        if (chunk->points_count == 0) {
+            glm_vec3_copy((vec3) {points[0].position[0], points[0].position[1], 0.0f}, chunk->bounds[0]);
+            glm_vec3_copy(chunk->bounds[0], chunk->bounds[1]);
+        }
+
+        appended_count = POINT_CLOUD_CHUNK_POINTS_COUNT - chunk->points_count;
+        if (appended_count > points_count)
+            appended_count = points_count;
+        memcpy(&chunk->points[chunk->points_count], points, appended_count * sizeof(struct point_cloud_point));
+        // fminf and fmaxf are library calls handling NaN, cglm compares the bounds kept in registers instead
+        vec2 min = {chunk->bounds[0][0], chunk->bounds[0][1]};
+        vec2 max = {chunk->bounds[1][0], chunk->bounds[1][1]};
+
+        for (uint32_t i = 0; i < appended_count; ++i) {
+            glm_vec2_minv(min, (float *) points[i].position, min);
+            glm_vec2_maxv(max, (float *) points[i].position, max);
+        }
+        chunk->bounds[0][0] = min[0];
+        chunk->bounds[0][1] = min[1];
+        chunk->bounds[1][0] = max[0];
+        chunk->bounds[1][1] = max[1];
+
+        chunk->points_count += appended_count;
+        point_cloud->points_count += appended_count;
+        points += appended_count;
+        points_count -= appended_count;
+    }
+    return true;
+}
+
+void point_cloud_clear(point_cloud_t point_cloud)
+{
+    for (uint32_t i = 0; i < point_cloud->chunks_count; ++i) {
+        vulkan_cancel_buffer_updates(&point_cloud->engine->vulkan_context, point_cloud->chunks[i].buffer);
+        point_cloud->chunks[i].points_count = 0;
+        point_cloud->chunks[i].uploaded_count = 0;
+    }
+    point_cloud->chunks_count = 0;
+    point_cloud->points_count = 0;
+    point_cloud->draws_count = 0;
+}
+
+void point_cloud_set_model(point_cloud_t point_cloud, mat4 model)
+{
+    glm_mat4_copy(model, point_cloud->push_constant.model);
+}
+
+void point_cloud_set_color(point_cloud_t point_cloud, vec4 color)
+{
+    glm_vec4_copy(color, point_cloud->push_constant.color);
+}
+
+void point_cloud_set_point_size(point_cloud_t point_cloud, float point_size)
+{
+    point_cloud->push_constant.uv_rect[0] = point_size;
+}
+
+uint32_t point_cloud_pack_color(vec4 color)
+{
+    uint32_t packed = 0;
+
+    for (uint32_t i = 0; i < 4; ++i)
+        packed |= (uint32_t) (glm_clamp_zo(color[i]) * 255.0f + 0.5f) << (i * 8);
+    return packed;
+}
+
+/*
+    The frustum planes are extracted from the projection of the space of the point cloud, so a chunk is tested with its own bounds.
+    Only visible chunks are uploaded, each one from the first point it hasn't uploaded yet, until the budget of the frame is spent
+*/
+bool point_cloud_draw(engine_t engine, point_cloud_t point_cloud)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    uint32_t upload_budget = POINT_CLOUD_MAX_UPLOAD_POINTS_COUNT;
+    bool is_queued = false;
+    mat4 view_projection;
+    mat4 points_to_clip;
+    vec4 planes[6];
+
+    for (uint32_t i = 0; i < engine->point_clouds_to_draw_count && !is_queued; ++i)
+        is_queued = engine->point_clouds_to_draw[i] == point_cloud;
+    if (!is_queued) {
+        if (engine->point_clouds_to_draw_count >= ENGINE_MAX_POINT_CLOUDS_TO_DRAW) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Cannot draw more point clouds\n", 31);
+            #endif
+            return false;
+        }
+        engine->point_clouds_to_draw[engine->point_clouds_to_draw_count++] = point_cloud;
+    }
+
+    glm_mat4_mul(context->proj, context->view, view_projection);
+    glm_mat4_mul(view_projection, point_cloud->push_constant.model, points_to_clip);
+    glm_frustum_planes(points_to_clip, planes);
+
+    point_cloud->draws_count = 0;
+    for (uint32_t i = 0; i < point_cloud->chunks_count; ++i) {
+        struct point_cloud_chunk *chunk = &point_cloud->chunks[i];
+
+        if (!glm_aabb_frustum(chunk->bounds, planes))
+            continue;
+        if (chunk->uploaded_count < chunk->points_count && upload_budget > 0 && context->buffer_updates_count < FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT) {
+            uint32_t uploaded_count = chunk->points_count - chunk->uploaded_count;
+
+            if (uploaded_count > upload_budget)
+                uploaded_count = upload_budget;
+            vulkan_queue_buffer_update(context, chunk->buffer, (VkDeviceSize) chunk->uploaded_count * sizeof(struct point_cloud_point),
+                &chunk->points[chunk->uploaded_count], (VkDeviceSize) uploaded_count * sizeof(struct point_cloud_point));
+            chunk->uploaded_count += uploaded_count;
+            upload_budget -= uploaded_count;
+        }
+        if (chunk->uploaded_count > 0)
+            point_cloud->draws[point_cloud->draws_count++] = i;
+    }
+    return true;
+}
+
+void point_cloud_get_binding_description(uint32_t *point_cloud_binding_descriptions_count, VkVertexInputBindingDescription *point_cloud_binding_descriptions, VkVertexInputRate input_rate)
+{
+    if (!point_cloud_binding_descriptions) {
+        *point_cloud_binding_descriptions_count = 1;
+        return;
+    }
+
+    point_cloud_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct point_cloud_point),
+        .inputRate = input_rate
+    };
+}
+
+void point_cloud_get_attribute_description(uint32_t *point_cloud_attribute_descriptions_count, VkVertexInputAttributeDescription *point_cloud_attribute_descriptions)
+{
+    if (!point_cloud_attribute_descriptions) {
+        *point_cloud_attribute_descriptions_count = POINT_CLOUD_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    point_cloud_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct point_cloud_point, position)
+    };
+    point_cloud_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R8G8B8A8_UNORM,
+        .offset = offsetof(struct point_cloud_point, color)
+    };
+}
@@ -0,0 +1,97 @@
+#include "quad_batch.h"
+#include "vulkan/vulkan_wrapper.h"
+
+void quad_batch_init(quad_batch_t batch, uint32_t quad_size)
+{
+    batch->quad_size = quad_size;
+    quad_batch_reset(batch);
+}
+
+void quad_batch_reset(quad_batch_t batch)
+{
+    batch->quads = NULL;
+    batch->quads_count = 0;
+    batch->quads_capacity = 0;
+    batch->draws_count = 0;
+}
+
+bool quad_batch_grow(quad_batch_t batch, struct vulkan_context *context)
+{
+    uint32_t capacity = batch->quads_capacity ? batch->quads_capacity * 2 : QUAD_BATCH_FIRST_CHUNK_QUADS_COUNT;
+    struct frame_allocation allocation;
+    bool allocated = false;
+
+    // When the frame is nearly full, smaller chunks use what is left of it
+    while (batch->draws_count < QUAD_BATCH_MAX_DRAWS_COUNT && !allocated && capacity >= QUAD_BATCH_FIRST_CHUNK_QUADS_COUNT) {
+        allocated = vulkan_frame_allocate(context, (VkDeviceSize) capacity * batch->quad_size, 16, &allocation);
+        if (!allocated)
+            capacity /= 2;
+    }
+    if (!allocated) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Cannot draw more quads\n", 24);
+        #endif
+        return false;
+    }
+
+    if (batch->draws_count > 0)
+        batch->draws[batch->draws_count - 1].quads_count = batch->quads_count;
+    batch->draws[batch->draws_count++] = (struct quad_batch_draw) {
+        .offset = allocation.offset,
+        .quads_count = 0
+    };
+    batch->quads = allocation.data;
+    batch->quads_count = 0;
+    batch->quads_capacity = capacity;
+    return true;
+}
+
+uint32_t quad_batch_get_quads_count(const struct quad_batch *batch)
+{
+    uint32_t quads_count = 0;
+
+    for (uint32_t i = 0; i + 1 < batch->draws_count; ++i)
+        quads_count += batch->draws[i].quads_count;
+    return batch->draws_count > 0 ? quads_count + batch->quads_count : 0;
+}
+
+void quad_get_binding_description(uint32_t *quad_binding_descriptions_count, VkVertexInputBindingDescription *quad_binding_descriptions)
+{
+    if (!quad_binding_descriptions) {
+        *quad_binding_descriptions_count = 1;
+        return;
+    }
+
+    quad_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct quad),
+        .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+    };
+}
+
+void quad_get_attribute_description(uint32_t *quad_attribute_descriptions_count, VkVertexInputAttributeDescription *quad_attribute_descriptions)
+{
+    if (!quad_attribute_descriptions) {
+        *quad_attribute_descriptions_count = QUAD_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    quad_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct quad, position)
+    };
+    quad_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct quad, size)
+    };
+    quad_attribute_descriptions[2] = (VkVertexInputAttributeDescription) {
+        .location = 2,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct quad, color)
+    };
+}
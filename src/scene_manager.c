@@ -1,40 +1,57 @@
 #include "scene_manager.h"
 
-static void scene_node_add_child(scene_node_t new_child, scene_node_t dest)
+static void scene_node_add_child(engine_t engine, scene_node_t new_child, scene_node_t dest)
 {
-    scene_node_t *new_childrens_arr = malloc(sizeof(scene_node_t) * (dest->childrens_size + 1));
+    scene_node_t *new_childrens_arr = allocator_allocate(&engine->allocator, sizeof(scene_node_t) * (dest->childrens_size + 1), ALLOCATOR_SUBSYSTEM_SCENE);
 
     if (dest->childrens != NULL) {
         memcpy(new_childrens_arr, dest->childrens, sizeof(scene_node_t) * dest->childrens_size);
-        free(dest->childrens);
+        allocator_free(&engine->allocator, dest->childrens, ALLOCATOR_SUBSYSTEM_SCENE);
     }
     new_childrens_arr[dest->childrens_size++] = new_child;
     dest->childrens = new_childrens_arr;
     new_child->index = dest->childrens_size - 1;
 }
 
-scene_node_t scene_node_create(scene_node_t parent, object_t object)
+static scene_node_t scene_node_find_baked(scene_node_t node)
 {
-    scene_node_t scene_node = calloc(1, sizeof(struct scene_node));
+    while (node && !node->batch)
+        node = node->parent;
+    return node;
+}
+
+static void scene_node_outdate_bake(scene_node_t node)
+{
+    scene_node_t baked = scene_node_find_baked(node);
+
+    if (baked)
+        baked->batch_outdated = true;
+}
+
+scene_node_t scene_node_create(engine_t engine, scene_node_t parent, object_t object)
+{
+    scene_node_t scene_node = allocator_allocate_zeroed(&engine->allocator, 1, sizeof(struct scene_node), ALLOCATOR_SUBSYSTEM_SCENE);
 
     scene_node->parent = parent;
     scene_node->object = object;
 
-    if (parent != NULL)
-        scene_node_add_child(scene_node, parent);
+    if (parent != NULL) {
+        scene_node_add_child(engine, scene_node, parent);
+        scene_node_outdate_bake(parent);
+    }
     return scene_node;
 }
 
-void scene_node_remove_child(scene_node_t child, scene_node_t node)
+void scene_node_remove_child(engine_t engine, scene_node_t child, scene_node_t node)
 {
     if (child->index == -1)
         return;
 
     if (node->childrens_size == 1) {
-        free(node->childrens);
+        allocator_free(&engine->allocator, node->childrens, ALLOCATOR_SUBSYSTEM_SCENE);
         node->childrens = NULL;
     } else {
-        scene_node_t *new_childrens_arr = malloc(sizeof(scene_node_t) * (node->childrens_size - 1));
+        scene_node_t *new_childrens_arr = allocator_allocate(&engine->allocator, sizeof(scene_node_t) * (node->childrens_size - 1), ALLOCATOR_SUBSYSTEM_SCENE);
         int index = 0;
 
         for (int i = 0; i < node->childrens_size; ++i) {
@@ -43,36 +60,125 @@ void scene_node_remove_child(scene_node_t child, scene_node_t node)
         }
 
         if (node->childrens != NULL)
-            free(node->childrens);
+            allocator_free(&engine->allocator, node->childrens, ALLOCATOR_SUBSYSTEM_SCENE);
         node->childrens = new_childrens_arr;
     }
 
     child->index = 0;
     child->parent = NULL;
     node->childrens_size--;
+    scene_node_outdate_bake(node);
 }
 
-void scene_node_destroy(scene_node_t node, bool recursive)
+void scene_node_destroy(engine_t engine, scene_node_t node, bool recursive)
 {
     if (node->parent)
-        scene_node_remove_child(node, node->parent);
+        scene_node_remove_child(engine, node, node->parent);
 
     for (int i = 0; i < node->childrens_size; ++i) {
         if (recursive)
-            scene_node_destroy(node->childrens[i], true);
+            scene_node_destroy(engine, node->childrens[i], true);
         else
-            scene_node_remove_child(node->childrens[i], node);
+            scene_node_remove_child(engine, node->childrens[i], node);
+    }
+
+    scene_node_unbake(engine, node);
+    allocator_free(&engine->allocator, node->childrens, ALLOCATOR_SUBSYSTEM_SCENE);
+    allocator_free(&engine->allocator, node, ALLOCATOR_SUBSYSTEM_SCENE);
+}
+
+static uint32_t scene_node_count_objects(scene_node_t node)
+{
+    uint32_t objects_count = node->object ? 1 : 0;
+
+    for (int i = 0; i < node->childrens_size; ++i)
+        objects_count += scene_node_count_objects(node->childrens[i]);
+    return objects_count;
+}
+
+// Objects are collected in the order `scene_node_draw()` draws them, children first
+static void scene_node_collect_objects(scene_node_t node, object_t *objects, uint32_t *objects_count)
+{
+    for (int i = 0; i < node->childrens_size; ++i)
+        scene_node_collect_objects(node->childrens[i], objects, objects_count);
+    if (node->object) {
+        node->batch_entry = *objects_count;
+        objects[(*objects_count)++] = node->object;
+    }
+}
+
+static bool scene_node_rebake(engine_t engine, scene_node_t node)
+{
+    uint32_t objects_count = scene_node_count_objects(node);
+    object_t *objects = allocator_allocate(&engine->allocator, sizeof(object_t) * (objects_count > 0 ? objects_count : 1), ALLOCATOR_SUBSYSTEM_SCENE);
+    bool baked;
+
+    if (!objects)
+        return false;
+    objects_count = 0;
+    scene_node_collect_objects(node, objects, &objects_count);
+    baked = static_batch_build(node->batch, objects, objects_count);
+    node->batch_outdated = !baked;
+
+    allocator_free(&engine->allocator, objects, ALLOCATOR_SUBSYSTEM_SCENE);
+    return baked;
+}
+
+// A subtree is baked by its topmost baked node only
+static void scene_node_unbake_childrens(engine_t engine, scene_node_t node)
+{
+    for (int i = 0; i < node->childrens_size; ++i) {
+        scene_node_unbake(engine, node->childrens[i]);
+        scene_node_unbake_childrens(engine, node->childrens[i]);
+    }
+}
+
+bool scene_node_bake(engine_t engine, scene_node_t node)
+{
+    scene_node_unbake_childrens(engine, node);
+    if (!node->batch) {
+        node->batch = allocator_allocate(&engine->allocator, sizeof(struct static_batch), ALLOCATOR_SUBSYSTEM_SCENE);
+        if (!node->batch)
+            return false;
+        static_batch_init(node->batch, engine);
+    }
+    if (!scene_node_rebake(engine, node)) {
+        scene_node_unbake(engine, node);
+        return false;
     }
+    return true;
+}
+
+void scene_node_unbake(engine_t engine, scene_node_t node)
+{
+    if (!node->batch)
+        return;
 
-    free(node->childrens);
-    free(node);
+    static_batch_cleanup(node->batch);
+    allocator_free(&engine->allocator, node->batch, ALLOCATOR_SUBSYSTEM_SCENE);
+    node->batch = NULL;
+    node->batch_outdated = false;
+}
+
+void scene_node_invalidate(scene_node_t node)
+{
+    scene_node_t baked = scene_node_find_baked(node);
+
+    if (baked && node->object)
+        static_batch_invalidate(baked->batch, node->batch_entry);
 }
 
 bool scene_node_draw(engine_t engine, scene_node_t node)
 {
+    if (node->batch) {
+        if (node->batch_outdated && !scene_node_rebake(engine, node))
+            return false;
+        return static_batch_draw(engine, node->batch);
+    }
+
     for (int i = 0; i < node->childrens_size; ++i) {
         if (!scene_node_draw(engine, node->childrens[i]))
             return false;
     }
-    return engine_draw(engine, node->object);
+    return !node->object || engine_draw(engine, node->object);
 }
@@ -0,0 +1,97 @@
+#include "shape.h"
+
+static void shape_init(shape_t shape, enum shape_type type, vec2 center, vec2 half_size, float rotation, vec4 color)
+{
+    glm_vec2_copy(center, shape->center);
+    glm_vec2_copy(half_size, shape->half_size);
+    glm_vec4_copy(color, shape->color);
+    shape->rotation = rotation;
+    shape->corner_radius = 0.0f;
+    shape->thickness = 0.0f;
+    shape->type = type;
+}
+
+void shape_init_circle(shape_t shape, vec2 center, float radius, vec4 color)
+{
+    shape_init(shape, SHAPE_TYPE_CIRCLE, center, (vec2) {radius, radius}, 0.0f, color);
+}
+
+void shape_init_ellipse(shape_t shape, vec2 center, vec2 radii, float rotation, vec4 color)
+{
+    shape_init(shape, SHAPE_TYPE_ELLIPSE, center, radii, rotation, color);
+}
+
+void shape_init_ring(shape_t shape, vec2 center, float radius, float thickness, vec4 color)
+{
+    shape_init(shape, SHAPE_TYPE_RING, center, (vec2) {radius, radius}, 0.0f, color);
+    shape->thickness = thickness;
+}
+
+void shape_init_rounded_rectangle(shape_t shape, vec2 center, vec2 size, float corner_radius, float rotation, vec4 color)
+{
+    shape_init(shape, SHAPE_TYPE_ROUNDED_RECTANGLE, center, (vec2) {size[0] * 0.5f, size[1] * 0.5f}, rotation, color);
+    shape->corner_radius = corner_radius;
+}
+
+void shape_init_capsule(shape_t shape, vec2 start, vec2 end, float radius, vec4 color)
+{
+    vec2 center;
+    vec2 direction;
+
+    glm_vec2_center(start, end, center);
+    glm_vec2_sub(end, start, direction);
+    shape_init(shape, SHAPE_TYPE_CAPSULE, center, (vec2) {glm_vec2_norm(direction) * 0.5f + radius, radius}, atan2f(direction[1], direction[0]), color);
+}
+
+void shape_get_binding_description(uint32_t *shape_binding_descriptions_count, VkVertexInputBindingDescription *shape_binding_descriptions)
+{
+    if (!shape_binding_descriptions) {
+        *shape_binding_descriptions_count = 1;
+        return;
+    }
+
+    shape_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct shape),
+        .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+    };
+}
+
+void shape_get_attribute_description(uint32_t *shape_attribute_descriptions_count, VkVertexInputAttributeDescription *shape_attribute_descriptions)
+{
+    if (!shape_attribute_descriptions) {
+        *shape_attribute_descriptions_count = SHAPE_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    shape_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct shape, center)
+    };
+    shape_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct shape, half_size)
+    };
+    shape_attribute_descriptions[2] = (VkVertexInputAttributeDescription) {
+        .location = 2,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct shape, color)
+    };
+    shape_attribute_descriptions[3] = (VkVertexInputAttributeDescription) {
+        .location = 3,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32_SFLOAT,
+        .offset = offsetof(struct shape, rotation)
+    };
+    shape_attribute_descriptions[4] = (VkVertexInputAttributeDescription) {
+        .location = 4,
+        .binding = 0,
+        .format = VK_FORMAT_R32_UINT,
+        .offset = offsetof(struct shape, type)
+    };
+}
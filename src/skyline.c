@@ -0,0 +1,129 @@
+#include "skyline.h"
+#include <string.h>
+
+bool skyline_init(skyline_t skyline, allocator_t allocator, uint32_t width, uint32_t height)
+{
+    memset(skyline, 0, sizeof(struct skyline));
+    if (width == 0 || height == 0)
+        return false;
+
+    skyline->allocator = allocator;
+    skyline->width = width;
+    skyline->height = height;
+    // One more segment than the width for the one inserted before the segments it covers are removed
+    skyline->nodes = allocator_allocate(allocator, sizeof(struct skyline_node) * (width + 1), ALLOCATOR_SUBSYSTEM_TEXTURE);
+    if (!skyline->nodes)
+        return false;
+    skyline_reset(skyline);
+    return true;
+}
+
+void skyline_cleanup(skyline_t skyline)
+{
+    if (skyline->nodes)
+        allocator_free(skyline->allocator, skyline->nodes, ALLOCATOR_SUBSYSTEM_TEXTURE);
+    skyline->nodes = NULL;
+    skyline->nodes_count = 0;
+}
+
+void skyline_reset(skyline_t skyline)
+{
+    skyline->nodes[0] = (struct skyline_node) {
+        .x = 0,
+        .y = 0,
+        .width = skyline->width
+    };
+    skyline->nodes_count = 1;
+    skyline->used_area = 0;
+}
+
+// Top of a rectangle whose left is the left of segment `index`, resting on the highest segment under it
+static bool skyline_fit(const struct skyline *skyline, uint32_t index, uint32_t width, uint32_t height, uint32_t *y)
+{
+    uint32_t remaining = width;
+
+    if (skyline->nodes[index].x + width > skyline->width)
+        return false;
+
+    *y = 0;
+    for (uint32_t i = index; i < skyline->nodes_count; ++i) {
+        if (skyline->nodes[i].y > *y)
+            *y = skyline->nodes[i].y;
+        if (*y + height > skyline->height)
+            return false;
+        if (skyline->nodes[i].width >= remaining)
+            return true;
+        remaining -= skyline->nodes[i].width;
+    }
+    return false;
+}
+
+static void skyline_insert(skyline_t skyline, uint32_t index, uint32_t x, uint32_t y, uint32_t width)
+{
+    struct skyline_node *nodes = skyline->nodes;
+    uint32_t right = x + width;
+
+    memmove(&nodes[index + 1], &nodes[index], sizeof(struct skyline_node) * (skyline->nodes_count - index));
+    nodes[index] = (struct skyline_node) {
+        .x = x,
+        .y = y,
+        .width = width
+    };
+    skyline->nodes_count++;
+
+    // Shrink or remove the segments now under the new one
+    while (index + 1 < skyline->nodes_count && nodes[index + 1].x < right) {
+        uint32_t overlap = right - nodes[index + 1].x;
+
+        if (overlap < nodes[index + 1].width) {
+            nodes[index + 1].x += overlap;
+            nodes[index + 1].width -= overlap;
+            break;
+        }
+        memmove(&nodes[index + 1], &nodes[index + 2], sizeof(struct skyline_node) * (skyline->nodes_count - index - 2));
+        skyline->nodes_count--;
+    }
+
+    // Merge the segments at the same height
+    for (uint32_t i = 0; i + 1 < skyline->nodes_count;) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].width += nodes[i + 1].width;
+            memmove(&nodes[i + 1], &nodes[i + 2], sizeof(struct skyline_node) * (skyline->nodes_count - i - 2));
+            skyline->nodes_count--;
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool skyline_pack(skyline_t skyline, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y)
+{
+    uint32_t best_index = UINT32_MAX;
+    uint32_t best_bottom = UINT32_MAX;
+    uint32_t best_width = UINT32_MAX;
+    uint32_t best_y = 0;
+
+    if (width == 0 || height == 0)
+        return false;
+
+    for (uint32_t i = 0; i < skyline->nodes_count; ++i) {
+        uint32_t top;
+
+        if (!skyline_fit(skyline, i, width, height, &top))
+            continue;
+        if (top + height < best_bottom || (top + height == best_bottom && skyline->nodes[i].width < best_width)) {
+            best_index = i;
+            best_bottom = top + height;
+            best_width = skyline->nodes[i].width;
+            best_y = top;
+        }
+    }
+    if (best_index == UINT32_MAX)
+        return false;
+
+    *x = skyline->nodes[best_index].x;
+    *y = best_y;
+    skyline_insert(skyline, best_index, *x, best_y + height, width);
+    skyline->used_area += (uint64_t) width * height;
+    return true;
+}
@@ -0,0 +1,356 @@
+#include "static_batch.h"
+#include "engine.h"
+
+void static_batch_init(static_batch_t batch, engine_t engine)
+{
+    memset(batch, 0, sizeof(struct static_batch));
+    batch->engine = engine;
+}
+
+static void static_batch_destroy_buffers(vulkan_context_t context, mesh_t mesh)
+{
+    if (mesh->vertex_buffer != VK_NULL_HANDLE) {
+        vulkan_cancel_buffer_updates(context, mesh->vertex_buffer);
+        vkDestroyBuffer(context->device, mesh->vertex_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, mesh->vertex_memory, &context->allocation_callbacks);
+    }
+    if (mesh->index_buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(context->device, mesh->index_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, mesh->index_memory, &context->allocation_callbacks);
+    }
+}
+
+static void static_batch_release_group(static_batch_t batch, struct static_batch_group *group)
+{
+    static_batch_destroy_buffers(&batch->engine->vulkan_context, &group->mesh);
+    if (group->vertices)
+        allocator_free(&batch->engine->allocator, group->vertices, ALLOCATOR_SUBSYSTEM_SCENE);
+    group->vertices = NULL;
+    memset(&group->mesh, 0, sizeof(struct mesh));
+}
+
+void static_batch_cleanup(static_batch_t batch)
+{
+    allocator_t allocator = &batch->engine->allocator;
+
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        static_batch_release_group(batch, batch->groups[i]);
+        allocator_free(allocator, batch->groups[i], ALLOCATOR_SUBSYSTEM_SCENE);
+    }
+    if (batch->groups)
+        allocator_free(allocator, batch->groups, ALLOCATOR_SUBSYSTEM_SCENE);
+    if (batch->entries)
+        allocator_free(allocator, batch->entries, ALLOCATOR_SUBSYSTEM_SCENE);
+    static_batch_init(batch, batch->engine);
+}
+
+// Geometry is baked as 2D positions, a model matrix tilting it out of its plane or projecting it can't be baked
+static bool static_batch_is_planar(object_t object)
+{
+    vec4 *model = object->vertex_push_constant.model;
+
+    return model[0][2] == 0.0f && model[1][2] == 0.0f && model[0][3] == 0.0f && model[1][3] == 0.0f && model[3][3] == 1.0f;
+}
+
+static bool static_batch_match_material(struct static_batch_group *group, object_t object)
+{
+    return group->object.texture == object->texture
+        && group->mesh.topology == object->mesh->topology
+        && glm_vec4_eqv(group->object.vertex_push_constant.color, object->vertex_push_constant.color)
+        && group->object.vertex_push_constant.model[3][2] == object->vertex_push_constant.model[3][2];
+}
+
+// Texture coordinates are baked in the vertices, so the group maps the whole texture and only keeps the plane of its objects
+static void static_batch_set_material(struct static_batch_group *group, object_t object)
+{
+    group->object.mesh = &group->mesh;
+    group->object.lod = 0;
+    group->mesh.topology = object->mesh->topology;
+    glm_mat4_identity(group->object.vertex_push_constant.model);
+    group->object.vertex_push_constant.model[3][2] = object->vertex_push_constant.model[3][2];
+    glm_vec4_copy(object->vertex_push_constant.color, group->object.vertex_push_constant.color);
+    object_set_texture(&group->object, object->texture, (vec4) {0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+static bool static_batch_has_material(static_batch_t batch, object_t object)
+{
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        if (batch->groups[i]->entries_count > 0 && static_batch_match_material(batch->groups[i], object))
+            return true;
+    }
+    return false;
+}
+
+static bool static_batch_find_group(static_batch_t batch, object_t object, uint32_t *group)
+{
+    uint32_t empty_group = UINT32_MAX;
+
+    if (!static_batch_is_planar(object)) {
+        *group = STATIC_BATCH_LOOSE_GROUP;
+        return true;
+    }
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        if (batch->groups[i]->entries_count == 0) {
+            if (empty_group == UINT32_MAX)
+                empty_group = i;
+        } else if (static_batch_match_material(batch->groups[i], object)) {
+            *group = i;
+            return true;
+        }
+    }
+
+    if (empty_group == UINT32_MAX) {
+        allocator_t allocator = &batch->engine->allocator;
+        struct static_batch_group **new_groups = allocator_reallocate(allocator, batch->groups, sizeof(struct static_batch_group *) * (batch->groups_count + 1), ALLOCATOR_SUBSYSTEM_SCENE);
+
+        if (!new_groups)
+            return false;
+        batch->groups = new_groups;
+        batch->groups[batch->groups_count] = allocator_allocate_zeroed(allocator, 1, sizeof(struct static_batch_group), ALLOCATOR_SUBSYSTEM_SCENE);
+        if (!batch->groups[batch->groups_count])
+            return false;
+        empty_group = batch->groups_count++;
+    }
+    static_batch_set_material(batch->groups[empty_group], object);
+    batch->groups[empty_group]->dirty = true;
+    *group = empty_group;
+    return true;
+}
+
+static void static_batch_bake_vertices(object_t object, struct vertex *vertices)
+{
+    mesh_t mesh = object->mesh;
+    vec4 *model = object->vertex_push_constant.model;
+    float *uv_rect = object->vertex_push_constant.uv_rect;
+
+    mesh_generate_uvs(mesh->positions, mesh->vertices_count, vertices);
+    for (uint32_t i = 0; i < mesh->vertices_count; ++i) {
+        vec3 position = {vertices[i].pos[0], vertices[i].pos[1], 0.0f};
+        vec3 world;
+
+        glm_mat4_mulv3(model, position, 1.0f, world);
+        glm_vec2_copy(world, vertices[i].pos);
+        vertices[i].uv[0] = glm_lerp(uv_rect[0], uv_rect[2], vertices[i].uv[0]);
+        vertices[i].uv[1] = glm_lerp(uv_rect[1], uv_rect[3], vertices[i].uv[1]);
+    }
+}
+
+/*
+    Objects are merged from the last one to the first, so that within a group the first object given is drawn on top as with `engine_draw()`.
+    Creating the buffers waits for the queue to be idle, so the previous ones can be destroyed right after.
+    An emptied group creates nothing, so it waits for the frames in flight before destroying its buffers
+*/
+static bool static_batch_rebuild_group(static_batch_t batch, uint32_t index)
+{
+    struct static_batch_group *group = batch->groups[index];
+    vulkan_context_t context = &batch->engine->vulkan_context;
+    allocator_t allocator = &batch->engine->allocator;
+    // Strips of consecutive objects are kept apart by a restart index
+    bool is_strip = group->mesh.topology == MESH_TOPOLOGY_TRIANGLE_STRIP || group->mesh.topology == MESH_TOPOLOGY_LINE_STRIP;
+    enum mesh_topology topology = group->mesh.topology;
+    uint32_t vertices_count = 0;
+    uint32_t indices_count = 0;
+
+    for (uint32_t i = 0; i < batch->entries_count; ++i) {
+        mesh_t mesh = batch->entries[i].object->mesh;
+
+        if (batch->entries[i].group == index) {
+            if (is_strip && indices_count > 0)
+                indices_count++;
+            vertices_count += mesh->vertices_count;
+            indices_count += mesh->lods[mesh->lods_count - 1].indices_count;
+        }
+    }
+    group->dirty = false;
+    if (indices_count == 0) {
+        if (group->mesh.vertex_buffer != VK_NULL_HANDLE)
+            vkDeviceWaitIdle(context->device);
+        static_batch_release_group(batch, group);
+        return true;
+    }
+
+    struct vertex *vertices = allocator_allocate(allocator, sizeof(struct vertex) * vertices_count, ALLOCATOR_SUBSYSTEM_SCENE);
+    uint32_t *indices = allocator_allocate(allocator, sizeof(uint32_t) * indices_count, ALLOCATOR_SUBSYSTEM_SCENE);
+    struct mesh mesh = {
+        .ref_count = 1,
+        .primitive = MESH_PRIMITIVE_NONE,
+        .topology = topology,
+        .vertices_count = vertices_count,
+        .indices_count = indices_count,
+        .lods = {{.first_index = 0, .indices_count = indices_count, .segments_count = 0, .error = 0.0f}},
+        .lods_count = 1
+    };
+
+    if (!vertices || !indices) {
+        allocator_free(allocator, vertices, ALLOCATOR_SUBSYSTEM_SCENE);
+        allocator_free(allocator, indices, ALLOCATOR_SUBSYSTEM_SCENE);
+        group->dirty = true;
+        return false;
+    }
+
+    uint32_t first_vertex = 0;
+    uint32_t first_index = 0;
+    for (uint32_t i = batch->entries_count; i-- > 0;) {
+        struct static_batch_entry *entry = &batch->entries[i];
+        mesh_t entry_mesh = entry->object->mesh;
+        struct mesh_lod *lod = &entry_mesh->lods[entry_mesh->lods_count - 1];
+
+        if (entry->group != index)
+            continue;
+        entry->mesh = entry_mesh;
+        entry->first_vertex = first_vertex;
+        entry->dirty = false;
+        static_batch_bake_vertices(entry->object, vertices + first_vertex);
+        if (is_strip && first_index > 0)
+            indices[first_index++] = MESH_PRIMITIVE_RESTART_INDEX;
+        for (uint32_t j = 0; j < lod->indices_count; ++j) {
+            uint32_t entry_index = entry_mesh->indices[lod->first_index + j];
+
+            indices[first_index++] = entry_index == MESH_PRIMITIVE_RESTART_INDEX ? entry_index : entry_index + first_vertex;
+        }
+        first_vertex += entry_mesh->vertices_count;
+    }
+
+    // The old group is kept and drawn until its buffers can be replaced
+    bool created = vulkan_create_vertex_buffer(context, &mesh, vertices, vertices_count)
+        && vulkan_create_index_buffer(context, &mesh, indices, indices_count, vertices_count);
+
+    allocator_free(allocator, indices, ALLOCATOR_SUBSYSTEM_SCENE);
+    if (!created) {
+        static_batch_destroy_buffers(context, &mesh);
+        allocator_free(allocator, vertices, ALLOCATOR_SUBSYSTEM_SCENE);
+        group->dirty = true;
+        return false;
+    }
+
+    static_batch_release_group(batch, group);
+    group->mesh = mesh;
+    group->vertices = vertices;
+    return true;
+}
+
+static bool static_batch_rebuild_dirty_groups(static_batch_t batch)
+{
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        if (batch->groups[i]->dirty && !static_batch_rebuild_group(batch, i))
+            return false;
+    }
+    return true;
+}
+
+bool static_batch_build(static_batch_t batch, const object_t *objects, uint32_t objects_count)
+{
+    allocator_t allocator = &batch->engine->allocator;
+
+    if (batch->entries)
+        allocator_free(allocator, batch->entries, ALLOCATOR_SUBSYSTEM_SCENE);
+    batch->entries = NULL;
+    batch->entries_count = 0;
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        batch->groups[i]->entries_count = 0;
+        batch->groups[i]->dirty = true;
+    }
+
+    if (objects_count > 0) {
+        batch->entries = allocator_allocate_zeroed(allocator, objects_count, sizeof(struct static_batch_entry), ALLOCATOR_SUBSYSTEM_SCENE);
+        if (!batch->entries) {
+            static_batch_cleanup(batch);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < objects_count; ++i) {
+        struct static_batch_entry *entry = &batch->entries[batch->entries_count++];
+
+        entry->object = objects[i];
+        entry->mesh = objects[i]->mesh;
+        if (!static_batch_find_group(batch, objects[i], &entry->group)) {
+            static_batch_cleanup(batch);
+            return false;
+        }
+        if (entry->group != STATIC_BATCH_LOOSE_GROUP)
+            batch->groups[entry->group]->entries_count++;
+    }
+
+    if (!static_batch_rebuild_dirty_groups(batch)) {
+        static_batch_cleanup(batch);
+        return false;
+    }
+    return true;
+}
+
+void static_batch_invalidate(static_batch_t batch, uint32_t entry)
+{
+    if (entry < batch->entries_count)
+        batch->entries[entry].dirty = true;
+}
+
+/*
+    An edited object keeping its group and its mesh is baked again in place, otherwise the groups it leaves and joins are rebuilt.
+    An object alone in its group and changing of material to one no other group has takes its group along, so that it is baked in place too
+*/
+static bool static_batch_update(static_batch_t batch)
+{
+    vulkan_context_t context = &batch->engine->vulkan_context;
+
+    for (uint32_t i = 0; i < batch->entries_count; ++i) {
+        struct static_batch_entry *entry = &batch->entries[i];
+        object_t object = entry->object;
+        uint32_t group;
+
+        if (!entry->dirty)
+            continue;
+        if (entry->group != STATIC_BATCH_LOOSE_GROUP && batch->groups[entry->group]->entries_count == 1 && entry->mesh == object->mesh
+            && static_batch_is_planar(object) && !static_batch_has_material(batch, object))
+            static_batch_set_material(batch->groups[entry->group], object);
+        if (!static_batch_find_group(batch, object, &group))
+            return false;
+
+        // A group whose rebuild failed still holds its old geometry, the offsets of its entries don't match it anymore
+        if (group == entry->group && (group == STATIC_BATCH_LOOSE_GROUP || (entry->mesh == object->mesh && !batch->groups[group]->dirty))) {
+            if (group != STATIC_BATCH_LOOSE_GROUP) {
+                struct static_batch_group *baked_group = batch->groups[group];
+                struct vertex *vertices = baked_group->vertices + entry->first_vertex;
+
+                // The update is kept for the next frame when the queue is full
+                static_batch_bake_vertices(object, vertices);
+                if (!vulkan_queue_buffer_update(context, baked_group->mesh.vertex_buffer, sizeof(struct vertex) * entry->first_vertex,
+                    vertices, sizeof(struct vertex) * object->mesh->vertices_count))
+                    break;
+            }
+            entry->mesh = object->mesh;
+            entry->dirty = false;
+            continue;
+        }
+
+        if (entry->group != STATIC_BATCH_LOOSE_GROUP) {
+            batch->groups[entry->group]->entries_count--;
+            batch->groups[entry->group]->dirty = true;
+        }
+        if (group != STATIC_BATCH_LOOSE_GROUP) {
+            batch->groups[group]->entries_count++;
+            batch->groups[group]->dirty = true;
+        }
+        entry->group = group;
+        entry->mesh = object->mesh;
+        entry->dirty = false;
+    }
+    return static_batch_rebuild_dirty_groups(batch);
+}
+
+bool static_batch_draw(engine_t engine, static_batch_t batch)
+{
+    if (!static_batch_update(batch))
+        return false;
+
+    for (uint32_t i = 0; i < batch->groups_count; ++i) {
+        struct static_batch_group *group = batch->groups[i];
+
+        if (group->entries_count > 0 && group->mesh.indices_count > 0 && !engine_draw(engine, &group->object))
+            return false;
+    }
+    for (uint32_t i = 0; i < batch->entries_count; ++i) {
+        if (batch->entries[i].group == STATIC_BATCH_LOOSE_GROUP && !engine_draw(engine, batch->entries[i].object))
+            return false;
+    }
+    return true;
+}
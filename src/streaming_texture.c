@@ -0,0 +1,101 @@
+#include "streaming_texture.h"
+#include "engine.h"
+
+bool streaming_texture_init(streaming_texture_t streaming_texture, engine_t engine, uint32_t width, uint32_t height, VkFormat format)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    VkDeviceSize slice_size;
+    void *mapped;
+
+    memset(streaming_texture, 0, sizeof(struct streaming_texture));
+    streaming_texture->texel_size = vulkan_get_texel_size(format);
+    streaming_texture->row_pitch = width * streaming_texture->texel_size;
+    slice_size = ((VkDeviceSize) streaming_texture->row_pitch * height + STREAMING_TEXTURE_SLICE_ALIGNMENT - 1) & ~(VkDeviceSize) (STREAMING_TEXTURE_SLICE_ALIGNMENT - 1);
+
+    if (!vulkan_create_texture(context, width, height, format, &streaming_texture->texture))
+        return false;
+    if (!vulkan_create_staging_buffer(context, slice_size * STREAMING_TEXTURE_SLICES_COUNT, &streaming_texture->buffer, &streaming_texture->memory, &mapped)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Failed to create the staging buffer of a streaming texture\n", 60);
+        #endif
+        vulkan_destroy_texture(context, &streaming_texture->texture);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < STREAMING_TEXTURE_SLICES_COUNT; ++i) {
+        streaming_texture->slices[i].offset = slice_size * i;
+        streaming_texture->slices[i].pixels = PTR_OFFSET(mapped, slice_size * i);
+        atomic_init(&streaming_texture->slices[i].state, STREAMING_TEXTURE_SLICE_FREE);
+    }
+    atomic_init(&streaming_texture->next_sequence, 0);
+    streaming_texture->engine = engine;
+
+    if (!vulkan_add_streaming_texture(context, streaming_texture)) {
+        streaming_texture_cleanup(streaming_texture);
+        return false;
+    }
+    return true;
+}
+
+void streaming_texture_cleanup(streaming_texture_t streaming_texture)
+{
+    engine_t engine = streaming_texture->engine;
+    vulkan_context_t context;
+
+    if (!engine)
+        return;
+    context = &engine->vulkan_context;
+
+    vulkan_remove_streaming_texture(context, streaming_texture);
+    // Freeing the memory unmaps the slices
+    vkDestroyBuffer(context->device, streaming_texture->buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, streaming_texture->memory, &context->allocation_callbacks);
+    vulkan_destroy_texture(context, &streaming_texture->texture);
+    memset(streaming_texture, 0, sizeof(struct streaming_texture));
+}
+
+/*
+    A slice is owned by whoever moved it out of the free state, so concurrent producers never get the same slice.
+    The frame recording only reads the slices once they are ready, and frees them when a later slice covers them or their copy is done
+*/
+streaming_texture_slice_t streaming_texture_acquire(streaming_texture_t streaming_texture)
+{
+    for (uint32_t i = 0; i < STREAMING_TEXTURE_SLICES_COUNT; ++i) {
+        streaming_texture_slice_t slice = &streaming_texture->slices[i];
+        uint32_t expected = STREAMING_TEXTURE_SLICE_FREE;
+
+        if (atomic_compare_exchange_strong_explicit(&slice->state, &expected, STREAMING_TEXTURE_SLICE_WRITING, memory_order_acquire, memory_order_relaxed))
+            return slice;
+    }
+    return NULL;
+}
+
+void streaming_texture_submit(streaming_texture_t streaming_texture, streaming_texture_slice_t slice, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    if (width == 0 || height == 0) {
+        atomic_store_explicit(&slice->state, STREAMING_TEXTURE_SLICE_FREE, memory_order_release);
+        return;
+    }
+
+    slice->x = x;
+    slice->y = y;
+    slice->width = width;
+    slice->height = height;
+    slice->sequence = atomic_fetch_add_explicit(&streaming_texture->next_sequence, 1, memory_order_relaxed);
+    // Publishes the texels and the rectangle written before to the frame recording
+    atomic_store_explicit(&slice->state, STREAMING_TEXTURE_SLICE_READY, memory_order_release);
+}
+
+bool streaming_texture_update(streaming_texture_t streaming_texture, const void *pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t row_length)
+{
+    streaming_texture_slice_t slice = streaming_texture_acquire(streaming_texture);
+    size_t row_size = (size_t) width * streaming_texture->texel_size;
+
+    if (!slice)
+        return false;
+    for (uint32_t row = 0; row < height; ++row)
+        memcpy(PTR_OFFSET(slice->pixels, (size_t) (y + row) * streaming_texture->row_pitch + (size_t) x * streaming_texture->texel_size),
+            PTR_OFFSET(pixels, (size_t) row * row_length * streaming_texture->texel_size), row_size);
+    streaming_texture_submit(streaming_texture, slice, x, y, width, height);
+    return true;
+}
@@ -0,0 +1,268 @@
+#include "stroke.h"
+#include "geometry.h"
+#include <math.h>
+
+/*
+    Every segment is a quad of its own and the gap left on the outer side of a corner is filled by the join,
+    the quads overlap on the inner side. Nothing of a segment depends on the next one, so appending a point
+    only emits the join at the previous last point and the quad of the new segment
+*/
+#define STROKE_BUFFER_MIN_CAPACITY 64
+#define STROKE_COLLINEAR_EPSILON 1e-6f
+
+void stroke_style_init(struct stroke_style *style, float width)
+{
+    style->width = width;
+    style->join = STROKE_JOIN_MITER;
+    style->cap = STROKE_CAP_BUTT;
+    style->miter_limit = STROKE_MITER_LIMIT_DEFAULT;
+}
+
+void stroke_buffer_init(stroke_buffer_t buffer, allocator_t allocator)
+{
+    buffer->allocator = allocator;
+    buffer->positions = NULL;
+    buffer->vertices_count = 0;
+    buffer->vertices_capacity = 0;
+    buffer->indices = NULL;
+    buffer->indices_count = 0;
+    buffer->indices_capacity = 0;
+}
+
+void stroke_buffer_clear(stroke_buffer_t buffer)
+{
+    buffer->vertices_count = 0;
+    buffer->indices_count = 0;
+}
+
+void stroke_buffer_cleanup(stroke_buffer_t buffer)
+{
+    if (buffer->positions)
+        allocator_free(buffer->allocator, buffer->positions, ALLOCATOR_SUBSYSTEM_MESH);
+    if (buffer->indices)
+        allocator_free(buffer->allocator, buffer->indices, ALLOCATOR_SUBSYSTEM_MESH);
+    stroke_buffer_init(buffer, buffer->allocator);
+}
+
+static bool stroke_buffer_reserve(stroke_buffer_t buffer, uint32_t vertices_count, uint32_t indices_count)
+{
+    if (buffer->vertices_count + vertices_count > buffer->vertices_capacity) {
+        uint32_t capacity = buffer->vertices_capacity ? buffer->vertices_capacity : STROKE_BUFFER_MIN_CAPACITY;
+        vec2 *positions;
+
+        while (capacity < buffer->vertices_count + vertices_count)
+            capacity *= 2;
+        positions = allocator_reallocate(buffer->allocator, buffer->positions, capacity * sizeof(vec2), ALLOCATOR_SUBSYSTEM_MESH);
+        if (!positions)
+            return false;
+        buffer->positions = positions;
+        buffer->vertices_capacity = capacity;
+    }
+    if (buffer->indices_count + indices_count > buffer->indices_capacity) {
+        uint32_t capacity = buffer->indices_capacity ? buffer->indices_capacity : STROKE_BUFFER_MIN_CAPACITY;
+        uint32_t *indices;
+
+        while (capacity < buffer->indices_count + indices_count)
+            capacity *= 2;
+        indices = allocator_reallocate(buffer->allocator, buffer->indices, capacity * sizeof(uint32_t), ALLOCATOR_SUBSYSTEM_MESH);
+        if (!indices)
+            return false;
+        buffer->indices = indices;
+        buffer->indices_capacity = capacity;
+    }
+    return true;
+}
+
+static uint32_t stroke_buffer_push_vertex(stroke_buffer_t buffer, float x, float y)
+{
+    buffer->positions[buffer->vertices_count][0] = x;
+    buffer->positions[buffer->vertices_count][1] = y;
+    return buffer->vertices_count++;
+}
+
+// Push a triangle, swapping two of its vertices if needed so that it is counter-clockwise
+static void stroke_buffer_push_triangle(stroke_buffer_t buffer, uint32_t a, uint32_t b, uint32_t c)
+{
+    const float *pa = buffer->positions[a];
+    const float *pb = buffer->positions[b];
+    const float *pc = buffer->positions[c];
+    float area = (pb[0] - pa[0]) * (pc[1] - pa[1]) - (pb[1] - pa[1]) * (pc[0] - pa[0]);
+
+    buffer->indices[buffer->indices_count++] = a;
+    buffer->indices[buffer->indices_count++] = area < 0.0f ? c : b;
+    buffer->indices[buffer->indices_count++] = area < 0.0f ? b : c;
+}
+
+static uint32_t stroke_arc_segments_count(float angle)
+{
+    uint32_t count = (uint32_t) ceilf(fabsf(angle) / (float) M_PI * STROKE_ROUND_SEGMENTS_PER_HALF_TURN);
+
+    return count ? count : 1;
+}
+
+// Fan of triangles around `center` from `start_angle` turning of `angle` radians, the vertices at both ends included
+static bool stroke_push_arc(stroke_buffer_t buffer, const vec2 center, float radius, float start_angle, float angle)
+{
+    uint32_t segments_count = stroke_arc_segments_count(angle);
+    uint32_t center_index;
+
+    if (!stroke_buffer_reserve(buffer, segments_count + 2, segments_count * 3))
+        return false;
+    center_index = stroke_buffer_push_vertex(buffer, center[0], center[1]);
+    geometry_generate_arc(center, (vec2) {radius, radius}, start_angle, angle / segments_count, segments_count + 1,
+        buffer->positions + buffer->vertices_count);
+    buffer->vertices_count += segments_count + 1;
+    for (uint32_t i = 1; i <= segments_count; i++)
+        stroke_buffer_push_triangle(buffer, center_index, center_index + i, center_index + i + 1);
+    return true;
+}
+
+static bool stroke_push_segment(stroke_buffer_t buffer, const vec2 from, const vec2 to, const vec2 direction, float half_width)
+{
+    float nx = -direction[1] * half_width;
+    float ny = direction[0] * half_width;
+    uint32_t first;
+
+    if (!stroke_buffer_reserve(buffer, 4, 6))
+        return false;
+    first = stroke_buffer_push_vertex(buffer, from[0] + nx, from[1] + ny);
+    stroke_buffer_push_vertex(buffer, from[0] - nx, from[1] - ny);
+    stroke_buffer_push_vertex(buffer, to[0] + nx, to[1] + ny);
+    stroke_buffer_push_vertex(buffer, to[0] - nx, to[1] - ny);
+    stroke_buffer_push_triangle(buffer, first + 1, first + 3, first + 2);
+    stroke_buffer_push_triangle(buffer, first + 1, first + 2, first);
+    return true;
+}
+
+// Cap at `point`, `outward` being the normalized direction pointing out of the stroke
+static bool stroke_push_cap(stroke_buffer_t buffer, const struct stroke_style *style, const vec2 point, const vec2 outward)
+{
+    float half_width = style->width * 0.5f;
+
+    switch (style->cap) {
+        case STROKE_CAP_SQUARE: {
+            vec2 end = {point[0] + outward[0] * half_width, point[1] + outward[1] * half_width};
+
+            return stroke_push_segment(buffer, point, end, outward, half_width);
+        }
+        case STROKE_CAP_ROUND:
+            return stroke_push_arc(buffer, point, half_width, atan2f(outward[1], outward[0]) - (float) M_PI_2, (float) M_PI);
+        default:
+            return true;
+    }
+}
+
+// Join at `point` between the segment of direction `in` ending there and the segment of direction `out` starting there
+static bool stroke_push_join(stroke_buffer_t buffer, const struct stroke_style *style, const vec2 point, const vec2 in, const vec2 out)
+{
+    float half_width = style->width * 0.5f;
+    float cross = in[0] * out[1] - in[1] * out[0];
+    float dot = in[0] * out[0] + in[1] * out[1];
+    // The outer side of a left turn is on the right of the segments
+    float side = cross > 0.0f ? -1.0f : 1.0f;
+    vec2 outer_in = {-in[1] * side, in[0] * side};
+    vec2 outer_out = {-out[1] * side, out[0] * side};
+    enum stroke_join join = style->join;
+    uint32_t first;
+
+    if (fabsf(cross) < STROKE_COLLINEAR_EPSILON && dot > 0.0f)
+        return true;
+
+    if (join == STROKE_JOIN_ROUND) {
+        float start_angle = atan2f(outer_in[1], outer_in[0]);
+        float angle = atan2f(cross, dot);
+
+        return stroke_push_arc(buffer, point, half_width, start_angle, fabsf(cross) < STROKE_COLLINEAR_EPSILON ? (float) M_PI * -side : angle);
+    }
+
+    // The miter tip is at half_width / cos(theta / 2) along the bisector of the outer normals, theta being the turn angle
+    float cos_half_angle = sqrtf((1.0f + dot) * 0.5f);
+    float miter_ratio = cos_half_angle > STROKE_COLLINEAR_EPSILON ? 1.0f / cos_half_angle : INFINITY;
+
+    if (join == STROKE_JOIN_MITER && miter_ratio > style->miter_limit)
+        join = STROKE_JOIN_BEVEL;
+    if (!stroke_buffer_reserve(buffer, 4, 6))
+        return false;
+    first = stroke_buffer_push_vertex(buffer, point[0], point[1]);
+    stroke_buffer_push_vertex(buffer, point[0] + outer_in[0] * half_width, point[1] + outer_in[1] * half_width);
+    stroke_buffer_push_vertex(buffer, point[0] + outer_out[0] * half_width, point[1] + outer_out[1] * half_width);
+    stroke_buffer_push_triangle(buffer, first, first + 1, first + 2);
+    if (join == STROKE_JOIN_MITER) {
+        vec2 bisector = {outer_in[0] + outer_out[0], outer_in[1] + outer_out[1]};
+        float length = sqrtf(bisector[0] * bisector[0] + bisector[1] * bisector[1]);
+        float scale = half_width * miter_ratio / length;
+
+        stroke_buffer_push_vertex(buffer, point[0] + bisector[0] * scale, point[1] + bisector[1] * scale);
+        stroke_buffer_push_triangle(buffer, first + 1, first + 3, first + 2);
+    }
+    return true;
+}
+
+void stroke_begin(stroke_t stroke, const struct stroke_style *style, vec2 point)
+{
+    stroke->style = *style;
+    glm_vec2_copy(point, stroke->first_point);
+    glm_vec2_copy(point, stroke->last_point);
+    glm_vec2_zero(stroke->first_direction);
+    glm_vec2_zero(stroke->last_direction);
+    stroke->segments_count = 0;
+    stroke->closed = false;
+}
+
+bool stroke_append(stroke_buffer_t buffer, stroke_t stroke, const vec2 *points, uint32_t points_count)
+{
+    float half_width = stroke->style.width * 0.5f;
+
+    for (uint32_t i = 0; i < points_count; i++) {
+        vec2 direction = {points[i][0] - stroke->last_point[0], points[i][1] - stroke->last_point[1]};
+        float length = sqrtf(direction[0] * direction[0] + direction[1] * direction[1]);
+
+        if (length <= 0.0f)
+            continue;
+        direction[0] /= length;
+        direction[1] /= length;
+
+        if (stroke->segments_count == 0)
+            glm_vec2_copy(direction, stroke->first_direction);
+        else if (!stroke_push_join(buffer, &stroke->style, stroke->last_point, stroke->last_direction, direction))
+            return false;
+        if (!stroke_push_segment(buffer, stroke->last_point, points[i], direction, half_width))
+            return false;
+
+        glm_vec2_copy(direction, stroke->last_direction);
+        glm_vec2_copy((float *) points[i], stroke->last_point);
+        stroke->segments_count++;
+    }
+    return true;
+}
+
+bool stroke_end(stroke_buffer_t buffer, stroke_t stroke)
+{
+    vec2 outward;
+
+    if (stroke->segments_count == 0)
+        return true;
+    if (stroke->closed)
+        return stroke_push_join(buffer, &stroke->style, stroke->first_point, stroke->last_direction, stroke->first_direction);
+
+    glm_vec2_negate_to(stroke->first_direction, outward);
+    return stroke_push_cap(buffer, &stroke->style, stroke->first_point, outward)
+        && stroke_push_cap(buffer, &stroke->style, stroke->last_point, stroke->last_direction);
+}
+
+bool stroke_buffer_add_polyline(stroke_buffer_t buffer, const struct stroke_style *style, const vec2 *points, uint32_t points_count, bool closed)
+{
+    struct stroke stroke;
+
+    if (points_count == 0)
+        return true;
+    stroke_begin(&stroke, style, (float *) points[0]);
+    if (!stroke_append(buffer, &stroke, points + 1, points_count - 1))
+        return false;
+    if (closed) {
+        if (!stroke_append(buffer, &stroke, points, 1))
+            return false;
+        stroke.closed = true;
+    }
+    return stroke_end(buffer, &stroke);
+}
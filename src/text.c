@@ -0,0 +1,173 @@
+#include "text.h"
+#include "engine.h"
+
+#define TEXT_REPLACEMENT_CHARACTER 0xFFFD
+
+// Decode the codepoint at `*string` and advance past it, malformed sequences decode to the replacement character one byte at a time
+static uint32_t text_decode_utf8(const char **string)
+{
+    const uint8_t *bytes = (const uint8_t *) *string;
+    uint32_t codepoint;
+    uint32_t length;
+
+    if (bytes[0] < 0x80) {
+        *string += 1;
+        return bytes[0];
+    }
+    if ((bytes[0] & 0xE0) == 0xC0) {
+        codepoint = bytes[0] & 0x1F;
+        length = 2;
+    } else if ((bytes[0] & 0xF0) == 0xE0) {
+        codepoint = bytes[0] & 0x0F;
+        length = 3;
+    } else if ((bytes[0] & 0xF8) == 0xF0) {
+        codepoint = bytes[0] & 0x07;
+        length = 4;
+    } else {
+        *string += 1;
+        return TEXT_REPLACEMENT_CHARACTER;
+    }
+    for (uint32_t i = 1; i < length; ++i) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            *string += 1;
+            return TEXT_REPLACEMENT_CHARACTER;
+        }
+        codepoint = codepoint << 6 | (bytes[i] & 0x3F);
+    }
+    *string += length;
+    return codepoint;
+}
+
+static float text_get_line_height(const struct font *font)
+{
+    return (float) (font->ascender - font->descender + font->line_gap) / font->units_per_em;
+}
+
+/*
+    Glyphs are placed on the baseline from their advance and the kerning with the previous glyph, and drawn from
+    the quad of their cell in the atlas, so the layout of a glyph already in the atlas is a hash lookup and a 48 bytes store
+*/
+bool text_draw(engine_t engine, const struct font *font, const char *string, vec2 position, float size, vec4 color)
+{
+    quad_batch_t batch = &engine->text_batch;
+    float units_to_world = size / font->units_per_em;
+    float line_advance = text_get_line_height(font) * size;
+    float x = position[0];
+    float y = position[1];
+    uint32_t previous = 0;
+
+    while (*string) {
+        uint32_t codepoint = text_decode_utf8(&string);
+        uint32_t index;
+        int32_t advance;
+        const struct glyph *glyph;
+
+        if (codepoint == '\n') {
+            x = position[0];
+            y -= line_advance;
+            previous = 0;
+            continue;
+        }
+        index = font_get_glyph_index(font, codepoint);
+        if (previous)
+            x += font_get_kerning(font, previous, index) * units_to_world;
+        previous = index;
+        font_get_glyph_horizontal_metrics(font, index, &advance, NULL);
+
+        if (!glyph_atlas_acquire(&engine->glyph_atlas, font, index, &glyph))
+            return false;
+        if (glyph) {
+            if (batch->quads_count == batch->quads_capacity && !quad_batch_grow(batch, &engine->vulkan_context))
+                return false;
+
+            struct text_quad *quad = (struct text_quad *) batch->quads + batch->quads_count++;
+
+            quad->position[0] = x + glyph->plane[0] * size;
+            quad->position[1] = y + glyph->plane[1] * size;
+            quad->size[0] = (glyph->plane[2] - glyph->plane[0]) * size;
+            quad->size[1] = (glyph->plane[3] - glyph->plane[1]) * size;
+            glm_vec4_copy((float *) glyph->uv_rect, quad->uv_rect);
+            glm_vec4_copy(color, quad->color);
+        }
+        x += advance * units_to_world;
+    }
+    return true;
+}
+
+void text_measure(const struct font *font, const char *string, float size, vec2 dimensions)
+{
+    float units_to_world = size / font->units_per_em;
+    float width = 0.0f;
+    float line_width = 0.0f;
+    uint32_t lines_count = 1;
+    uint32_t previous = 0;
+
+    while (*string) {
+        uint32_t codepoint = text_decode_utf8(&string);
+        uint32_t index;
+        int32_t advance;
+
+        if (codepoint == '\n') {
+            width = fmaxf(width, line_width);
+            line_width = 0.0f;
+            lines_count++;
+            previous = 0;
+            continue;
+        }
+        index = font_get_glyph_index(font, codepoint);
+        if (previous)
+            line_width += font_get_kerning(font, previous, index) * units_to_world;
+        previous = index;
+        font_get_glyph_horizontal_metrics(font, index, &advance, NULL);
+        line_width += advance * units_to_world;
+    }
+    dimensions[0] = fmaxf(width, line_width);
+    dimensions[1] = ((lines_count - 1) * text_get_line_height(font) + (float) (font->ascender - font->descender) / font->units_per_em) * size;
+}
+
+void text_get_binding_description(uint32_t *text_binding_descriptions_count, VkVertexInputBindingDescription *text_binding_descriptions)
+{
+    if (!text_binding_descriptions) {
+        *text_binding_descriptions_count = 1;
+        return;
+    }
+
+    text_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct text_quad),
+        .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+    };
+}
+
+void text_get_attribute_description(uint32_t *text_attribute_descriptions_count, VkVertexInputAttributeDescription *text_attribute_descriptions)
+{
+    if (!text_attribute_descriptions) {
+        *text_attribute_descriptions_count = TEXT_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    text_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct text_quad, position)
+    };
+    text_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct text_quad, size)
+    };
+    text_attribute_descriptions[2] = (VkVertexInputAttributeDescription) {
+        .location = 2,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct text_quad, uv_rect)
+    };
+    text_attribute_descriptions[3] = (VkVertexInputAttributeDescription) {
+        .location = 3,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct text_quad, color)
+    };
+}
@@ -0,0 +1,140 @@
+#include "texture_atlas.h"
+#include "engine.h"
+
+#define TEXTURE_ATLAS_TEXEL_SIZE 4
+
+bool texture_atlas_init(texture_atlas_t atlas, engine_t engine, uint32_t page_size)
+{
+    memset(atlas, 0, sizeof(struct texture_atlas));
+    if (page_size <= 2 * TEXTURE_ATLAS_PADDING)
+        return false;
+
+    atlas->engine = engine;
+    atlas->page_size = page_size;
+    return true;
+}
+
+static void texture_atlas_destroy_page(texture_atlas_t atlas, struct texture_atlas_page *page)
+{
+    allocator_t allocator = &atlas->engine->allocator;
+
+    skyline_cleanup(&page->skyline);
+    if (page->pixels)
+        allocator_free(allocator, page->pixels, ALLOCATOR_SUBSYSTEM_TEXTURE);
+    if (page->texture) {
+        vulkan_destroy_texture(&atlas->engine->vulkan_context, page->texture);
+        allocator_free(allocator, page->texture, ALLOCATOR_SUBSYSTEM_TEXTURE);
+    }
+}
+
+void texture_atlas_cleanup(texture_atlas_t atlas)
+{
+    for (uint32_t i = 0; i < atlas->pages_count; ++i)
+        texture_atlas_destroy_page(atlas, &atlas->pages[i]);
+    if (atlas->pages)
+        allocator_free(&atlas->engine->allocator, atlas->pages, ALLOCATOR_SUBSYSTEM_TEXTURE);
+    atlas->pages = NULL;
+    atlas->pages_count = 0;
+    atlas->pages_capacity = 0;
+}
+
+static struct texture_atlas_page *texture_atlas_add_page(texture_atlas_t atlas)
+{
+    allocator_t allocator = &atlas->engine->allocator;
+    struct texture_atlas_page *page;
+
+    if (atlas->pages_count == atlas->pages_capacity) {
+        uint32_t new_capacity = atlas->pages_capacity ? atlas->pages_capacity * 2 : 1;
+        struct texture_atlas_page *new_pages = allocator_reallocate(allocator, atlas->pages, sizeof(struct texture_atlas_page) * new_capacity, ALLOCATOR_SUBSYSTEM_TEXTURE);
+
+        if (!new_pages)
+            return NULL;
+        atlas->pages = new_pages;
+        atlas->pages_capacity = new_capacity;
+    }
+
+    page = &atlas->pages[atlas->pages_count];
+    memset(page, 0, sizeof(struct texture_atlas_page));
+    page->pixels = allocator_allocate_zeroed(allocator, (size_t) atlas->page_size * atlas->page_size, TEXTURE_ATLAS_TEXEL_SIZE, ALLOCATOR_SUBSYSTEM_TEXTURE);
+    page->texture = allocator_allocate_zeroed(allocator, 1, sizeof(struct texture), ALLOCATOR_SUBSYSTEM_TEXTURE);
+    if (!page->pixels || !page->texture
+        || !skyline_init(&page->skyline, allocator, atlas->page_size, atlas->page_size)
+        || !vulkan_create_texture(&atlas->engine->vulkan_context, atlas->page_size, atlas->page_size, VK_FORMAT_R8G8B8A8_SRGB, page->texture)) {
+        texture_atlas_destroy_page(atlas, page);
+        return NULL;
+    }
+    atlas->pages_count++;
+    return page;
+}
+
+// Copy the image inside its padding, then repeat its border columns and rows over the padding
+static void texture_atlas_blit(texture_atlas_t atlas, struct texture_atlas_page *page, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *pixels)
+{
+    size_t stride = (size_t) atlas->page_size * TEXTURE_ATLAS_TEXEL_SIZE;
+    size_t row_size = (size_t) width * TEXTURE_ATLAS_TEXEL_SIZE;
+    uint8_t *first_row = page->pixels + (y + TEXTURE_ATLAS_PADDING) * stride + (size_t) x * TEXTURE_ATLAS_TEXEL_SIZE;
+
+    for (uint32_t row = 0; row < height; ++row) {
+        uint8_t *destination = first_row + row * stride;
+
+        memcpy(destination + TEXTURE_ATLAS_PADDING * TEXTURE_ATLAS_TEXEL_SIZE, pixels + row * row_size, row_size);
+        for (uint32_t i = 0; i < TEXTURE_ATLAS_PADDING; ++i) {
+            memcpy(destination + i * TEXTURE_ATLAS_TEXEL_SIZE, pixels + row * row_size, TEXTURE_ATLAS_TEXEL_SIZE);
+            memcpy(destination + (TEXTURE_ATLAS_PADDING + width + i) * TEXTURE_ATLAS_TEXEL_SIZE, pixels + row * row_size + row_size - TEXTURE_ATLAS_TEXEL_SIZE, TEXTURE_ATLAS_TEXEL_SIZE);
+        }
+    }
+    for (uint32_t i = 0; i < TEXTURE_ATLAS_PADDING; ++i) {
+        memcpy(first_row - (i + 1) * stride, first_row, row_size + 2 * TEXTURE_ATLAS_PADDING * TEXTURE_ATLAS_TEXEL_SIZE);
+        memcpy(first_row + (height + i) * stride, first_row + (height - 1) * stride, row_size + 2 * TEXTURE_ATLAS_PADDING * TEXTURE_ATLAS_TEXEL_SIZE);
+    }
+}
+
+bool texture_atlas_add(texture_atlas_t atlas, uint32_t width, uint32_t height, const void *pixels, struct texture_region *region)
+{
+    uint32_t padded_width = width + 2 * TEXTURE_ATLAS_PADDING;
+    uint32_t padded_height = height + 2 * TEXTURE_ATLAS_PADDING;
+    struct texture_atlas_page *page = NULL;
+    uint32_t x;
+    uint32_t y;
+
+    if (width == 0 || height == 0 || padded_width > atlas->page_size || padded_height > atlas->page_size) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Image doesn't fit in a texture atlas page\n", 43);
+        #endif
+        return false;
+    }
+
+    for (uint32_t i = 0; i < atlas->pages_count && !page; ++i) {
+        if (skyline_pack(&atlas->pages[i].skyline, padded_width, padded_height, &x, &y))
+            page = &atlas->pages[i];
+    }
+    if (!page) {
+        page = texture_atlas_add_page(atlas);
+        if (!page || !skyline_pack(&page->skyline, padded_width, padded_height, &x, &y))
+            return false;
+    }
+
+    texture_atlas_blit(atlas, page, x, y, width, height, pixels);
+    page->dirty = true;
+
+    region->texture = page->texture;
+    region->uv_rect[0] = (float) (x + TEXTURE_ATLAS_PADDING) / atlas->page_size;
+    region->uv_rect[1] = (float) (y + TEXTURE_ATLAS_PADDING + height) / atlas->page_size;
+    region->uv_rect[2] = (float) (x + TEXTURE_ATLAS_PADDING + width) / atlas->page_size;
+    region->uv_rect[3] = (float) (y + TEXTURE_ATLAS_PADDING) / atlas->page_size;
+    return true;
+}
+
+bool texture_atlas_upload(texture_atlas_t atlas)
+{
+    for (uint32_t i = 0; i < atlas->pages_count; ++i) {
+        struct texture_atlas_page *page = &atlas->pages[i];
+
+        if (!page->dirty)
+            continue;
+        if (!vulkan_upload_texture(&atlas->engine->vulkan_context, page->texture, page->pixels))
+            return false;
+        page->dirty = false;
+    }
+    return true;
+}
@@ -0,0 +1,240 @@
+#include "tilemap.h"
+#include "engine.h"
+
+bool tilemap_init(tilemap_t tilemap, engine_t engine, uint32_t width, uint32_t height, vec2 position, float tile_size, texture_t tileset, uint32_t tileset_columns, uint32_t tileset_rows)
+{
+    allocator_t allocator = &engine->allocator;
+    size_t chunks_count;
+
+    memset(tilemap, 0, sizeof(struct tilemap));
+    if (width == 0 || height == 0 || width > TILEMAP_MAX_SIZE || height > TILEMAP_MAX_SIZE || !tileset || tileset_columns == 0 || tileset_rows == 0) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Invalid tilemap or tileset size\n", 33);
+        #endif
+        return false;
+    }
+
+    tilemap->engine = engine;
+    tilemap->width = width;
+    tilemap->height = height;
+    tilemap->chunks_width = (width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    tilemap->chunks_height = (height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+    chunks_count = (size_t) tilemap->chunks_width * tilemap->chunks_height;
+
+    tilemap->tiles = allocator_allocate_zeroed(allocator, (size_t) width * height, sizeof(uint16_t), ALLOCATOR_SUBSYSTEM_TILEMAP);
+    tilemap->chunks = allocator_allocate_zeroed(allocator, chunks_count, sizeof(struct tilemap_chunk), ALLOCATOR_SUBSYSTEM_TILEMAP);
+    tilemap->instances = allocator_allocate(allocator, chunks_count * TILEMAP_CHUNK_TILES_COUNT * sizeof(struct tile_instance), ALLOCATOR_SUBSYSTEM_TILEMAP);
+    tilemap->draws = allocator_allocate(allocator, chunks_count * sizeof(struct tilemap_draw), ALLOCATOR_SUBSYSTEM_TILEMAP);
+    if (!tilemap->tiles || !tilemap->chunks || !tilemap->instances || !tilemap->draws
+        || !vulkan_create_instance_buffer(&engine->vulkan_context, chunks_count * TILEMAP_CHUNK_TILES_COUNT * sizeof(struct tile_instance), &tilemap->instance_buffer, &tilemap->instance_memory)) {
+        tilemap_cleanup(tilemap);
+        return false;
+    }
+
+    glm_translate_make(tilemap->push_constant.model, (vec3) {position[0], position[1], 0.0f});
+    glm_scale_uni(tilemap->push_constant.model, tile_size);
+    glm_vec4_one(tilemap->push_constant.color);
+    glm_vec4_copy((vec4) {1.0f / tileset_columns, 1.0f / tileset_rows, (float) tileset_columns, 0.0f}, tilemap->push_constant.uv_rect);
+    tilemap->push_constant.texture_index = tileset->index;
+    return true;
+}
+
+void tilemap_cleanup(tilemap_t tilemap)
+{
+    engine_t engine = tilemap->engine;
+    vulkan_context_t context;
+    uint32_t kept_count = 0;
+
+    if (!engine)
+        return;
+    context = &engine->vulkan_context;
+
+    // Forget the tilemap in the frame being built, with the updates still reading its instances
+    for (uint32_t i = 0; i < engine->tilemaps_to_draw_count; ++i) {
+        if (engine->tilemaps_to_draw[i] != tilemap)
+            engine->tilemaps_to_draw[kept_count++] = engine->tilemaps_to_draw[i];
+    }
+    engine->tilemaps_to_draw_count = kept_count;
+    if (tilemap->instance_buffer)
+        vulkan_cancel_buffer_updates(context, tilemap->instance_buffer);
+
+    vkDestroyBuffer(context->device, tilemap->instance_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, tilemap->instance_memory, &context->allocation_callbacks);
+    allocator_free(&engine->allocator, tilemap->tiles, ALLOCATOR_SUBSYSTEM_TILEMAP);
+    allocator_free(&engine->allocator, tilemap->chunks, ALLOCATOR_SUBSYSTEM_TILEMAP);
+    allocator_free(&engine->allocator, tilemap->instances, ALLOCATOR_SUBSYSTEM_TILEMAP);
+    allocator_free(&engine->allocator, tilemap->draws, ALLOCATOR_SUBSYSTEM_TILEMAP);
+    memset(tilemap, 0, sizeof(struct tilemap));
+}
+
+uint16_t tilemap_get_tile(const struct tilemap *tilemap, uint32_t x, uint32_t y)
+{
+    if (x >= tilemap->width || y >= tilemap->height)
+        return TILEMAP_EMPTY_TILE;
+    return tilemap->tiles[(size_t) y * tilemap->width + x];
+}
+
+void tilemap_set_tile(tilemap_t tilemap, uint32_t x, uint32_t y, uint16_t tile)
+{
+    uint16_t *destination;
+
+    if (x >= tilemap->width || y >= tilemap->height)
+        return;
+    destination = &tilemap->tiles[(size_t) y * tilemap->width + x];
+    if (*destination == tile)
+        return;
+    *destination = tile;
+    tilemap->chunks[(y / TILEMAP_CHUNK_SIZE) * tilemap->chunks_width + x / TILEMAP_CHUNK_SIZE].dirty = true;
+}
+
+void tilemap_set_tiles(tilemap_t tilemap, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint16_t *tiles)
+{
+    uint32_t right;
+    uint32_t top;
+
+    if (x >= tilemap->width || y >= tilemap->height)
+        return;
+    right = width < tilemap->width - x ? x + width : tilemap->width;
+    top = height < tilemap->height - y ? y + height : tilemap->height;
+    if (right == x || top == y)
+        return;
+
+    for (uint32_t row = y; row < top; ++row)
+        memcpy(&tilemap->tiles[(size_t) row * tilemap->width + x], &tiles[(size_t) (row - y) * width], sizeof(uint16_t) * (right - x));
+    for (uint32_t chunk_y = y / TILEMAP_CHUNK_SIZE; chunk_y <= (top - 1) / TILEMAP_CHUNK_SIZE; ++chunk_y) {
+        for (uint32_t chunk_x = x / TILEMAP_CHUNK_SIZE; chunk_x <= (right - 1) / TILEMAP_CHUNK_SIZE; ++chunk_x)
+            tilemap->chunks[chunk_y * tilemap->chunks_width + chunk_x].dirty = true;
+    }
+}
+
+void tilemap_set_color(tilemap_t tilemap, vec4 color)
+{
+    glm_vec4_copy(color, tilemap->push_constant.color);
+}
+
+// Pack the non empty tiles of a chunk at the start of its range of the instances
+static void tilemap_build_chunk(tilemap_t tilemap, uint32_t chunk_x, uint32_t chunk_y)
+{
+    uint32_t chunk_index = chunk_y * tilemap->chunks_width + chunk_x;
+    struct tile_instance *instances = &tilemap->instances[(size_t) chunk_index * TILEMAP_CHUNK_TILES_COUNT];
+    uint32_t left = chunk_x * TILEMAP_CHUNK_SIZE;
+    uint32_t bottom = chunk_y * TILEMAP_CHUNK_SIZE;
+    uint32_t right = left + TILEMAP_CHUNK_SIZE < tilemap->width ? left + TILEMAP_CHUNK_SIZE : tilemap->width;
+    uint32_t top = bottom + TILEMAP_CHUNK_SIZE < tilemap->height ? bottom + TILEMAP_CHUNK_SIZE : tilemap->height;
+    uint32_t count = 0;
+
+    for (uint32_t y = bottom; y < top; ++y) {
+        const uint16_t *row = &tilemap->tiles[(size_t) y * tilemap->width];
+
+        for (uint32_t x = left; x < right; ++x) {
+            if (row[x] == TILEMAP_EMPTY_TILE)
+                continue;
+            instances[count++] = (struct tile_instance) {
+                .x = (uint16_t) x,
+                .y = (uint16_t) y,
+                .tile = row[x]
+            };
+        }
+    }
+    tilemap->chunks[chunk_index].instances_count = count;
+}
+
+/*
+    The frustum planes are extracted from the projection of the tile coordinates, so a chunk is tested with its box in tiles.
+    Visible dirty chunks are rebuilt and queued only when the queue has room for them, so that the drawn count always matches queued instances.
+    Consecutive chunks are merged in one draw while the first ones are full, their instances being contiguous
+*/
+bool tilemap_draw(engine_t engine, tilemap_t tilemap)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    bool is_queued = false;
+    mat4 view_projection;
+    mat4 tiles_to_clip;
+    vec4 planes[6];
+
+    for (uint32_t i = 0; i < engine->tilemaps_to_draw_count && !is_queued; ++i)
+        is_queued = engine->tilemaps_to_draw[i] == tilemap;
+    if (!is_queued) {
+        if (engine->tilemaps_to_draw_count >= ENGINE_MAX_TILEMAPS_TO_DRAW) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Cannot draw more tilemaps\n", 27);
+            #endif
+            return false;
+        }
+        engine->tilemaps_to_draw[engine->tilemaps_to_draw_count++] = tilemap;
+    }
+
+    glm_mat4_mul(context->proj, context->view, view_projection);
+    glm_mat4_mul(view_projection, tilemap->push_constant.model, tiles_to_clip);
+    glm_frustum_planes(tiles_to_clip, planes);
+
+    tilemap->draws_count = 0;
+    for (uint32_t chunk_y = 0; chunk_y < tilemap->chunks_height; ++chunk_y) {
+        for (uint32_t chunk_x = 0; chunk_x < tilemap->chunks_width; ++chunk_x) {
+            uint32_t chunk_index = chunk_y * tilemap->chunks_width + chunk_x;
+            struct tilemap_chunk *chunk = &tilemap->chunks[chunk_index];
+            uint32_t first_instance = chunk_index * TILEMAP_CHUNK_TILES_COUNT;
+            vec3 box[2] = {
+                {(float) (chunk_x * TILEMAP_CHUNK_SIZE), (float) (chunk_y * TILEMAP_CHUNK_SIZE), 0.0f},
+                {fminf((float) ((chunk_x + 1) * TILEMAP_CHUNK_SIZE), (float) tilemap->width), fminf((float) ((chunk_y + 1) * TILEMAP_CHUNK_SIZE), (float) tilemap->height), 0.0f}
+            };
+
+            if (!glm_aabb_frustum(box, planes))
+                continue;
+            if (chunk->dirty && context->buffer_updates_count < FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT) {
+                tilemap_build_chunk(tilemap, chunk_x, chunk_y);
+                vulkan_queue_buffer_update(context, tilemap->instance_buffer, (VkDeviceSize) first_instance * sizeof(struct tile_instance),
+                    &tilemap->instances[first_instance], (VkDeviceSize) chunk->instances_count * sizeof(struct tile_instance));
+                chunk->dirty = false;
+            }
+            if (chunk->instances_count == 0)
+                continue;
+
+            struct tilemap_draw *previous = tilemap->draws_count > 0 ? &tilemap->draws[tilemap->draws_count - 1] : NULL;
+            if (previous && previous->first_instance + previous->instances_count == first_instance) {
+                previous->instances_count += chunk->instances_count;
+            } else {
+                tilemap->draws[tilemap->draws_count++] = (struct tilemap_draw) {
+                    .first_instance = first_instance,
+                    .instances_count = chunk->instances_count
+                };
+            }
+        }
+    }
+    return true;
+}
+
+void tilemap_get_binding_description(uint32_t *tilemap_binding_descriptions_count, VkVertexInputBindingDescription *tilemap_binding_descriptions)
+{
+    if (!tilemap_binding_descriptions) {
+        *tilemap_binding_descriptions_count = 1;
+        return;
+    }
+
+    tilemap_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct tile_instance),
+        .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+    };
+}
+
+void tilemap_get_attribute_description(uint32_t *tilemap_attribute_descriptions_count, VkVertexInputAttributeDescription *tilemap_attribute_descriptions)
+{
+    if (!tilemap_attribute_descriptions) {
+        *tilemap_attribute_descriptions_count = TILEMAP_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    tilemap_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R16G16_UINT,
+        .offset = offsetof(struct tile_instance, x)
+    };
+    tilemap_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R32_UINT,
+        .offset = offsetof(struct tile_instance, tile)
+    };
+}
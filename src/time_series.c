@@ -0,0 +1,332 @@
+#include "time_series.h"
+#include "engine.h"
+
+bool time_series_init(time_series_t time_series, engine_t engine, uint32_t series_count, uint32_t capacity, vec2 position, vec2 sample_size)
+{
+    uint32_t rounded_capacity = 1;
+    uint32_t levels_count = 1;
+    uint64_t entries_count = 0;
+
+    memset(time_series, 0, sizeof(struct time_series));
+    if (series_count == 0 || capacity > (UINT32_C(1) << 31)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Invalid time series size\n", 26);
+        #endif
+        return false;
+    }
+    while (rounded_capacity < capacity) {
+        rounded_capacity <<= 1;
+        levels_count++;
+    }
+
+    time_series->series_count = series_count;
+    time_series->capacity = rounded_capacity;
+    time_series->levels_count = levels_count;
+    for (uint32_t i = 0; i < levels_count; ++i) {
+        time_series->levels[i].offset = entries_count;
+        time_series->levels[i].slots_count = rounded_capacity >> i;
+        entries_count += (uint64_t) series_count * time_series->levels[i].slots_count;
+    }
+
+    time_series->pyramid = allocator_allocate(&engine->allocator, entries_count * sizeof(vec2), ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    time_series->colors = allocator_allocate(&engine->allocator, series_count * sizeof(vec4), ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    time_series->draws = allocator_allocate(&engine->allocator, 2 * series_count * sizeof(VkDrawIndirectCommand), ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    if (!time_series->pyramid || !time_series->colors || !time_series->draws
+        || !vulkan_create_instance_buffer(&engine->vulkan_context, entries_count * sizeof(vec2), &time_series->buffer, &time_series->memory)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Failed to allocate a time series\n", 34);
+        #endif
+        allocator_free(&engine->allocator, time_series->pyramid, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+        allocator_free(&engine->allocator, time_series->colors, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+        allocator_free(&engine->allocator, time_series->draws, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+        memset(time_series, 0, sizeof(struct time_series));
+        return false;
+    }
+
+    time_series->engine = engine;
+    glm_vec2_copy(position, time_series->position);
+    glm_vec2_copy(sample_size, time_series->sample_size);
+    for (uint32_t i = 0; i < series_count; ++i)
+        glm_vec4_one(time_series->colors[i]);
+    glm_mat4_identity(time_series->push_constant.model);
+    glm_vec4_one(time_series->push_constant.color);
+    return true;
+}
+
+void time_series_cleanup(time_series_t time_series)
+{
+    engine_t engine = time_series->engine;
+    vulkan_context_t context;
+    uint32_t kept_count = 0;
+
+    if (!engine)
+        return;
+    context = &engine->vulkan_context;
+
+    // Forget the time series in the frame being built, with the updates still reading its pyramid
+    for (uint32_t i = 0; i < engine->time_series_to_draw_count; ++i) {
+        if (engine->time_series_to_draw[i] != time_series)
+            engine->time_series_to_draw[kept_count++] = engine->time_series_to_draw[i];
+    }
+    engine->time_series_to_draw_count = kept_count;
+
+    vulkan_cancel_buffer_updates(context, time_series->buffer);
+    vkDestroyBuffer(context->device, time_series->buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, time_series->memory, &context->allocation_callbacks);
+    allocator_free(&engine->allocator, time_series->pyramid, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    allocator_free(&engine->allocator, time_series->colors, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    allocator_free(&engine->allocator, time_series->draws, ALLOCATOR_SUBSYSTEM_TIME_SERIES);
+    memset(time_series, 0, sizeof(struct time_series));
+}
+
+// Write the entries of a level reduced from a batch, the first one widening the entry already holding the samples before the batch
+static void time_series_write_level(struct time_series_level *level, vec2 *entries, const vec2 *reduced, uint32_t reduced_count, uint64_t first_entry, bool widens_first)
+{
+    uint32_t slot_mask = level->slots_count - 1;
+    // Only the newest entries of the batch stay in the ring
+    uint32_t first = reduced_count > level->slots_count ? reduced_count - level->slots_count : 0;
+
+    for (uint32_t i = first; i < reduced_count; ++i) {
+        vec2 *entry = &entries[(uint32_t) (first_entry + i) & slot_mask];
+
+        if (i == 0 && widens_first) {
+            (*entry)[0] = glm_min((*entry)[0], reduced[0][0]);
+            (*entry)[1] = glm_max((*entry)[1], reduced[0][1]);
+        } else {
+            glm_vec2_copy((float *) reduced[i], *entry);
+        }
+    }
+}
+
+/*
+    Samples are appended by batches, each series of a batch is reduced level after level by merging pairs of entries,
+    so every level is built from the one below and appending costs about two writes per value whatever the count of levels.
+    An entry already holding samples before the batch is widened by the reduction of the batch instead of being replaced
+*/
+void time_series_append(time_series_t time_series, const float *values, uint32_t samples_count)
+{
+    uint32_t series_count = time_series->series_count;
+    vec2 reduced[2][TIME_SERIES_APPEND_BATCH_SIZE];
+
+    while (samples_count > 0) {
+        uint32_t batch_count = samples_count < TIME_SERIES_APPEND_BATCH_SIZE ? samples_count : TIME_SERIES_APPEND_BATCH_SIZE;
+        uint64_t first_sample = time_series->samples_count;
+
+        for (uint32_t s = 0; s < series_count; ++s) {
+            vec2 *current = reduced[0];
+            vec2 *next = reduced[1];
+            uint32_t reduced_count = batch_count;
+
+            for (uint32_t i = 0; i < batch_count; ++i) {
+                current[i][0] = values[(size_t) i * series_count + s];
+                current[i][1] = current[i][0];
+            }
+            for (uint32_t l = 0; l < time_series->levels_count; ++l) {
+                struct time_series_level *level = &time_series->levels[l];
+                uint64_t first_entry = first_sample >> l;
+                uint64_t next_first_entry = first_entry >> 1;
+                uint32_t next_count = (uint32_t) (((first_entry + reduced_count - 1) >> 1) - next_first_entry + 1);
+
+                time_series_write_level(level, &time_series->pyramid[level->offset + (uint64_t) s * level->slots_count],
+                    current, reduced_count, first_entry, (first_sample & ((UINT64_C(1) << l) - 1)) != 0);
+
+                // The first entry of the next level misses its first child when the batch starts on an odd entry, the last one its second child
+                for (uint32_t i = 0; i < next_count; ++i) {
+                    int64_t child = (int64_t) ((next_first_entry + i) << 1) - (int64_t) first_entry;
+
+                    if (child < 0) {
+                        glm_vec2_copy(current[0], next[i]);
+                    } else if ((uint32_t) child + 1 >= reduced_count) {
+                        glm_vec2_copy(current[child], next[i]);
+                    } else {
+                        next[i][0] = glm_min(current[child][0], current[child + 1][0]);
+                        next[i][1] = glm_max(current[child][1], current[child + 1][1]);
+                    }
+                }
+                current = next;
+                next = current == reduced[0] ? reduced[1] : reduced[0];
+                reduced_count = next_count;
+            }
+        }
+        time_series->samples_count += batch_count;
+        values += (size_t) batch_count * series_count;
+        samples_count -= batch_count;
+    }
+}
+
+void time_series_set_color(time_series_t time_series, uint32_t series, vec4 color)
+{
+    if (series < time_series->series_count)
+        glm_vec4_copy(color, time_series->colors[series]);
+}
+
+/*
+    Get the x coordinate, in samples, where the vertical edge of the viewport at `clip_x` crosses the baseline of the series,
+    solving clip.x = clip_x * clip.w along the baseline rather than inverting the projection, which is singular when the near plane is at 0
+*/
+static double time_series_edge(mat4 samples_to_clip, float clip_x)
+{
+    double slope = (double) samples_to_clip[0][0] - (double) clip_x * samples_to_clip[0][3];
+    double intercept = (double) samples_to_clip[3][0] - (double) clip_x * samples_to_clip[3][3];
+
+    if (fabs(slope) < 1e-30)
+        return clip_x * INFINITY;
+    return -intercept / slope;
+}
+
+// Queue the entries of a level appended or widened since its last upload, one update per series and per contiguous part of its ring
+static void time_series_upload_level(vulkan_context_t context, time_series_t time_series, uint32_t l)
+{
+    struct time_series_level *level = &time_series->levels[l];
+    uint64_t end = (time_series->samples_count + (UINT64_C(1) << l) - 1) >> l;
+    uint64_t start = level->uploaded_samples_count >> l;
+    uint64_t budget = TIME_SERIES_MAX_UPLOAD_SIZE / (time_series->series_count * sizeof(vec2));
+    uint64_t upload_end;
+
+    if (start >= end || context->buffer_updates_count + 2 * time_series->series_count > FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT)
+        return;
+    // Entries older than the ring are already overwritten, the level starts over from the oldest one it holds
+    if (end - start > level->slots_count) {
+        start = end - level->slots_count;
+        level->first_uploaded = start;
+    }
+    upload_end = end - start > budget && budget > 0 ? start + budget : end;
+
+    for (uint64_t first = start; first < upload_end;) {
+        uint32_t slot = (uint32_t) first & (level->slots_count - 1);
+        uint32_t count = upload_end - first < level->slots_count - slot ? (uint32_t) (upload_end - first) : level->slots_count - slot;
+
+        for (uint32_t s = 0; s < time_series->series_count; ++s) {
+            uint64_t entry = level->offset + (uint64_t) s * level->slots_count + slot;
+
+            vulkan_queue_buffer_update(context, time_series->buffer, entry * sizeof(vec2), &time_series->pyramid[entry], (VkDeviceSize) count * sizeof(vec2));
+        }
+        first += count;
+    }
+    level->uploaded_samples_count = upload_end == end ? time_series->samples_count : upload_end << l;
+    if (upload_end > level->slots_count && level->first_uploaded < upload_end - level->slots_count)
+        level->first_uploaded = upload_end - level->slots_count;
+}
+
+/*
+    The edges of the viewport are found on the baseline of the series to get the count of samples per pixel column,
+    the drawn level is the first whose entries hold at least that many samples so that each column gets at most one entry, two vertices.
+    Only that level is uploaded, the other ones catch up from their last upload when they are drawn
+*/
+bool time_series_draw(engine_t engine, time_series_t time_series)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    bool is_queued = false;
+    mat4 samples_to_world;
+    mat4 world_to_clip;
+    mat4 samples_to_clip;
+
+    for (uint32_t i = 0; i < engine->time_series_to_draw_count && !is_queued; ++i)
+        is_queued = engine->time_series_to_draw[i] == time_series;
+    if (!is_queued) {
+        if (engine->time_series_to_draw_count >= ENGINE_MAX_TIME_SERIES_TO_DRAW) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Cannot draw more time series\n", 30);
+            #endif
+            return false;
+        }
+        engine->time_series_to_draw[engine->time_series_to_draw_count++] = time_series;
+    }
+
+    time_series->draws_count = 0;
+    if (time_series->samples_count == 0)
+        return true;
+
+    glm_translate_make(samples_to_world, (vec3) {time_series->position[0], time_series->position[1], 0.0f});
+    glm_scale(samples_to_world, (vec3) {time_series->sample_size[0], time_series->sample_size[1], 1.0f});
+    glm_mat4_mul(context->proj, context->view, world_to_clip);
+    glm_mat4_mul(world_to_clip, samples_to_world, samples_to_clip);
+
+    double left = time_series_edge(samples_to_clip, -1.0f);
+    double right = time_series_edge(samples_to_clip, 1.0f);
+    double samples_per_pixel = fabs(right - left) / context->viewport.width;
+    uint32_t l = 0;
+
+    while (l + 1 < time_series->levels_count && (double) (UINT64_C(1) << l) < samples_per_pixel)
+        l++;
+    time_series->level = l;
+    time_series_upload_level(context, time_series, l);
+
+    struct time_series_level *level = &time_series->levels[l];
+    double samples_per_entry = (double) (UINT64_C(1) << l);
+    uint64_t uploaded_end = (level->uploaded_samples_count + (UINT64_C(1) << l) - 1) >> l;
+    // Keep one entry past each edge so the lines leaving the viewport are drawn
+    double first_visible = floor(fmin(left, right) / samples_per_entry) - 1.0;
+    double last_visible = floor(fmax(left, right) / samples_per_entry) + 2.0;
+    uint64_t first = first_visible > (double) level->first_uploaded ? (uint64_t) first_visible : level->first_uploaded;
+    uint64_t last = last_visible < (double) uploaded_end ? (uint64_t) fmax(last_visible, 0.0) : uploaded_end;
+
+    if (first >= last)
+        return true;
+
+    uint64_t newest = uploaded_end - 1;
+    mat4 model;
+
+    glm_translate_to(samples_to_world, (vec3) {(float) ((double) newest * samples_per_entry), 0.0f, 0.0f}, model);
+    glm_mat4_copy(model, time_series->push_constant.model);
+    time_series->push_constant.uv_rect[0] = (float) samples_per_entry;
+    time_series->push_constant.uv_rect[1] = (float) level->slots_count;
+    time_series->push_constant.texture_index = (uint32_t) newest & (level->slots_count - 1);
+
+    // The visible entries wrap at most once around the ring, each part is a draw of two vertices per entry
+    for (uint32_t s = 0; s < time_series->series_count; ++s) {
+        for (uint64_t entry = first; entry < last;) {
+            uint32_t slot = (uint32_t) entry & (level->slots_count - 1);
+            uint32_t count = last - entry < level->slots_count - slot ? (uint32_t) (last - entry) : level->slots_count - slot;
+
+            time_series->draws[time_series->draws_count++] = (VkDrawIndirectCommand) {
+                .vertexCount = 2 * count,
+                .instanceCount = 1,
+                .firstVertex = 2 * (s * level->slots_count + slot),
+                .firstInstance = s
+            };
+            entry += count;
+        }
+    }
+    return true;
+}
+
+void time_series_get_binding_description(uint32_t *time_series_binding_descriptions_count, VkVertexInputBindingDescription *time_series_binding_descriptions)
+{
+    if (!time_series_binding_descriptions) {
+        *time_series_binding_descriptions_count = 2;
+        return;
+    }
+
+    time_series_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(float),
+        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+    };
+    time_series_binding_descriptions[1] = (VkVertexInputBindingDescription) {
+        .binding = 1,
+        .stride = sizeof(vec4),
+        .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+    };
+}
+
+void time_series_get_attribute_description(uint32_t *time_series_attribute_descriptions_count, VkVertexInputAttributeDescription *time_series_attribute_descriptions)
+{
+    if (!time_series_attribute_descriptions) {
+        *time_series_attribute_descriptions_count = TIME_SERIES_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    time_series_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32_SFLOAT,
+        .offset = 0
+    };
+    time_series_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 1,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = 0
+    };
+}
@@ -0,0 +1,685 @@
+#include "triangulation.h"
+#include <stdlib.h>
+#include <math.h>
+
+/*
+    Port of the earcut algorithm (https://github.com/mapbox/earcut, ISC license).
+    Every ring is a circular doubly linked list of nodes, ears are clipped one by one and, above
+    TRIANGULATION_HASH_THRESHOLD vertices, nodes are also linked in z-order so that the point in triangle
+    tests of an ear only visit the nodes inside the bounding box of the ear
+*/
+#define TRIANGULATION_HASH_THRESHOLD 80
+
+struct triangulation_node {
+    uint32_t i;
+    double x;
+    double y;
+
+    struct triangulation_node *prev;
+    struct triangulation_node *next;
+
+    uint32_t z;
+    struct triangulation_node *prev_z;
+    struct triangulation_node *next_z;
+
+    bool steiner;
+};
+
+struct triangulation {
+    struct triangulation_node *nodes;
+    uint32_t nodes_count;
+    uint32_t nodes_capacity;
+
+    uint32_t *indices;
+    uint32_t indices_count;
+
+    double min_x;
+    double min_y;
+    double inv_size;
+};
+
+static struct triangulation_node *triangulation_create_node(struct triangulation *triangulation, uint32_t i, double x, double y)
+{
+    struct triangulation_node *node = &triangulation->nodes[triangulation->nodes_count++];
+
+    *node = (struct triangulation_node) {
+        .i = i,
+        .x = x,
+        .y = y,
+        .prev = NULL,
+        .next = NULL,
+        .z = 0,
+        .prev_z = NULL,
+        .next_z = NULL,
+        .steiner = false
+    };
+    return node;
+}
+
+static struct triangulation_node *triangulation_insert_node(struct triangulation *triangulation, uint32_t i, const vec2 position, struct triangulation_node *last)
+{
+    struct triangulation_node *node = triangulation_create_node(triangulation, i, position[0], position[1]);
+
+    if (!last) {
+        node->prev = node;
+        node->next = node;
+    } else {
+        node->next = last->next;
+        node->prev = last;
+        last->next->prev = node;
+        last->next = node;
+    }
+    return node;
+}
+
+static void triangulation_remove_node(struct triangulation_node *node)
+{
+    node->next->prev = node->prev;
+    node->prev->next = node->next;
+
+    if (node->prev_z)
+        node->prev_z->next_z = node->next_z;
+    if (node->next_z)
+        node->next_z->prev_z = node->prev_z;
+}
+
+static void triangulation_emit(struct triangulation *triangulation, struct triangulation_node *a, struct triangulation_node *b, struct triangulation_node *c)
+{
+    triangulation->indices[triangulation->indices_count++] = a->i;
+    triangulation->indices[triangulation->indices_count++] = b->i;
+    triangulation->indices[triangulation->indices_count++] = c->i;
+}
+
+static double triangulation_area(const struct triangulation_node *p, const struct triangulation_node *q, const struct triangulation_node *r)
+{
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+static bool triangulation_equals(const struct triangulation_node *a, const struct triangulation_node *b)
+{
+    return a->x == b->x && a->y == b->y;
+}
+
+static int triangulation_sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+static bool triangulation_on_segment(const struct triangulation_node *p, const struct triangulation_node *q, const struct triangulation_node *r)
+{
+    return q->x <= fmax(p->x, r->x) && q->x >= fmin(p->x, r->x) && q->y <= fmax(p->y, r->y) && q->y >= fmin(p->y, r->y);
+}
+
+static bool triangulation_intersects(const struct triangulation_node *p1, const struct triangulation_node *q1, const struct triangulation_node *p2, const struct triangulation_node *q2)
+{
+    int o1 = triangulation_sign(triangulation_area(p1, q1, p2));
+    int o2 = triangulation_sign(triangulation_area(p1, q1, q2));
+    int o3 = triangulation_sign(triangulation_area(p2, q2, p1));
+    int o4 = triangulation_sign(triangulation_area(p2, q2, q1));
+
+    if (o1 != o2 && o3 != o4)
+        return true;
+    return (o1 == 0 && triangulation_on_segment(p1, p2, q1))
+        || (o2 == 0 && triangulation_on_segment(p1, q2, q1))
+        || (o3 == 0 && triangulation_on_segment(p2, p1, q2))
+        || (o4 == 0 && triangulation_on_segment(p2, q1, q2));
+}
+
+static bool triangulation_intersects_polygon(const struct triangulation_node *a, const struct triangulation_node *b)
+{
+    const struct triangulation_node *p = a;
+
+    do {
+        if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && triangulation_intersects(p, p->next, a, b))
+            return true;
+        p = p->next;
+    } while (p != a);
+    return false;
+}
+
+static bool triangulation_locally_inside(const struct triangulation_node *a, const struct triangulation_node *b)
+{
+    if (triangulation_area(a->prev, a, a->next) < 0.0)
+        return triangulation_area(a, b, a->next) >= 0.0 && triangulation_area(a, a->prev, b) >= 0.0;
+    return triangulation_area(a, b, a->prev) < 0.0 || triangulation_area(a, a->next, b) < 0.0;
+}
+
+static bool triangulation_middle_inside(const struct triangulation_node *a, const struct triangulation_node *b)
+{
+    const struct triangulation_node *p = a;
+    double px = (a->x + b->x) / 2.0;
+    double py = (a->y + b->y) / 2.0;
+    bool inside = false;
+
+    do {
+        if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y
+            && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+            inside = !inside;
+        p = p->next;
+    } while (p != a);
+    return inside;
+}
+
+static bool triangulation_point_in_triangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+        && (ax - px) * (by - py) >= (bx - px) * (ay - py)
+        && (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+static bool triangulation_is_valid_diagonal(const struct triangulation_node *a, const struct triangulation_node *b)
+{
+    if (a->next->i == b->i || a->prev->i == b->i || triangulation_intersects_polygon(a, b))
+        return false;
+
+    // the diagonal is inside the polygon and doesn't create a zero area triangle, or it joins two coincident vertices of convex corners
+    return (triangulation_locally_inside(a, b) && triangulation_locally_inside(b, a) && triangulation_middle_inside(a, b)
+            && (triangulation_area(a->prev, a, b->prev) != 0.0 || triangulation_area(a, b->prev, b) != 0.0))
+        || (triangulation_equals(a, b) && triangulation_area(a->prev, a, a->next) > 0.0 && triangulation_area(b->prev, b, b->next) > 0.0);
+}
+
+/*
+    Link a to b by splitting the ring in two, both ends are duplicated and the returned node starts the second ring
+*/
+static struct triangulation_node *triangulation_split_polygon(struct triangulation *triangulation, struct triangulation_node *a, struct triangulation_node *b)
+{
+    struct triangulation_node *a2 = triangulation_create_node(triangulation, a->i, a->x, a->y);
+    struct triangulation_node *b2 = triangulation_create_node(triangulation, b->i, b->x, b->y);
+    struct triangulation_node *an = a->next;
+    struct triangulation_node *bp = b->prev;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+}
+
+static struct triangulation_node *triangulation_filter_points(struct triangulation_node *start, struct triangulation_node *end)
+{
+    if (!start)
+        return start;
+    if (!end)
+        end = start;
+
+    struct triangulation_node *p = start;
+    bool again;
+
+    do {
+        again = false;
+
+        if (!p->steiner && (triangulation_equals(p, p->next) || triangulation_area(p->prev, p, p->next) == 0.0)) {
+            triangulation_remove_node(p);
+            p = end = p->prev;
+            if (p == p->next)
+                break;
+            again = true;
+        } else {
+            p = p->next;
+        }
+    } while (again || p != end);
+
+    return end;
+}
+
+static double triangulation_signed_area(const vec2 *positions, uint32_t start, uint32_t end)
+{
+    double sum = 0.0;
+
+    for (uint32_t i = start, j = end - 1; i < end; j = i++)
+        sum += ((double) positions[j][0] - positions[i][0]) * ((double) positions[i][1] + positions[j][1]);
+    return sum;
+}
+
+static struct triangulation_node *triangulation_linked_list(struct triangulation *triangulation, const vec2 *positions, uint32_t start, uint32_t end, bool counter_clockwise)
+{
+    struct triangulation_node *last = NULL;
+
+    if (counter_clockwise == (triangulation_signed_area(positions, start, end) > 0.0)) {
+        for (uint32_t i = start; i < end; ++i)
+            last = triangulation_insert_node(triangulation, i, positions[i], last);
+    } else {
+        for (uint32_t i = end; i-- > start;)
+            last = triangulation_insert_node(triangulation, i, positions[i], last);
+    }
+
+    if (last && triangulation_equals(last, last->next)) {
+        triangulation_remove_node(last);
+        last = last->next;
+    }
+    return last;
+}
+
+static uint32_t triangulation_z_order(const struct triangulation *triangulation, double x, double y)
+{
+    uint32_t ix = (uint32_t) ((x - triangulation->min_x) * triangulation->inv_size);
+    uint32_t iy = (uint32_t) ((y - triangulation->min_y) * triangulation->inv_size);
+
+    ix = (ix | (ix << 8)) & 0x00FF00FF;
+    ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+    ix = (ix | (ix << 2)) & 0x33333333;
+    ix = (ix | (ix << 1)) & 0x55555555;
+
+    iy = (iy | (iy << 8)) & 0x00FF00FF;
+    iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+    iy = (iy | (iy << 2)) & 0x33333333;
+    iy = (iy | (iy << 1)) & 0x55555555;
+
+    return ix | (iy << 1);
+}
+
+/*
+    Bottom-up merge sort of the z-order list, O(n log n) without recursion nor allocation
+*/
+static void triangulation_sort_linked(struct triangulation_node *list)
+{
+    uint32_t in_size = 1;
+    uint32_t merges_count;
+
+    do {
+        struct triangulation_node *p = list;
+        struct triangulation_node *tail = NULL;
+
+        list = NULL;
+        merges_count = 0;
+
+        while (p) {
+            struct triangulation_node *q = p;
+            uint32_t p_size = 0;
+            uint32_t q_size = in_size;
+
+            merges_count++;
+            for (uint32_t i = 0; i < in_size && q; ++i) {
+                p_size++;
+                q = q->next_z;
+            }
+
+            while (p_size > 0 || (q_size > 0 && q)) {
+                struct triangulation_node *e;
+
+                if (p_size != 0 && (q_size == 0 || !q || p->z <= q->z)) {
+                    e = p;
+                    p = p->next_z;
+                    p_size--;
+                } else {
+                    e = q;
+                    q = q->next_z;
+                    q_size--;
+                }
+
+                if (tail)
+                    tail->next_z = e;
+                else
+                    list = e;
+                e->prev_z = tail;
+                tail = e;
+            }
+            p = q;
+        }
+
+        tail->next_z = NULL;
+        in_size *= 2;
+    } while (merges_count > 1);
+}
+
+static void triangulation_index_curve(struct triangulation *triangulation, struct triangulation_node *start)
+{
+    struct triangulation_node *p = start;
+
+    do {
+        if (p->z == 0)
+            p->z = triangulation_z_order(triangulation, p->x, p->y);
+        p->prev_z = p->prev;
+        p->next_z = p->next;
+        p = p->next;
+    } while (p != start);
+
+    p->prev_z->next_z = NULL;
+    p->prev_z = NULL;
+    triangulation_sort_linked(p);
+}
+
+static bool triangulation_is_ear(const struct triangulation_node *ear)
+{
+    const struct triangulation_node *a = ear->prev;
+    const struct triangulation_node *b = ear;
+    const struct triangulation_node *c = ear->next;
+
+    if (triangulation_area(a, b, c) >= 0.0)
+        return false;
+
+    double x0 = fmin(a->x, fmin(b->x, c->x));
+    double y0 = fmin(a->y, fmin(b->y, c->y));
+    double x1 = fmax(a->x, fmax(b->x, c->x));
+    double y1 = fmax(a->y, fmax(b->y, c->y));
+
+    for (const struct triangulation_node *p = c->next; p != a; p = p->next) {
+        if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1
+            && triangulation_point_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y)
+            && triangulation_area(p->prev, p, p->next) >= 0.0)
+            return false;
+    }
+    return true;
+}
+
+static bool triangulation_blocks_ear(const struct triangulation_node *p, const struct triangulation_node *ear, double x0, double y0, double x1, double y1)
+{
+    const struct triangulation_node *a = ear->prev;
+    const struct triangulation_node *c = ear->next;
+
+    return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c
+        && triangulation_point_in_triangle(a->x, a->y, ear->x, ear->y, c->x, c->y, p->x, p->y)
+        && triangulation_area(p->prev, p, p->next) >= 0.0;
+}
+
+static bool triangulation_is_ear_hashed(const struct triangulation *triangulation, const struct triangulation_node *ear)
+{
+    const struct triangulation_node *a = ear->prev;
+    const struct triangulation_node *b = ear;
+    const struct triangulation_node *c = ear->next;
+
+    if (triangulation_area(a, b, c) >= 0.0)
+        return false;
+
+    double x0 = fmin(a->x, fmin(b->x, c->x));
+    double y0 = fmin(a->y, fmin(b->y, c->y));
+    double x1 = fmax(a->x, fmax(b->x, c->x));
+    double y1 = fmax(a->y, fmax(b->y, c->y));
+    uint32_t min_z = triangulation_z_order(triangulation, x0, y0);
+    uint32_t max_z = triangulation_z_order(triangulation, x1, y1);
+    const struct triangulation_node *p = ear->prev_z;
+    const struct triangulation_node *n = ear->next_z;
+
+    // walk the z-order list in both directions from the ear while inside the z range of its bounding box
+    while (p && p->z >= min_z && n && n->z <= max_z) {
+        if (triangulation_blocks_ear(p, ear, x0, y0, x1, y1))
+            return false;
+        p = p->prev_z;
+
+        if (triangulation_blocks_ear(n, ear, x0, y0, x1, y1))
+            return false;
+        n = n->next_z;
+    }
+    for (; p && p->z >= min_z; p = p->prev_z) {
+        if (triangulation_blocks_ear(p, ear, x0, y0, x1, y1))
+            return false;
+    }
+    for (; n && n->z <= max_z; n = n->next_z) {
+        if (triangulation_blocks_ear(n, ear, x0, y0, x1, y1))
+            return false;
+    }
+    return true;
+}
+
+static struct triangulation_node *triangulation_cure_local_intersections(struct triangulation *triangulation, struct triangulation_node *start)
+{
+    struct triangulation_node *p = start;
+
+    do {
+        struct triangulation_node *a = p->prev;
+        struct triangulation_node *b = p->next->next;
+
+        if (!triangulation_equals(a, b) && triangulation_intersects(a, p, p->next, b)
+            && triangulation_locally_inside(a, b) && triangulation_locally_inside(b, a)) {
+            triangulation_emit(triangulation, a, p, b);
+            triangulation_remove_node(p);
+            triangulation_remove_node(p->next);
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return triangulation_filter_points(p, NULL);
+}
+
+static void triangulation_earcut_linked(struct triangulation *triangulation, struct triangulation_node *ear, int pass);
+
+static void triangulation_split_earcut(struct triangulation *triangulation, struct triangulation_node *start)
+{
+    struct triangulation_node *a = start;
+
+    do {
+        for (struct triangulation_node *b = a->next->next; b != a->prev; b = b->next) {
+            if (a->i != b->i && triangulation_is_valid_diagonal(a, b)) {
+                struct triangulation_node *c = triangulation_split_polygon(triangulation, a, b);
+
+                a = triangulation_filter_points(a, a->next);
+                c = triangulation_filter_points(c, c->next);
+                triangulation_earcut_linked(triangulation, a, 0);
+                triangulation_earcut_linked(triangulation, c, 0);
+                return;
+            }
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+/*
+    Clip ears until the ring is a single triangle, when no ear is left the ring is cleaned from duplicated points (pass 1),
+    then small self-intersections are cured (pass 2) and as a last resort the ring is split in two along a valid diagonal
+*/
+static void triangulation_earcut_linked(struct triangulation *triangulation, struct triangulation_node *ear, int pass)
+{
+    if (!ear)
+        return;
+    if (pass == 0 && triangulation->inv_size != 0.0)
+        triangulation_index_curve(triangulation, ear);
+
+    struct triangulation_node *stop = ear;
+
+    while (ear->prev != ear->next) {
+        struct triangulation_node *prev = ear->prev;
+        struct triangulation_node *next = ear->next;
+        bool is_ear = triangulation->inv_size != 0.0 ? triangulation_is_ear_hashed(triangulation, ear) : triangulation_is_ear(ear);
+
+        if (is_ear) {
+            triangulation_emit(triangulation, prev, ear, next);
+            triangulation_remove_node(ear);
+            ear = next->next;
+            stop = next->next;
+            continue;
+        }
+
+        ear = next;
+        if (ear == stop) {
+            if (pass == 0) {
+                triangulation_earcut_linked(triangulation, triangulation_filter_points(ear, NULL), 1);
+            } else if (pass == 1) {
+                ear = triangulation_cure_local_intersections(triangulation, triangulation_filter_points(ear, NULL));
+                triangulation_earcut_linked(triangulation, ear, 2);
+            } else {
+                triangulation_split_earcut(triangulation, ear);
+            }
+            break;
+        }
+    }
+}
+
+static struct triangulation_node *triangulation_get_leftmost(struct triangulation_node *start)
+{
+    struct triangulation_node *p = start;
+    struct triangulation_node *leftmost = start;
+
+    do {
+        if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y))
+            leftmost = p;
+        p = p->next;
+    } while (p != start);
+    return leftmost;
+}
+
+static bool triangulation_sector_contains_sector(const struct triangulation_node *m, const struct triangulation_node *p)
+{
+    return triangulation_area(m->prev, m, p->prev) < 0.0 && triangulation_area(p->next, m, m->next) < 0.0;
+}
+
+/*
+    Find the vertex of the outer ring visible from the leftmost vertex of the hole with a ray cast to the left
+*/
+static struct triangulation_node *triangulation_find_hole_bridge(struct triangulation_node *hole, struct triangulation_node *outer_node)
+{
+    struct triangulation_node *p = outer_node;
+    struct triangulation_node *m = NULL;
+    double hx = hole->x;
+    double hy = hole->y;
+    double qx = -INFINITY;
+
+    do {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+
+            if (x <= hx && x > qx) {
+                qx = x;
+                m = p->x < p->next->x ? p : p->next;
+                if (x == hx)
+                    return m;
+            }
+        }
+        p = p->next;
+    } while (p != outer_node);
+
+    if (!m)
+        return NULL;
+
+    // look for the vertex inside the triangle (hole, intersection, m) closest in angle to the ray, it would block the bridge to m
+    struct triangulation_node *stop = m;
+    double mx = m->x;
+    double my = m->y;
+    double tan_min = INFINITY;
+
+    p = m;
+    do {
+        if (hx >= p->x && p->x >= mx && hx != p->x
+            && triangulation_point_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+            double tan = fabs(hy - p->y) / (hx - p->x);
+
+            if (triangulation_locally_inside(p, hole)
+                && (tan < tan_min || (tan == tan_min && (p->x > m->x || (p->x == m->x && triangulation_sector_contains_sector(m, p)))))) {
+                m = p;
+                tan_min = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+
+    return m;
+}
+
+static struct triangulation_node *triangulation_eliminate_hole(struct triangulation *triangulation, struct triangulation_node *hole, struct triangulation_node *outer_node)
+{
+    struct triangulation_node *bridge = triangulation_find_hole_bridge(hole, outer_node);
+
+    if (!bridge)
+        return outer_node;
+
+    struct triangulation_node *bridge_reverse = triangulation_split_polygon(triangulation, bridge, hole);
+
+    triangulation_filter_points(bridge_reverse, bridge_reverse->next);
+    return triangulation_filter_points(bridge, bridge->next);
+}
+
+static int triangulation_compare_x(const void *a, const void *b)
+{
+    const struct triangulation_node *node_a = *(struct triangulation_node * const *) a;
+    const struct triangulation_node *node_b = *(struct triangulation_node * const *) b;
+
+    if (node_a->x != node_b->x)
+        return node_a->x < node_b->x ? -1 : 1;
+    if (node_a->y != node_b->y)
+        return node_a->y < node_b->y ? -1 : 1;
+    return 0;
+}
+
+/*
+    Holes are bridged to the outer ring from left to right, each bridge turns the hole into a part of the outer ring
+*/
+static struct triangulation_node *triangulation_eliminate_holes(struct triangulation *triangulation, struct triangulation_node **queue, const vec2 *positions, uint32_t vertices_count, const uint32_t *holes_starts, uint32_t holes_count, struct triangulation_node *outer_node)
+{
+    uint32_t queue_count = 0;
+
+    for (uint32_t i = 0; i < holes_count; ++i) {
+        uint32_t start = holes_starts[i];
+        uint32_t end = i < holes_count - 1 ? holes_starts[i + 1] : vertices_count;
+        struct triangulation_node *list = start < end ? triangulation_linked_list(triangulation, positions, start, end, false) : NULL;
+
+        if (!list)
+            continue;
+        if (list == list->next)
+            list->steiner = true;
+        queue[queue_count++] = triangulation_get_leftmost(list);
+    }
+
+    qsort(queue, queue_count, sizeof(struct triangulation_node *), triangulation_compare_x);
+    for (uint32_t i = 0; i < queue_count; ++i)
+        outer_node = triangulation_eliminate_hole(triangulation, queue[i], outer_node);
+    return outer_node;
+}
+
+bool triangulate_polygon(allocator_t allocator, const vec2 *positions, uint32_t vertices_count, const uint32_t *holes_starts, uint32_t holes_count, uint32_t **indices, uint32_t *indices_count)
+{
+    uint32_t outer_count = holes_count > 0 ? holes_starts[0] : vertices_count;
+    struct triangulation triangulation = {
+        .nodes_count = 0,
+        // every split of a ring, by a hole bridge or a diagonal, duplicates two nodes
+        .nodes_capacity = vertices_count * 3 + holes_count * 2,
+        .indices_count = 0,
+        .min_x = 0.0,
+        .min_y = 0.0,
+        .inv_size = 0.0
+    };
+
+    *indices = NULL;
+    *indices_count = 0;
+    if (vertices_count < 3 || outer_count < 3)
+        return true;
+
+    struct triangulation_node **holes_queue = allocator_allocate(allocator, sizeof(struct triangulation_node *) * (holes_count + 1), ALLOCATOR_SUBSYSTEM_MESH);
+    triangulation.nodes = allocator_allocate(allocator, sizeof(struct triangulation_node) * triangulation.nodes_capacity, ALLOCATOR_SUBSYSTEM_MESH);
+    // a polygon of n vertices with h holes has n + 2h - 2 triangles
+    triangulation.indices = allocator_allocate(allocator, sizeof(uint32_t) * (vertices_count + holes_count * 2) * 3, ALLOCATOR_SUBSYSTEM_MESH);
+    if (!holes_queue || !triangulation.nodes || !triangulation.indices) {
+        allocator_free(allocator, holes_queue, ALLOCATOR_SUBSYSTEM_MESH);
+        allocator_free(allocator, triangulation.nodes, ALLOCATOR_SUBSYSTEM_MESH);
+        allocator_free(allocator, triangulation.indices, ALLOCATOR_SUBSYSTEM_MESH);
+        return false;
+    }
+
+    struct triangulation_node *outer_node = triangulation_linked_list(&triangulation, positions, 0, outer_count, true);
+
+    if (outer_node && outer_node->next != outer_node->prev) {
+        if (holes_count > 0)
+            outer_node = triangulation_eliminate_holes(&triangulation, holes_queue, positions, vertices_count, holes_starts, holes_count, outer_node);
+
+        if (vertices_count > TRIANGULATION_HASH_THRESHOLD) {
+            double max_x = triangulation.min_x = positions[0][0];
+            double max_y = triangulation.min_y = positions[0][1];
+
+            for (uint32_t i = 1; i < outer_count; ++i) {
+                triangulation.min_x = fmin(triangulation.min_x, positions[i][0]);
+                triangulation.min_y = fmin(triangulation.min_y, positions[i][1]);
+                max_x = fmax(max_x, positions[i][0]);
+                max_y = fmax(max_y, positions[i][1]);
+            }
+
+            // the bounding box is mapped on 15 bits per axis for the z-order
+            double size = fmax(max_x - triangulation.min_x, max_y - triangulation.min_y);
+            triangulation.inv_size = size != 0.0 ? 32767.0 / size : 0.0;
+        }
+
+        triangulation_earcut_linked(&triangulation, outer_node, 0);
+    }
+
+    allocator_free(allocator, holes_queue, ALLOCATOR_SUBSYSTEM_MESH);
+    allocator_free(allocator, triangulation.nodes, ALLOCATOR_SUBSYSTEM_MESH);
+    *indices = triangulation.indices;
+    *indices_count = triangulation.indices_count;
+    return true;
+}
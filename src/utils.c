@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "geometry.h"
 
 char *int_to_str(int n, char *buffer)
 {
@@ -39,7 +40,7 @@ int max_int(int val, int max)
     return val > max ? val : max;
 }
 
-char *read_file(const char *file_name, uint32_t *buffer_size)
+char *read_file(allocator_t allocator, const char *file_name, uint32_t *buffer_size, enum allocator_subsystem subsystem)
 {
     FILE *file = fopen(file_name, "rb");
     *buffer_size = 0;
@@ -49,7 +50,7 @@ char *read_file(const char *file_name, uint32_t *buffer_size)
         fseek(file, 0, SEEK_END);
         *buffer_size = ftell(file);
         fseek(file, 0, SEEK_SET);
-        buffer = malloc(sizeof(char) * (*buffer_size));
+        buffer = allocator_allocate(allocator, sizeof(char) * (*buffer_size), subsystem);
         if (buffer)
             fread(buffer, 1, *buffer_size, file);
         fclose(file);
@@ -64,8 +65,17 @@ char *read_file(const char *file_name, uint32_t *buffer_size)
 
 void find_circle_point(vec2 center, float radius, float degreesAngle, vec2 dest)
 {
-    double sinAngle = sin(DEGREES_TO_RADIANS(degreesAngle));
-    double cosAngle = cos(DEGREES_TO_RADIANS(degreesAngle));
+    geometry_generate_arc(center, (vec2) {radius, radius}, DEGREES_TO_RADIANS(degreesAngle), 0.0f, 1, (vec2 *) dest);
+}
+
+uint64_t hash_fnv1a(const void *data, size_t size, uint64_t hash)
+{
+    const unsigned char *bytes = data;
+
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
 
-    glm_vec2_copy((vec2) {center[0] + (radius * cosAngle), center[1] + (radius * sinAngle)}, dest);
+    return hash;
 }
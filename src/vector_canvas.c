@@ -0,0 +1,430 @@
+#include "vector_canvas.h"
+#include "engine.h"
+
+// The target and the lists of its screen tiles are sized like the swapchain
+static bool vector_canvas_create_target(vector_canvas_t canvas)
+{
+    vulkan_context_t context = &canvas->engine->vulkan_context;
+    VkExtent2D extent = context->swapchain_extent;
+    VkDeviceSize screen_tiles_count = (VkDeviceSize) ((extent.width + VECTOR_CANVAS_TILE_SIZE - 1) / VECTOR_CANVAS_TILE_SIZE)
+        * ((extent.height + VECTOR_CANVAS_TILE_SIZE - 1) / VECTOR_CANVAS_TILE_SIZE);
+
+    return vulkan_create_storage_texture(context, extent.width, extent.height, VK_FORMAT_R8G8B8A8_UNORM, &canvas->target)
+        && vulkan_create_storage_buffer(context, (screen_tiles_count > 0 ? screen_tiles_count : 1) * sizeof(uint32_t), &canvas->coarse_buffer, &canvas->coarse_memory);
+}
+
+static void vector_canvas_destroy_target(vector_canvas_t canvas)
+{
+    vulkan_context_t context = &canvas->engine->vulkan_context;
+
+    vulkan_destroy_texture(context, &canvas->target);
+    vkDestroyBuffer(context->device, canvas->coarse_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, canvas->coarse_memory, &context->allocation_callbacks);
+    canvas->coarse_buffer = VK_NULL_HANDLE;
+    canvas->coarse_memory = VK_NULL_HANDLE;
+}
+
+bool vector_canvas_init(vector_canvas_t canvas, engine_t engine, uint32_t paths_capacity, uint32_t segments_capacity, float tolerance)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    VkDeviceSize alignment = context->frame_allocator.uniform_alignment > 0 ? context->frame_allocator.uniform_alignment : 1;
+
+    memset(canvas, 0, sizeof(struct vector_canvas));
+    if (paths_capacity == 0 || segments_capacity == 0 || segments_capacity > UINT32_MAX / 4 || !(tolerance > 0.0f)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Invalid vector canvas size\n", 28);
+        #endif
+        return false;
+    }
+
+    canvas->engine = engine;
+    canvas->tolerance = tolerance;
+    canvas->paths_capacity = paths_capacity;
+    canvas->segments_capacity = segments_capacity;
+    // Each segment crosses a few tiles on average, the long ones crossing many
+    canvas->nodes_capacity = segments_capacity * 4 > VECTOR_CANVAS_MIN_NODES_COUNT ? segments_capacity * 4 : VECTOR_CANVAS_MIN_NODES_COUNT;
+    canvas->tiles_offset = (paths_capacity * sizeof(struct vector_path_tiles) + alignment - 1) / alignment * alignment;
+    canvas->nodes_offset = canvas->tiles_offset + (VECTOR_CANVAS_MAX_TILES_COUNT * sizeof(struct vector_tile) + alignment - 1) / alignment * alignment;
+    glm_mat4_identity(canvas->model);
+
+    canvas->paths = allocator_allocate(&engine->allocator, paths_capacity * sizeof(struct vector_path), ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    canvas->path_tiles = allocator_allocate(&engine->allocator, paths_capacity * sizeof(struct vector_path_tiles), ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    canvas->segments = allocator_allocate(&engine->allocator, segments_capacity * sizeof(struct vector_segment), ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    if (!canvas->paths || !canvas->path_tiles || !canvas->segments
+        || !vulkan_create_storage_buffer(context, segments_capacity * sizeof(struct vector_segment), &canvas->segments_buffer, &canvas->segments_memory)
+        || !vulkan_create_storage_buffer(context, canvas->nodes_offset + canvas->nodes_capacity * sizeof(struct vector_node), &canvas->scratch_buffer, &canvas->scratch_memory)
+        || !vector_canvas_create_target(canvas)
+        || !vulkan_allocate_vector_descriptor_set(context, &canvas->descriptor_set)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Failed to allocate a vector canvas\n", 36);
+        #endif
+        vector_canvas_cleanup(canvas);
+        return false;
+    }
+    vulkan_write_vector_descriptor_set(context, canvas);
+    return true;
+}
+
+void vector_canvas_cleanup(vector_canvas_t canvas)
+{
+    engine_t engine = canvas->engine;
+    vulkan_context_t context;
+    uint32_t kept_count = 0;
+
+    if (!engine)
+        return;
+    context = &engine->vulkan_context;
+
+    // Forget the canvas in the frame being built, with the updates still reading its segments
+    for (uint32_t i = 0; i < engine->vector_canvases_to_draw_count; ++i) {
+        if (engine->vector_canvases_to_draw[i] != canvas)
+            engine->vector_canvases_to_draw[kept_count++] = engine->vector_canvases_to_draw[i];
+    }
+    engine->vector_canvases_to_draw_count = kept_count;
+
+    vulkan_cancel_buffer_updates(context, canvas->segments_buffer);
+    vulkan_free_vector_descriptor_set(context, canvas->descriptor_set);
+    vector_canvas_destroy_target(canvas);
+    vkDestroyBuffer(context->device, canvas->segments_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, canvas->segments_memory, &context->allocation_callbacks);
+    vkDestroyBuffer(context->device, canvas->scratch_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, canvas->scratch_memory, &context->allocation_callbacks);
+    allocator_free(&engine->allocator, canvas->paths, ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    allocator_free(&engine->allocator, canvas->path_tiles, ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    allocator_free(&engine->allocator, canvas->segments, ALLOCATOR_SUBSYSTEM_VECTOR_CANVAS);
+    memset(canvas, 0, sizeof(struct vector_canvas));
+}
+
+void vector_canvas_clear(vector_canvas_t canvas)
+{
+    vulkan_cancel_buffer_updates(&canvas->engine->vulkan_context, canvas->segments_buffer);
+    canvas->paths_count = 0;
+    canvas->segments_count = 0;
+    canvas->path_first_segment = 0;
+    canvas->has_subpath = false;
+    canvas->is_path_dropped = false;
+    canvas->uploaded_segments_count = 0;
+    canvas->tiles_count = 0;
+}
+
+// Append a segment from the pen to the contour being built, dropping the whole path when the canvas is full
+static bool vector_canvas_add_segment(vector_canvas_t canvas, vec2 point)
+{
+    struct vector_segment *segment;
+
+    if (canvas->is_path_dropped)
+        return false;
+    if (glm_vec2_eqv(canvas->pen, point))
+        return true;
+    if (canvas->segments_count >= canvas->segments_capacity) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many vector segments\n", 26);
+        #endif
+        canvas->segments_count = canvas->path_first_segment;
+        canvas->has_subpath = false;
+        canvas->is_path_dropped = true;
+        return false;
+    }
+
+    segment = &canvas->segments[canvas->segments_count++];
+    glm_vec2_copy(canvas->pen, segment->from);
+    glm_vec2_copy(point, segment->to);
+    segment->path = canvas->paths_count;
+    segment->padding = 0;
+    glm_vec2_copy(point, canvas->pen);
+    return true;
+}
+
+bool vector_canvas_move_to(vector_canvas_t canvas, vec2 point)
+{
+    if (canvas->is_path_dropped || !vector_canvas_close(canvas))
+        return false;
+    glm_vec2_copy(point, canvas->subpath_start);
+    glm_vec2_copy(point, canvas->pen);
+    canvas->has_subpath = true;
+    return true;
+}
+
+bool vector_canvas_line_to(vector_canvas_t canvas, vec2 point)
+{
+    if (!canvas->has_subpath)
+        return vector_canvas_move_to(canvas, point);
+    return vector_canvas_add_segment(canvas, point);
+}
+
+/*
+    Wang's formula bounds the count of segments keeping a Bézier curve of degree n within the tolerance
+    from its largest second difference M of control points: sqrt(n * (n - 1) * M / (8 * tolerance))
+*/
+static uint32_t vector_canvas_curve_segments_count(float factor, float second_difference, float tolerance)
+{
+    float count = ceilf(sqrtf(factor * second_difference / tolerance));
+
+    if (!(count >= 1.0f))
+        return 1;
+    return count < VECTOR_CANVAS_MAX_CURVE_SEGMENTS ? (uint32_t) count : VECTOR_CANVAS_MAX_CURVE_SEGMENTS;
+}
+
+bool vector_canvas_quadratic_to(vector_canvas_t canvas, vec2 control, vec2 point)
+{
+    vec2 start;
+    uint32_t count;
+
+    if (!canvas->has_subpath)
+        return vector_canvas_move_to(canvas, point);
+    glm_vec2_copy(canvas->pen, start);
+    count = vector_canvas_curve_segments_count(0.25f, glm_vec2_norm((vec2) {
+        start[0] - 2.0f * control[0] + point[0],
+        start[1] - 2.0f * control[1] + point[1]
+    }), canvas->tolerance);
+
+    for (uint32_t i = 1; i < count; ++i) {
+        float t = (float) i / (float) count;
+        float u = 1.0f - t;
+        vec2 position = {
+            u * u * start[0] + 2.0f * u * t * control[0] + t * t * point[0],
+            u * u * start[1] + 2.0f * u * t * control[1] + t * t * point[1]
+        };
+
+        if (!vector_canvas_add_segment(canvas, position))
+            return false;
+    }
+    return vector_canvas_add_segment(canvas, point);
+}
+
+bool vector_canvas_cubic_to(vector_canvas_t canvas, vec2 control0, vec2 control1, vec2 point)
+{
+    vec2 start;
+    uint32_t count;
+
+    if (!canvas->has_subpath)
+        return vector_canvas_move_to(canvas, point);
+    glm_vec2_copy(canvas->pen, start);
+    count = vector_canvas_curve_segments_count(0.75f, glm_max(glm_vec2_norm((vec2) {
+        start[0] - 2.0f * control0[0] + control1[0],
+        start[1] - 2.0f * control0[1] + control1[1]
+    }), glm_vec2_norm((vec2) {
+        control0[0] - 2.0f * control1[0] + point[0],
+        control0[1] - 2.0f * control1[1] + point[1]
+    })), canvas->tolerance);
+
+    for (uint32_t i = 1; i < count; ++i) {
+        float t = (float) i / (float) count;
+        float u = 1.0f - t;
+        vec2 position = {
+            u * u * u * start[0] + 3.0f * u * u * t * control0[0] + 3.0f * u * t * t * control1[0] + t * t * t * point[0],
+            u * u * u * start[1] + 3.0f * u * u * t * control0[1] + 3.0f * u * t * t * control1[1] + t * t * t * point[1]
+        };
+
+        if (!vector_canvas_add_segment(canvas, position))
+            return false;
+    }
+    return vector_canvas_add_segment(canvas, point);
+}
+
+bool vector_canvas_close(vector_canvas_t canvas)
+{
+    if (canvas->is_path_dropped)
+        return false;
+    if (!canvas->has_subpath)
+        return true;
+    if (!vector_canvas_add_segment(canvas, canvas->subpath_start))
+        return false;
+    canvas->has_subpath = false;
+    return true;
+}
+
+bool vector_canvas_fill(vector_canvas_t canvas, vec4 color, enum vector_fill_rule fill_rule)
+{
+    bool is_filled = vector_canvas_close(canvas);
+
+    if (is_filled && canvas->segments_count > canvas->path_first_segment) {
+        if (canvas->paths_count >= canvas->paths_capacity) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Too many vector paths\n", 23);
+            #endif
+            canvas->segments_count = canvas->path_first_segment;
+            is_filled = false;
+        } else {
+            struct vector_path *path = &canvas->paths[canvas->paths_count++];
+
+            path->first_segment = canvas->path_first_segment;
+            path->segments_count = canvas->segments_count - canvas->path_first_segment;
+            glm_vec2_copy(canvas->segments[path->first_segment].from, path->min);
+            glm_vec2_copy(canvas->segments[path->first_segment].from, path->max);
+            // The contours are closed, every point starts a segment
+            for (uint32_t i = path->first_segment + 1; i < canvas->segments_count; ++i) {
+                glm_vec2_minv(path->min, canvas->segments[i].from, path->min);
+                glm_vec2_maxv(path->max, canvas->segments[i].from, path->max);
+            }
+            glm_vec4_copy(color, path->color);
+            path->fill_rule = fill_rule;
+        }
+    }
+
+    canvas->path_first_segment = canvas->segments_count;
+    canvas->has_subpath = false;
+    canvas->is_path_dropped = false;
+    return is_filled;
+}
+
+// Recreate the target when the swapchain has been resized, the frames in flight still sampling the old one
+static bool vector_canvas_fit_target(vector_canvas_t canvas)
+{
+    vulkan_context_t context = &canvas->engine->vulkan_context;
+    VkExtent2D extent = context->swapchain_extent;
+
+    if (canvas->target.width == extent.width && canvas->target.height == extent.height)
+        return true;
+
+    vkDeviceWaitIdle(context->device);
+    vector_canvas_destroy_target(canvas);
+    if (!vector_canvas_create_target(canvas)) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Failed to resize a vector canvas\n", 34);
+        #endif
+        return false;
+    }
+    vulkan_write_vector_descriptor_set(context, canvas);
+    return true;
+}
+
+// Queue the segments of the filled paths not uploaded yet, the ones of the path being built may still be dropped
+static void vector_canvas_upload(vector_canvas_t canvas)
+{
+    vulkan_context_t context = &canvas->engine->vulkan_context;
+    uint32_t filled_count = canvas->path_first_segment;
+    uint32_t count = filled_count - canvas->uploaded_segments_count;
+
+    if (count == 0)
+        return;
+    if (count > VECTOR_CANVAS_MAX_UPLOAD_SIZE / sizeof(struct vector_segment))
+        count = VECTOR_CANVAS_MAX_UPLOAD_SIZE / sizeof(struct vector_segment);
+    if (vulkan_queue_buffer_update(context, canvas->segments_buffer, canvas->uploaded_segments_count * sizeof(struct vector_segment),
+        &canvas->segments[canvas->uploaded_segments_count], count * sizeof(struct vector_segment)))
+        canvas->uploaded_segments_count += count;
+}
+
+// Bound the pixels covered by a path with a rectangle of tiles, false when the path is outside the screen.
+// The canvas lying in its z = 0 plane, each corner in clip space is the sum of a column scaled by x and of one scaled by y
+static bool vector_canvas_bound_path(mat4 canvas_to_clip, const struct vector_path *path, uint32_t width, uint32_t height, int32_t bounds[4])
+{
+    vec4 columns[2][2];
+    vec2 min = {FLT_MAX, FLT_MAX};
+    vec2 max = {-FLT_MAX, -FLT_MAX};
+
+    glm_vec4_scale(canvas_to_clip[0], path->min[0], columns[0][0]);
+    glm_vec4_scale(canvas_to_clip[0], path->max[0], columns[0][1]);
+    glm_vec4_scale(canvas_to_clip[1], path->min[1], columns[1][0]);
+    glm_vec4_scale(canvas_to_clip[1], path->max[1], columns[1][1]);
+    glm_vec4_add(columns[1][0], canvas_to_clip[3], columns[1][0]);
+    glm_vec4_add(columns[1][1], canvas_to_clip[3], columns[1][1]);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        vec4 clip;
+
+        glm_vec4_add(columns[0][i & 1], columns[1][i >> 1], clip);
+        // A corner behind the camera may project anywhere
+        if (clip[3] <= 0.0f) {
+            glm_vec2_zero(min);
+            glm_vec2_copy((vec2) {(float) width, (float) height}, max);
+            break;
+        }
+        float scale = 0.5f / clip[3];
+        vec2 pixel = {
+            (clip[0] * scale + 0.5f) * (float) width,
+            (clip[1] * scale + 0.5f) * (float) height
+        };
+        glm_vec2_minv(min, pixel, min);
+        glm_vec2_maxv(max, pixel, max);
+    }
+
+    if (max[0] < 0.0f || max[1] < 0.0f || min[0] >= (float) width || min[1] >= (float) height)
+        return false;
+    bounds[0] = (int32_t) (glm_max(min[0], 0.0f) / VECTOR_CANVAS_TILE_SIZE);
+    bounds[1] = (int32_t) (glm_max(min[1], 0.0f) / VECTOR_CANVAS_TILE_SIZE);
+    bounds[2] = (int32_t) (glm_min(max[0], (float) (width - 1)) / VECTOR_CANVAS_TILE_SIZE);
+    bounds[3] = (int32_t) (glm_min(max[1], (float) (height - 1)) / VECTOR_CANVAS_TILE_SIZE);
+    return true;
+}
+
+/*
+    The CPU only bounds every path in a rectangle of tiles each frame, the tiles of the visible paths following each other
+    in the scratch buffer. The paths are drawn in order up to the first one whose segments aren't uploaded yet,
+    or whose tiles don't fit in `VECTOR_CANVAS_MAX_TILES_COUNT`
+*/
+bool vector_canvas_draw(engine_t engine, vector_canvas_t canvas)
+{
+    vulkan_context_t context = &engine->vulkan_context;
+    bool is_queued = false;
+    uint32_t width;
+    uint32_t height;
+    uint32_t paths_count = 0;
+    uint32_t tiles_count = 0;
+    uint32_t rows_count = 0;
+    mat4 world_to_clip;
+
+    for (uint32_t i = 0; i < engine->vector_canvases_to_draw_count && !is_queued; ++i)
+        is_queued = engine->vector_canvases_to_draw[i] == canvas;
+    if (!is_queued && engine->vector_canvases_to_draw_count >= ENGINE_MAX_VECTOR_CANVASES_TO_DRAW) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Cannot draw more vector canvases\n", 34);
+        #endif
+        return false;
+    }
+
+    canvas->tiles_count = 0;
+    if (!vector_canvas_fit_target(canvas))
+        return false;
+    if (!is_queued)
+        engine->vector_canvases_to_draw[engine->vector_canvases_to_draw_count++] = canvas;
+    vector_canvas_upload(canvas);
+
+    width = canvas->target.width;
+    height = canvas->target.height;
+    glm_mat4_mul(context->proj, context->view, world_to_clip);
+    glm_mat4_mul(world_to_clip, canvas->model, canvas->push_constant.transform);
+
+    for (; paths_count < canvas->paths_count; ++paths_count) {
+        struct vector_path *path = &canvas->paths[paths_count];
+        struct vector_path_tiles *path_tiles = &canvas->path_tiles[paths_count];
+        int32_t bounds[4];
+        uint32_t covered_count;
+
+        if (path->first_segment + path->segments_count > canvas->uploaded_segments_count)
+            break;
+        *path_tiles = (struct vector_path_tiles) {
+            .first_tile = tiles_count,
+            .first_row = rows_count,
+            .fill_rule = path->fill_rule
+        };
+        glm_vec4_copy(path->color, path_tiles->color);
+        if (!vector_canvas_bound_path(canvas->push_constant.transform, path, width, height, bounds))
+            continue;
+
+        covered_count = (uint32_t) (bounds[2] - bounds[0] + 1) * (uint32_t) (bounds[3] - bounds[1] + 1);
+        if (covered_count > VECTOR_CANVAS_MAX_TILES_COUNT - tiles_count) {
+            #ifdef DEBUG
+            write(STDERR_FILENO, "Too many vector tiles\n", 23);
+            #endif
+            break;
+        }
+        path_tiles->x = bounds[0];
+        path_tiles->y = bounds[1];
+        path_tiles->width = (uint32_t) (bounds[2] - bounds[0] + 1);
+        path_tiles->height = (uint32_t) (bounds[3] - bounds[1] + 1);
+        tiles_count += covered_count;
+        rows_count += path_tiles->height;
+    }
+
+    canvas->push_constant.size[0] = (float) width;
+    canvas->push_constant.size[1] = (float) height;
+    canvas->push_constant.columns_count = (width + VECTOR_CANVAS_TILE_SIZE - 1) / VECTOR_CANVAS_TILE_SIZE;
+    canvas->push_constant.paths_count = paths_count;
+    canvas->push_constant.segments_count = paths_count > 0 ? canvas->paths[paths_count - 1].first_segment + canvas->paths[paths_count - 1].segments_count : 0;
+    canvas->push_constant.rows_count = rows_count;
+    canvas->push_constant.nodes_capacity = canvas->nodes_capacity;
+    canvas->push_constant.padding = 0;
+    canvas->tiles_count = tiles_count;
+    return true;
+}
@@ -27,11 +27,57 @@ void vertex_get_attribute_description(uint32_t *vertex_attribute_descriptions_co
         .format = VK_FORMAT_R32G32_SFLOAT,
         .offset = offsetof(struct vertex, pos)
     };
-
     vertex_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
         .location = 1,
         .binding = 0,
-        .format = VK_FORMAT_R32G32B32_SFLOAT,
-        .offset = offsetof(struct vertex, color)
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct vertex, uv)
+    };
+}
+
+void batched_vertex_get_binding_description(uint32_t *batched_vertex_binding_descriptions_count, VkVertexInputBindingDescription *batched_vertex_binding_descriptions)
+{
+    if (!batched_vertex_binding_descriptions) {
+        *batched_vertex_binding_descriptions_count = 1;
+        return;
+    }
+
+    batched_vertex_binding_descriptions[0] = (VkVertexInputBindingDescription) {
+        .binding = 0,
+        .stride = sizeof(struct batched_vertex),
+        .inputRate = VK_VERTEX_INPUT_RATE_VERTEX
+    };
+}
+
+void batched_vertex_get_attribute_description(uint32_t *batched_vertex_attribute_descriptions_count, VkVertexInputAttributeDescription *batched_vertex_attribute_descriptions)
+{
+    if (!batched_vertex_attribute_descriptions) {
+        *batched_vertex_attribute_descriptions_count = BATCHED_VERTEX_ATTRIBUTE_DESCRIPTIONS_COUNT;
+        return;
+    }
+
+    batched_vertex_attribute_descriptions[0] = (VkVertexInputAttributeDescription) {
+        .location = 0,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct batched_vertex, position)
+    };
+    batched_vertex_attribute_descriptions[1] = (VkVertexInputAttributeDescription) {
+        .location = 1,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .offset = offsetof(struct batched_vertex, color)
+    };
+    batched_vertex_attribute_descriptions[2] = (VkVertexInputAttributeDescription) {
+        .location = 2,
+        .binding = 0,
+        .format = VK_FORMAT_R32G32_SFLOAT,
+        .offset = offsetof(struct batched_vertex, uv)
+    };
+    batched_vertex_attribute_descriptions[3] = (VkVertexInputAttributeDescription) {
+        .location = 3,
+        .binding = 0,
+        .format = VK_FORMAT_R32_UINT,
+        .offset = offsetof(struct batched_vertex, texture_index)
     };
 }
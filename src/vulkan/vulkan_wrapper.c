@@ -37,13 +37,13 @@ static void vulkan_get_instance_extensions_names(const char **extensions_names,
     #endif
 }
 
-static bool vulkan_check_instance_extensions(const char **queried_extensions_names, uint32_t extensions_count)
+static bool vulkan_check_instance_extensions(vulkan_context_t context, const char **queried_extensions_names, uint32_t extensions_count)
 {
     bool result = true;
     uint32_t extensions_properties_count;
 
     vkEnumerateInstanceExtensionProperties(NULL, &extensions_properties_count, NULL);
-    VkExtensionProperties *extensions_properties = malloc(sizeof(VkExtensionProperties) * extensions_properties_count);
+    VkExtensionProperties *extensions_properties = allocator_allocate(context->allocator, sizeof(VkExtensionProperties) * extensions_properties_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkEnumerateInstanceExtensionProperties(NULL, &extensions_properties_count, extensions_properties);
 
     for (uint32_t i = 0; i < extensions_count; ++i) {
@@ -58,16 +58,16 @@ static bool vulkan_check_instance_extensions(const char **queried_extensions_nam
             result = false;
     }
 
-    free(extensions_properties);
+    allocator_free(context->allocator, extensions_properties, ALLOCATOR_SUBSYSTEM_VULKAN);
     return result;
 }
 
-static bool vulkan_check_instance_layers(const char **queried_layers, uint32_t layers_count)
+static bool vulkan_check_instance_layers(vulkan_context_t context, const char **queried_layers, uint32_t layers_count)
 {
     bool result = true;
     uint32_t layers_properties_count;
     vkEnumerateInstanceLayerProperties(&layers_properties_count, NULL);
-    VkLayerProperties *layer_properties = malloc(sizeof(VkLayerProperties) * layers_properties_count);
+    VkLayerProperties *layer_properties = allocator_allocate(context->allocator, sizeof(VkLayerProperties) * layers_properties_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkEnumerateInstanceLayerProperties(&layers_properties_count, layer_properties);
 
     for (uint32_t i = 0; i < layers_count; ++i) {
@@ -82,7 +82,7 @@ static bool vulkan_check_instance_layers(const char **queried_layers, uint32_t l
             result = false;
     }
 
-    free(layer_properties);
+    allocator_free(context->allocator, layer_properties, ALLOCATOR_SUBSYSTEM_VULKAN);
     return result;
 }
 
@@ -115,7 +115,7 @@ static bool vulkan_setup_debug_messenger(vulkan_context_t context)
         .pfnUserCallback = vulkan_debug_callback
     };
 
-    return context->vulkan_extensions_functions.vkCreateDebugUtilsMessengerEXT(context->instance, &debug_messenger_info, NULL, &context->debug_messenger) == VK_SUCCESS;
+    return context->vulkan_extensions_functions.vkCreateDebugUtilsMessengerEXT(context->instance, &debug_messenger_info, &context->allocation_callbacks, &context->debug_messenger) == VK_SUCCESS;
 }
 
 static bool vulkan_create_instance(vulkan_context_t context,
@@ -136,19 +136,19 @@ static bool vulkan_create_instance(vulkan_context_t context,
 
     uint32_t extensions_count;
     vulkan_get_instance_extensions_names(NULL, &extensions_count);
-    const char **extensions_names = malloc(sizeof(char *) * extensions_count);
+    const char **extensions_names = allocator_allocate(context->allocator, sizeof(char *) * extensions_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vulkan_get_instance_extensions_names(extensions_names, &extensions_count);
-    if (!vulkan_check_instance_extensions(extensions_names, extensions_count))
+    if (!vulkan_check_instance_extensions(context, extensions_names, extensions_count))
         return false;
 
     uint32_t layers_count;
     vulkan_get_instance_layers_names(NULL, &layers_count);
-    const char **layers_names = malloc(sizeof(char *) * layers_count);
+    const char **layers_names = allocator_allocate(context->allocator, sizeof(char *) * layers_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vulkan_get_instance_layers_names(layers_names, &layers_count);
     
-    if (!vulkan_check_instance_layers(layers_names, layers_count)) {
-        free(layers_names);
-        free(extensions_names);
+    if (!vulkan_check_instance_layers(context, layers_names, layers_count)) {
+        allocator_free(context->allocator, layers_names, ALLOCATOR_SUBSYSTEM_VULKAN);
+        allocator_free(context->allocator, extensions_names, ALLOCATOR_SUBSYSTEM_VULKAN);
         return false;
     }
 
@@ -162,10 +162,10 @@ static bool vulkan_create_instance(vulkan_context_t context,
         .ppEnabledLayerNames = layers_names
     };
 
-    VkBool32 result = vkCreateInstance(&instance_info, NULL, &context->instance);
+    VkBool32 result = vkCreateInstance(&instance_info, &context->allocation_callbacks, &context->instance);
     
-    free(extensions_names);
-    free(layers_names);
+    allocator_free(context->allocator, extensions_names, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, layers_names, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     return result == VK_SUCCESS;
 }
@@ -175,12 +175,25 @@ static int vulkan_get_physical_device_suitability_score(VkPhysicalDevice physica
     int score = 0;
     VkPhysicalDeviceProperties properties;
     VkPhysicalDeviceFeatures features;
+    VkPhysicalDeviceVulkan12Features features_12 = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = NULL
+    };
+    VkPhysicalDeviceFeatures2 features_2 = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &features_12
+    };
 
     vkGetPhysicalDeviceProperties(physical_device, &properties);
     vkGetPhysicalDeviceFeatures(physical_device, &features);
+    vkGetPhysicalDeviceFeatures2(physical_device, &features_2);
 
     if (!features.geometryShader)
         return 0;
+    // The bindless texture array is written while frames using other elements of it are still pending
+    if (!features_12.runtimeDescriptorArray || !features_12.descriptorBindingPartiallyBound
+        || !features_12.descriptorBindingSampledImageUpdateAfterBind || !features_12.descriptorBindingUpdateUnusedWhilePending)
+        return 0;
     
     if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
         score += 1000;
@@ -198,8 +211,8 @@ static bool vulkan_pick_physical_device(vulkan_context_t context)
     vkEnumeratePhysicalDevices(context->instance, &physical_devices_count, NULL);
     if (physical_devices_count == 0)
         return false;
-    VkPhysicalDevice *physical_devices = malloc(sizeof(VkPhysicalDevice) * physical_devices_count);
-    int *physical_devices_score  = malloc(sizeof(int) * physical_devices_count);
+    VkPhysicalDevice *physical_devices = allocator_allocate(context->allocator, sizeof(VkPhysicalDevice) * physical_devices_count, ALLOCATOR_SUBSYSTEM_VULKAN);
+    int *physical_devices_score  = allocator_allocate(context->allocator, sizeof(int) * physical_devices_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkEnumeratePhysicalDevices(context->instance, &physical_devices_count, physical_devices);
 
     for (uint32_t i = 0; i < physical_devices_count; ++i)
@@ -215,38 +228,41 @@ static bool vulkan_pick_physical_device(vulkan_context_t context)
     if (is_picked_valid)
         context->physical_device = physical_devices[picked_index];
 
-    free(physical_devices);
-    free(physical_devices_score);
+    allocator_free(context->allocator, physical_devices, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, physical_devices_score, ALLOCATOR_SUBSYSTEM_VULKAN);
     return is_picked_valid;
 }
 
-static struct queue_family_indices vulkan_get_queue_families_indices(VkPhysicalDevice physical_device, VkSurfaceKHR surface)
+static struct queue_family_indices vulkan_get_queue_families_indices(vulkan_context_t context, VkPhysicalDevice physical_device, VkSurfaceKHR surface)
 {
     struct queue_family_indices queue_family_indices = {0};
 
     uint32_t queue_family_properties_count;
     vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_properties_count, NULL);
-    VkQueueFamilyProperties *queue_family_properties = malloc(sizeof(VkQueueFamilyProperties) * queue_family_properties_count);
+    VkQueueFamilyProperties *queue_family_properties = allocator_allocate(context->allocator, sizeof(VkQueueFamilyProperties) * queue_family_properties_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_properties_count, queue_family_properties);
 
     queue_family_indices.present = UINT32_MAX;
     queue_family_indices.graphic = UINT32_MAX;
 
+    // The vector canvases are rasterized by compute passes recorded in the same command buffer as the rendering
+    VkQueueFlags graphic_flags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;
+
     for (uint32_t i = 0; i < queue_family_properties_count; ++i) {
         VkBool32 graphic_support_present = VK_FALSE;
         vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, i, surface, &graphic_support_present);
 
-        if (queue_family_properties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT
+        if ((queue_family_properties[i].queueFlags & graphic_flags) == graphic_flags
             && graphic_support_present) {
             queue_family_indices.graphic = i;
             queue_family_indices.present = i;
-            free(queue_family_properties);
+            allocator_free(context->allocator, queue_family_properties, ALLOCATOR_SUBSYSTEM_VULKAN);
             return queue_family_indices;
         }
     }
 
     for (uint32_t i = 0; i < queue_family_properties_count; ++i) {
-        if (queue_family_properties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+        if ((queue_family_properties[i].queueFlags & graphic_flags) == graphic_flags)
             queue_family_indices.graphic = i;
 
         VkBool32 support_present = VK_FALSE;
@@ -259,21 +275,21 @@ static struct queue_family_indices vulkan_get_queue_families_indices(VkPhysicalD
             break;
     }
 
-    free(queue_family_properties);
+    allocator_free(context->allocator, queue_family_properties, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     return queue_family_indices;
 }
 
 static bool vulkan_create_logical_device(vulkan_context_t context)
 {
-    context->queue_family_indices = vulkan_get_queue_families_indices(context->physical_device, context->surface);
+    context->queue_family_indices = vulkan_get_queue_families_indices(context, context->physical_device, context->surface);
     if (context->queue_family_indices.graphic == UINT32_MAX || context->queue_family_indices.present == UINT32_MAX)
         return false;
     float queue_priority = 1.0f;
     bool is_graphic_also_present = context->queue_family_indices.graphic == context->queue_family_indices.present;
     int queue_count = (is_graphic_also_present) ? 1 : 2;
 
-    VkDeviceQueueCreateInfo *device_queue_info = malloc(sizeof(VkDeviceQueueCreateInfo) * queue_count);
+    VkDeviceQueueCreateInfo *device_queue_info = allocator_allocate(context->allocator, sizeof(VkDeviceQueueCreateInfo) * queue_count, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     for (int i = 0; i < queue_count; ++i) {
         device_queue_info[i].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -300,9 +316,33 @@ static bool vulkan_create_logical_device(vulkan_context_t context)
         .pNext = &physical_device_features_extended,
     };
 
+    VkPhysicalDeviceVulkan12Features physical_device_features_12 = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .runtimeDescriptorArray = true,
+        .descriptorBindingPartiallyBound = true,
+        .descriptorBindingSampledImageUpdateAfterBind = true,
+        .descriptorBindingUpdateUnusedWhilePending = true,
+        .pNext = &physical_device_features_13,
+    };
+
+    VkPhysicalDeviceFeatures supported_features;
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceFeatures(context->physical_device, &supported_features);
+    vkGetPhysicalDeviceProperties(context->physical_device, &properties);
+    // Point clouds are drawn as points when the device can draw them at their size, as instanced sprites otherwise
+    context->max_point_size = supported_features.largePoints ? properties.limits.pointSizeRange[1] : 1.0f;
+    // Time series draw all their series with one indirect draw when it can hold several draws starting at their own instance
+    context->multi_draw_indirect = supported_features.multiDrawIndirect && supported_features.drawIndirectFirstInstance;
+
     VkPhysicalDeviceFeatures2 physical_device_features = {
         .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
-        .pNext = &physical_device_features_13
+        .pNext = &physical_device_features_12,
+        .features = {
+            .fullDrawIndexUint32 = supported_features.fullDrawIndexUint32,
+            .largePoints = supported_features.largePoints,
+            .multiDrawIndirect = context->multi_draw_indirect,
+            .drawIndirectFirstInstance = context->multi_draw_indirect
+        }
     };
 
     const char *device_extensions[] = {
@@ -322,9 +362,9 @@ static bool vulkan_create_logical_device(vulkan_context_t context)
         .ppEnabledExtensionNames = device_extensions
     };
 
-    VkResult result = vkCreateDevice(context->physical_device, &device_info, NULL, &context->device);
+    VkResult result = vkCreateDevice(context->physical_device, &device_info, &context->allocation_callbacks, &context->device);
     
-    free(device_queue_info);
+    allocator_free(context->allocator, device_queue_info, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     if (result != VK_SUCCESS)
         return false;
@@ -348,7 +388,7 @@ static bool vulkan_create_surface(vulkan_context_t context, surface_context_t su
         .display = surface_context->display
     };
 
-    result = vkCreateWaylandSurfaceKHR(context->instance, &surface_info, NULL, &context->surface);
+    result = vkCreateWaylandSurfaceKHR(context->instance, &surface_info, &context->allocation_callbacks, &context->surface);
     #elif WIN32_SURFACE
     VkWin32SurfaceCreateInfoKHR surface_info = {
         .sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR,
@@ -357,7 +397,7 @@ static bool vulkan_create_surface(vulkan_context_t context, surface_context_t su
         .hwnd = surface_context->hwnd
     };
 
-    result = vkCreateWin32SurfaceKHR(context->instance, &surface_info, NULL, &context->surface);
+    result = vkCreateWin32SurfaceKHR(context->instance, &surface_info, &context->allocation_callbacks, &context->surface);
     #endif
     return result == VK_SUCCESS;
 }
@@ -399,7 +439,7 @@ static bool vulkan_create_swapchain(vulkan_context_t context, window_t window)
 
     uint32_t surface_formats_count;
     vkGetPhysicalDeviceSurfaceFormatsKHR(context->physical_device, context->surface, &surface_formats_count, NULL);
-    VkSurfaceFormatKHR *surface_formats = malloc(sizeof(VkSurfaceFormatKHR) * surface_formats_count);
+    VkSurfaceFormatKHR *surface_formats = allocator_allocate(context->allocator, sizeof(VkSurfaceFormatKHR) * surface_formats_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkGetPhysicalDeviceSurfaceFormatsKHR(context->physical_device, context->surface, &surface_formats_count, surface_formats);
     context->swapchain_image_format = vulkan_choose_swapchain_surface_format(surface_formats, surface_formats_count).format;
 
@@ -414,7 +454,7 @@ static bool vulkan_create_swapchain(vulkan_context_t context, window_t window)
 
     uint32_t available_present_modes_count;
     vkGetPhysicalDeviceSurfacePresentModesKHR(context->physical_device, context->surface, &available_present_modes_count, NULL);
-    VkPresentModeKHR *available_present_modes = malloc(sizeof(VkPresentModeKHR) * available_present_modes_count);
+    VkPresentModeKHR *available_present_modes = allocator_allocate(context->allocator, sizeof(VkPresentModeKHR) * available_present_modes_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkGetPhysicalDeviceSurfacePresentModesKHR(context->physical_device, context->surface, &available_present_modes_count, available_present_modes);
 
     VkSwapchainCreateInfoKHR swapchain_info = {0};
@@ -445,14 +485,14 @@ static bool vulkan_create_swapchain(vulkan_context_t context, window_t window)
         swapchain_info.pQueueFamilyIndices = NULL;
     }
 
-    VkResult result = vkCreateSwapchainKHR(context->device, &swapchain_info, NULL, &context->swapchain);
+    VkResult result = vkCreateSwapchainKHR(context->device, &swapchain_info, &context->allocation_callbacks, &context->swapchain);
     
     vkGetSwapchainImagesKHR(context->device, context->swapchain, &context->swapchain_images_count, NULL);
-    context->swapchain_images = malloc(sizeof(VkImage) * context->swapchain_images_count);
+    context->swapchain_images = allocator_allocate(context->allocator, sizeof(VkImage) * context->swapchain_images_count, ALLOCATOR_SUBSYSTEM_VULKAN);
     vkGetSwapchainImagesKHR(context->device, context->swapchain, &context->swapchain_images_count, context->swapchain_images);
 
-    free(surface_formats);
-    free(available_present_modes);
+    allocator_free(context->allocator, surface_formats, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, available_present_modes, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     return result == VK_SUCCESS;
 }
@@ -478,18 +518,18 @@ static bool vulkan_create_image_view(vulkan_context_t context)
         .b = VK_COMPONENT_SWIZZLE_IDENTITY
     };
 
-    context->swapchain_image_views = malloc(sizeof(VkImageView) * context->swapchain_images_count);
+    context->swapchain_image_views = allocator_allocate(context->allocator, sizeof(VkImageView) * context->swapchain_images_count, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     for (uint32_t i = 0; i < context->swapchain_images_count; ++i) {
         image_view_info.image = context->swapchain_images[i];
-        if (vkCreateImageView(context->device, &image_view_info, NULL, &(context->swapchain_image_views[i])) != VK_SUCCESS)
+        if (vkCreateImageView(context->device, &image_view_info, &context->allocation_callbacks, &(context->swapchain_image_views[i])) != VK_SUCCESS)
             return false;
     }
 
     return true;
 }
 
-static VkShaderModule vulkan_create_shader_module(VkDevice device, const char *code, uint32_t code_size)
+static VkShaderModule vulkan_create_shader_module(vulkan_context_t context, const char *code, uint32_t code_size)
 {
     VkShaderModuleCreateInfo shader_module_info = {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
@@ -501,28 +541,65 @@ static VkShaderModule vulkan_create_shader_module(VkDevice device, const char *c
 
     VkShaderModule shader_module;
 
-    vkCreateShaderModule(device, &shader_module_info, NULL, &shader_module);
+    vkCreateShaderModule(context->device, &shader_module_info, &context->allocation_callbacks, &shader_module);
 
     return shader_module;
 }
 
-static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
+static bool vulkan_create_pipeline_layout(vulkan_context_t context)
 {
-    uint32_t code_size;
-    const char *shader_file = getenv("ANTAGL_SHADER_PATH");
-    if (!shader_file)
-        shader_file = SHADER_FILE_PATH;
-    char *shader_code = read_file(shader_file, &code_size);
+    VkDescriptorSetLayout set_layouts[] = {context->descriptor_set_layout, context->texture_descriptor_set_layout};
+    VkPushConstantRange push_constant_range = {
+        .offset = 0,
+        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+        .size = sizeof(struct push_constant)
+    };
 
-    VkShaderModule shader_module = vulkan_create_shader_module(context->device, shader_code, code_size);
-    
+    VkPipelineLayoutCreateInfo pipeline_layout_info = {
+        .flags = 0,
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 2,
+        .pSetLayouts = set_layouts,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &push_constant_range
+    };
+
+    // The compute passes keep the sets of the graphic pipelines so their own set doesn't alias the bindings of the shader module
+    VkDescriptorSetLayout vector_set_layouts[] = {context->descriptor_set_layout, context->texture_descriptor_set_layout, context->vector_descriptor_set_layout};
+    VkPushConstantRange vector_push_constant_range = {
+        .offset = 0,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .size = sizeof(struct vector_push_constant)
+    };
+
+    VkPipelineLayoutCreateInfo vector_pipeline_layout_info = {
+        .flags = 0,
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 3,
+        .pSetLayouts = vector_set_layouts,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &vector_push_constant_range
+    };
+
+    return vkCreatePipelineLayout(context->device, &pipeline_layout_info, &context->allocation_callbacks, &context->pipeline_layout) == VK_SUCCESS
+        && vkCreatePipelineLayout(context->device, &vector_pipeline_layout_info, &context->allocation_callbacks, &context->vector_pipeline_layout) == VK_SUCCESS;
+}
+
+/*
+    Every pipeline of the engine renders with dynamic rendering into the swapchain image with the same layout,
+    they only differ by their entry points, vertex input and fixed function states
+*/
+static bool vulkan_create_pipeline(vulkan_context_t context, VkShaderModule shader_module, const struct pipeline_description *description, VkPipeline *pipeline)
+{
     VkPipelineShaderStageCreateInfo vert_stage_info = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
         .pNext = NULL,
         .flags = 0,
         .stage = VK_SHADER_STAGE_VERTEX_BIT,
         .module = shader_module,
-        .pName = SHADER_VERTEX_ENTRY_POINT
+        .pName = description->vertex_entry_point
     };
 
     VkPipelineShaderStageCreateInfo frag_stage_info = {
@@ -531,57 +608,32 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
         .flags = 0,
         .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
         .module = shader_module,
-        .pName = SHADER_FRAGMENT_ENTRY_POINT
+        .pName = description->fragment_entry_point
     };
 
     VkPipelineShaderStageCreateInfo shader_stages[] = {vert_stage_info, frag_stage_info};
 
+    // The topology of pipelines drawing meshes is set per draw, among the topologies of the class given by the description
     VkDynamicState dynamic_states[] = {
         VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR
+        VK_DYNAMIC_STATE_SCISSOR,
+        VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+        VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE
     };
 
     VkPipelineDynamicStateCreateInfo dynamic_state_info = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
         .pNext = NULL,
         .flags = 0,
-        .dynamicStateCount = 2,
+        .dynamicStateCount = description->dynamic_topology ? 4 : 2,
         .pDynamicStates = dynamic_states
     };
 
-    uint32_t vertex_binding_descriptions_count;
-    vertex_get_binding_description(&vertex_binding_descriptions_count, NULL);
-    VkVertexInputBindingDescription *vertex_binding_descriptions = malloc(sizeof(VkVertexInputBindingDescription) * vertex_binding_descriptions_count);
-    vertex_get_binding_description(&vertex_binding_descriptions_count, vertex_binding_descriptions);
-
-    uint32_t vertex_attribute_descriptions_count;
-    vertex_get_attribute_description(&vertex_attribute_descriptions_count, NULL);
-    VkVertexInputAttributeDescription *vertex_attribute_descriptions = malloc(sizeof(VkVertexInputAttributeDescription) * vertex_attribute_descriptions_count);
-    vertex_get_attribute_description(&vertex_attribute_descriptions_count, vertex_attribute_descriptions);
-
-    VkPipelineVertexInputStateCreateInfo vertex_input_info = {
-        .pNext = NULL,
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-        .vertexBindingDescriptionCount = vertex_binding_descriptions_count,
-        .pVertexBindingDescriptions = vertex_binding_descriptions,
-        .vertexAttributeDescriptionCount = vertex_attribute_descriptions_count,
-        .pVertexAttributeDescriptions = vertex_attribute_descriptions
-    };
-
     VkPipelineInputAssemblyStateCreateInfo input_assembly_info = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
         .pNext = NULL,
         .flags = 0,
-        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST
-    };
-
-    context->viewport = (VkViewport) {
-        .x = 0,
-        .y = 0,
-        .height = (float) context->swapchain_extent.height,
-        .width = (float) context->swapchain_extent.width,
-        .minDepth = 0.0f,
-        .maxDepth = 1.0f
+        .topology = description->topology
     };
 
     VkPipelineViewportStateCreateInfo viewport_state_info = {
@@ -599,7 +651,7 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
         .depthClampEnable = VK_FALSE,
         .rasterizerDiscardEnable = VK_FALSE,
         .polygonMode = VK_POLYGON_MODE_FILL,
-        .cullMode = VK_CULL_MODE_BACK_BIT,
+        .cullMode = description->cull_mode,
         .frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE,
         .depthBiasClamp = VK_FALSE,
         .depthBiasSlopeFactor = 1.0f,
@@ -616,7 +668,13 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
 
     VkPipelineColorBlendAttachmentState color_blend_attachment = {
         .colorWriteMask = VK_COLOR_COMPONENT_A_BIT | VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT,
-        .blendEnable = VK_FALSE
+        .blendEnable = description->blend_enable ? VK_TRUE : VK_FALSE,
+        .srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
+        .dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+        .colorBlendOp = VK_BLEND_OP_ADD,
+        .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+        .dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+        .alphaBlendOp = VK_BLEND_OP_ADD
     };
 
     VkPipelineColorBlendStateCreateInfo color_blend_info = {
@@ -629,27 +687,6 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
         .pAttachments = &color_blend_attachment
     };
 
-    VkPushConstantRange push_constant_range = {
-        .offset = 0,
-        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-        .size = sizeof(struct push_constant)
-    };
-
-    VkPipelineLayoutCreateInfo pipeline_layout_info = {
-        .flags = 0,
-        .pNext = NULL,
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-        .pSetLayouts = &context->descriptor_set_layout,
-        .pushConstantRangeCount = 1,
-        .pPushConstantRanges = &push_constant_range
-    };
-
-    if (vkCreatePipelineLayout(context->device, &pipeline_layout_info, NULL, &context->pipeline_layout) != VK_SUCCESS) {
-        vkDestroyShaderModule(context->device, shader_module, NULL);
-        return false;
-    }
-
     VkPipelineRenderingCreateInfo pipeline_rendering_info = {
         .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
         .pNext = NULL,
@@ -662,7 +699,7 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
         .pNext = &pipeline_rendering_info,
         .stageCount = 2,
         .pStages = shader_stages,
-        .pVertexInputState = &vertex_input_info,
+        .pVertexInputState = description->vertex_input,
         .pInputAssemblyState = &input_assembly_info,
         .pViewportState = &viewport_state_info,
         .pRasterizationState = &rasterization_info,
@@ -675,14 +712,377 @@ static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
         .basePipelineIndex = -1
     };
 
-    VkResult result = vkCreateGraphicsPipelines(context->device, NULL, 1, &graphic_pipeline_info, NULL, &context->graphic_pipeline);
+    return vkCreateGraphicsPipelines(context->device, NULL, 1, &graphic_pipeline_info, &context->allocation_callbacks, pipeline) == VK_SUCCESS;
+}
 
-    free(shader_code);
-    free(vertex_binding_descriptions);
-    free(vertex_attribute_descriptions);
-    vkDestroyShaderModule(context->device, shader_module, NULL);
+static bool vulkan_create_compute_pipeline(vulkan_context_t context, VkShaderModule shader_module, const char *entry_point, VkPipeline *pipeline)
+{
+    VkComputePipelineCreateInfo compute_pipeline_info = {
+        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .stage = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .pNext = NULL,
+            .flags = 0,
+            .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+            .module = shader_module,
+            .pName = entry_point
+        },
+        .layout = context->vector_pipeline_layout,
+        .basePipelineHandle = VK_NULL_HANDLE,
+        .basePipelineIndex = -1
+    };
 
-    return result == VK_SUCCESS;
+    return vkCreateComputePipelines(context->device, NULL, 1, &compute_pipeline_info, &context->allocation_callbacks, pipeline) == VK_SUCCESS;
+}
+
+static bool vulkan_create_graphic_pipeline(vulkan_context_t context)
+{
+    uint32_t code_size;
+    const char *shader_file = getenv("ANTAGL_SHADER_PATH");
+    if (!shader_file)
+        shader_file = SHADER_FILE_PATH;
+    char *shader_code = read_file(context->allocator, shader_file, &code_size, ALLOCATOR_SUBSYSTEM_VULKAN);
+
+    VkShaderModule shader_module = vulkan_create_shader_module(context, shader_code, code_size);
+
+    uint32_t vertex_binding_descriptions_count;
+    vertex_get_binding_description(&vertex_binding_descriptions_count, NULL);
+    VkVertexInputBindingDescription *vertex_binding_descriptions = allocator_allocate(context->allocator, sizeof(VkVertexInputBindingDescription) * vertex_binding_descriptions_count, ALLOCATOR_SUBSYSTEM_VULKAN);
+    vertex_get_binding_description(&vertex_binding_descriptions_count, vertex_binding_descriptions);
+
+    uint32_t vertex_attribute_descriptions_count;
+    vertex_get_attribute_description(&vertex_attribute_descriptions_count, NULL);
+    VkVertexInputAttributeDescription *vertex_attribute_descriptions = allocator_allocate(context->allocator, sizeof(VkVertexInputAttributeDescription) * vertex_attribute_descriptions_count, ALLOCATOR_SUBSYSTEM_VULKAN);
+    vertex_get_attribute_description(&vertex_attribute_descriptions_count, vertex_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo vertex_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = vertex_binding_descriptions_count,
+        .pVertexBindingDescriptions = vertex_binding_descriptions,
+        .vertexAttributeDescriptionCount = vertex_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = vertex_attribute_descriptions
+    };
+
+    uint32_t batched_vertex_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription batched_vertex_binding_description;
+    batched_vertex_get_binding_description(&batched_vertex_binding_descriptions_count, &batched_vertex_binding_description);
+
+    uint32_t batched_vertex_attribute_descriptions_count = BATCHED_VERTEX_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription batched_vertex_attribute_descriptions[BATCHED_VERTEX_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    batched_vertex_get_attribute_description(&batched_vertex_attribute_descriptions_count, batched_vertex_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo batched_vertex_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = batched_vertex_binding_descriptions_count,
+        .pVertexBindingDescriptions = &batched_vertex_binding_description,
+        .vertexAttributeDescriptionCount = batched_vertex_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = batched_vertex_attribute_descriptions
+    };
+
+    uint32_t shape_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription shape_binding_description;
+    shape_get_binding_description(&shape_binding_descriptions_count, &shape_binding_description);
+
+    uint32_t shape_attribute_descriptions_count = SHAPE_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription shape_attribute_descriptions[SHAPE_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    shape_get_attribute_description(&shape_attribute_descriptions_count, shape_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo shape_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = shape_binding_descriptions_count,
+        .pVertexBindingDescriptions = &shape_binding_description,
+        .vertexAttributeDescriptionCount = shape_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = shape_attribute_descriptions
+    };
+
+    uint32_t quad_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription quad_binding_description;
+    quad_get_binding_description(&quad_binding_descriptions_count, &quad_binding_description);
+
+    uint32_t quad_attribute_descriptions_count = QUAD_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription quad_attribute_descriptions[QUAD_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    quad_get_attribute_description(&quad_attribute_descriptions_count, quad_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo quad_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = quad_binding_descriptions_count,
+        .pVertexBindingDescriptions = &quad_binding_description,
+        .vertexAttributeDescriptionCount = quad_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = quad_attribute_descriptions
+    };
+
+    uint32_t text_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription text_binding_description;
+    text_get_binding_description(&text_binding_descriptions_count, &text_binding_description);
+
+    uint32_t text_attribute_descriptions_count = TEXT_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription text_attribute_descriptions[TEXT_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    text_get_attribute_description(&text_attribute_descriptions_count, text_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo text_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = text_binding_descriptions_count,
+        .pVertexBindingDescriptions = &text_binding_description,
+        .vertexAttributeDescriptionCount = text_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = text_attribute_descriptions
+    };
+
+    uint32_t tilemap_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription tilemap_binding_description;
+    tilemap_get_binding_description(&tilemap_binding_descriptions_count, &tilemap_binding_description);
+
+    uint32_t tilemap_attribute_descriptions_count = TILEMAP_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription tilemap_attribute_descriptions[TILEMAP_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    tilemap_get_attribute_description(&tilemap_attribute_descriptions_count, tilemap_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo tilemap_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = tilemap_binding_descriptions_count,
+        .pVertexBindingDescriptions = &tilemap_binding_description,
+        .vertexAttributeDescriptionCount = tilemap_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = tilemap_attribute_descriptions
+    };
+
+    uint32_t point_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription point_binding_description;
+    point_cloud_get_binding_description(&point_binding_descriptions_count, &point_binding_description, VK_VERTEX_INPUT_RATE_VERTEX);
+
+    uint32_t point_sprite_binding_descriptions_count = 1;
+    VkVertexInputBindingDescription point_sprite_binding_description;
+    point_cloud_get_binding_description(&point_sprite_binding_descriptions_count, &point_sprite_binding_description, VK_VERTEX_INPUT_RATE_INSTANCE);
+
+    uint32_t point_attribute_descriptions_count = POINT_CLOUD_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription point_attribute_descriptions[POINT_CLOUD_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    point_cloud_get_attribute_description(&point_attribute_descriptions_count, point_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo point_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = point_binding_descriptions_count,
+        .pVertexBindingDescriptions = &point_binding_description,
+        .vertexAttributeDescriptionCount = point_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = point_attribute_descriptions
+    };
+    VkPipelineVertexInputStateCreateInfo point_sprite_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = point_sprite_binding_descriptions_count,
+        .pVertexBindingDescriptions = &point_sprite_binding_description,
+        .vertexAttributeDescriptionCount = point_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = point_attribute_descriptions
+    };
+
+    uint32_t series_binding_descriptions_count = 2;
+    VkVertexInputBindingDescription series_binding_descriptions[2];
+    time_series_get_binding_description(&series_binding_descriptions_count, series_binding_descriptions);
+
+    uint32_t series_attribute_descriptions_count = TIME_SERIES_ATTRIBUTE_DESCRIPTIONS_COUNT;
+    VkVertexInputAttributeDescription series_attribute_descriptions[TIME_SERIES_ATTRIBUTE_DESCRIPTIONS_COUNT];
+    time_series_get_attribute_description(&series_attribute_descriptions_count, series_attribute_descriptions);
+
+    VkPipelineVertexInputStateCreateInfo series_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = series_binding_descriptions_count,
+        .pVertexBindingDescriptions = series_binding_descriptions,
+        .vertexAttributeDescriptionCount = series_attribute_descriptions_count,
+        .pVertexAttributeDescriptions = series_attribute_descriptions
+    };
+
+    VkPipelineVertexInputStateCreateInfo empty_input_info = {
+        .pNext = NULL,
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = 0,
+        .pVertexBindingDescriptions = NULL,
+        .vertexAttributeDescriptionCount = 0,
+        .pVertexAttributeDescriptions = NULL
+    };
+
+    struct pipeline_description graphic_pipeline_description = {
+        .vertex_entry_point = SHADER_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .cull_mode = VK_CULL_MODE_BACK_BIT,
+        .blend_enable = false,
+        .dynamic_topology = true
+    };
+    struct pipeline_description textured_pipeline_description = {
+        .vertex_entry_point = SHADER_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXTURED_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .cull_mode = VK_CULL_MODE_BACK_BIT,
+        .blend_enable = true,
+        .dynamic_topology = true
+    };
+    // Without dynamicPrimitiveTopologyUnrestricted a dynamic topology stays in the class of the pipeline, so lines and points get their own
+    struct pipeline_description line_pipeline_description = {
+        .vertex_entry_point = SHADER_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = false,
+        .dynamic_topology = true
+    };
+    struct pipeline_description textured_line_pipeline_description = {
+        .vertex_entry_point = SHADER_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXTURED_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true,
+        .dynamic_topology = true
+    };
+    struct pipeline_description object_point_pipeline_description = {
+        .vertex_entry_point = SHADER_OBJECT_POINT_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = false,
+        .dynamic_topology = true
+    };
+    struct pipeline_description textured_object_point_pipeline_description = {
+        .vertex_entry_point = SHADER_OBJECT_POINT_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXTURED_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true,
+        .dynamic_topology = true
+    };
+    // Dynamic batches are shaded like the objects they merge, with the same fixed function state
+    struct pipeline_description batched_pipeline_description = {
+        .vertex_entry_point = SHADER_BATCHED_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &batched_vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .cull_mode = VK_CULL_MODE_BACK_BIT,
+        .blend_enable = false
+    };
+    struct pipeline_description batched_textured_pipeline_description = {
+        .vertex_entry_point = SHADER_BATCHED_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXTURED_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &batched_vertex_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .cull_mode = VK_CULL_MODE_BACK_BIT,
+        .blend_enable = true
+    };
+    struct pipeline_description shape_pipeline_description = {
+        .vertex_entry_point = SHADER_SHAPE_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_SHAPE_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &shape_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    // The quads output the same interpolants as objects, their fragments are shaded by the same entry point
+    struct pipeline_description quad_pipeline_description = {
+        .vertex_entry_point = SHADER_QUAD_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &quad_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    struct pipeline_description text_pipeline_description = {
+        .vertex_entry_point = SHADER_TEXT_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXT_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &text_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    struct pipeline_description tile_pipeline_description = {
+        .vertex_entry_point = SHADER_TILE_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TILE_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &tilemap_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    struct pipeline_description point_pipeline_description = {
+        .vertex_entry_point = SHADER_POINT_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_POINT_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &point_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    struct pipeline_description point_sprite_pipeline_description = {
+        .vertex_entry_point = SHADER_POINT_SPRITE_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_POINT_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &point_sprite_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    // The series output the same interpolants as objects, their fragments are shaded by the same entry point
+    struct pipeline_description series_pipeline_description = {
+        .vertex_entry_point = SHADER_SERIES_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &series_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+    // The targets of the vector canvases cover the screen with a single triangle, sampled like the textured objects
+    struct pipeline_description vector_composite_pipeline_description = {
+        .vertex_entry_point = SHADER_VECTOR_VERTEX_ENTRY_POINT,
+        .fragment_entry_point = SHADER_TEXTURED_FRAGMENT_ENTRY_POINT,
+        .vertex_input = &empty_input_info,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .cull_mode = VK_CULL_MODE_NONE,
+        .blend_enable = true
+    };
+
+    context->viewport = (VkViewport) {
+        .x = 0,
+        .y = 0,
+        .height = (float) context->swapchain_extent.height,
+        .width = (float) context->swapchain_extent.width,
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f
+    };
+
+    bool result = vulkan_create_pipeline_layout(context)
+        && vulkan_create_pipeline(context, shader_module, &graphic_pipeline_description, &context->graphic_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &textured_pipeline_description, &context->textured_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &line_pipeline_description, &context->line_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &textured_line_pipeline_description, &context->textured_line_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &object_point_pipeline_description, &context->object_point_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &textured_object_point_pipeline_description, &context->textured_object_point_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &batched_pipeline_description, &context->batched_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &batched_textured_pipeline_description, &context->batched_textured_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &shape_pipeline_description, &context->shape_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &quad_pipeline_description, &context->quad_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &text_pipeline_description, &context->text_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &tile_pipeline_description, &context->tile_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &point_pipeline_description, &context->point_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &point_sprite_pipeline_description, &context->point_sprite_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &series_pipeline_description, &context->series_pipeline)
+        && vulkan_create_pipeline(context, shader_module, &vector_composite_pipeline_description, &context->vector_composite_pipeline)
+        && vulkan_create_compute_pipeline(context, shader_module, SHADER_VECTOR_BIN_ENTRY_POINT, &context->vector_bin_pipeline)
+        && vulkan_create_compute_pipeline(context, shader_module, SHADER_VECTOR_BACKDROP_ENTRY_POINT, &context->vector_backdrop_pipeline)
+        && vulkan_create_compute_pipeline(context, shader_module, SHADER_VECTOR_COARSE_ENTRY_POINT, &context->vector_coarse_pipeline)
+        && vulkan_create_compute_pipeline(context, shader_module, SHADER_VECTOR_RASTER_ENTRY_POINT, &context->vector_raster_pipeline);
+
+    allocator_free(context->allocator, shader_code, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, vertex_binding_descriptions, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, vertex_attribute_descriptions, ALLOCATOR_SUBSYSTEM_VULKAN);
+    vkDestroyShaderModule(context->device, shader_module, &context->allocation_callbacks);
+
+    return result;
 }
 
 static bool vulkan_create_command_pool(vulkan_context_t context)
@@ -694,7 +1094,7 @@ static bool vulkan_create_command_pool(vulkan_context_t context)
         .queueFamilyIndex = context->queue_family_indices.graphic
     };
 
-    return vkCreateCommandPool(context->device, &command_pool_info, NULL, &context->command_pool) == VK_SUCCESS;
+    return vkCreateCommandPool(context->device, &command_pool_info, &context->allocation_callbacks, &context->command_pool) == VK_SUCCESS;
 }
 
 static bool vulkan_create_command_buffers(vulkan_context_t context)
@@ -707,7 +1107,7 @@ static bool vulkan_create_command_buffers(vulkan_context_t context)
         .commandPool = context->command_pool
     };
 
-    context->command_buffers = malloc(sizeof(VkCommandBuffer) * MAX_FRAMES_IN_FLIGHT);
+    context->command_buffers = allocator_allocate(context->allocator, sizeof(VkCommandBuffer) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     return vkAllocateCommandBuffers(context->device, &command_buffer_info, context->command_buffers) == VK_SUCCESS;
 }
@@ -755,45 +1155,686 @@ static void transition_image_layout(
     vkCmdPipelineBarrier2(command_buffer, &dependency_info);
 }
 
-static void vulkan_record_command_buffer(vulkan_context_t context, object_t *objects, uint32_t objects_count)
+// Size in bytes of a texel of the uncompressed color formats textures can be created with, 0 for the others
+uint32_t vulkan_get_texel_size(VkFormat format)
 {
-    VkCommandBufferBeginInfo begin_info = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-        .flags = 0,
-        .pNext = NULL,
-        .pInheritanceInfo = NULL,
-    };
-
-    vkBeginCommandBuffer(context->command_buffers[context->current_frame], &begin_info);
+    switch (format) {
+        case VK_FORMAT_R8_UNORM:
+            return 1;
+        case VK_FORMAT_R8G8_UNORM:
+            return 2;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_R32_SFLOAT:
+            return 4;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            return 16;
+        default:
+            return 0;
+    }
+}
 
-    transition_image_layout(context->image_index, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, context->swapchain_images, context->command_buffers[context->current_frame]);
-    
-    VkClearValue clear_color = {
-        .color = {
-            .float32 = {0.0, 0.0, 0.0, 1.0}
+static void vulkan_transition_texture_layout(VkCommandBuffer command_buffer, texture_t texture, VkImageLayout new_layout,
+    VkAccessFlags2 src_access_mask, VkAccessFlags2 dst_access_mask, VkPipelineStageFlags2 src_stage_mask, VkPipelineStageFlags2 dst_stage_mask)
+{
+    VkImageMemoryBarrier2 barrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+        .pNext = NULL,
+        .srcAccessMask = src_access_mask,
+        .dstAccessMask = dst_access_mask,
+        .srcStageMask = src_stage_mask,
+        .dstStageMask = dst_stage_mask,
+        .oldLayout = texture->layout,
+        .newLayout = new_layout,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = texture->image,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1,
         }
     };
-    VkRenderingAttachmentInfo attachment_info = {
-        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+
+    VkDependencyInfo dependency_info = {
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
         .pNext = NULL,
-        .imageView = context->swapchain_image_views[context->image_index],
-        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .clearValue = clear_color
+        .dependencyFlags = 0,
+        .imageMemoryBarrierCount = 1,
+        .pImageMemoryBarriers = &barrier
     };
 
-    VkRenderingInfo rendering_info = {
-        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
-        .pNext = NULL,
-        .flags = 0,
-        .renderArea = {
-            .offset.x = 0,
-            .offset.y = 0,
-            .extent = context->swapchain_extent
-        },
-        .layerCount = 1,
-        .colorAttachmentCount = 1,
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+    texture->layout = new_layout;
+}
+
+/*
+    The texels of every queued update are staged in the frame allocator and copied before the rendering begins,
+    updates that don't fit in the frame stay queued for the next one
+*/
+static void vulkan_record_texture_updates(vulkan_context_t context)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    uint32_t recorded_count = 0;
+
+    for (; recorded_count < context->texture_updates_count; ++recorded_count) {
+        struct texture_update *update = &context->texture_updates[recorded_count];
+        texture_t texture = update->texture;
+        uint32_t texel_size = vulkan_get_texel_size(texture->format);
+        VkDeviceSize row_size = (VkDeviceSize) update->width * texel_size;
+        struct frame_allocation staging;
+
+        if (!vulkan_frame_allocate(context, row_size * update->height, 16, &staging))
+            break;
+        if (update->row_length == update->width) {
+            memcpy(staging.data, update->pixels, row_size * update->height);
+        } else {
+            for (uint32_t row = 0; row < update->height; ++row)
+                memcpy(PTR_OFFSET(staging.data, row * row_size), PTR_OFFSET(update->pixels, (size_t) row * update->row_length * texel_size), row_size);
+        }
+
+        if (texture->layout == VK_IMAGE_LAYOUT_UNDEFINED)
+            vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                0, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+        else
+            vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+
+        VkBufferImageCopy region = {
+            .bufferOffset = staging.offset,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {
+                .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1
+            },
+            .imageOffset = {(int32_t) update->x, (int32_t) update->y, 0},
+            .imageExtent = {update->width, update->height, 1}
+        };
+
+        vkCmdCopyBufferToImage(command_buffer, staging.buffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    }
+
+    context->texture_updates_count -= recorded_count;
+    memmove(context->texture_updates, context->texture_updates + recorded_count, sizeof(struct texture_update) * context->texture_updates_count);
+}
+
+// Whether the rectangle of the slice `a` lies inside the one of the slice `b`
+static bool vulkan_streaming_slice_covers(streaming_texture_slice_t b, streaming_texture_slice_t a)
+{
+    return a->x >= b->x && a->y >= b->y && a->x + a->width <= b->x + b->width && a->y + a->height <= b->y + b->height;
+}
+
+static bool vulkan_copy_regions_overlap(const VkBufferImageCopy *a, const VkBufferImageCopy *b)
+{
+    return a->imageOffset.x < b->imageOffset.x + (int32_t) b->imageExtent.width && b->imageOffset.x < a->imageOffset.x + (int32_t) a->imageExtent.width
+        && a->imageOffset.y < b->imageOffset.y + (int32_t) b->imageExtent.height && b->imageOffset.y < a->imageOffset.y + (int32_t) a->imageExtent.height;
+}
+
+/*
+    The slices submitted since the last frame are copied straight from the staging buffer in the order they were submitted,
+    a slice covered by a later one is freed without being copied. Regions of a single copy command may land in any order,
+    so a region overlapping one already batched starts a new copy behind a barrier.
+    The copied slices stay pending until the fence of this frame is waited on by vulkan_begin_frame()
+*/
+static void vulkan_record_streaming_textures(vulkan_context_t context)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+
+    for (uint32_t i = 0; i < context->streaming_textures_count; ++i) {
+        streaming_texture_t streaming_texture = context->streaming_textures[i];
+        texture_t texture = &streaming_texture->texture;
+        streaming_texture_slice_t ready[STREAMING_TEXTURE_SLICES_COUNT];
+        VkBufferImageCopy regions[STREAMING_TEXTURE_SLICES_COUNT];
+        uint32_t ready_count = 0;
+        uint32_t regions_count = 0;
+
+        for (uint32_t j = 0; j < STREAMING_TEXTURE_SLICES_COUNT; ++j) {
+            streaming_texture_slice_t slice = &streaming_texture->slices[j];
+            uint32_t k = ready_count;
+
+            if (atomic_load_explicit(&slice->state, memory_order_acquire) != STREAMING_TEXTURE_SLICE_READY)
+                continue;
+            ready_count++;
+            // Insertion by sequence, compared through their difference so that the counter may wrap
+            for (; k > 0 && (int32_t) (slice->sequence - ready[k - 1]->sequence) < 0; --k)
+                ready[k] = ready[k - 1];
+            ready[k] = slice;
+        }
+        // A gap is a slice between its sequence and its ready state, the slices after it wait for the next frame
+        for (uint32_t j = 0; j < ready_count; ++j) {
+            if (ready[j]->sequence != streaming_texture->copied_sequence + j) {
+                ready_count = j;
+                break;
+            }
+        }
+        if (ready_count == 0)
+            continue;
+        streaming_texture->copied_sequence += ready_count;
+
+        if (texture->layout == VK_IMAGE_LAYOUT_UNDEFINED)
+            vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                0, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+        else
+            vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+
+        for (uint32_t j = 0; j < ready_count; ++j) {
+            streaming_texture_slice_t slice = ready[j];
+            bool is_covered = false;
+
+            for (uint32_t k = j + 1; k < ready_count && !is_covered; ++k)
+                is_covered = vulkan_streaming_slice_covers(ready[k], slice);
+            if (is_covered) {
+                streaming_texture->skipped_count++;
+                atomic_store_explicit(&slice->state, STREAMING_TEXTURE_SLICE_FREE, memory_order_release);
+                continue;
+            }
+
+            VkBufferImageCopy region = {
+                .bufferOffset = slice->offset + (VkDeviceSize) slice->y * streaming_texture->row_pitch + (VkDeviceSize) slice->x * streaming_texture->texel_size,
+                .bufferRowLength = texture->width,
+                .bufferImageHeight = 0,
+                .imageSubresource = {
+                    .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = 0,
+                    .baseArrayLayer = 0,
+                    .layerCount = 1
+                },
+                .imageOffset = {(int32_t) slice->x, (int32_t) slice->y, 0},
+                .imageExtent = {slice->width, slice->height, 1}
+            };
+            bool is_overlapping = false;
+
+            for (uint32_t k = 0; k < regions_count && !is_overlapping; ++k)
+                is_overlapping = vulkan_copy_regions_overlap(&regions[k], &region);
+            if (is_overlapping) {
+                vkCmdCopyBufferToImage(command_buffer, streaming_texture->buffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions_count, regions);
+                vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+                regions_count = 0;
+            }
+            regions[regions_count++] = region;
+            slice->frame = context->current_frame;
+            atomic_store_explicit(&slice->state, STREAMING_TEXTURE_SLICE_PENDING, memory_order_relaxed);
+        }
+
+        vkCmdCopyBufferToImage(command_buffer, streaming_texture->buffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, regions_count, regions);
+        vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    }
+}
+
+/*
+    Same staging as the texture updates. The first barrier waits for the frames already submitted
+    that read the buffers as vertex input, the second one makes the copies visible to this frame
+*/
+static void vulkan_record_buffer_updates(vulkan_context_t context)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    uint32_t recorded_count = 0;
+
+    if (context->buffer_updates_count == 0)
+        return;
+
+    VkMemoryBarrier2 barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .pNext = NULL,
+        // Updated buffers are read as vertices, or as storage buffers by the compute passes of the vector canvases
+        .srcStageMask = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .srcAccessMask = 0,
+        .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+        .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT
+    };
+    VkDependencyInfo dependency_info = {
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .pNext = NULL,
+        .dependencyFlags = 0,
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &barrier
+    };
+
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+    for (; recorded_count < context->buffer_updates_count; ++recorded_count) {
+        struct buffer_update *update = &context->buffer_updates[recorded_count];
+        struct frame_allocation staging;
+
+        if (!vulkan_frame_allocate(context, update->size, 16, &staging))
+            break;
+        memcpy(staging.data, update->data, update->size);
+
+        VkBufferCopy region = {
+            .srcOffset = staging.offset,
+            .dstOffset = update->offset,
+            .size = update->size
+        };
+
+        vkCmdCopyBuffer(command_buffer, staging.buffer, update->buffer, 1, &region);
+    }
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+
+    context->buffer_updates_count -= recorded_count;
+    memmove(context->buffer_updates, context->buffer_updates + recorded_count, sizeof(struct buffer_update) * context->buffer_updates_count);
+}
+
+static void vulkan_bind_vector_canvas(vulkan_context_t context, vector_canvas_t canvas)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->vector_pipeline_layout, 2, 1, &canvas->descriptor_set, 0, NULL);
+    vkCmdPushConstants(command_buffer, context->vector_pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(struct vector_push_constant), &canvas->push_constant);
+}
+
+/*
+    The vector canvases are rasterized before the rendering begins, each pass running for every canvas before the barrier of the next one.
+    The rectangles of the paths are copied and the tiles cleared, the segments are binned into the tiles they cross,
+    the winding numbers at the left of the tiles are summed along their rows, the tiles covering each screen tile are listed,
+    then the coverage of every pixel is written to the targets from the tiles of its screen tile
+*/
+static void vulkan_record_vector_canvases(vulkan_context_t context, vector_canvas_t *vector_canvases, uint32_t vector_canvases_count)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    bool is_rasterized = false;
+
+    for (uint32_t i = 0; i < vector_canvases_count && !is_rasterized; ++i)
+        is_rasterized = vector_canvases[i]->tiles_count > 0;
+    if (!is_rasterized)
+        return;
+
+    // The passes of the previous frame still reading or writing the scratch buffers must be done
+    VkMemoryBarrier2 barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+        .pNext = NULL,
+        .srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        .srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT,
+        .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT
+    };
+    VkDependencyInfo dependency_info = {
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+        .pNext = NULL,
+        .dependencyFlags = 0,
+        .memoryBarrierCount = 1,
+        .pMemoryBarriers = &barrier
+    };
+
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+        VkDeviceSize size = sizeof(struct vector_path_tiles) * canvas->push_constant.paths_count;
+        struct frame_allocation staging;
+
+        if (canvas->tiles_count == 0)
+            continue;
+        if (!vulkan_frame_allocate(context, size, alignof(struct vector_path_tiles), &staging)) {
+            canvas->tiles_count = 0;
+            continue;
+        }
+        memcpy(staging.data, canvas->path_tiles, size);
+
+        VkBufferCopy region = {
+            .srcOffset = staging.offset,
+            .dstOffset = 0,
+            .size = size
+        };
+
+        vkCmdCopyBuffer(command_buffer, staging.buffer, canvas->scratch_buffer, 1, &region);
+        // The first node counts the allocated pieces, so the pieces start from index 1 and 0 ends the lists of the tiles
+        vkCmdFillBuffer(command_buffer, canvas->scratch_buffer, canvas->tiles_offset, sizeof(struct vector_tile) * canvas->tiles_count, 0);
+        vkCmdFillBuffer(command_buffer, canvas->scratch_buffer, canvas->nodes_offset, sizeof(struct vector_node), 0);
+    }
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT | VK_PIPELINE_STAGE_2_CLEAR_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->vector_bin_pipeline);
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+
+        if (canvas->tiles_count == 0 || canvas->push_constant.segments_count == 0)
+            continue;
+        vulkan_bind_vector_canvas(context, canvas);
+        vkCmdDispatch(command_buffer, (canvas->push_constant.segments_count + VECTOR_CANVAS_WORKGROUP_SIZE - 1) / VECTOR_CANVAS_WORKGROUP_SIZE, 1, 1);
+    }
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->vector_backdrop_pipeline);
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+
+        if (canvas->tiles_count == 0)
+            continue;
+        vulkan_bind_vector_canvas(context, canvas);
+        vkCmdDispatch(command_buffer, (canvas->push_constant.rows_count + VECTOR_CANVAS_WORKGROUP_SIZE - 1) / VECTOR_CANVAS_WORKGROUP_SIZE, 1, 1);
+    }
+
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->vector_coarse_pipeline);
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+        uint32_t rows_count = (canvas->target.height + VECTOR_CANVAS_TILE_SIZE - 1) / VECTOR_CANVAS_TILE_SIZE;
+
+        if (canvas->tiles_count == 0)
+            continue;
+        vulkan_bind_vector_canvas(context, canvas);
+        vkCmdDispatch(command_buffer, (canvas->push_constant.columns_count + VECTOR_CANVAS_COARSE_SIZE - 1) / VECTOR_CANVAS_COARSE_SIZE,
+            (rows_count + VECTOR_CANVAS_COARSE_SIZE - 1) / VECTOR_CANVAS_COARSE_SIZE, 1);
+    }
+
+    vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->vector_raster_pipeline);
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+
+        if (canvas->tiles_count == 0)
+            continue;
+        // Every pixel of the target is written again, its previous content is discarded
+        canvas->target.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        vulkan_transition_texture_layout(command_buffer, &canvas->target, VK_IMAGE_LAYOUT_GENERAL,
+            0, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+        vulkan_bind_vector_canvas(context, canvas);
+        vkCmdDispatch(command_buffer, canvas->push_constant.columns_count, (canvas->target.height + VECTOR_CANVAS_TILE_SIZE - 1) / VECTOR_CANVAS_TILE_SIZE, 1);
+        vulkan_transition_texture_layout(command_buffer, &canvas->target, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    }
+}
+
+// The targets rasterized in this frame cover the screen, blended over what has been drawn before them
+static void vulkan_record_vector_composites(vulkan_context_t context, vector_canvas_t *vector_canvases, uint32_t vector_canvases_count, VkPipeline *bound_pipeline)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    struct push_constant push_constant = {0};
+
+    glm_mat4_identity(push_constant.model);
+    glm_vec4_one(push_constant.color);
+    push_constant.uv_rect[2] = 1.0f;
+    push_constant.uv_rect[3] = 1.0f;
+    for (uint32_t i = 0; i < vector_canvases_count; ++i) {
+        vector_canvas_t canvas = vector_canvases[i];
+
+        if (canvas->tiles_count == 0)
+            continue;
+        if (*bound_pipeline != context->vector_composite_pipeline) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->vector_composite_pipeline);
+            *bound_pipeline = context->vector_composite_pipeline;
+        }
+        push_constant.texture_index = canvas->target.index;
+        vkCmdPushConstants(command_buffer, context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &push_constant);
+        vkCmdDraw(command_buffer, 3, 1, 0, 0);
+    }
+}
+
+// Every chunk of a batch already lives in the frame allocator buffer, each one is a draw call reading its instances from the chunk
+static void vulkan_record_quad_batch(vulkan_context_t context, const struct quad_batch *batch, VkPipeline pipeline, uint32_t default_parameters_offset, uint32_t *bound_parameters_offset)
+{
+    if (quad_batch_get_quads_count(batch) == 0)
+        return;
+
+    vkCmdBindPipeline(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    if (*bound_parameters_offset == UINT32_MAX) {
+        vkCmdBindDescriptorSets(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &default_parameters_offset);
+        *bound_parameters_offset = default_parameters_offset;
+    }
+    for (uint32_t i = 0; i < batch->draws_count; ++i) {
+        uint32_t quads_count = i + 1 == batch->draws_count ? batch->quads_count : batch->draws[i].quads_count;
+
+        if (quads_count == 0)
+            continue;
+        vkCmdBindVertexBuffers(context->command_buffers[context->current_frame], 0, 1, &context->frame_allocator.buffer, &batch->draws[i].offset);
+        vkCmdDraw(context->command_buffers[context->current_frame], 4, quads_count, 0, 0);
+    }
+}
+
+// A tilemap binds its instance buffer once, each range of visible chunks is an instanced draw starting at its first instance
+static void vulkan_record_tilemaps(vulkan_context_t context, tilemap_t *tilemaps, uint32_t tilemaps_count, uint32_t default_parameters_offset, uint32_t *bound_parameters_offset)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    VkDeviceSize offset = 0;
+
+    if (tilemaps_count == 0)
+        return;
+
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->tile_pipeline);
+    if (*bound_parameters_offset == UINT32_MAX) {
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &default_parameters_offset);
+        *bound_parameters_offset = default_parameters_offset;
+    }
+    for (uint32_t i = 0; i < tilemaps_count; ++i) {
+        tilemap_t tilemap = tilemaps[i];
+
+        if (tilemap->draws_count == 0)
+            continue;
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, &tilemap->instance_buffer, &offset);
+        vkCmdPushConstants(command_buffer, context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &tilemap->push_constant);
+        for (uint32_t j = 0; j < tilemap->draws_count; ++j)
+            vkCmdDraw(command_buffer, 4, tilemap->draws[j].instances_count, 0, tilemap->draws[j].first_instance);
+    }
+}
+
+// Each visible chunk of a point cloud is a draw call reading its own vertex buffer, one vertex per point or one instance per sprite
+static void vulkan_record_point_clouds(vulkan_context_t context, point_cloud_t *point_clouds, uint32_t point_clouds_count, uint32_t default_parameters_offset, uint32_t *bound_parameters_offset, VkPipeline *bound_pipeline)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+    VkDeviceSize offset = 0;
+
+    for (uint32_t i = 0; i < point_clouds_count; ++i) {
+        point_cloud_t point_cloud = point_clouds[i];
+        bool is_sprite = point_cloud->push_constant.uv_rect[0] > context->max_point_size;
+        VkPipeline pipeline = is_sprite ? context->point_sprite_pipeline : context->point_pipeline;
+
+        if (point_cloud->draws_count == 0)
+            continue;
+        if (pipeline != *bound_pipeline) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            *bound_pipeline = pipeline;
+        }
+        if (*bound_parameters_offset == UINT32_MAX) {
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &default_parameters_offset);
+            *bound_parameters_offset = default_parameters_offset;
+        }
+        vkCmdPushConstants(command_buffer, context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &point_cloud->push_constant);
+        for (uint32_t j = 0; j < point_cloud->draws_count; ++j) {
+            struct point_cloud_chunk *chunk = &point_cloud->chunks[point_cloud->draws[j]];
+
+            if (chunk->uploaded_count == 0)
+                continue;
+            vkCmdBindVertexBuffers(command_buffer, 0, 1, &chunk->buffer, &offset);
+            if (is_sprite)
+                vkCmdDraw(command_buffer, 4, chunk->uploaded_count, 0, 0);
+            else
+                vkCmdDraw(command_buffer, chunk->uploaded_count, 1, 0, 0);
+        }
+    }
+}
+
+// Every series of a time series reads the values of the drawn level of its pyramid and its color as an instance written in the frame allocator,
+// their draws are written next to it and issued by one indirect draw when the device can, one draw per series and part of ring otherwise
+static void vulkan_record_time_series(vulkan_context_t context, time_series_t *time_series, uint32_t time_series_count, uint32_t default_parameters_offset, uint32_t *bound_parameters_offset, VkPipeline *bound_pipeline)
+{
+    VkCommandBuffer command_buffer = context->command_buffers[context->current_frame];
+
+    for (uint32_t i = 0; i < time_series_count; ++i) {
+        time_series_t series = time_series[i];
+        struct frame_allocation colors_allocation;
+        struct frame_allocation draws_allocation;
+
+        if (series->draws_count == 0
+            || !vulkan_frame_allocate(context, sizeof(vec4) * series->series_count, alignof(vec4), &colors_allocation)
+            || (context->multi_draw_indirect && !vulkan_frame_allocate(context, sizeof(VkDrawIndirectCommand) * series->draws_count, alignof(VkDrawIndirectCommand), &draws_allocation)))
+            continue;
+        memcpy(colors_allocation.data, series->colors, sizeof(vec4) * series->series_count);
+
+        VkBuffer buffers[2] = {series->buffer, colors_allocation.buffer};
+        VkDeviceSize offsets[2] = {series->levels[series->level].offset * sizeof(vec2), colors_allocation.offset};
+
+        if (*bound_pipeline != context->series_pipeline) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->series_pipeline);
+            *bound_pipeline = context->series_pipeline;
+        }
+        if (*bound_parameters_offset == UINT32_MAX) {
+            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &default_parameters_offset);
+            *bound_parameters_offset = default_parameters_offset;
+        }
+        vkCmdBindVertexBuffers(command_buffer, 0, 2, buffers, offsets);
+        vkCmdPushConstants(command_buffer, context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &series->push_constant);
+        if (context->multi_draw_indirect) {
+            memcpy(draws_allocation.data, series->draws, sizeof(VkDrawIndirectCommand) * series->draws_count);
+            vkCmdDrawIndirect(command_buffer, draws_allocation.buffer, draws_allocation.offset, series->draws_count, sizeof(VkDrawIndirectCommand));
+            continue;
+        }
+        for (uint32_t j = 0; j < series->draws_count; ++j)
+            vkCmdDraw(command_buffer, series->draws[j].vertexCount, 1, series->draws[j].firstVertex, series->draws[j].firstInstance);
+    }
+}
+
+static const VkPrimitiveTopology vulkan_mesh_topologies[] = {
+    [MESH_TOPOLOGY_TRIANGLE_LIST] = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+    [MESH_TOPOLOGY_TRIANGLE_STRIP] = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+    [MESH_TOPOLOGY_LINE_LIST] = VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+    [MESH_TOPOLOGY_LINE_STRIP] = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP,
+    [MESH_TOPOLOGY_POINT_LIST] = VK_PRIMITIVE_TOPOLOGY_POINT_LIST
+};
+
+// Restarting lists needs the primitiveTopologyListRestart feature, only strips are cut by the restart index
+static bool vulkan_mesh_topology_restarts(enum mesh_topology topology)
+{
+    return topology == MESH_TOPOLOGY_TRIANGLE_STRIP || topology == MESH_TOPOLOGY_LINE_STRIP;
+}
+
+// Objects are drawn by the pipeline of the topology class of their mesh, the topology itself being set per draw
+static VkPipeline vulkan_get_object_pipeline(vulkan_context_t context, object_t object)
+{
+    switch (object->mesh->topology) {
+        case MESH_TOPOLOGY_LINE_LIST:
+        case MESH_TOPOLOGY_LINE_STRIP:
+            return object->texture ? context->textured_line_pipeline : context->line_pipeline;
+        case MESH_TOPOLOGY_POINT_LIST:
+            return object->texture ? context->textured_object_point_pipeline : context->object_point_pipeline;
+        default:
+            return object->texture ? context->textured_pipeline : context->graphic_pipeline;
+    }
+}
+
+// A draw command can join the run of the one before it when it is small enough and shares its pipeline, its texture and its draw parameters,
+// batches being triangle lists
+static bool vulkan_can_batch_draw(const struct draw_command *draw_command, const struct draw_command *run_start, uint32_t dynamic_batch_threshold)
+{
+    return draw_command->object->mesh->vertices_count <= dynamic_batch_threshold
+        && draw_command->object->mesh->topology == MESH_TOPOLOGY_TRIANGLE_LIST
+        && draw_command->parameters_offset == run_start->parameters_offset
+        && draw_command->object->texture == run_start->object->texture;
+}
+
+// Transform the vertices of the draw commands from first down to last into the frame allocator, in the order they would have been drawn
+static bool vulkan_write_dynamic_batch(vulkan_context_t context, struct draw_command *draw_commands, ssize_t first, ssize_t last,
+    struct frame_allocation *vertices_allocation, struct frame_allocation *indices_allocation, uint32_t *indices_count)
+{
+    uint32_t vertices_count = 0;
+
+    *indices_count = 0;
+    for (ssize_t i = first; i >= last; --i) {
+        vertices_count += draw_commands[i].object->mesh->vertices_count;
+        *indices_count += draw_commands[i].object->mesh->lods[draw_commands[i].lod].indices_count;
+    }
+    if (!vulkan_frame_allocate(context, sizeof(struct batched_vertex) * vertices_count, alignof(struct batched_vertex), vertices_allocation)
+        || !vulkan_frame_allocate(context, sizeof(uint32_t) * *indices_count, alignof(uint32_t), indices_allocation))
+        return false;
+
+    struct batched_vertex *vertices = vertices_allocation->data;
+    uint32_t *indices = indices_allocation->data;
+    uint32_t first_vertex = 0;
+
+    for (ssize_t i = first; i >= last; --i) {
+        object_t object = draw_commands[i].object;
+        mesh_t mesh = object->mesh;
+        struct mesh_lod *lod = &mesh->lods[draw_commands[i].lod];
+        struct push_constant *push_constant = &object->vertex_push_constant;
+
+        geometry_transform_points(push_constant->model, mesh->positions, mesh->vertices_count, vertices->position, sizeof(struct batched_vertex));
+        for (uint32_t j = 0; j < mesh->vertices_count; ++j)
+            glm_vec4_copy(push_constant->color, vertices[j].color);
+        // Untextured batches are shaded by fragMain which never reads the texture coordinates
+        for (uint32_t j = 0; object->texture && j < mesh->vertices_count; ++j) {
+            vertices[j].uv[0] = glm_lerp(push_constant->uv_rect[0], push_constant->uv_rect[2], (mesh->positions[j][0] - mesh->uv_origin[0]) * mesh->uv_scale[0]);
+            vertices[j].uv[1] = glm_lerp(push_constant->uv_rect[1], push_constant->uv_rect[3], (mesh->positions[j][1] - mesh->uv_origin[1]) * mesh->uv_scale[1]);
+            vertices[j].texture_index = push_constant->texture_index;
+        }
+        for (uint32_t j = 0; j < lod->indices_count; ++j)
+            indices[j] = mesh->indices[lod->first_index + j] + first_vertex;
+
+        vertices += mesh->vertices_count;
+        indices += lod->indices_count;
+        first_vertex += mesh->vertices_count;
+    }
+    return true;
+}
+
+static void vulkan_record_command_buffer(vulkan_context_t context, const struct draw_lists *draw_lists, uint32_t dynamic_batch_threshold)
+{
+    VkCommandBufferBeginInfo begin_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = 0,
+        .pNext = NULL,
+        .pInheritanceInfo = NULL,
+    };
+
+    context->dynamic_batches_count = 0;
+    context->dynamic_batched_objects_count = 0;
+    vkBeginCommandBuffer(context->command_buffers[context->current_frame], &begin_info);
+    vulkan_record_buffer_updates(context);
+    vulkan_record_texture_updates(context);
+    vulkan_record_streaming_textures(context);
+    vulkan_record_vector_canvases(context, draw_lists->vector_canvases, draw_lists->vector_canvases_count);
+
+    transition_image_layout(context->image_index, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, 0, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, context->swapchain_images, context->command_buffers[context->current_frame]);
+    
+    VkClearValue clear_color = {
+        .color = {
+            .float32 = {0.0, 0.0, 0.0, 1.0}
+        }
+    };
+    VkRenderingAttachmentInfo attachment_info = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+        .pNext = NULL,
+        .imageView = context->swapchain_image_views[context->image_index],
+        .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .clearValue = clear_color
+    };
+
+    VkRenderingInfo rendering_info = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .renderArea = {
+            .offset.x = 0,
+            .offset.y = 0,
+            .extent = context->swapchain_extent
+        },
+        .layerCount = 1,
+        .colorAttachmentCount = 1,
         .pColorAttachments = &attachment_info
     };
 
@@ -809,16 +1850,98 @@ static void vulkan_record_command_buffer(vulkan_context_t context, object_t *obj
     };
     vkCmdSetScissor(context->command_buffers[context->current_frame], 0, 1, &scissor);
 
-    vkCmdBindDescriptorSets(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 0, NULL);
+    uint32_t default_parameters_offset = (uint32_t) context->frame_allocator.frame_start;
+    uint32_t bound_parameters_offset = UINT32_MAX;
+    VkPipeline bound_pipeline = draw_lists->tilemaps_count > 0 ? context->tile_pipeline : context->graphic_pipeline;
+    uint32_t bound_topology = UINT32_MAX;
+
+    // The whole texture array is bound once, textured objects only push the index of their texture
+    vkCmdBindDescriptorSets(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 1, 1, &context->texture_descriptor_set, 0, NULL);
+    vulkan_record_tilemaps(context, draw_lists->tilemaps, draw_lists->tilemaps_count, default_parameters_offset, &bound_parameters_offset);
+    vulkan_record_point_clouds(context, draw_lists->point_clouds, draw_lists->point_clouds_count, default_parameters_offset, &bound_parameters_offset, &bound_pipeline);
+
+    struct draw_command *draw_commands = draw_lists->draw_commands;
 
-    for (ssize_t i = (ssize_t) objects_count - 1; i >= 0; --i) {
+    for (ssize_t i = (ssize_t) draw_lists->draw_commands_count - 1; i >= 0; --i) {
+        object_t object = draw_commands[i].object;
+        struct mesh_lod *lod = &object->mesh->lods[draw_commands[i].lod];
+        uint32_t parameters_offset = draw_commands[i].parameters_offset;
         VkDeviceSize offset = 0;
-        vkCmdBindVertexBuffers(context->command_buffers[context->current_frame], 0, 1, &(objects[i]->vertex_buffer), &offset);
-        vkCmdBindIndexBuffer(context->command_buffers[context->current_frame], objects[i]->index_buffer, offset, VK_INDEX_TYPE_UINT16);
-        vkCmdPushConstants(context->command_buffers[context->current_frame], context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &objects[i]->vertex_push_constant);
-        vkCmdDrawIndexed(context->command_buffers[context->current_frame], objects[i]->indices_count, 1, 0, 0, 0);
+
+        if (parameters_offset == FRAME_ALLOCATOR_DEFAULT_PARAMETERS)
+            parameters_offset = default_parameters_offset;
+        if (parameters_offset != bound_parameters_offset) {
+            vkCmdBindDescriptorSets(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &parameters_offset);
+            bound_parameters_offset = parameters_offset;
+        }
+
+        // Consecutive small objects are merged into one draw, they keep the order they would have been drawn in
+        ssize_t last = i;
+        struct frame_allocation vertices_allocation;
+        struct frame_allocation indices_allocation;
+        uint32_t indices_count;
+
+        if (object->mesh->vertices_count <= dynamic_batch_threshold && object->mesh->topology == MESH_TOPOLOGY_TRIANGLE_LIST)
+            while (last > 0 && vulkan_can_batch_draw(&draw_commands[last - 1], &draw_commands[i], dynamic_batch_threshold))
+                last--;
+        if (last < i && vulkan_write_dynamic_batch(context, draw_commands, i, last, &vertices_allocation, &indices_allocation, &indices_count)) {
+            VkPipeline pipeline = object->texture ? context->batched_textured_pipeline : context->batched_pipeline;
+            if (pipeline != bound_pipeline) {
+                vkCmdBindPipeline(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+                bound_pipeline = pipeline;
+            }
+
+            offset = vertices_allocation.offset;
+            vkCmdBindVertexBuffers(context->command_buffers[context->current_frame], 0, 1, &vertices_allocation.buffer, &offset);
+            vkCmdBindIndexBuffer(context->command_buffers[context->current_frame], indices_allocation.buffer, indices_allocation.offset, VK_INDEX_TYPE_UINT32);
+            vkCmdDrawIndexed(context->command_buffers[context->current_frame], indices_count, 1, 0, 0, 0);
+            context->dynamic_batches_count++;
+            context->dynamic_batched_objects_count += (uint32_t) (i - last + 1);
+            i = last;
+            continue;
+        }
+
+        VkPipeline pipeline = vulkan_get_object_pipeline(context, object);
+        if (pipeline != bound_pipeline) {
+            vkCmdBindPipeline(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            bound_pipeline = pipeline;
+            bound_topology = UINT32_MAX;
+        }
+        // Binding a pipeline whose topology is static leaves the dynamic one undefined, so it is set again after every bind
+        if (object->mesh->topology != bound_topology) {
+            vkCmdSetPrimitiveTopology(context->command_buffers[context->current_frame], vulkan_mesh_topologies[object->mesh->topology]);
+            vkCmdSetPrimitiveRestartEnable(context->command_buffers[context->current_frame], vulkan_mesh_topology_restarts(object->mesh->topology));
+            bound_topology = object->mesh->topology;
+        }
+
+        vkCmdBindVertexBuffers(context->command_buffers[context->current_frame], 0, 1, &(object->mesh->vertex_buffer), &offset);
+        vkCmdBindIndexBuffer(context->command_buffers[context->current_frame], object->mesh->index_buffer, offset, object->mesh->index_type);
+        vkCmdPushConstants(context->command_buffers[context->current_frame], context->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(struct push_constant), &object->vertex_push_constant);
+        vkCmdDrawIndexed(context->command_buffers[context->current_frame], lod->indices_count, 1, lod->first_index, 0, 0);
+    }
+
+    vulkan_record_time_series(context, draw_lists->time_series, draw_lists->time_series_count, default_parameters_offset, &bound_parameters_offset, &bound_pipeline);
+    vulkan_record_vector_composites(context, draw_lists->vector_canvases, draw_lists->vector_canvases_count, &bound_pipeline);
+
+    struct frame_allocation shapes_allocation;
+
+    if (draw_lists->shapes_count > 0 && vulkan_frame_allocate(context, sizeof(struct shape) * draw_lists->shapes_count, alignof(struct shape), &shapes_allocation)) {
+        memcpy(shapes_allocation.data, draw_lists->shapes, sizeof(struct shape) * draw_lists->shapes_count);
+
+        vkCmdBindPipeline(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->shape_pipeline);
+        if (bound_parameters_offset == UINT32_MAX) {
+            vkCmdBindDescriptorSets(context->command_buffers[context->current_frame], VK_PIPELINE_BIND_POINT_GRAPHICS, context->pipeline_layout, 0, 1, &(context->descriptor_sets[context->current_frame]), 1, &default_parameters_offset);
+            bound_parameters_offset = default_parameters_offset;
+        }
+        vkCmdBindVertexBuffers(context->command_buffers[context->current_frame], 0, 1, &shapes_allocation.buffer, &shapes_allocation.offset);
+        vkCmdDraw(context->command_buffers[context->current_frame], 4, draw_lists->shapes_count, 0, 0);
     }
 
+    vulkan_record_quad_batch(context, draw_lists->quads, context->quad_pipeline, default_parameters_offset, &bound_parameters_offset);
+    // The glyph atlas can't be sampled before its first upload has been recorded
+    if (context->glyph_atlas_texture && context->glyph_atlas_texture->layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+        vulkan_record_quad_batch(context, draw_lists->text, context->text_pipeline, default_parameters_offset, &bound_parameters_offset);
+
     vkCmdEndRendering(context->command_buffers[context->current_frame]);
 
     transition_image_layout(context->image_index, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, 0, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, context->swapchain_images, context->command_buffers[context->current_frame]);
@@ -839,18 +1962,18 @@ static bool vulkan_create_sync_objects(vulkan_context_t context)
         .flags = VK_FENCE_CREATE_SIGNALED_BIT
     };
 
-    context->present_complete_semaphores = malloc(sizeof(VkSemaphore) * MAX_FRAMES_IN_FLIGHT);
-    context->render_finished_semaphores = malloc(sizeof(VkSemaphore) * context->swapchain_images_count);
-    context->in_fligh_fences = malloc(sizeof(VkFence) * MAX_FRAMES_IN_FLIGHT);
+    context->present_complete_semaphores = allocator_allocate(context->allocator, sizeof(VkSemaphore) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
+    context->render_finished_semaphores = allocator_allocate(context->allocator, sizeof(VkSemaphore) * context->swapchain_images_count, ALLOCATOR_SUBSYSTEM_VULKAN);
+    context->in_fligh_fences = allocator_allocate(context->allocator, sizeof(VkFence) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-        if (vkCreateSemaphore(context->device, &semaphore_info, NULL, &(context->present_complete_semaphores[i])) != VK_SUCCESS
-        || vkCreateFence(context->device, &fence_info, NULL, (&context->in_fligh_fences[i])) != VK_SUCCESS)
+        if (vkCreateSemaphore(context->device, &semaphore_info, &context->allocation_callbacks, &(context->present_complete_semaphores[i])) != VK_SUCCESS
+        || vkCreateFence(context->device, &fence_info, &context->allocation_callbacks, (&context->in_fligh_fences[i])) != VK_SUCCESS)
             return false;
     }
 
     for (size_t i = 0; i < context->swapchain_images_count; ++i) {
-        if (vkCreateSemaphore(context->device, &semaphore_info, NULL, &(context->render_finished_semaphores[i])) != VK_SUCCESS)
+        if (vkCreateSemaphore(context->device, &semaphore_info, &context->allocation_callbacks, &(context->render_finished_semaphores[i])) != VK_SUCCESS)
             return false;
     }
     return true;
@@ -860,11 +1983,11 @@ static void vulkan_cleanup_swapchain(vulkan_context_t context)
 {
     if (context->swapchain_image_views) {
         for (uint32_t i = 0; i < context->swapchain_images_count; ++i)
-            vkDestroyImageView(context->device, context->swapchain_image_views[i], NULL);
+            vkDestroyImageView(context->device, context->swapchain_image_views[i], &context->allocation_callbacks);
     }
-    free(context->swapchain_image_views);
-    free(context->swapchain_images);
-    vkDestroySwapchainKHR(context->device, context->swapchain, NULL);
+    allocator_free(context->allocator, context->swapchain_image_views, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->swapchain_images, ALLOCATOR_SUBSYSTEM_VULKAN);
+    vkDestroySwapchainKHR(context->device, context->swapchain, &context->allocation_callbacks);
 }
 
 void vulkan_recreate_swapchain(vulkan_context_t context, window_t window)
@@ -880,27 +2003,33 @@ void vulkan_recreate_swapchain(vulkan_context_t context, window_t window)
 
 void vulkan_update_view(vulkan_context_t context, camera_t camera)
 {
-    mat4 view;
-    glm_lookat(camera->pos, camera->target, camera->up, view);
+    glm_lookat(camera->pos, camera->target, camera->up, context->view);
 
     for (size_t i = 0; i <  MAX_FRAMES_IN_FLIGHT; ++i)
-        memcpy(context->uniform_buffers_mapped[i], &view, sizeof(mat4));
+        memcpy(context->uniform_buffers_mapped[i], &context->view, sizeof(mat4));
 }
 
 void vulkan_update_proj(vulkan_context_t context, camera_t camera)
 {
-    mat4 proj;
+    glm_perspective(camera->fov_in_radians, (float) (context->swapchain_extent.width / context->swapchain_extent.height), camera->render_depth_range[0], camera->render_depth_range[1], context->proj);
+    context->proj[1][1] *= -1;
 
-    glm_perspective(camera->fov_in_radians, (float) (context->swapchain_extent.width / context->swapchain_extent.height), camera->render_depth_range[0], camera->render_depth_range[1], proj);
-    proj[1][1] *= -1;
+    for (size_t i = 0; i <  MAX_FRAMES_IN_FLIGHT; ++i)
+        memcpy(PTR_OFFSET(context->uniform_buffers_mapped[i], offsetof(struct uniform_buffer, proj)), &context->proj, sizeof(mat4));
 
+    vec4 viewport = {
+        (float) context->swapchain_extent.width,
+        (float) context->swapchain_extent.height,
+        1.0f / context->swapchain_extent.width,
+        1.0f / context->swapchain_extent.height
+    };
     for (size_t i = 0; i <  MAX_FRAMES_IN_FLIGHT; ++i)
-        memcpy(PTR_OFFSET(context->uniform_buffers_mapped[i], sizeof(mat4)), &proj, sizeof(mat4));
+        memcpy(PTR_OFFSET(context->uniform_buffers_mapped[i], offsetof(struct uniform_buffer, viewport)), &viewport, sizeof(vec4));
 }
 
-bool vulkan_draw_frame(vulkan_context_t context, window_t window, object_t *objects, uint32_t objects_count)
+bool vulkan_draw_frame(vulkan_context_t context, window_t window, const struct draw_lists *draw_lists, uint32_t dynamic_batch_threshold)
 {
-    vkWaitForFences(context->device, 1, &context->in_fligh_fences[context->current_frame], VK_TRUE, UINT64_MAX);
+    vulkan_begin_frame(context);
 
     VkResult result = vkAcquireNextImageKHR(context->device, context->swapchain, UINT64_MAX, context->present_complete_semaphores[context->current_frame], NULL, &context->image_index);
     VkPipelineStageFlags wait_destination_stage_mask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -927,17 +2056,20 @@ bool vulkan_draw_frame(vulkan_context_t context, window_t window, object_t *obje
         #ifdef WAYLAND_SURFACE
         window->framebuffer_resized = false;
         #endif
+        context->frame_allocator.frame_begun = false;
         return true;
     } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
         #ifdef DEBUG
         write(STDERR_FILENO, "Failed to acquire swapchain image\n", 35);
         #endif
+        context->frame_allocator.frame_begun = false;
         return false;
     }
     vkResetFences(context->device, 1, &context->in_fligh_fences[context->current_frame]);
 
-    vkResetCommandBuffer(context->command_buffers[context->current_frame], VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
-    vulkan_record_command_buffer(context, objects, objects_count);
+    // keep the command buffer memory for the next recording instead of giving it back to the pool every frame
+    vkResetCommandBuffer(context->command_buffers[context->current_frame], 0);
+    vulkan_record_command_buffer(context, draw_lists, dynamic_batch_threshold);
 
     const VkSubmitInfo submit_info = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
@@ -975,6 +2107,7 @@ bool vulkan_draw_frame(vulkan_context_t context, window_t window, object_t *obje
     }
     #endif
 
+    context->frame_allocator.frame_begun = false;
     context->current_frame = (context->current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
     return true;
 }
@@ -1010,7 +2143,7 @@ static bool vulkan_create_buffer(vulkan_context_t context, VkDeviceSize size, Vk
         .pQueueFamilyIndices = NULL
     };
 
-    if (vkCreateBuffer(context->device, &buffer_info, NULL, buffer) != VK_SUCCESS)
+    if (vkCreateBuffer(context->device, &buffer_info, &context->allocation_callbacks, buffer) != VK_SUCCESS)
         return false;
     VkMemoryRequirements memory_requirements;
     vkGetBufferMemoryRequirements(context->device, *buffer, &memory_requirements);
@@ -1026,7 +2159,7 @@ static bool vulkan_create_buffer(vulkan_context_t context, VkDeviceSize size, Vk
         .memoryTypeIndex = memory_type_index
     };
 
-    if (vkAllocateMemory(context->device, &memory_allocate_info, NULL, memory) != VK_SUCCESS
+    if (vkAllocateMemory(context->device, &memory_allocate_info, &context->allocation_callbacks, memory) != VK_SUCCESS
         || vkBindBufferMemory(context->device, *buffer, *memory, 0) != VK_SUCCESS)
         return false;
     return true;
@@ -1074,79 +2207,187 @@ bool vulkan_copy_buffer(vulkan_context_t context, VkBuffer *src_buffer, VkBuffer
     return true;
 }
 
-bool vulkan_create_index_buffer(vulkan_context_t context, object_t object, uint16_t *indices, uint32_t indices_count)
+bool vulkan_create_index_buffer(vulkan_context_t context, mesh_t mesh, uint32_t *indices, uint32_t indices_count, uint32_t vertices_count)
 {
-    VkDeviceSize size = sizeof(uint16_t) * indices_count;
+    // The restart index of strips is the largest index of the type, truncating MESH_PRIMITIVE_RESTART_INDEX to 16 bits gives the 16-bit one
+    bool is_compact = vertices_count <= (vulkan_mesh_topology_restarts(mesh->topology) ? UINT16_MAX : UINT16_MAX + 1u);
+    size_t index_size = is_compact ? sizeof(uint16_t) : sizeof(uint32_t);
+    VkDeviceSize size = index_size * indices_count;
 
-    VkBuffer staging_buffer;
-    VkDeviceMemory staging_memory;
+    mesh->index_type = is_compact ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
 
-    vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_buffer, &staging_memory);
-    
+    VkBuffer staging_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory staging_memory = VK_NULL_HANDLE;
     void *data_staging;
-    vkMapMemory(context->device, staging_memory, 0, size, 0, &data_staging);
-    memcpy(data_staging, indices, size);
-    vkUnmapMemory(context->device, staging_memory);
 
-    vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &object->index_buffer, &object->index_memory);
-    vulkan_copy_buffer(context, &staging_buffer, &object->index_buffer, size);
+    mesh->index_buffer = VK_NULL_HANDLE;
+    mesh->index_memory = VK_NULL_HANDLE;
+    if (!vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_buffer, &staging_memory)
+        || vkMapMemory(context->device, staging_memory, 0, size, 0, &data_staging) != VK_SUCCESS) {
+        vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+        return false;
+    }
+    if (is_compact) {
+        uint16_t *compact_indices = data_staging;
+        for (uint32_t i = 0; i < indices_count; ++i)
+            compact_indices[i] = (uint16_t) indices[i];
+    } else
+        memcpy(data_staging, indices, size);
+    vkUnmapMemory(context->device, staging_memory);
 
-    vkDestroyBuffer(context->device, staging_buffer, NULL);
-    vkFreeMemory(context->device, staging_memory, NULL);
+    bool created = vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &mesh->index_buffer, &mesh->index_memory)
+        && vulkan_copy_buffer(context, &staging_buffer, &mesh->index_buffer, size);
 
-    return true;
+    vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+    if (!created) {
+        vkDestroyBuffer(context->device, mesh->index_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, mesh->index_memory, &context->allocation_callbacks);
+        mesh->index_buffer = VK_NULL_HANDLE;
+        mesh->index_memory = VK_NULL_HANDLE;
+    }
+    return created;
 }
 
-bool vulkan_create_vertex_buffer(vulkan_context_t context, object_t object, struct vertex *vertices, uint32_t vertices_count)
+bool vulkan_create_vertex_buffer(vulkan_context_t context, mesh_t mesh, struct vertex *vertices, uint32_t vertices_count)
 {
     VkDeviceSize size = sizeof(struct vertex) * vertices_count;
 
-    VkBuffer staging_buffer;
-    VkDeviceMemory staging_memory;
-
-    vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_buffer, &staging_memory);
-
+    VkBuffer staging_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory staging_memory = VK_NULL_HANDLE;
     void *data_staging;
-    vkMapMemory(context->device, staging_memory, 0, size, 0, &data_staging);
+
+    mesh->vertex_buffer = VK_NULL_HANDLE;
+    mesh->vertex_memory = VK_NULL_HANDLE;
+    if (!vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_buffer, &staging_memory)
+        || vkMapMemory(context->device, staging_memory, 0, size, 0, &data_staging) != VK_SUCCESS) {
+        vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+        return false;
+    }
     memcpy(data_staging, vertices, size);
     vkUnmapMemory(context->device, staging_memory);
 
-    vulkan_create_buffer(context, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &object->vertex_buffer, &object->vertex_memory);
-    vulkan_copy_buffer(context, &staging_buffer, &object->vertex_buffer, size);
-    vkDestroyBuffer(context->device, staging_buffer, NULL);
-    vkFreeMemory(context->device, staging_memory, NULL);
+    bool created = vulkan_create_buffer(context, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &mesh->vertex_buffer, &mesh->vertex_memory)
+        && vulkan_copy_buffer(context, &staging_buffer, &mesh->vertex_buffer, size);
 
-    return true;
+    vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+    if (!created) {
+        vkDestroyBuffer(context->device, mesh->vertex_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, mesh->vertex_memory, &context->allocation_callbacks);
+        mesh->vertex_buffer = VK_NULL_HANDLE;
+        mesh->vertex_memory = VK_NULL_HANDLE;
+    }
+    return created;
 }
 
 static bool vulkan_create_descriptor_set_layout(vulkan_context_t context)
 {
-    VkDescriptorSetLayoutBinding descriptor_binding = {
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-        .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-        .descriptorCount = 1,
-        .pImmutableSamplers = NULL,
-        .binding = 0
+    VkDescriptorSetLayoutBinding descriptor_bindings[] = {
+        {
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .descriptorCount = 1,
+            .pImmutableSamplers = NULL,
+            .binding = 0
+        },
+        {
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+            .descriptorCount = 1,
+            .pImmutableSamplers = NULL,
+            .binding = 1
+        },
+        {
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .descriptorCount = 1,
+            .pImmutableSamplers = NULL,
+            .binding = 2
+        }
     };
 
     VkDescriptorSetLayoutCreateInfo descriptor_info = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
         .pNext = NULL,
-        .bindingCount = 1,
-        .pBindings = &descriptor_binding,
+        .bindingCount = 3,
+        .pBindings = descriptor_bindings,
         .flags = 0
     };
 
-    if (vkCreateDescriptorSetLayout(context->device, &descriptor_info, NULL, &context->descriptor_set_layout) != VK_SUCCESS)
-        return false;
-    return true;
-}
+    VkDescriptorSetLayoutBinding texture_binding = {
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+        .descriptorCount = TEXTURE_MAX_COUNT,
+        .pImmutableSamplers = NULL,
+        .binding = 0
+    };
+
+    // Elements no texture is written in are never sampled, and textures are written while the array is bound
+    VkDescriptorBindingFlags texture_binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+        | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+        | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo texture_binding_flags_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .pNext = NULL,
+        .bindingCount = 1,
+        .pBindingFlags = &texture_binding_flags
+    };
+
+    VkDescriptorSetLayoutCreateInfo texture_descriptor_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &texture_binding_flags_info,
+        .bindingCount = 1,
+        .pBindings = &texture_binding,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
+    };
+
+    // Segments, rectangles of the paths, tiles and segment pieces binned into them, lists of the screen tiles, then the target of a vector canvas
+    VkDescriptorSetLayoutBinding vector_bindings[VECTOR_DESCRIPTOR_BINDINGS_COUNT];
+
+    for (uint32_t i = 0; i < VECTOR_DESCRIPTOR_BINDINGS_COUNT; ++i) {
+        vector_bindings[i] = (VkDescriptorSetLayoutBinding) {
+            .descriptorType = i == VECTOR_DESCRIPTOR_BINDINGS_COUNT - 1 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            .descriptorCount = 1,
+            .pImmutableSamplers = NULL,
+            .binding = i
+        };
+    }
+
+    VkDescriptorSetLayoutCreateInfo vector_descriptor_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = NULL,
+        .bindingCount = VECTOR_DESCRIPTOR_BINDINGS_COUNT,
+        .pBindings = vector_bindings,
+        .flags = 0
+    };
+
+    if (vkCreateDescriptorSetLayout(context->device, &descriptor_info, &context->allocation_callbacks, &context->descriptor_set_layout) != VK_SUCCESS
+        || vkCreateDescriptorSetLayout(context->device, &texture_descriptor_info, &context->allocation_callbacks, &context->texture_descriptor_set_layout) != VK_SUCCESS
+        || vkCreateDescriptorSetLayout(context->device, &vector_descriptor_info, &context->allocation_callbacks, &context->vector_descriptor_set_layout) != VK_SUCCESS)
+        return false;
+    return true;
+}
 
 static bool vulkan_create_descriptor_pool(vulkan_context_t context)
 {
-    VkDescriptorPoolSize size = {
-        .descriptorCount = MAX_FRAMES_IN_FLIGHT,
-        .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+    VkDescriptorPoolSize sizes[] = {
+        {
+            .descriptorCount = MAX_FRAMES_IN_FLIGHT,
+            .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER
+        },
+        {
+            .descriptorCount = MAX_FRAMES_IN_FLIGHT,
+            .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+        },
+        {
+            .descriptorCount = MAX_FRAMES_IN_FLIGHT,
+            .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+        }
     };
 
     VkDescriptorPoolCreateInfo descriptor_info = {
@@ -1154,18 +2395,54 @@ static bool vulkan_create_descriptor_pool(vulkan_context_t context)
         .pNext = NULL,
         .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
         .maxSets = MAX_FRAMES_IN_FLIGHT,
+        .poolSizeCount = 3,
+        .pPoolSizes = sizes
+    };
+
+    VkDescriptorPoolSize texture_size = {
+        .descriptorCount = TEXTURE_MAX_COUNT,
+        .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+    };
+
+    VkDescriptorPoolCreateInfo texture_descriptor_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = NULL,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1,
         .poolSizeCount = 1,
-        .pPoolSizes = &size
+        .pPoolSizes = &texture_size
     };
 
-    return vkCreateDescriptorPool(context->device, &descriptor_info, NULL, &context->descriptor_pool) == VK_SUCCESS;
+    VkDescriptorPoolSize vector_sizes[] = {
+        {
+            .descriptorCount = VECTOR_CANVAS_MAX_COUNT * (VECTOR_DESCRIPTOR_BINDINGS_COUNT - 1),
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+        },
+        {
+            .descriptorCount = VECTOR_CANVAS_MAX_COUNT,
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+        }
+    };
+
+    VkDescriptorPoolCreateInfo vector_descriptor_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = NULL,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+        .maxSets = VECTOR_CANVAS_MAX_COUNT,
+        .poolSizeCount = 2,
+        .pPoolSizes = vector_sizes
+    };
+
+    return vkCreateDescriptorPool(context->device, &descriptor_info, &context->allocation_callbacks, &context->descriptor_pool) == VK_SUCCESS
+        && vkCreateDescriptorPool(context->device, &texture_descriptor_info, &context->allocation_callbacks, &context->texture_descriptor_pool) == VK_SUCCESS
+        && vkCreateDescriptorPool(context->device, &vector_descriptor_info, &context->allocation_callbacks, &context->vector_descriptor_pool) == VK_SUCCESS;
 }
 
 static bool vulkan_create_uniform_buffers(vulkan_context_t context)
 {
-    context->uniform_buffers = malloc(sizeof(VkBuffer) * MAX_FRAMES_IN_FLIGHT);
-    context->uniform_buffers_memory = malloc(sizeof(VkDeviceMemory) * MAX_FRAMES_IN_FLIGHT);
-    context->uniform_buffers_mapped = malloc(sizeof(void *) * MAX_FRAMES_IN_FLIGHT);
+    context->uniform_buffers = allocator_allocate(context->allocator, sizeof(VkBuffer) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
+    context->uniform_buffers_memory = allocator_allocate(context->allocator, sizeof(VkDeviceMemory) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
+    context->uniform_buffers_mapped = allocator_allocate(context->allocator, sizeof(void *) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         VkDeviceSize size = sizeof(struct uniform_buffer);
@@ -1177,10 +2454,89 @@ static bool vulkan_create_uniform_buffers(vulkan_context_t context)
     return true;
 }
 
+static bool vulkan_create_frame_allocator(vulkan_context_t context)
+{
+    frame_allocator_t frame_allocator = &context->frame_allocator;
+    VkPhysicalDeviceProperties properties;
+    VkDeviceSize size = FRAME_ALLOCATOR_FRAME_SIZE * MAX_FRAMES_IN_FLIGHT;
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT
+        | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+        | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    vkGetPhysicalDeviceProperties(context->physical_device, &properties);
+    frame_allocator->uniform_alignment = properties.limits.minUniformBufferOffsetAlignment;
+    if (properties.limits.minStorageBufferOffsetAlignment > frame_allocator->uniform_alignment)
+        frame_allocator->uniform_alignment = properties.limits.minStorageBufferOffsetAlignment;
+    frame_allocator->frame_size = FRAME_ALLOCATOR_FRAME_SIZE;
+    frame_allocator->frame_start = 0;
+    frame_allocator->offset = 0;
+    frame_allocator->frame_begun = false;
+
+    return vulkan_create_buffer(context, size, usage, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &frame_allocator->buffer, &frame_allocator->memory)
+        && vkMapMemory(context->device, frame_allocator->memory, 0, size, 0, &frame_allocator->mapped) == VK_SUCCESS;
+}
+
+/*
+    The region of a frame is reused only once its fence signaled, waiting lazily on the first use of the frame
+    lets the CPU prepare transient data before engine_display() without racing the GPU
+*/
+void vulkan_begin_frame(vulkan_context_t context)
+{
+    frame_allocator_t frame_allocator = &context->frame_allocator;
+    struct draw_parameters default_parameters = {0};
+
+    if (frame_allocator->frame_begun)
+        return;
+
+    vkWaitForFences(context->device, 1, &context->in_fligh_fences[context->current_frame], VK_TRUE, UINT64_MAX);
+
+    // The slices copied by the last submission of this frame can be written again
+    for (uint32_t i = 0; i < context->streaming_textures_count; ++i) {
+        for (uint32_t j = 0; j < STREAMING_TEXTURE_SLICES_COUNT; ++j) {
+            streaming_texture_slice_t slice = &context->streaming_textures[i]->slices[j];
+
+            if (slice->frame == context->current_frame && atomic_load_explicit(&slice->state, memory_order_relaxed) == STREAMING_TEXTURE_SLICE_PENDING)
+                atomic_store_explicit(&slice->state, STREAMING_TEXTURE_SLICE_FREE, memory_order_release);
+        }
+    }
+
+    frame_allocator->frame_start = frame_allocator->frame_size * context->current_frame;
+    frame_allocator->offset = frame_allocator->frame_start;
+    frame_allocator->frame_begun = true;
+
+    glm_mat4_identity(default_parameters.transform);
+    glm_vec4_one(default_parameters.color);
+    memcpy(PTR_OFFSET(frame_allocator->mapped, frame_allocator->offset), &default_parameters, sizeof(struct draw_parameters));
+    frame_allocator->offset += sizeof(struct draw_parameters);
+}
+
+bool vulkan_frame_allocate(vulkan_context_t context, VkDeviceSize size, VkDeviceSize alignment, frame_allocation_t allocation)
+{
+    frame_allocator_t frame_allocator = &context->frame_allocator;
+
+    vulkan_begin_frame(context);
+    if (alignment == FRAME_ALLOCATOR_UNIFORM_ALIGNMENT)
+        alignment = frame_allocator->uniform_alignment;
+
+    VkDeviceSize offset = (frame_allocator->offset + alignment - 1) & ~(alignment - 1);
+    if (offset + size > frame_allocator->frame_start + frame_allocator->frame_size) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Frame allocator is full\n", 25);
+        #endif
+        return false;
+    }
+
+    frame_allocator->offset = offset + size;
+    allocation->buffer = frame_allocator->buffer;
+    allocation->offset = offset;
+    allocation->data = PTR_OFFSET(frame_allocator->mapped, offset);
+    return true;
+}
+
 static bool vulkan_create_descriptor_sets(vulkan_context_t context)
 {
-    VkDescriptorSetLayout *layouts = malloc(sizeof(VkDescriptorSetLayout) * MAX_FRAMES_IN_FLIGHT);
-    context->descriptor_sets = malloc(sizeof(VkDescriptorSet) * MAX_FRAMES_IN_FLIGHT);
+    VkDescriptorSetLayout *layouts = allocator_allocate(context->allocator, sizeof(VkDescriptorSetLayout) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
+    context->descriptor_sets = allocator_allocate(context->allocator, sizeof(VkDescriptorSet) * MAX_FRAMES_IN_FLIGHT, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
         layouts[i] = context->descriptor_set_layout;
@@ -1193,10 +2549,24 @@ static bool vulkan_create_descriptor_sets(vulkan_context_t context)
         .pSetLayouts = layouts
     };
 
-    if (vkAllocateDescriptorSets(context->device, &descriptor_set_info, context->descriptor_sets) != VK_SUCCESS) {
-        free(layouts);
+    VkDescriptorSetAllocateInfo texture_descriptor_set_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = NULL,
+        .descriptorPool = context->texture_descriptor_pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &context->texture_descriptor_set_layout
+    };
+
+    if (vkAllocateDescriptorSets(context->device, &descriptor_set_info, context->descriptor_sets) != VK_SUCCESS
+        || vkAllocateDescriptorSets(context->device, &texture_descriptor_set_info, &context->texture_descriptor_set) != VK_SUCCESS) {
+        allocator_free(context->allocator, layouts, ALLOCATOR_SUBSYSTEM_VULKAN);
         return false;
     }
+
+    // Popped from the end, so that the first textures take the first elements of the array
+    for (uint32_t i = 0; i < TEXTURE_MAX_COUNT; ++i)
+        context->texture_free_indices[i] = TEXTURE_MAX_COUNT - 1 - i;
+    context->texture_free_indices_count = TEXTURE_MAX_COUNT;
     
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         VkDescriptorBufferInfo buffer_info = {
@@ -1204,26 +2574,507 @@ static bool vulkan_create_descriptor_sets(vulkan_context_t context)
             .offset = 0,
             .range = sizeof(struct uniform_buffer)
         };
+        VkDescriptorBufferInfo draw_parameters_info = {
+            .buffer = context->frame_allocator.buffer,
+            .offset = 0,
+            .range = sizeof(struct draw_parameters)
+        };
+
+        VkWriteDescriptorSet write_descriptors[] = {
+            {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = NULL,
+                .dstSet = context->descriptor_sets[i],
+                .dstBinding = 0,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                .pBufferInfo = &buffer_info
+            },
+            {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = NULL,
+                .dstSet = context->descriptor_sets[i],
+                .dstBinding = 1,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                .pBufferInfo = &draw_parameters_info
+            }
+        };
+
+        vkUpdateDescriptorSets(context->device, 2, write_descriptors, 0, NULL);
+    }
+
+    allocator_free(context->allocator, layouts, ALLOCATOR_SUBSYSTEM_VULKAN);
+    return true;
+}
+
+static bool vulkan_create_sampler(vulkan_context_t context)
+{
+    VkSamplerCreateInfo sampler_info = {
+        .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .magFilter = VK_FILTER_LINEAR,
+        .minFilter = VK_FILTER_LINEAR,
+        .mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST,
+        .addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        .mipLodBias = 0.0f,
+        .anisotropyEnable = VK_FALSE,
+        .maxAnisotropy = 1.0f,
+        .compareEnable = VK_FALSE,
+        .compareOp = VK_COMPARE_OP_ALWAYS,
+        .minLod = 0.0f,
+        .maxLod = 0.0f,
+        .borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
+        .unnormalizedCoordinates = VK_FALSE
+    };
+
+    return vkCreateSampler(context->device, &sampler_info, &context->allocation_callbacks, &context->sampler) == VK_SUCCESS;
+}
+
+static bool vulkan_create_texture_with_usage(vulkan_context_t context, uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, texture_t texture)
+{
+    memset(texture, 0, sizeof(struct texture));
+    if (vulkan_get_texel_size(format) == 0) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Unsupported texture format\n", 28);
+        #endif
+        return false;
+    }
+    if (context->texture_free_indices_count == 0) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many textures\n", 19);
+        #endif
+        return false;
+    }
+
+    VkImageCreateInfo image_info = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = format,
+        .extent = {width, height, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = NULL,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    if (vkCreateImage(context->device, &image_info, &context->allocation_callbacks, &texture->image) != VK_SUCCESS)
+        return false;
+    VkMemoryRequirements memory_requirements;
+    vkGetImageMemoryRequirements(context->device, texture->image, &memory_requirements);
+
+    uint32_t memory_type_index;
+    if (!vulkan_find_memory_type(context, memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memory_type_index)) {
+        vulkan_destroy_texture(context, texture);
+        return false;
+    }
+
+    VkMemoryAllocateInfo memory_allocate_info = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = NULL,
+        .allocationSize = memory_requirements.size,
+        .memoryTypeIndex = memory_type_index
+    };
+
+    if (vkAllocateMemory(context->device, &memory_allocate_info, &context->allocation_callbacks, &texture->memory) != VK_SUCCESS
+        || vkBindImageMemory(context->device, texture->image, texture->memory, 0) != VK_SUCCESS) {
+        vulkan_destroy_texture(context, texture);
+        return false;
+    }
+
+    VkImageViewCreateInfo view_info = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext = NULL,
+        .flags = 0,
+        .image = texture->image,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = format,
+        .components = {
+            .r = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .g = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .b = VK_COMPONENT_SWIZZLE_IDENTITY,
+            .a = VK_COMPONENT_SWIZZLE_IDENTITY
+        },
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+
+    if (vkCreateImageView(context->device, &view_info, &context->allocation_callbacks, &texture->view) != VK_SUCCESS) {
+        vulkan_destroy_texture(context, texture);
+        return false;
+    }
+    texture->index = context->texture_free_indices[--context->texture_free_indices_count];
+
+    VkDescriptorImageInfo descriptor_image_info = {
+        .sampler = context->sampler,
+        .imageView = texture->view,
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+    };
+
+    VkWriteDescriptorSet write_descriptor = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext = NULL,
+        .dstSet = context->texture_descriptor_set,
+        .dstBinding = 0,
+        .dstArrayElement = texture->index,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .pImageInfo = &descriptor_image_info
+    };
+
+    vkUpdateDescriptorSets(context->device, 1, &write_descriptor, 0, NULL);
+    texture->format = format;
+    texture->width = width;
+    texture->height = height;
+    texture->layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    return true;
+}
+
+bool vulkan_create_texture(vulkan_context_t context, uint32_t width, uint32_t height, VkFormat format, texture_t texture)
+{
+    return vulkan_create_texture_with_usage(context, width, height, format, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, texture);
+}
+
+// Texture written by compute shaders in the general layout, then sampled from the texture array like the others
+bool vulkan_create_storage_texture(vulkan_context_t context, uint32_t width, uint32_t height, VkFormat format, texture_t texture)
+{
+    return vulkan_create_texture_with_usage(context, width, height, format, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, texture);
+}
+
+void vulkan_destroy_texture(vulkan_context_t context, texture_t texture)
+{
+    uint32_t kept_count = 0;
+
+    // Drop the updates still queued for the texture
+    for (uint32_t i = 0; i < context->texture_updates_count; ++i) {
+        if (context->texture_updates[i].texture != texture)
+            context->texture_updates[kept_count++] = context->texture_updates[i];
+    }
+    context->texture_updates_count = kept_count;
+    if (context->glyph_atlas_texture == texture)
+        context->glyph_atlas_texture = NULL;
+
+    // Only textures whose view has been created own an element of the array
+    if (texture->view)
+        context->texture_free_indices[context->texture_free_indices_count++] = texture->index;
+    vkDestroyImageView(context->device, texture->view, &context->allocation_callbacks);
+    vkDestroyImage(context->device, texture->image, &context->allocation_callbacks);
+    vkFreeMemory(context->device, texture->memory, &context->allocation_callbacks);
+    memset(texture, 0, sizeof(struct texture));
+}
+
+/*
+    Load time upload of the whole texture through a staging buffer, like the vertex buffers.
+    The barrier before the copy waits for the frames already submitted that sample the texture
+*/
+bool vulkan_upload_texture(vulkan_context_t context, texture_t texture, const void *pixels)
+{
+    VkDeviceSize size = (VkDeviceSize) texture->width * texture->height * vulkan_get_texel_size(texture->format);
+    VkBuffer staging_buffer;
+    VkDeviceMemory staging_memory;
+    void *data;
+
+    if (!vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &staging_buffer, &staging_memory)
+        || vkMapMemory(context->device, staging_memory, 0, size, 0, &data) != VK_SUCCESS) {
+        vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+        return false;
+    }
+    memcpy(data, pixels, size);
+    vkUnmapMemory(context->device, staging_memory);
+
+    VkCommandBufferAllocateInfo alloc_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext = NULL,
+        .commandBufferCount = 1,
+        .commandPool = context->command_pool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY
+    };
+
+    VkCommandBuffer command_buffer;
+    vkAllocateCommandBuffers(context->device, &alloc_info, &command_buffer);
+
+    VkCommandBufferBeginInfo begin_info = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = NULL,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_2_COPY_BIT);
+
+    VkBufferImageCopy region = {
+        .bufferOffset = 0,
+        .bufferRowLength = 0,
+        .bufferImageHeight = 0,
+        .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = 0,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        },
+        .imageOffset = {0, 0, 0},
+        .imageExtent = {texture->width, texture->height, 1}
+    };
+
+    vkCmdCopyBufferToImage(command_buffer, staging_buffer, texture->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    vulkan_transition_texture_layout(command_buffer, texture, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    vkEndCommandBuffer(command_buffer);
+
+    VkSubmitInfo submit_info = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext = NULL,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &command_buffer
+    };
+
+    vkQueueSubmit(context->graphic_queue, 1, &submit_info, NULL);
+    vkQueueWaitIdle(context->graphic_queue);
+
+    vkFreeCommandBuffers(context->device, context->command_pool, 1, &command_buffer);
+    vkDestroyBuffer(context->device, staging_buffer, &context->allocation_callbacks);
+    vkFreeMemory(context->device, staging_memory, &context->allocation_callbacks);
+    return true;
+}
+
+bool vulkan_queue_texture_update(vulkan_context_t context, texture_t texture, const void *pixels, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t row_length)
+{
+    if (context->texture_updates_count >= TEXTURE_MAX_UPDATES_COUNT) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many texture updates queued\n", 33);
+        #endif
+        return false;
+    }
+    if (width == 0 || height == 0)
+        return true;
+
+    context->texture_updates[context->texture_updates_count++] = (struct texture_update) {
+        .texture = texture,
+        .pixels = pixels,
+        .x = x,
+        .y = y,
+        .width = width,
+        .height = height,
+        .row_length = row_length
+    };
+    return true;
+}
+
+bool vulkan_create_instance_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory)
+{
+    return vulkan_create_buffer(context, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory);
+}
+
+// Device local buffer read and written by compute shaders, cleared and updated by transfer commands
+bool vulkan_create_storage_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory)
+{
+    *buffer = VK_NULL_HANDLE;
+    *memory = VK_NULL_HANDLE;
+    if (!vulkan_create_buffer(context, size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory)) {
+        vkDestroyBuffer(context->device, *buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, *memory, &context->allocation_callbacks);
+        return false;
+    }
+    return true;
+}
+
+// Host visible buffer mapped until its memory is freed, for data the CPU writes straight into and the GPU copies from
+bool vulkan_create_staging_buffer(vulkan_context_t context, VkDeviceSize size, VkBuffer *buffer, VkDeviceMemory *memory, void **mapped)
+{
+    *buffer = VK_NULL_HANDLE;
+    *memory = VK_NULL_HANDLE;
+    if (!vulkan_create_buffer(context, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, buffer, memory)
+        || vkMapMemory(context->device, *memory, 0, size, 0, mapped) != VK_SUCCESS) {
+        vkDestroyBuffer(context->device, *buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, *memory, &context->allocation_callbacks);
+        return false;
+    }
+    return true;
+}
+
+bool vulkan_queue_buffer_update(vulkan_context_t context, VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size)
+{
+    if (context->buffer_updates_count >= FRAME_ALLOCATOR_MAX_BUFFER_UPDATES_COUNT) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many buffer updates queued\n", 32);
+        #endif
+        return false;
+    }
+    if (size == 0)
+        return true;
+
+    context->buffer_updates[context->buffer_updates_count++] = (struct buffer_update) {
+        .buffer = buffer,
+        .offset = offset,
+        .data = data,
+        .size = size
+    };
+    return true;
+}
+
+void vulkan_cancel_buffer_updates(vulkan_context_t context, VkBuffer buffer)
+{
+    uint32_t kept_count = 0;
+
+    for (uint32_t i = 0; i < context->buffer_updates_count; ++i) {
+        if (context->buffer_updates[i].buffer != buffer)
+            context->buffer_updates[kept_count++] = context->buffer_updates[i];
+    }
+    context->buffer_updates_count = kept_count;
+}
+
+// Descriptor sets can't be written while a command buffer using them is pending, the texture is set before the first frame
+bool vulkan_add_streaming_texture(vulkan_context_t context, streaming_texture_t streaming_texture)
+{
+    if (context->streaming_textures_count >= STREAMING_TEXTURE_MAX_COUNT) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many streaming textures\n", 29);
+        #endif
+        return false;
+    }
+    context->streaming_textures[context->streaming_textures_count++] = streaming_texture;
+    return true;
+}
+
+void vulkan_remove_streaming_texture(vulkan_context_t context, streaming_texture_t streaming_texture)
+{
+    uint32_t kept_count = 0;
+
+    for (uint32_t i = 0; i < context->streaming_textures_count; ++i) {
+        if (context->streaming_textures[i] != streaming_texture)
+            context->streaming_textures[kept_count++] = context->streaming_textures[i];
+    }
+    context->streaming_textures_count = kept_count;
+}
+
+bool vulkan_allocate_vector_descriptor_set(vulkan_context_t context, VkDescriptorSet *descriptor_set)
+{
+    VkDescriptorSetAllocateInfo descriptor_set_info = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = NULL,
+        .descriptorPool = context->vector_descriptor_pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &context->vector_descriptor_set_layout
+    };
+
+    if (vkAllocateDescriptorSets(context->device, &descriptor_set_info, descriptor_set) != VK_SUCCESS) {
+        #ifdef DEBUG
+        write(STDERR_FILENO, "Too many vector canvases\n", 26);
+        #endif
+        *descriptor_set = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
+}
+
+void vulkan_free_vector_descriptor_set(vulkan_context_t context, VkDescriptorSet descriptor_set)
+{
+    if (descriptor_set)
+        vkFreeDescriptorSets(context->device, context->vector_descriptor_pool, 1, &descriptor_set);
+}
+
+// Written when the canvas is created and when its target is resized, no frame using the set being pending
+void vulkan_write_vector_descriptor_set(vulkan_context_t context, vector_canvas_t canvas)
+{
+    VkDescriptorBufferInfo buffer_infos[VECTOR_DESCRIPTOR_BINDINGS_COUNT - 1] = {
+        {
+            .buffer = canvas->segments_buffer,
+            .offset = 0,
+            .range = VK_WHOLE_SIZE
+        },
+        {
+            .buffer = canvas->scratch_buffer,
+            .offset = 0,
+            .range = canvas->tiles_offset
+        },
+        {
+            .buffer = canvas->scratch_buffer,
+            .offset = canvas->tiles_offset,
+            .range = canvas->nodes_offset - canvas->tiles_offset
+        },
+        {
+            .buffer = canvas->scratch_buffer,
+            .offset = canvas->nodes_offset,
+            .range = VK_WHOLE_SIZE
+        },
+        {
+            .buffer = canvas->coarse_buffer,
+            .offset = 0,
+            .range = VK_WHOLE_SIZE
+        }
+    };
+    VkDescriptorImageInfo image_info = {
+        .sampler = VK_NULL_HANDLE,
+        .imageView = canvas->target.view,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+    };
+    VkWriteDescriptorSet write_descriptors[VECTOR_DESCRIPTOR_BINDINGS_COUNT];
+
+    for (uint32_t i = 0; i < VECTOR_DESCRIPTOR_BINDINGS_COUNT; ++i) {
+        bool is_image = i == VECTOR_DESCRIPTOR_BINDINGS_COUNT - 1;
+
+        write_descriptors[i] = (VkWriteDescriptorSet) {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext = NULL,
+            .dstSet = canvas->descriptor_set,
+            .dstBinding = i,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = is_image ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pBufferInfo = is_image ? NULL : &buffer_infos[i],
+            .pImageInfo = is_image ? &image_info : NULL
+        };
+    }
+
+    vkUpdateDescriptorSets(context->device, VECTOR_DESCRIPTOR_BINDINGS_COUNT, write_descriptors, 0, NULL);
+}
+
+void vulkan_set_glyph_atlas_texture(vulkan_context_t context, texture_t texture)
+{
+    context->glyph_atlas_texture = texture;
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+        VkDescriptorImageInfo image_info = {
+            .sampler = context->sampler,
+            .imageView = texture->view,
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
 
         VkWriteDescriptorSet write_descriptor = {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
             .pNext = NULL,
             .dstSet = context->descriptor_sets[i],
-            .dstBinding = 0,
+            .dstBinding = 2,
             .dstArrayElement = 0,
             .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .pBufferInfo = &buffer_info
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImageInfo = &image_info
         };
 
         vkUpdateDescriptorSets(context->device, 1, &write_descriptor, 0, NULL);
     }
-
-    free(layouts);
-    return true;
 }
 
 bool vulkan_init(vulkan_context_t context,
+    allocator_t allocator,
     surface_context_t surface_context,
     window_t window,
     const char *engine_name,
@@ -1231,6 +3082,9 @@ bool vulkan_init(vulkan_context_t context,
     const char *application_name,
     uint32_t application_version)
 {
+    context->allocator = allocator;
+    allocator_get_vulkan_callbacks(allocator, &context->allocation_callbacks);
+
     return vulkan_create_instance(context, engine_name, engine_version, application_name, application_version)
         && vulkan_init_extensions_functions(context->instance, &context->vulkan_extensions_functions)
         #ifdef DEBUG
@@ -1245,64 +3099,98 @@ bool vulkan_init(vulkan_context_t context,
         && vulkan_create_graphic_pipeline(context)
         && vulkan_create_command_pool(context)
         && vulkan_create_uniform_buffers(context)
+        && vulkan_create_frame_allocator(context)
         && vulkan_create_descriptor_pool(context)
         && vulkan_create_descriptor_sets(context)
+        && vulkan_create_sampler(context)
         && vulkan_create_command_buffers(context)
         && vulkan_create_sync_objects(context);
 }
 
 void vulkan_cleanup(vulkan_context_t context)
 {
+    if (!context->allocator)
+        return;
+
     if (context->device) {
         vulkan_cleanup_swapchain(context);
 
         if (context->descriptor_pool) vkFreeDescriptorSets(context->device, context->descriptor_pool, MAX_FRAMES_IN_FLIGHT, context->descriptor_sets);
-        vkDestroyDescriptorPool(context->device, context->descriptor_pool, NULL);
+        vkDestroyDescriptorPool(context->device, context->descriptor_pool, &context->allocation_callbacks);
+        vkDestroyDescriptorPool(context->device, context->texture_descriptor_pool, &context->allocation_callbacks);
+        vkDestroyDescriptorPool(context->device, context->vector_descriptor_pool, &context->allocation_callbacks);
 
         if (context->uniform_buffers && context->uniform_buffers_mapped) {
             for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
-                vkDestroyBuffer(context->device, context->uniform_buffers[i], NULL);
-                vkFreeMemory(context->device, context->uniform_buffers_memory[i], NULL);
+                vkDestroyBuffer(context->device, context->uniform_buffers[i], &context->allocation_callbacks);
+                vkFreeMemory(context->device, context->uniform_buffers_memory[i], &context->allocation_callbacks);
             }
         }
 
-        vkDestroyDescriptorSetLayout(context->device, context->descriptor_set_layout, NULL);
+        vkDestroyBuffer(context->device, context->frame_allocator.buffer, &context->allocation_callbacks);
+        vkFreeMemory(context->device, context->frame_allocator.memory, &context->allocation_callbacks);
+
+        vkDestroyDescriptorSetLayout(context->device, context->descriptor_set_layout, &context->allocation_callbacks);
+        vkDestroyDescriptorSetLayout(context->device, context->texture_descriptor_set_layout, &context->allocation_callbacks);
+        vkDestroyDescriptorSetLayout(context->device, context->vector_descriptor_set_layout, &context->allocation_callbacks);
+        vkDestroySampler(context->device, context->sampler, &context->allocation_callbacks);
 
         if (context->present_complete_semaphores) {
             for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
-                vkDestroySemaphore(context->device, context->present_complete_semaphores[i], NULL);
+                vkDestroySemaphore(context->device, context->present_complete_semaphores[i], &context->allocation_callbacks);
         }
         if (context->render_finished_semaphores) {
             for (size_t i = 0; i < context->swapchain_images_count; ++i)
-                vkDestroySemaphore(context->device, context->render_finished_semaphores[i], NULL);
+                vkDestroySemaphore(context->device, context->render_finished_semaphores[i], &context->allocation_callbacks);
         }        
         if (context->in_fligh_fences) {
             for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
-                vkDestroyFence(context->device, context->in_fligh_fences[i], NULL);
+                vkDestroyFence(context->device, context->in_fligh_fences[i], &context->allocation_callbacks);
         }
 
         if (context->command_pool) {
             vkFreeCommandBuffers(context->device, context->command_pool, MAX_FRAMES_IN_FLIGHT, context->command_buffers);
-            vkDestroyCommandPool(context->device, context->command_pool, NULL);
+            vkDestroyCommandPool(context->device, context->command_pool, &context->allocation_callbacks);
         }
-        vkDestroyPipeline(context->device, context->graphic_pipeline, NULL);
-        vkDestroyPipelineLayout(context->device, context->pipeline_layout, NULL);
-        vkDestroyDevice(context->device, NULL);
+        vkDestroyPipeline(context->device, context->graphic_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->textured_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->line_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->textured_line_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->object_point_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->textured_object_point_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->batched_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->batched_textured_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->shape_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->quad_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->text_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->tile_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->point_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->point_sprite_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->series_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->vector_composite_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->vector_bin_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->vector_backdrop_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->vector_coarse_pipeline, &context->allocation_callbacks);
+        vkDestroyPipeline(context->device, context->vector_raster_pipeline, &context->allocation_callbacks);
+        vkDestroyPipelineLayout(context->device, context->pipeline_layout, &context->allocation_callbacks);
+        vkDestroyPipelineLayout(context->device, context->vector_pipeline_layout, &context->allocation_callbacks);
+        vkDestroyDevice(context->device, &context->allocation_callbacks);
     }
 
-    free(context->descriptor_sets);
-    free(context->uniform_buffers_mapped);
-    free(context->uniform_buffers);
-    free(context->uniform_buffers_memory);
-    free(context->present_complete_semaphores);
-    free(context->render_finished_semaphores);
-    free(context->in_fligh_fences);
+    allocator_free(context->allocator, context->descriptor_sets, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->uniform_buffers_mapped, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->uniform_buffers, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->uniform_buffers_memory, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->present_complete_semaphores, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->render_finished_semaphores, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->in_fligh_fences, ALLOCATOR_SUBSYSTEM_VULKAN);
+    allocator_free(context->allocator, context->command_buffers, ALLOCATOR_SUBSYSTEM_VULKAN);
 
     #ifdef DEBUG
     if (context->vulkan_extensions_functions.vkDestroyDebugUtilsMessengerEXT)
-        context->vulkan_extensions_functions.vkDestroyDebugUtilsMessengerEXT(context->instance, context->debug_messenger, NULL);
+        context->vulkan_extensions_functions.vkDestroyDebugUtilsMessengerEXT(context->instance, context->debug_messenger, &context->allocation_callbacks);
     #endif
 
-    if (context->instance) vkDestroySurfaceKHR(context->instance, context->surface, NULL);
-    vkDestroyInstance(context->instance, NULL);
+    if (context->instance) vkDestroySurfaceKHR(context->instance, context->surface, &context->allocation_callbacks);
+    vkDestroyInstance(context->instance, &context->allocation_callbacks);
 }
@@ -0,0 +1,622 @@
+#include <vulkan/vulkan.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Vulkan driver doing nothing, linked in place of the loader so that the engine runs headless.
+    Every object is a distinct handle, buffers and images remember their size
+    and device memory is host memory, so that the engine can map it and write to it like on a real device
+*/
+
+#define NULL_DRIVER_SWAPCHAIN_IMAGES_COUNT 3
+#define NULL_DRIVER_WIDTH 800
+#define NULL_DRIVER_HEIGHT 600
+
+struct null_resource {
+    VkDeviceSize size;
+};
+
+static uintptr_t null_driver_handles_count = 0;
+
+#define NULL_DRIVER_HANDLE(type) ((type) ++null_driver_handles_count)
+
+static const char *null_driver_extensions[] = {
+    VK_KHR_SURFACE_EXTENSION_NAME,
+    VK_EXT_DEBUG_UTILS_EXTENSION_NAME
+};
+
+static const char *null_driver_layers[] = {
+    "VK_LAYER_KHRONOS_validation"
+};
+
+// Resources are allocated to remember their size, their memory requirements only depending on it
+static uint64_t null_driver_create_resource(VkDeviceSize size)
+{
+    struct null_resource *resource = malloc(sizeof(struct null_resource));
+
+    if (!resource)
+        return 0;
+    resource->size = size;
+    return (uint64_t) (uintptr_t) resource;
+}
+
+static void null_driver_get_memory_requirements(uint64_t resource, VkMemoryRequirements *requirements)
+{
+    requirements->size = (((struct null_resource *) (uintptr_t) resource)->size + 255) & ~(VkDeviceSize) 255;
+    requirements->alignment = 256;
+    requirements->memoryTypeBits = 1;
+}
+
+static VKAPI_ATTR VkResult VKAPI_CALL null_driver_create_debug_messenger(VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT *create_info, const VkAllocationCallbacks *allocator, VkDebugUtilsMessengerEXT *messenger)
+{
+    *messenger = NULL_DRIVER_HANDLE(VkDebugUtilsMessengerEXT);
+    return VK_SUCCESS;
+}
+
+static VKAPI_ATTR void VKAPI_CALL null_driver_destroy_debug_messenger(VkInstance instance, VkDebugUtilsMessengerEXT messenger, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(VkInstance instance, const char *name)
+{
+    if (strcmp(name, "vkCreateDebugUtilsMessengerEXT") == 0)
+        return (PFN_vkVoidFunction) null_driver_create_debug_messenger;
+    if (strcmp(name, "vkDestroyDebugUtilsMessengerEXT") == 0)
+        return (PFN_vkVoidFunction) null_driver_destroy_debug_messenger;
+    return NULL;
+}
+
+/* === INSTANCE AND PHYSICAL DEVICE === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkInstance *instance)
+{
+    *instance = NULL_DRIVER_HANDLE(VkInstance);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyInstance(VkInstance instance, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceExtensionProperties(const char *layer_name, uint32_t *properties_count, VkExtensionProperties *properties)
+{
+    uint32_t count = sizeof(null_driver_extensions) / sizeof(null_driver_extensions[0]);
+
+    if (properties) {
+        count = *properties_count < count ? *properties_count : count;
+        for (uint32_t i = 0; i < count; ++i) {
+            memset(&properties[i], 0, sizeof(VkExtensionProperties));
+            strcpy(properties[i].extensionName, null_driver_extensions[i]);
+            properties[i].specVersion = 1;
+        }
+    }
+    *properties_count = count;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceLayerProperties(uint32_t *properties_count, VkLayerProperties *properties)
+{
+    uint32_t count = sizeof(null_driver_layers) / sizeof(null_driver_layers[0]);
+
+    if (properties) {
+        count = *properties_count < count ? *properties_count : count;
+        for (uint32_t i = 0; i < count; ++i) {
+            memset(&properties[i], 0, sizeof(VkLayerProperties));
+            strcpy(properties[i].layerName, null_driver_layers[i]);
+        }
+    }
+    *properties_count = count;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEnumeratePhysicalDevices(VkInstance instance, uint32_t *physical_devices_count, VkPhysicalDevice *physical_devices)
+{
+    static VkPhysicalDevice physical_device = VK_NULL_HANDLE;
+
+    if (!physical_device)
+        physical_device = NULL_DRIVER_HANDLE(VkPhysicalDevice);
+    if (physical_devices && *physical_devices_count > 0)
+        physical_devices[0] = physical_device;
+    *physical_devices_count = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceProperties(VkPhysicalDevice physical_device, VkPhysicalDeviceProperties *properties)
+{
+    memset(properties, 0, sizeof(VkPhysicalDeviceProperties));
+    properties->apiVersion = VK_API_VERSION_1_3;
+    properties->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+    strcpy(properties->deviceName, "AntaGL null driver");
+    properties->limits.maxImageDimension2D = 16384;
+    properties->limits.maxPushConstantsSize = 256;
+    properties->limits.minUniformBufferOffsetAlignment = 256;
+    properties->limits.minStorageBufferOffsetAlignment = 64;
+    properties->limits.nonCoherentAtomSize = 64;
+    properties->limits.pointSizeRange[0] = 1.0f;
+    properties->limits.pointSizeRange[1] = 64.0f;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFeatures(VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures *features)
+{
+    VkBool32 *feature = (VkBool32 *) features;
+
+    for (size_t i = 0; i < sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32); ++i)
+        feature[i] = VK_TRUE;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFeatures2(VkPhysicalDevice physical_device, VkPhysicalDeviceFeatures2 *features)
+{
+    vkGetPhysicalDeviceFeatures(physical_device, &features->features);
+    for (VkBaseOutStructure *next = features->pNext; next; next = next->pNext) {
+        if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES) {
+            VkPhysicalDeviceVulkan12Features *features_12 = (VkPhysicalDeviceVulkan12Features *) next;
+
+            features_12->runtimeDescriptorArray = VK_TRUE;
+            features_12->descriptorBindingPartiallyBound = VK_TRUE;
+            features_12->descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            features_12->descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        } else if (next->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES) {
+            VkPhysicalDeviceVulkan13Features *features_13 = (VkPhysicalDeviceVulkan13Features *) next;
+
+            features_13->dynamicRendering = VK_TRUE;
+            features_13->synchronization2 = VK_TRUE;
+        }
+    }
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice physical_device, VkPhysicalDeviceMemoryProperties *properties)
+{
+    memset(properties, 0, sizeof(VkPhysicalDeviceMemoryProperties));
+    properties->memoryTypeCount = 1;
+    properties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    properties->memoryTypes[0].heapIndex = 0;
+    properties->memoryHeapCount = 1;
+    properties->memoryHeaps[0].size = (VkDeviceSize) 1 << 32;
+    properties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice physical_device, uint32_t *properties_count, VkQueueFamilyProperties *properties)
+{
+    if (properties && *properties_count > 0) {
+        memset(properties, 0, sizeof(VkQueueFamilyProperties));
+        properties->queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+        properties->queueCount = 1;
+    }
+    *properties_count = 1;
+}
+
+/* === SURFACE AND SWAPCHAIN === */
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice physical_device, uint32_t queue_family_index, VkSurfaceKHR surface, VkBool32 *supported)
+{
+    *supported = VK_TRUE;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceSurfaceCapabilitiesKHR(VkPhysicalDevice physical_device, VkSurfaceKHR surface, VkSurfaceCapabilitiesKHR *capabilities)
+{
+    memset(capabilities, 0, sizeof(VkSurfaceCapabilitiesKHR));
+    capabilities->minImageCount = 2;
+    capabilities->maxImageCount = NULL_DRIVER_SWAPCHAIN_IMAGES_COUNT;
+    capabilities->currentExtent = (VkExtent2D) {NULL_DRIVER_WIDTH, NULL_DRIVER_HEIGHT};
+    capabilities->minImageExtent = (VkExtent2D) {1, 1};
+    capabilities->maxImageExtent = (VkExtent2D) {NULL_DRIVER_WIDTH, NULL_DRIVER_HEIGHT};
+    capabilities->maxImageArrayLayers = 1;
+    capabilities->supportedTransforms = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    capabilities->currentTransform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+    capabilities->supportedCompositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    capabilities->supportedUsageFlags = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceSurfaceFormatsKHR(VkPhysicalDevice physical_device, VkSurfaceKHR surface, uint32_t *formats_count, VkSurfaceFormatKHR *formats)
+{
+    if (formats && *formats_count > 0)
+        formats[0] = (VkSurfaceFormatKHR) {VK_FORMAT_R8G8B8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+    *formats_count = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceSurfacePresentModesKHR(VkPhysicalDevice physical_device, VkSurfaceKHR surface, uint32_t *present_modes_count, VkPresentModeKHR *present_modes)
+{
+    if (present_modes && *present_modes_count > 0)
+        present_modes[0] = VK_PRESENT_MODE_FIFO_KHR;
+    *present_modes_count = 1;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInfoKHR *create_info, const VkAllocationCallbacks *allocator, VkSwapchainKHR *swapchain)
+{
+    *swapchain = NULL_DRIVER_HANDLE(VkSwapchainKHR);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *images_count, VkImage *images)
+{
+    if (images) {
+        for (uint32_t i = 0; i < *images_count && i < NULL_DRIVER_SWAPCHAIN_IMAGES_COUNT; ++i)
+            images[i] = NULL_DRIVER_HANDLE(VkImage);
+    }
+    *images_count = NULL_DRIVER_SWAPCHAIN_IMAGES_COUNT;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout, VkSemaphore semaphore, VkFence fence, uint32_t *image_index)
+{
+    static uint32_t next_image = 0;
+
+    *image_index = next_image;
+    next_image = (next_image + 1) % NULL_DRIVER_SWAPCHAIN_IMAGES_COUNT;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *present_info)
+{
+    return VK_SUCCESS;
+}
+
+/* === DEVICE AND QUEUE === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateDevice(VkPhysicalDevice physical_device, const VkDeviceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkDevice *device)
+{
+    *device = NULL_DRIVER_HANDLE(VkDevice);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyDevice(VkDevice device, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkDeviceWaitIdle(VkDevice device)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetDeviceQueue(VkDevice device, uint32_t queue_family_index, uint32_t queue_index, VkQueue *queue)
+{
+    static VkQueue device_queue = VK_NULL_HANDLE;
+
+    if (!device_queue)
+        device_queue = NULL_DRIVER_HANDLE(VkQueue);
+    *queue = device_queue;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkQueueSubmit(VkQueue queue, uint32_t submits_count, const VkSubmitInfo *submits, VkFence fence)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkQueueWaitIdle(VkQueue queue)
+{
+    return VK_SUCCESS;
+}
+
+/* === SYNCHRONIZATION === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkSemaphore *semaphore)
+{
+    *semaphore = NULL_DRIVER_HANDLE(VkSemaphore);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateFence(VkDevice device, const VkFenceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkFence *fence)
+{
+    *fence = NULL_DRIVER_HANDLE(VkFence);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkWaitForFences(VkDevice device, uint32_t fences_count, const VkFence *fences, VkBool32 wait_all, uint64_t timeout)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkResetFences(VkDevice device, uint32_t fences_count, const VkFence *fences)
+{
+    return VK_SUCCESS;
+}
+
+/* === MEMORY, BUFFERS AND IMAGES === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateMemory(VkDevice device, const VkMemoryAllocateInfo *allocate_info, const VkAllocationCallbacks *allocator, VkDeviceMemory *memory)
+{
+    void *data = calloc(1, allocate_info->allocationSize);
+
+    if (!data)
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    *memory = (VkDeviceMemory) (uintptr_t) data;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkFreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *allocator)
+{
+    free((void *) (uintptr_t) memory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkMapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, VkMemoryMapFlags flags, void **data)
+{
+    *data = (char *) (uintptr_t) memory + offset;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkUnmapMemory(VkDevice device, VkDeviceMemory memory)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateBuffer(VkDevice device, const VkBufferCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkBuffer *buffer)
+{
+    uint64_t resource = null_driver_create_resource(create_info->size);
+
+    if (!resource)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    *buffer = (VkBuffer) resource;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *allocator)
+{
+    free((void *) (uintptr_t) buffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *requirements)
+{
+    null_driver_get_memory_requirements((uint64_t) buffer, requirements);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    return VK_SUCCESS;
+}
+
+// Images hold up to 16 bytes per texel, the largest format the engine uses
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateImage(VkDevice device, const VkImageCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkImage *image)
+{
+    VkDeviceSize size = (VkDeviceSize) create_info->extent.width * create_info->extent.height * create_info->extent.depth * create_info->arrayLayers * 16;
+    uint64_t resource = null_driver_create_resource(size);
+
+    if (!resource)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    *image = (VkImage) resource;
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *allocator)
+{
+    free((void *) (uintptr_t) image);
+}
+
+VKAPI_ATTR void VKAPI_CALL vkGetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements *requirements)
+{
+    null_driver_get_memory_requirements((uint64_t) image, requirements);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateImageView(VkDevice device, const VkImageViewCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkImageView *view)
+{
+    *view = NULL_DRIVER_HANDLE(VkImageView);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyImageView(VkDevice device, VkImageView view, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateSampler(VkDevice device, const VkSamplerCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkSampler *sampler)
+{
+    *sampler = NULL_DRIVER_HANDLE(VkSampler);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks *allocator)
+{
+}
+
+/* === PIPELINES AND DESCRIPTORS === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkShaderModule *shader_module)
+{
+    *shader_module = NULL_DRIVER_HANDLE(VkShaderModule);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyShaderModule(VkDevice device, VkShaderModule shader_module, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreatePipelineLayout(VkDevice device, const VkPipelineLayoutCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkPipelineLayout *pipeline_layout)
+{
+    *pipeline_layout = NULL_DRIVER_HANDLE(VkPipelineLayout);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyPipelineLayout(VkDevice device, VkPipelineLayout pipeline_layout, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateGraphicsPipelines(VkDevice device, VkPipelineCache cache, uint32_t create_infos_count, const VkGraphicsPipelineCreateInfo *create_infos, const VkAllocationCallbacks *allocator, VkPipeline *pipelines)
+{
+    for (uint32_t i = 0; i < create_infos_count; ++i)
+        pipelines[i] = NULL_DRIVER_HANDLE(VkPipeline);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateComputePipelines(VkDevice device, VkPipelineCache cache, uint32_t create_infos_count, const VkComputePipelineCreateInfo *create_infos, const VkAllocationCallbacks *allocator, VkPipeline *pipelines)
+{
+    for (uint32_t i = 0; i < create_infos_count; ++i)
+        pipelines[i] = NULL_DRIVER_HANDLE(VkPipeline);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkDescriptorSetLayout *set_layout)
+{
+    *set_layout = NULL_DRIVER_HANDLE(VkDescriptorSetLayout);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout set_layout, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateDescriptorPool(VkDevice device, const VkDescriptorPoolCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkDescriptorPool *descriptor_pool)
+{
+    *descriptor_pool = NULL_DRIVER_HANDLE(VkDescriptorPool);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptor_pool, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *allocate_info, VkDescriptorSet *descriptor_sets)
+{
+    for (uint32_t i = 0; i < allocate_info->descriptorSetCount; ++i)
+        descriptor_sets[i] = NULL_DRIVER_HANDLE(VkDescriptorSet);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptor_pool, uint32_t descriptor_sets_count, const VkDescriptorSet *descriptor_sets)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkUpdateDescriptorSets(VkDevice device, uint32_t writes_count, const VkWriteDescriptorSet *writes, uint32_t copies_count, const VkCopyDescriptorSet *copies)
+{
+}
+
+/* === COMMAND BUFFERS === */
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreateCommandPool(VkDevice device, const VkCommandPoolCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkCommandPool *command_pool)
+{
+    *command_pool = NULL_DRIVER_HANDLE(VkCommandPool);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyCommandPool(VkDevice device, VkCommandPool command_pool, const VkAllocationCallbacks *allocator)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkAllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *allocate_info, VkCommandBuffer *command_buffers)
+{
+    for (uint32_t i = 0; i < allocate_info->commandBufferCount; ++i)
+        command_buffers[i] = NULL_DRIVER_HANDLE(VkCommandBuffer);
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkFreeCommandBuffers(VkDevice device, VkCommandPool command_pool, uint32_t command_buffers_count, const VkCommandBuffer *command_buffers)
+{
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkBeginCommandBuffer(VkCommandBuffer command_buffer, const VkCommandBufferBeginInfo *begin_info)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkEndCommandBuffer(VkCommandBuffer command_buffer)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandBuffer(VkCommandBuffer command_buffer, VkCommandBufferResetFlags flags)
+{
+    return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdPipelineBarrier2(VkCommandBuffer command_buffer, const VkDependencyInfo *dependency_info)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBeginRendering(VkCommandBuffer command_buffer, const VkRenderingInfo *rendering_info)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdEndRendering(VkCommandBuffer command_buffer)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindPipeline(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipeline pipeline)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdSetViewport(VkCommandBuffer command_buffer, uint32_t first_viewport, uint32_t viewports_count, const VkViewport *viewports)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdSetScissor(VkCommandBuffer command_buffer, uint32_t first_scissor, uint32_t scissors_count, const VkRect2D *scissors)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdSetPrimitiveTopology(VkCommandBuffer command_buffer, VkPrimitiveTopology topology)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdSetPrimitiveRestartEnable(VkCommandBuffer command_buffer, VkBool32 enable)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindDescriptorSets(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t first_set, uint32_t descriptor_sets_count, const VkDescriptorSet *descriptor_sets, uint32_t dynamic_offsets_count, const uint32_t *dynamic_offsets)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindVertexBuffers(VkCommandBuffer command_buffer, uint32_t first_binding, uint32_t bindings_count, const VkBuffer *buffers, const VkDeviceSize *offsets)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdBindIndexBuffer(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdPushConstants(VkCommandBuffer command_buffer, VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void *values)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdDraw(VkCommandBuffer command_buffer, uint32_t vertices_count, uint32_t instances_count, uint32_t first_vertex, uint32_t first_instance)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdDrawIndexed(VkCommandBuffer command_buffer, uint32_t indices_count, uint32_t instances_count, uint32_t first_index, int32_t vertex_offset, uint32_t first_instance)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdDrawIndirect(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize offset, uint32_t draws_count, uint32_t stride)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdDispatch(VkCommandBuffer command_buffer, uint32_t groups_count_x, uint32_t groups_count_y, uint32_t groups_count_z)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdFillBuffer(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, uint32_t data)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdCopyBuffer(VkCommandBuffer command_buffer, VkBuffer source, VkBuffer destination, uint32_t regions_count, const VkBufferCopy *regions)
+{
+}
+
+VKAPI_ATTR void VKAPI_CALL vkCmdCopyBufferToImage(VkCommandBuffer command_buffer, VkBuffer source, VkImage destination, VkImageLayout layout, uint32_t regions_count, const VkBufferImageCopy *regions)
+{
+}
@@ -0,0 +1,22 @@
+#include "surfaces/surface.h"
+
+/*
+    Surface with no window, used with the null driver to run the engine headless
+*/
+
+const char *surface_instance_extensions[] = {NULL};
+
+bool end_surface_fallback(surface_context_t surface)
+{
+    return true;
+}
+
+bool init_surface_fallback(surface_context_t surface, window_t window)
+{
+    return true;
+}
+
+bool poll_events_surface_fallback(surface_context_t surface)
+{
+    return true;
+}
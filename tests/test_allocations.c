@@ -0,0 +1,90 @@
+#include "AntaGL.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+    Draws the same scene for many frames and checks that once the engine is warm,
+    a frame never goes through the allocator
+*/
+
+#define WARM_UP_FRAMES_COUNT 10
+#define FRAMES_COUNT 1000
+
+static bool draw_frame(engine_t engine, object_t rectangle, object_t triangle, object_t circle)
+{
+    struct draw_parameters parameters;
+
+    glm_mat4_identity(parameters.transform);
+    glm_vec4_one(parameters.color);
+    glm_vec4_zero(parameters.parameters);
+    return engine_poll_events(engine)
+        && engine_draw(engine, rectangle)
+        && engine_draw(engine, triangle)
+        && engine_draw_with_parameters(engine, circle, &parameters)
+        && engine_draw_quad(engine, (vec2) {-0.5f, -0.5f}, (vec2) {0.25f, 0.25f}, (vec4) {1.0f, 1.0f, 1.0f, 1.0f})
+        && engine_display(engine);
+}
+
+int main(void)
+{
+    struct version version = {
+        .major = 1,
+        .minor = 0,
+        .patch = 0
+    };
+    engine_t engine = engine_create("test_allocations", version, 800, 600, 16, NULL);
+    if (!engine) {
+        fprintf(stderr, "Failed to create the engine\n");
+        return EXIT_FAILURE;
+    }
+
+    mat3x2 triangle_positions = {
+        {0.0f, -0.5f},
+        {0.5f, 0.5f},
+        {-0.5f, 0.5f}
+    };
+    object_t rectangle = object_create_rectangle(engine, (vec2) {0.0f, 0.0f}, (vec2) {0.5f, 0.5f}, (vec3) {1.0f, 0.0f, 0.0f});
+    object_t triangle = object_create_triangle(engine, triangle_positions, (vec3) {0.0f, 1.0f, 0.0f});
+    object_t circle = object_create_circle(engine, (vec2) {0.0f, 0.0f}, 0.5f, (vec3) {0.0f, 0.0f, 1.0f}, 32);
+    int status = EXIT_SUCCESS;
+
+    if (!rectangle || !triangle || !circle) {
+        fprintf(stderr, "Failed to create the objects\n");
+        status = EXIT_FAILURE;
+    }
+
+    struct allocator_statistics warm_statistics;
+    struct allocator_statistics statistics;
+    for (int i = 0; status == EXIT_SUCCESS && i < WARM_UP_FRAMES_COUNT; ++i) {
+        if (!draw_frame(engine, rectangle, triangle, circle)) {
+            fprintf(stderr, "Failed to draw warm up frame %d\n", i);
+            status = EXIT_FAILURE;
+        }
+    }
+    engine_get_allocation_statistics(engine, &warm_statistics);
+    for (int i = 0; status == EXIT_SUCCESS && i < FRAMES_COUNT; ++i) {
+        if (!draw_frame(engine, rectangle, triangle, circle)) {
+            fprintf(stderr, "Failed to draw frame %d\n", i);
+            status = EXIT_FAILURE;
+        }
+    }
+    engine_get_allocation_statistics(engine, &statistics);
+
+    uint64_t allocations_count = allocator_statistics_total_allocations(&statistics) - allocator_statistics_total_allocations(&warm_statistics);
+    if (status == EXIT_SUCCESS && allocations_count != 0) {
+        fprintf(stderr, "%llu allocations made in %d frames after warm up\n", (unsigned long long) allocations_count, FRAMES_COUNT);
+        for (int i = 0; i < ALLOCATOR_SUBSYSTEM_COUNT; ++i)
+            fprintf(stderr, "    subsystem %d: %llu\n", i, (unsigned long long) (statistics.allocations_count[i] - warm_statistics.allocations_count[i]));
+        status = EXIT_FAILURE;
+    }
+
+    engine_wait_idle(engine);
+    if (rectangle)
+        object_destroy(engine, rectangle);
+    if (triangle)
+        object_destroy(engine, triangle);
+    if (circle)
+        object_destroy(engine, circle);
+    engine_cleanup(engine);
+    return status;
+}
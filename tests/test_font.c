@@ -0,0 +1,213 @@
+#include "font.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+    Parses a minimal TrueType font built in memory, then malformed copies of it: every truncation and
+    a table offset wrapping around 32 bits. Blocks are allocated at their exact size followed by guard bytes,
+    so that writing past a block is caught without the slack of the default allocator
+*/
+
+#define GUARD_SIZE 16
+#define GUARD_BYTE 0xAB
+#define HEADER_SIZE 16
+
+#define TABLES_COUNT 7
+#define TABLE_RECORDS 12
+#define GLYPH_PIXELS_SIZE 32
+
+static bool guard_overwritten = false;
+
+static void guard_check(unsigned char *base)
+{
+    size_t size;
+
+    memcpy(&size, base, sizeof(size));
+    for (size_t i = 0; i < GUARD_SIZE; ++i) {
+        if (base[HEADER_SIZE + size + i] != GUARD_BYTE)
+            guard_overwritten = true;
+    }
+}
+
+static void *guard_allocate(void *user_data, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    unsigned char *base = malloc(HEADER_SIZE + size + GUARD_SIZE);
+
+    if (!base || alignment > HEADER_SIZE) {
+        free(base);
+        return NULL;
+    }
+    memcpy(base, &size, sizeof(size));
+    memset(base + HEADER_SIZE + size, GUARD_BYTE, GUARD_SIZE);
+    return base + HEADER_SIZE;
+}
+
+static void guard_deallocate(void *user_data, void *memory, enum allocator_subsystem subsystem)
+{
+    unsigned char *base = (unsigned char *) memory - HEADER_SIZE;
+
+    guard_check(base);
+    free(base);
+}
+
+static void *guard_reallocate(void *user_data, void *memory, size_t size, size_t alignment, enum allocator_subsystem subsystem)
+{
+    void *new_memory = guard_allocate(user_data, size, alignment, subsystem);
+    size_t old_size;
+
+    if (!new_memory)
+        return NULL;
+    memcpy(&old_size, (unsigned char *) memory - HEADER_SIZE, sizeof(old_size));
+    memcpy(new_memory, memory, old_size < size ? old_size : size);
+    guard_deallocate(user_data, memory, subsystem);
+    return new_memory;
+}
+
+static uint32_t put_u16(uint8_t *data, uint32_t offset, uint16_t value)
+{
+    data[offset] = (uint8_t) (value >> 8);
+    data[offset + 1] = (uint8_t) value;
+    return offset + 2;
+}
+
+static uint32_t put_u32(uint8_t *data, uint32_t offset, uint32_t value)
+{
+    put_u16(data, offset, (uint16_t) (value >> 16));
+    return put_u16(data, offset + 2, (uint16_t) value);
+}
+
+static uint32_t put_table(uint8_t *data, uint32_t index, const char *tag, uint32_t offset, uint32_t length)
+{
+    uint32_t record = TABLE_RECORDS + 16 * index;
+
+    memcpy(data + record, tag, 4);
+    put_u32(data, record + 8, offset);
+    put_u32(data, record + 12, length);
+    return (offset + length + 3) & ~3u;
+}
+
+// Two glyphs, the empty .notdef and 'A' drawn as a triangle of three on curve points
+static uint32_t font_build(uint8_t *data)
+{
+    uint32_t offset = TABLE_RECORDS + 16 * TABLES_COUNT;
+    uint32_t cursor;
+
+    put_u32(data, 0, 0x00010000);
+    put_u16(data, 4, TABLES_COUNT);
+
+    put_u16(data, offset + 18, 1000);
+    put_u16(data, offset + 50, 0);
+    offset = put_table(data, 0, "head", offset, 54);
+
+    put_u16(data, offset + 4, 800);
+    put_u16(data, offset + 6, (uint16_t) -200);
+    put_u16(data, offset + 34, 2);
+    offset = put_table(data, 1, "hhea", offset, 36);
+
+    put_u16(data, offset + 4, 2);
+    offset = put_table(data, 2, "maxp", offset, 6);
+
+    cursor = put_u16(data, offset + 2, 1);
+    cursor = put_u16(data, cursor, 3);
+    cursor = put_u16(data, cursor, 1);
+    cursor = put_u32(data, cursor, 12);
+    cursor = put_u16(data, cursor, 4);
+    cursor = put_u16(data, cursor + 4, 4);
+    cursor = put_u16(data, cursor + 6, 'A');
+    cursor = put_u16(data, cursor, 0xFFFF);
+    cursor = put_u16(data, cursor + 2, 'A');
+    cursor = put_u16(data, cursor, 0xFFFF);
+    cursor = put_u16(data, cursor, (uint16_t) (1 - 'A'));
+    cursor = put_u16(data, cursor, 1);
+    cursor += 4;
+    offset = put_table(data, 3, "cmap", offset, cursor - offset);
+
+    put_u16(data, offset, 500);
+    put_u16(data, offset + 4, 600);
+    offset = put_table(data, 4, "hmtx", offset, 8);
+
+    put_u16(data, offset + 4, 15);
+    offset = put_table(data, 5, "loca", offset, 6);
+
+    cursor = put_u16(data, offset, 1);
+    put_u16(data, cursor, 100);
+    cursor = put_u16(data, cursor + 4, 500);
+    cursor = put_u16(data, cursor, 600);
+    cursor = put_u16(data, cursor, 2);
+    cursor = put_u16(data, cursor, 0);
+    memset(data + cursor, 0x01, 3);
+    cursor += 3;
+    cursor = put_u16(data, cursor, 100);
+    cursor = put_u16(data, cursor, 400);
+    cursor = put_u16(data, cursor, (uint16_t) -200);
+    cursor = put_u16(data, cursor, 0);
+    cursor = put_u16(data, cursor, 0);
+    cursor = put_u16(data, cursor, 600);
+    return put_table(data, 6, "glyf", offset, 30);
+}
+
+// Initializes the font and, when it loads, rasterizes 'A', which must not write out of any block
+static bool font_parse(struct allocator *allocator, const uint8_t *data, uint32_t size, bool *loaded)
+{
+    struct font font;
+    uint8_t pixels[GLYPH_PIXELS_SIZE * GLYPH_PIXELS_SIZE];
+
+    *loaded = font_init(&font, data, size);
+    if (*loaded) {
+        uint32_t glyph = font_get_glyph_index(&font, 'A');
+        float scale = 24.0f / font.units_per_em;
+
+        if (!font_rasterize_glyph_sdf(&font, allocator, glyph, scale, (vec2) {4.0f, 28.0f}, 4.0f, pixels, GLYPH_PIXELS_SIZE, GLYPH_PIXELS_SIZE, GLYPH_PIXELS_SIZE))
+            return false;
+    }
+    return !guard_overwritten;
+}
+
+int main(void)
+{
+    struct allocator allocator = {
+        .allocate = guard_allocate,
+        .reallocate = guard_reallocate,
+        .deallocate = guard_deallocate,
+        .user_data = NULL
+    };
+    static uint8_t data[512];
+    uint32_t size = font_build(data);
+    struct font font;
+    bool loaded;
+
+    if (!font_init(&font, data, size) || font_get_glyph_index(&font, 'A') != 1) {
+        fprintf(stderr, "Failed to load the font\n");
+        return EXIT_FAILURE;
+    }
+    int16_t box[4];
+    if (!font_get_glyph_box(&font, 1, box) || box[0] != 100 || box[2] != 500 || box[3] != 600) {
+        fprintf(stderr, "Wrong box of the glyph\n");
+        return EXIT_FAILURE;
+    }
+    if (!font_parse(&allocator, data, size, &loaded)) {
+        fprintf(stderr, "Rasterizing the glyph wrote out of its block\n");
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t truncated_size = 0; truncated_size < size; ++truncated_size) {
+        uint8_t *truncated = malloc(truncated_size ? truncated_size : 1);
+
+        memcpy(truncated, data, truncated_size);
+        bool result = font_parse(&allocator, truncated, truncated_size, &loaded);
+        free(truncated);
+        if (!result) {
+            fprintf(stderr, "Failed to parse the font truncated to %u bytes\n", truncated_size);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The head table offset wraps around 32 bits when added to the offsets of its fields
+    put_u32(data, TABLE_RECORDS + 8, 0xFFFFFFED);
+    if (!font_parse(&allocator, data, size, &loaded) || loaded) {
+        fprintf(stderr, "Loaded a font whose head table is out of the file\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}